@@ -277,6 +277,14 @@ void AActor::MarkPartitionDirty()
 		GetWorld()->GetPartitionManager()->MarkDirty(this);
 }
 
+void AActor::SetActorHiddenInGame(bool bNewHidden)
+{
+	if (bHiddenInGame == bNewHidden) return;
+	bHiddenInGame = bNewHidden;
+	// 숨김 여부는 오클루더 선정에 영향을 주므로 캐시된 가시성 결과를 무효화
+	MarkPartitionDirty();
+}
+
 void AActor::SetActorRotation(const FVector& EulerDegree)
 {
 	if (RootComponent)
@@ -123,7 +123,7 @@ public:
     bool GetIsPicked() { return bIsPicked; }
 
     // 가시성
-    void SetActorHiddenInGame(bool bNewHidden) { bHiddenInGame = bNewHidden; }
+    void SetActorHiddenInGame(bool bNewHidden);
     bool GetActorHiddenInGame() const { return bHiddenInGame; }
     bool IsActorVisible() const { return !bHiddenInGame; }
 
@@ -19,6 +19,8 @@ public:
     // 상태 확인 함수
     bool IsLoading() const { return bIsLoading; }
     bool IsSaving() const { return bIsSaving; }
+    // 읽기/쓰기가 중간에 실패했는지 (짧은 파일 등). 이후 읽은 값은 믿을 수 없다
+    virtual bool IsError() const { return false; }
 
     template<typename T>
     FArchive& operator<<(T& Value)
@@ -7,9 +7,15 @@
 #include <algorithm>
 #include "Frustum.h"
 #include "Picking.h" // FRay
+#include "JobSystem.h"
+#include "SimdDispatch.h"
+#include "RadixSort.h"
+#include <atomic>
+#include <bit>
 #include <cfloat>
 #include <cmath>
 #include <functional>
+#include <immintrin.h>
 #include <queue>
 
 namespace {
@@ -43,6 +49,49 @@ namespace {
         outTMax = tmax;
         return true;
     }
+
+    // 8개 레이를 SoA 로 묶은 패킷 (방향은 역수로 보관)
+    struct FRayPacket8
+    {
+        __m256 OX, OY, OZ;
+        __m256 IX, IY, IZ;
+    };
+
+    // 축에 평행한 방향은 아주 작은 값으로 바꿔 역수가 inf 가 되지 않게 한다 (0 * inf = NaN 방지)
+    inline float SafeInverse(float d)
+    {
+        if (std::abs(d) < 1e-6f) d = (d < 0.0f) ? -1e-6f : 1e-6f;
+        return 1.0f / d;
+    }
+
+    // 패킷 vs AABB 슬랩 테스트. 진입 거리가 MaxT 이하인 레인 마스크를 반환
+    inline int RayPacketAABB8(const FRayPacket8& P, const FBound& B, __m256 MaxT)
+    {
+        const __m256 tx1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(B.Min.X), P.OX), P.IX);
+        const __m256 tx2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(B.Max.X), P.OX), P.IX);
+        const __m256 ty1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(B.Min.Y), P.OY), P.IY);
+        const __m256 ty2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(B.Max.Y), P.OY), P.IY);
+        const __m256 tz1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(B.Min.Z), P.OZ), P.IZ);
+        const __m256 tz2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(B.Max.Z), P.OZ), P.IZ);
+
+        __m256 tmin = _mm256_max_ps(_mm256_min_ps(tx1, tx2), _mm256_setzero_ps());
+        tmin = _mm256_max_ps(tmin, _mm256_min_ps(ty1, ty2));
+        tmin = _mm256_max_ps(tmin, _mm256_min_ps(tz1, tz2));
+        __m256 tmax = _mm256_min_ps(_mm256_max_ps(tx1, tx2), _mm256_max_ps(ty1, ty2));
+        tmax = _mm256_min_ps(tmax, _mm256_max_ps(tz1, tz2));
+
+        const __m256 hit = _mm256_and_ps(
+            _mm256_cmp_ps(tmin, tmax, _CMP_LE_OQ),
+            _mm256_cmp_ps(tmin, MaxT, _CMP_LE_OQ));
+        return _mm256_movemask_ps(hit);
+    }
+
+    // 리핏 전파 중단 판정용 (정확히 같은 바운드면 상위는 바뀌지 않음)
+    inline bool BoundsEqual(const FBound& A, const FBound& B)
+    {
+        return A.Min.X == B.Min.X && A.Min.Y == B.Min.Y && A.Min.Z == B.Min.Z &&
+               A.Max.X == B.Max.X && A.Max.Y == B.Max.Y && A.Max.Z == B.Max.Z;
+    }
 }
 
 FBVHierachy::FBVHierachy(const FBound& InBounds, int InDepth, int InMaxDepth, int InMaxObjects)
@@ -61,10 +110,29 @@ FBVHierachy::~FBVHierachy()
 void FBVHierachy::Clear()
 {
     Primitives = TArray<UPrimitiveComponent*>();
-    PrimLastBounds = TMap<UPrimitiveComponent*, FBound>();
+    SlotPrims = TArray<UPrimitiveComponent*>();
+    SlotBounds = TArray<FBound>();
+    SlotOwners = TArray<AActor*>();
+    SlotFlags = TArray<uint8>();
+    SlotOrder = TArray<int32>();
+    SlotLeaf = TArray<int32>();
+    FreeSlots = TArray<int32>();
+    LiveSlotCount = 0;
+    PrimToSlot = TMap<UPrimitiveComponent*, int32>();
+    ActorSlots = TMap<AActor*, TArray<int32>>();
     PrimArray = TArray<UPrimitiveComponent*>();
+    PrimArrayBounds = TArray<FBound>();
+    PrimArrayBoundsSoA = FBoundSoA();
+    PrimArraySlots = TArray<int32>();
     Nodes = TArray<FLBVHNode>();
+    WideNodes = TArray<FWideNode>();
+    WideSlotOfNode = TArray<int32>();
+    LeafRejectPlane = TArray<uint8>();
+    DirtyLeaves = TSet<int32>();
     Bounds = FBound();
+    TotalCostArea = 0.0f;
+    BuildCostRatio = 0.0f;
+    RefitCount = 0;
     bPendingRebuild = false;
 
 }
@@ -73,8 +141,8 @@ void FBVHierachy::Insert(UPrimitiveComponent* InPrimitive, const FBound& PrimBou
 {
     if (!InPrimitive) return;
 
-    PrimLastBounds.Add(InPrimitive, PrimBounds);
-    bPendingRebuild = true;
+    // 이미 트리에 있는 컴포넌트면 구조는 그대로 두고 바운드만 리핏
+    UpsertPrimitive(InPrimitive, PrimBounds);
 }
 
 void FBVHierachy::BulkInsert(const TArray<std::pair<UPrimitiveComponent*, FBound>>& PrimsAndBounds)
@@ -82,10 +150,10 @@ void FBVHierachy::BulkInsert(const TArray<std::pair<UPrimitiveComponent*, FBound
     for (const auto& kv : PrimsAndBounds)
     {
         if (kv.first)
-            PrimLastBounds.Add(kv.first, kv.second);
+            UpsertPrimitive(kv.first, kv.second);
     }
 
-    BuildLBVHFromMap();
+    BuildTreeFromSlots();
     bPendingRebuild = false;
 }
 
@@ -94,108 +162,588 @@ bool FBVHierachy::Contains(const FBound& Box) const
     return Bounds.Contains(Box);
 }
 
+int32 FBVHierachy::FindPrimitiveHandle(UPrimitiveComponent* InPrimitive) const
+{
+    const int32* Slot = PrimToSlot.Find(InPrimitive);
+    return Slot ? *Slot : InvalidHandle;
+}
+
 bool FBVHierachy::Remove(UPrimitiveComponent* InPrimitive, const FBound& PrimBounds)
 {
     if (!InPrimitive) return false;
-    bool existed = PrimLastBounds.Remove(InPrimitive);
-    bPendingRebuild = existed || bPendingRebuild;
-    return existed;
+    const int32* Slot = PrimToSlot.Find(InPrimitive);
+    if (!Slot) return false;
+    FreeSlot(*Slot);
+    return true;
 }
 
 void FBVHierachy::Update(UPrimitiveComponent* InPrimitive, const FBound& OldBounds, const FBound& NewBounds)
 {
     if (!InPrimitive) return;
-    PrimLastBounds.Add(InPrimitive, NewBounds);
-    bPendingRebuild = true;
+    UpsertPrimitive(InPrimitive, NewBounds);
 }
 
 void FBVHierachy::Remove(AActor* InActor)
 {
     if (!InActor) return;
-    TArray<UPrimitiveComponent*> ToRemove;
-    for (const auto& kv : PrimLastBounds)
-    {
-        UPrimitiveComponent* Prim = kv.first;
-        if (Prim && Prim->GetOwner() == InActor)
-            ToRemove.Add(Prim);
-    }
-    for (UPrimitiveComponent* Prim : ToRemove)
-        PrimLastBounds.Remove(Prim);
-    if (!ToRemove.empty()) bPendingRebuild = true;
+    const TArray<int32>* Slots = ActorSlots.Find(InActor);
+    if (!Slots) return;
+    // FreeSlot 이 목록을 수정하므로 복사본으로 순회
+    const TArray<int32> ToRemove = *Slots;
+    for (int32 Slot : ToRemove)
+        FreeSlot(Slot);
 }
 
 void FBVHierachy::Update(AActor* InActor)
 {
     if (!InActor) return;
     // 동기화: 액터의 모든 PrimitiveComponent를 최신 바운즈로 추가/갱신, 사라진 것은 제거
-    TSet<UPrimitiveComponent*> Seen;
+    TSet<int32> Seen;
     for (USceneComponent* SC : InActor->GetSceneComponents())
     {
         if (UPrimitiveComponent* Prim = Cast<UPrimitiveComponent>(SC))
         {
-            PrimLastBounds.Add(Prim, Prim->GetWorldAABB());
-            Seen.insert(Prim);
+            UpsertPrimitive(Prim, Prim->GetWorldAABB());
+            Seen.insert(PrimToSlot[Prim]);
         }
     }
-    TArray<UPrimitiveComponent*> ToRemove;
-    for (const auto& kv : PrimLastBounds)
+    if (const TArray<int32>* Slots = ActorSlots.Find(InActor))
     {
-        UPrimitiveComponent* Prim = kv.first;
-        if (Prim && Prim->GetOwner() == InActor && !Seen.contains(Prim))
+        TArray<int32> ToRemove;
+        for (int32 Slot : *Slots)
         {
-            ToRemove.Add(Prim);
+            if (!Seen.contains(Slot))
+                ToRemove.Add(Slot);
         }
+        for (int32 Slot : ToRemove)
+            FreeSlot(Slot);
     }
-    for (UPrimitiveComponent* Prim : ToRemove)
-        PrimLastBounds.Remove(Prim);
 
-    bPendingRebuild = true;
     FlushRebuild();
 }
 
-void FBVHierachy::QueryFrustum(const Frustum& InFrustum)
+void FBVHierachy::UpsertPrimitive(UPrimitiveComponent* InPrimitive, const FBound& InBounds)
 {
+    const int32* Found = PrimToSlot.Find(InPrimitive);
+    if (!Found)
+    {
+        // 트리에 아직 없는 컴포넌트는 구조 변경이므로 재빌드 대상
+        AllocateSlot(InPrimitive, InBounds);
+        bPendingRebuild = true;
+        return;
+    }
+
+    const int32 Slot = *Found;
+    SlotBounds[Slot] = InBounds;
+    if (SlotOrder[Slot] < 0)
+    {
+        bPendingRebuild = true;
+        return;
+    }
+    PrimArrayBounds[SlotOrder[Slot]] = InBounds;
+    PrimArrayBoundsSoA.Set(SlotOrder[Slot], InBounds);
+    DirtyLeaves.insert(SlotLeaf[Slot]);
+}
+
+int32 FBVHierachy::AllocateSlot(UPrimitiveComponent* InPrimitive, const FBound& InBounds)
+{
+    int32 Slot;
+    if (!FreeSlots.empty())
+    {
+        Slot = FreeSlots.back();
+        FreeSlots.pop_back();
+    }
+    else
+    {
+        Slot = static_cast<int32>(SlotPrims.size());
+        SlotPrims.push_back(nullptr);
+        SlotBounds.push_back(FBound());
+        SlotOwners.push_back(nullptr);
+        SlotFlags.push_back(0);
+        SlotOrder.push_back(-1);
+        SlotLeaf.push_back(-1);
+    }
+
+    AActor* Owner = InPrimitive->GetOwner();
+    SlotPrims[Slot] = InPrimitive;
+    SlotBounds[Slot] = InBounds;
+    SlotOwners[Slot] = Owner;
+    SlotFlags[Slot] = PrimSlot_Alive;
+    SlotOrder[Slot] = -1;
+    SlotLeaf[Slot] = -1;
+    PrimToSlot.Add(InPrimitive, Slot);
+    ActorSlots[Owner].Add(Slot);
+    ++LiveSlotCount;
+    return Slot;
+}
+
+void FBVHierachy::FreeSlot(int32 Slot)
+{
+    if (Slot < 0 || Slot >= static_cast<int32>(SlotPrims.size()) || !(SlotFlags[Slot] & PrimSlot_Alive)) return;
+
+    PrimToSlot.Remove(SlotPrims[Slot]);
+    if (TArray<int32>* Slots = ActorSlots.Find(SlotOwners[Slot]))
+    {
+        auto It = std::find(Slots->begin(), Slots->end(), Slot);
+        if (It != Slots->end())
+        {
+            *It = Slots->back();
+            Slots->pop_back();
+        }
+        if (Slots->empty()) ActorSlots.Remove(SlotOwners[Slot]);
+    }
+
+    // 재빌드 전까지 트리에 남은 자리는 비워서 쿼리가 건너뛰게 한다
+    if (SlotOrder[Slot] >= 0)
+        PrimArray[SlotOrder[Slot]] = nullptr;
+
+    SlotPrims[Slot] = nullptr;
+    SlotOwners[Slot] = nullptr;
+    SlotFlags[Slot] = 0;
+    SlotOrder[Slot] = -1;
+    SlotLeaf[Slot] = -1;
+    FreeSlots.push_back(Slot);
+    --LiveSlotCount;
+    bPendingRebuild = true;
+}
+
+void FBVHierachy::QueryFrustum(const Frustum& InFrustum, TArray<UPrimitiveComponent*>& OutVisible, const FScreenSizeCullParams* ScreenSize)
+{
+    LastFrustumNodeVisits = 0;
+    LastFrustumPlaneTests = 0;
+    LastScreenSizeCulled = 0;
     if (Nodes.empty()) return;
-    if (!IsAABBVisible(InFrustum, Nodes[0].Bounds)) return;
-    if (!IsAABBIntersects(InFrustum, Nodes[0].Bounds))
+
+    if (ScreenSize && !ScreenSize->IsEnabled()) ScreenSize = nullptr;
+
+    // 루트: 밖이면 끝, 완전히 안쪽이면 전부 보임
+    uint32 RootPlanes = FrustumAllPlanes;
+    uint8 RootReject = 0;
+    if (!IsAABBVisibleMasked(InFrustum, Nodes[0].Bounds, RootPlanes, RootReject, LastFrustumPlaneTests)) return;
+    if (ScreenSize && IsSubtreeBelowScreenSize(*ScreenSize, Nodes[0].Bounds))
+    {
+        ++LastScreenSizeCulled;
+        return;
+    }
+
+    // 프러스텀을 통과한 프리미티브의 화면 크기 판정
+    auto PassesScreenSize = [&](int32 i)
+    {
+        if (!ScreenSize || !IsPrimitiveBelowScreenSize(*ScreenSize, PrimArray[i]->GetClass(), PrimArrayBounds[i])) return true;
+        ++LastScreenSizeCulled;
+        return false;
+    };
+
+    auto AcceptRange = [&](int32 First, int32 Count)
     {
-        for (UPrimitiveComponent* Prim : PrimArray)
+        for (int32 i = First; i < First + Count; ++i)
         {
-            Prim->SetCulled(false);
+            if (PrimArray[i] && PassesScreenSize(i)) OutVisible.push_back(PrimArray[i]);
         }
+    };
+    if (RootPlanes == 0)
+    {
+        AcceptRange(0, static_cast<int32>(PrimArray.size()));
         return;
     }
-    TArray<int32> IdxStack;
-    IdxStack.push_back({ 0 });
 
-    while (!IdxStack.empty())
+    // 리프 프리미티브는 부모에서 남은 평면만 테스트
+    auto CullLeaf = [&](int32 LeafIdx, uint32 PlaneMask)
     {
-        int32 Idx = IdxStack.back();
-        IdxStack.pop_back();
-        const FLBVHNode& node = Nodes[Idx];
-        if (node.IsLeaf())
+        const FLBVHNode& node = Nodes[LeafIdx];
+        if (PlaneMask == 0)
+        {
+            AcceptRange(node.First, node.Count);
+            return;
+        }
+        if (node.Count >= LeafStreamCullMin)
         {
-            for (int32 i = 0; i < node.Count; ++i)
+            // 큰 리프: SoA 구간을 SIMD 폭으로 한 번에
+            LeafVisibleIndices.resize(node.Count);
+            const int32 NumVisible = CullAABBStream(InFrustum, PrimArrayBoundsSoA.MakeStream(node.First, node.Count), LeafVisibleIndices.data(), PlaneMask);
+            LastFrustumPlaneTests += static_cast<uint32>(node.Count * std::popcount(PlaneMask));
+            for (int32 n = 0; n < NumVisible; ++n)
             {
-                UPrimitiveComponent* Prim = PrimArray[node.First + i];
-                if (!Prim || PrimLastBounds.find(Prim) == PrimLastBounds.end())
-                    continue;
-                const FBound* Cached = PrimLastBounds.Find(Prim);
-                const FBound Box = Cached ? *Cached : Prim->GetWorldAABB();
-                if (IsAABBVisible(InFrustum, Box))
+                const int32 i = node.First + static_cast<int32>(LeafVisibleIndices[n]);
+                if (PrimArray[i] && PassesScreenSize(i)) OutVisible.push_back(PrimArray[i]);
+            }
+            return;
+        }
+        uint8& RejectPlane = LeafRejectPlane[LeafIdx];
+        for (int32 i = node.First; i < node.First + node.Count; ++i)
+        {
+            UPrimitiveComponent* Prim = PrimArray[i];
+            if (!Prim) continue;
+            uint32 Planes = PlaneMask;
+            if (IsAABBVisibleMasked(InFrustum, PrimArrayBounds[i], Planes, RejectPlane, LastFrustumPlaneTests) && PassesScreenSize(i))
+            {
+                OutVisible.push_back(Prim);
+            }
+        }
+    };
+
+    if (WideNodes.empty())
+    {
+        // 루트가 리프인 작은 트리
+        CullLeaf(0, RootPlanes);
+        return;
+    }
+
+    // BVH8: 노드마다 자식 8개를 남은 평면에 대해 SIMD 로 한 번에 테스트
+    struct FStackItem
+    {
+        int32 Wide;
+        uint32 Planes;
+    };
+    TArray<FStackItem> Stack;
+    Stack.push_back({ 0, RootPlanes });
+    while (!Stack.empty())
+    {
+        const FStackItem Item = Stack.back();
+        Stack.pop_back();
+        FWideNode& Wide = WideNodes[Item.Wide];
+        ++LastFrustumNodeVisits;
+
+        const FCullResult8 Cull = CullAABBs8Masked(InFrustum, Wide.ChildBounds, Wide.ChildMask, Item.Planes, Wide.LastRejectPlane);
+        LastFrustumPlaneTests += Cull.PlaneTests;
+        if (Cull.RejectPlane >= 0)
+        {
+            Wide.LastRejectPlane = static_cast<uint8>(Cull.RejectPlane);
+            continue;
+        }
+
+        uint32 Mask = Cull.Visible;
+        while (Mask)
+        {
+            const int32 Lane = std::countr_zero(Mask);
+            Mask &= Mask - 1;
+
+            // 이 레인이 완전히 안쪽인 평면은 서브트리에서 제외
+            uint32 ChildPlanes = Item.Planes;
+            for (int32 p = 0; p < 6; ++p)
+            {
+                if (Cull.Inside[p] & (1u << Lane)) ChildPlanes &= ~(1u << p);
+            }
+
+            // 서브트리 전체가 화면에서 임계 픽셀보다 작으면 통째로 스킵
+            if (ScreenSize && IsSubtreeBelowScreenSize(*ScreenSize, Wide.ChildBounds.Get(Lane)))
+            {
+                ++LastScreenSizeCulled;
+                continue;
+            }
+
+            const int32 Child = Wide.Child[Lane];
+            if (ChildPlanes == 0)
+                AcceptRange(Wide.PrimFirst[Lane], Wide.PrimCount[Lane]);
+            else if (Child >= 0)
+                Stack.push_back({ Child, ChildPlanes });
+            else
+                CullLeaf(~Child, ChildPlanes);
+        }
+    }
+}
+
+void FBVHierachy::QueryFrustumMulti(const TArray<Frustum>& InFrustums, OUT TArray<UPrimitiveComponent*>& OutPrimitives, OUT TArray<uint8>& OutViewMasks,
+    const TArray<FScreenSizeCullParams>* ScreenSizes)
+{
+    OutPrimitives.clear();
+    OutViewMasks.clear();
+    LastFrustumNodeVisits = 0;
+    LastFrustumPlaneTests = 0;
+    LastScreenSizeCulled = 0;
+    const int32 NumViews = std::min(static_cast<int32>(InFrustums.size()), MaxMultiViews);
+    if (Nodes.empty() || NumViews == 0) return;
+
+    // 뷰별 화면 크기 컬링 (비활성 뷰는 nullptr)
+    const FScreenSizeCullParams* ViewScreenSize[MaxMultiViews] = {};
+    if (ScreenSizes)
+    {
+        for (int32 v = 0; v < NumViews && v < static_cast<int32>(ScreenSizes->size()); ++v)
+        {
+            if ((*ScreenSizes)[v].IsEnabled()) ViewScreenSize[v] = &(*ScreenSizes)[v];
+        }
+    }
+    auto SubtreeTooSmall = [&](int32 View, const FBound& Bound)
+    {
+        if (!ViewScreenSize[View] || !IsSubtreeBelowScreenSize(*ViewScreenSize[View], Bound)) return false;
+        ++LastScreenSizeCulled;
+        return true;
+    };
+    auto PrimTooSmall = [&](int32 View, int32 i)
+    {
+        if (!ViewScreenSize[View] || !IsPrimitiveBelowScreenSize(*ViewScreenSize[View], PrimArray[i]->GetClass(), PrimArrayBounds[i])) return false;
+        ++LastScreenSizeCulled;
+        return true;
+    };
+
+    // 마스크 배열은 쿼리 사이에 항상 0 으로 유지하고, 이번 쿼리에서 켠 인덱스만 기록해 두었다가 그것만 내보내고 지운다
+    // (월드 전체를 매번 0 으로 채우고 훑지 않도록)
+    if (MultiViewPrimMasks.size() != PrimArray.size())
+    {
+        MultiViewPrimMasks.assign(PrimArray.size(), 0);
+    }
+    MultiViewTouched.clear();
+    auto MarkVisible = [&](int32 i, uint8 ViewBit)
+    {
+        if (MultiViewPrimMasks[i] == 0) MultiViewTouched.push_back(i);
+        MultiViewPrimMasks[i] |= ViewBit;
+    };
+
+    // 뷰별로 남은 평면 마스크를 들고 내려간다 (ViewMask 의 비트가 꺼진 뷰는 이미 탈락했거나 서브트리 전체 수용)
+    struct FMultiItem
+    {
+        int32 Wide;
+        uint8 Views;
+        uint8 Planes[MaxMultiViews];
+    };
+
+    auto AcceptRange = [&](int32 First, int32 Count, int32 View)
+    {
+        const uint8 ViewBit = static_cast<uint8>(1u << View);
+        for (int32 i = First; i < First + Count; ++i)
+        {
+            if (PrimArray[i] && !PrimTooSmall(View, i)) MarkVisible(i, ViewBit);
+        }
+    };
+
+    // 리프 프리미티브는 뷰마다 남은 평면만 테스트 (탈락 평면 캐시는 단일 뷰 쿼리 전용이라 여기선 쓰지 않는다)
+    auto CullLeaf = [&](int32 LeafIdx, uint8 Views, const uint8* Planes)
+    {
+        const FLBVHNode& node = Nodes[LeafIdx];
+        for (int32 v = 0; v < NumViews; ++v)
+        {
+            const uint8 ViewBit = static_cast<uint8>(1u << v);
+            if (!(Views & ViewBit)) continue;
+            if (Planes[v] == 0)
+            {
+                AcceptRange(node.First, node.Count, v);
+                continue;
+            }
+            if (node.Count >= LeafStreamCullMin)
+            {
+                LeafVisibleIndices.resize(node.Count);
+                const int32 NumVisible = CullAABBStream(InFrustums[v], PrimArrayBoundsSoA.MakeStream(node.First, node.Count), LeafVisibleIndices.data(), Planes[v]);
+                LastFrustumPlaneTests += static_cast<uint32>(node.Count * std::popcount(static_cast<uint32>(Planes[v])));
+                for (int32 n = 0; n < NumVisible; ++n)
+                {
+                    const int32 i = node.First + static_cast<int32>(LeafVisibleIndices[n]);
+                    if (PrimArray[i] && !PrimTooSmall(v, i)) MarkVisible(i, ViewBit);
+                }
+                continue;
+            }
+            for (int32 i = node.First; i < node.First + node.Count; ++i)
+            {
+                if (!PrimArray[i]) continue;
+                uint32 PlaneMask = Planes[v];
+                uint8 RejectPlane = 0;
+                if (IsAABBVisibleMasked(InFrustums[v], PrimArrayBounds[i], PlaneMask, RejectPlane, LastFrustumPlaneTests) && !PrimTooSmall(v, i))
                 {
-                    Prim->SetCulled(false);
+                    MarkVisible(i, ViewBit);
                 }
             }
+        }
+    };
+
+    // 루트
+    FMultiItem Root{ 0, 0, {} };
+    for (int32 v = 0; v < NumViews; ++v)
+    {
+        uint32 PlaneMask = FrustumAllPlanes;
+        uint8 RejectPlane = 0;
+        if (!IsAABBVisibleMasked(InFrustums[v], Nodes[0].Bounds, PlaneMask, RejectPlane, LastFrustumPlaneTests)) continue;
+        if (SubtreeTooSmall(v, Nodes[0].Bounds)) continue;
+        if (PlaneMask == 0)
+        {
+            AcceptRange(0, static_cast<int32>(PrimArray.size()), v);
             continue;
         }
-        if (node.Left >= 0 && IsAABBVisible(InFrustum, Nodes[node.Left].Bounds))
-            IdxStack.push_back({ node.Left });
-        if (node.Right >= 0 && IsAABBVisible(InFrustum, Nodes[node.Right].Bounds))
-            IdxStack.push_back({ node.Right });
+        Root.Views |= static_cast<uint8>(1u << v);
+        Root.Planes[v] = static_cast<uint8>(PlaneMask);
+    }
+
+    if (Root.Views != 0)
+    {
+        if (WideNodes.empty())
+        {
+            CullLeaf(0, Root.Views, Root.Planes);
+        }
+        else
+        {
+            // BVH8: 노드의 자식 바운드를 한 번 읽어 활성 뷰마다 SIMD 로 테스트하고, 레인별 뷰 마스크를 만든다
+            TArray<FMultiItem> Stack;
+            Stack.push_back(Root);
+            while (!Stack.empty())
+            {
+                const FMultiItem Item = Stack.back();
+                Stack.pop_back();
+                const FWideNode& Wide = WideNodes[Item.Wide];
+                ++LastFrustumNodeVisits;
+
+                FMultiItem ChildItems[8] = {};
+                for (int32 v = 0; v < NumViews; ++v)
+                {
+                    const uint8 ViewBit = static_cast<uint8>(1u << v);
+                    if (!(Item.Views & ViewBit)) continue;
+
+                    const FCullResult8 Cull = CullAABBs8Masked(InFrustums[v], Wide.ChildBounds, Wide.ChildMask, Item.Planes[v], 0);
+                    LastFrustumPlaneTests += Cull.PlaneTests;
+
+                    uint32 Mask = Cull.Visible;
+                    while (Mask)
+                    {
+                        const int32 Lane = std::countr_zero(Mask);
+                        Mask &= Mask - 1;
+
+                        uint32 ChildPlanes = Item.Planes[v];
+                        for (int32 p = 0; p < 6; ++p)
+                        {
+                            if (Cull.Inside[p] & (1u << Lane)) ChildPlanes &= ~(1u << p);
+                        }
+
+                        if (SubtreeTooSmall(v, Wide.ChildBounds.Get(Lane)))
+                        {
+                            continue;
+                        }
+                        if (ChildPlanes == 0)
+                        {
+                            AcceptRange(Wide.PrimFirst[Lane], Wide.PrimCount[Lane], v);
+                        }
+                        else
+                        {
+                            ChildItems[Lane].Views |= ViewBit;
+                            ChildItems[Lane].Planes[v] = static_cast<uint8>(ChildPlanes);
+                        }
+                    }
+                }
+
+                for (int32 Lane = 0; Lane < 8; ++Lane)
+                {
+                    if (ChildItems[Lane].Views == 0) continue;
+                    const int32 Child = Wide.Child[Lane];
+                    if (Child >= 0)
+                    {
+                        ChildItems[Lane].Wide = Child;
+                        Stack.push_back(ChildItems[Lane]);
+                    }
+                    else
+                    {
+                        CullLeaf(~Child, ChildItems[Lane].Views, ChildItems[Lane].Planes);
+                    }
+                }
+            }
+        }
+    }
+
+    // 방문한 프리미티브만 PrimArray 순서로 한 번씩 내보내고 마스크를 되돌린다 (여러 뷰에서 보여도 중복 없음)
+    std::sort(MultiViewTouched.begin(), MultiViewTouched.end());
+    OutPrimitives.reserve(MultiViewTouched.size());
+    OutViewMasks.reserve(MultiViewTouched.size());
+    for (const int32 i : MultiViewTouched)
+    {
+        OutPrimitives.push_back(PrimArray[i]);
+        OutViewMasks.push_back(MultiViewPrimMasks[i]);
+        MultiViewPrimMasks[i] = 0;
     }
 }
 
+void FBVHierachy::BuildWideNodes()
+{
+    WideNodes.clear();
+    WideSlotOfNode.assign(Nodes.size(), -1);
+    LeafRejectPlane.assign(Nodes.size(), 0);
+    if (Nodes.empty() || Nodes[0].IsLeaf()) return;
+
+    // 노드별 서브트리 프리미티브 구간 (두 빌더 모두 자식 인덱스 > 부모 인덱스, 서브트리는 연속 구간)
+    TArray<int32> SubFirst, SubEnd;
+    SubFirst.resize(Nodes.size());
+    SubEnd.resize(Nodes.size());
+    for (int32 i = static_cast<int32>(Nodes.size()) - 1; i >= 0; --i)
+    {
+        const FLBVHNode& N = Nodes[i];
+        if (N.IsLeaf())
+        {
+            SubFirst[i] = N.First;
+            SubEnd[i] = N.First + N.Count;
+        }
+        else
+        {
+            SubFirst[i] = std::min(SubFirst[N.Left], SubFirst[N.Right]);
+            SubEnd[i] = std::max(SubEnd[N.Left], SubEnd[N.Right]);
+        }
+    }
+
+    // 내부 노드 하나당 최대 하나의 와이드 노드
+    WideNodes.reserve(Nodes.size() / 2 + 1);
+    WideNodes.emplace_back();
+
+    TArray<std::pair<int32, int32>> Stack; // (바이너리 내부 노드, 와이드 노드)
+    Stack.push_back({ 0, 0 });
+    while (!Stack.empty())
+    {
+        const auto [BinaryIdx, WideIdx] = Stack.back();
+        Stack.pop_back();
+
+        // 자식 후보 중 면적이 가장 큰 내부 노드를 두 자식으로 펼치기를 8개가 될 때까지 반복
+        int32 Cand[8];
+        int32 NumCand = 2;
+        Cand[0] = Nodes[BinaryIdx].Left;
+        Cand[1] = Nodes[BinaryIdx].Right;
+        while (NumCand < 8)
+        {
+            int32 Best = -1;
+            float BestArea = -1.0f;
+            for (int32 c = 0; c < NumCand; ++c)
+            {
+                const FLBVHNode& N = Nodes[Cand[c]];
+                if (N.IsLeaf()) continue;
+                const float Area = SurfaceArea(N.Bounds);
+                if (Area > BestArea) { BestArea = Area; Best = c; }
+            }
+            if (Best < 0) break;
+            const FLBVHNode& Expand = Nodes[Cand[Best]];
+            Cand[Best] = Expand.Left;
+            Cand[NumCand++] = Expand.Right;
+        }
+
+        for (int32 Lane = 0; Lane < 8; ++Lane)
+        {
+            if (Lane >= NumCand)
+            {
+                WideNodes[WideIdx].ChildBounds.SetEmpty(Lane);
+                WideNodes[WideIdx].Child[Lane] = -1;
+                WideNodes[WideIdx].PrimFirst[Lane] = 0;
+                WideNodes[WideIdx].PrimCount[Lane] = 0;
+                continue;
+            }
+            const int32 C = Cand[Lane];
+            WideSlotOfNode[C] = WideIdx * 8 + Lane;
+            WideNodes[WideIdx].PrimFirst[Lane] = SubFirst[C];
+            WideNodes[WideIdx].PrimCount[Lane] = SubEnd[C] - SubFirst[C];
+            WideNodes[WideIdx].ChildBounds.Set(Lane, Nodes[C].Bounds);
+            WideNodes[WideIdx].ChildMask |= static_cast<uint8>(1u << Lane);
+            if (Nodes[C].IsLeaf())
+            {
+                WideNodes[WideIdx].Child[Lane] = ~C;
+            }
+            else
+            {
+                const int32 ChildWide = static_cast<int32>(WideNodes.size());
+                WideNodes.emplace_back();
+                WideNodes[WideIdx].Child[Lane] = ChildWide;
+                Stack.push_back({ C, ChildWide });
+            }
+        }
+    }
+}
+
+void FBVHierachy::WriteWideLane(int32 NodeIdx)
+{
+    if (NodeIdx < 0 || NodeIdx >= static_cast<int32>(WideSlotOfNode.size())) return;
+    const int32 Slot = WideSlotOfNode[NodeIdx];
+    if (Slot < 0) return;
+    WideNodes[Slot / 8].ChildBounds.Set(Slot % 8, Nodes[NodeIdx].Bounds);
+}
+
 void FBVHierachy::DebugDraw(URenderer* Renderer) const
 {
     if (!Renderer) return;
@@ -247,20 +795,32 @@ int FBVHierachy::TotalNodeCount() const
 
 int FBVHierachy::TotalActorCount() const
 {
-    return static_cast<int>(PrimArray.size());
+    return LiveSlotCount;
 }
 
 int FBVHierachy::MaxOccupiedDepth() const
 {
-    return (Nodes.empty()) ? 0 : (int)std::ceil(std::log2((double)Nodes.size() + 1));
+    return BuildReport.MaxDepth;
 }
 
 void FBVHierachy::DebugDump() const
 {
-    UE_LOG("===== BVHierachy (LBVH) DUMP BEGIN =====\r\n");
+    const char* ModeName = BuildMode == EBVHBuildMode::BinnedSAH ? "BinnedSAH" : "LBVH";
     char buf[256];
+    std::snprintf(buf, sizeof(buf), "===== BVHierachy (%s) DUMP BEGIN =====\r\n", ModeName);
+    UE_LOG(buf);
     std::snprintf(buf, sizeof(buf), "nodes=%zu, actors=%zu\r\n", Nodes.size(), PrimArray.size());
     UE_LOG(buf);
+    const FBVHQualityReport Report = ComputeQualityReport();
+    std::snprintf(buf, sizeof(buf), "SAH cost=%.3f, overlap=%.3f, depth max=%d avg=%.2f, leaves=%d\r\n",
+        Report.SAHCost, Report.Overlap, Report.MaxDepth, Report.AvgLeafDepth, Report.LeafCount);
+    UE_LOG(buf);
+    std::snprintf(buf, sizeof(buf), "BVH8 nodes=%zu, last query visits: frustum=%u wide nodes (%u plane tests), ray=%u nodes\r\n",
+        WideNodes.size(), LastFrustumNodeVisits, LastFrustumPlaneTests, LastRayNodeVisits);
+    UE_LOG(buf);
+    std::snprintf(buf, sizeof(buf), "refits=%u, cost ratio=%.3f (build %.3f, rebuild x%.2f)\r\n",
+        RefitCount, CurrentCostRatio(), BuildCostRatio, RefitRebuildThreshold);
+    UE_LOG(buf);
     for (size_t i = 0; i < Nodes.size(); ++i)
     {
         const auto& n = Nodes[i];
@@ -271,7 +831,8 @@ void FBVHierachy::DebugDump() const
             n.Bounds.Max.X, n.Bounds.Max.Y, n.Bounds.Max.Z);
         UE_LOG(buf);
     }
-    UE_LOG("===== BVHierachy (LBVH) DUMP END =====\r\n");
+    std::snprintf(buf, sizeof(buf), "===== BVHierachy (%s) DUMP END =====\r\n", ModeName);
+    UE_LOG(buf);
 }
 
 
@@ -289,31 +850,63 @@ FBound FBVHierachy::UnionBounds(const FBound& A, const FBound& B)
     return out;
 }
 
-// Morton helpers
+// Morton helpers (축당 21비트, 63비트 코드)
 namespace {
-    inline uint32 ExpandBits(uint32 v)
+    constexpr uint32 MortonAxisMax = (1u << 21) - 1;
+    constexpr uint32 MortonBits = 63;
+    // 병렬 빌드 단계별 최소 작업 단위 (이보다 작으면 호출 스레드에서 그대로 처리)
+    constexpr int32 LBVHMinBatch = 4096;
+
+    inline uint64 ExpandBits(uint64 v)
     {
-        v = (v * 0x00010001u) & 0xFF0000FFu;
-        v = (v * 0x00000101u) & 0x0F00F00Fu;
-        v = (v * 0x00000011u) & 0xC30C30C3u;
-        v = (v * 0x00000005u) & 0x49249249u;
+        v &= 0x1FFFFFull;
+        v = (v | (v << 32)) & 0x1F00000000FFFFull;
+        v = (v | (v << 16)) & 0x1F0000FF0000FFull;
+        v = (v | (v << 8)) & 0x100F00F00F00F00Full;
+        v = (v | (v << 4)) & 0x10C30C30C30C30C3ull;
+        v = (v | (v << 2)) & 0x1249249249249249ull;
         return v;
     }
-    inline uint32 Morton3D(uint32 x, uint32 y, uint32 z)
+    inline uint64 Morton3D(uint32 x, uint32 y, uint32 z)
     {
         return (ExpandBits(x) << 2) | (ExpandBits(y) << 1) | ExpandBits(z);
     }
 }
 
-void FBVHierachy::BuildLBVHFromMap()
+void FBVHierachy::SetBuildMode(EBVHBuildMode InMode)
 {
-    // 프리미티브 수
-    PrimArray = TArray<UPrimitiveComponent*>();
-    PrimArray.reserve(PrimLastBounds.size());
-    for (const auto& kv : PrimLastBounds) PrimArray.Add(kv.first);
+    if (BuildMode == InMode) return;
+    BuildMode = InMode;
+    bPendingRebuild = true;
+    FlushRebuild();
+}
+
+void FBVHierachy::BuildTreeFromSlots()
+{
+    // 살아 있는 슬롯을 모은다 (빌더는 PrimArraySlots / PrimArrayBounds 를 리프 순서로 재배열)
+    PrimArraySlots = TArray<int32>();
+    PrimArrayBounds = TArray<FBound>();
+    PrimArraySlots.reserve(LiveSlotCount);
+    PrimArrayBounds.reserve(LiveSlotCount);
+    for (int32 Slot = 0; Slot < static_cast<int32>(SlotPrims.size()); ++Slot)
+    {
+        SlotOrder[Slot] = -1;
+        SlotLeaf[Slot] = -1;
+        if (!(SlotFlags[Slot] & PrimSlot_Alive)) continue;
+        PrimArraySlots.Add(Slot);
+        PrimArrayBounds.Add(SlotBounds[Slot]);
+    }
 
-    const int N = static_cast<int>(PrimArray.size());
+    const int N = static_cast<int>(PrimArraySlots.size());
+    PrimArray = TArray<UPrimitiveComponent*>();
+    PrimArrayBoundsSoA.Reset();
     Nodes = TArray<FLBVHNode>();
+    WideNodes.clear();
+    WideSlotOfNode.clear();
+    DirtyLeaves.clear();
+    TotalCostArea = 0.0f;
+    BuildCostRatio = 0.0f;
+    BuildReport = FBVHQualityReport();
 
     if (N == 0)
     {
@@ -322,84 +915,471 @@ void FBVHierachy::BuildLBVHFromMap()
     }
 
     // 글로벌 바운드 박스 계산
-    auto it0 = PrimLastBounds.begin();
-    Bounds = it0->second;
-    for (const auto& kv : PrimLastBounds) Bounds = UnionBounds(Bounds, kv.second);
-
-    // 프리미티브들의 모튼 코드 계산
-    TArray<uint32> codes;
-    codes.resize(N);
-    FVector gmin = Bounds.Min;
-    FVector ext = Bounds.GetExtent();
-    for (int i = 0; i < N; ++i)
+    Bounds = PrimArrayBounds[0];
+    for (const FBound& b : PrimArrayBounds) Bounds = UnionBounds(Bounds, b);
+
+    if (BuildMode == EBVHBuildMode::BinnedSAH)
+    {
+        BuildBinnedSAH();
+    }
+    else
     {
-        const FBound* b = PrimLastBounds.Find(PrimArray[i]);
-        FVector c = b ? b->GetCenter() : PrimArray[i]->GetWorldAABB().GetCenter();
-        float nx = (ext.X > 0) ? (c.X - gmin.X) / (ext.X * 2.0f) : 0.5f;
-        float ny = (ext.Y > 0) ? (c.Y - gmin.Y) / (ext.Y * 2.0f) : 0.5f;
-        float nz = (ext.Z > 0) ? (c.Z - gmin.Z) / (ext.Z * 2.0f) : 0.5f;
-        nx = std::clamp(nx, 0.0f, 1.0f);
-        ny = std::clamp(ny, 0.0f, 1.0f);
-        nz = std::clamp(nz, 0.0f, 1.0f);
-        uint32 ix = (uint32)(nx * 1023.0f);
-        uint32 iy = (uint32)(ny * 1023.0f);
-        uint32 iz = (uint32)(nz * 1023.0f);
-        codes[i] = Morton3D(ix, iy, iz);
+        BuildLBVH();
     }
 
-    // Primitive와 Morton 코드를 함께 정렬
-    TArray<std::pair<UPrimitiveComponent*, uint32>> primCodePairs;
-    primCodePairs.resize(N);
-    for (int i = 0; i < N; ++i) {
-        primCodePairs[i] = {PrimArray[i], codes[i]};
+    // 리프 순서 확정: 슬롯 -> 위치 / 리프 역참조
+    PrimArray.resize(N);
+    PrimArrayBoundsSoA.Resize(N);
+    for (int32 i = 0; i < N; ++i)
+    {
+        const int32 Slot = PrimArraySlots[i];
+        PrimArray[i] = SlotPrims[Slot];
+        PrimArrayBoundsSoA.Set(i, PrimArrayBounds[i]);
+        SlotOrder[Slot] = i;
+    }
+    for (int32 NodeIdx = 0; NodeIdx < static_cast<int32>(Nodes.size()); ++NodeIdx)
+    {
+        const FLBVHNode& Node = Nodes[NodeIdx];
+        for (int32 i = Node.First; i < Node.First + Node.Count; ++i)
+            SlotLeaf[PrimArraySlots[i]] = NodeIdx;
     }
-    std::sort(primCodePairs.begin(), primCodePairs.end(), 
-        [](const auto& a, const auto& b) { return a.second < b.second; });
+    BuildWideNodes();
+
+    // 리핏 품질 기준점 기록
+    for (const FLBVHNode& Node : Nodes)
+        TotalCostArea += NodeCostArea(Node);
+    BuildCostRatio = CurrentCostRatio();
+    BuildReport = ComputeQualityReport();
+}
+
+// Karras(2012) 방식 병렬 LBVH
+// 1) 모튼 코드 병렬 계산  2) 병렬 LSD 기수 정렬  3) 내부 노드별 독립적으로 자식/범위 결정
+// 4) 리프에서 루트로 원자적 카운터를 이용해 바운드 병렬 전파  5) 전위 순서로 압축 (MaxObjects 이하 범위는 리프로)
+void FBVHierachy::BuildLBVH()
+{
+    const TArray<FBound>& PrimBounds = PrimArrayBounds;
+    const int32 N = static_cast<int32>(PrimArraySlots.size());
+
+    // 1) 프리미티브들의 모튼 코드 계산
+    TArray<uint64> Codes;
+    TArray<uint32> Order;
+    Codes.resize(N);
+    Order.resize(N);
+    const FVector gmin = Bounds.Min;
+    const FVector size = Bounds.Max - Bounds.Min;
+    FJobSystem::ParallelFor(N, LBVHMinBatch, [&](int32 Begin, int32 End)
+    {
+        for (int32 i = Begin; i < End; ++i)
+        {
+            const FVector c = PrimBounds[i].GetCenter();
+            const float nx = (size.X > 0) ? std::clamp((c.X - gmin.X) / size.X, 0.0f, 1.0f) : 0.5f;
+            const float ny = (size.Y > 0) ? std::clamp((c.Y - gmin.Y) / size.Y, 0.0f, 1.0f) : 0.5f;
+            const float nz = (size.Z > 0) ? std::clamp((c.Z - gmin.Z) / size.Z, 0.0f, 1.0f) : 0.5f;
+            Codes[i] = Morton3D((uint32)(nx * MortonAxisMax), (uint32)(ny * MortonAxisMax), (uint32)(nz * MortonAxisMax));
+            Order[i] = static_cast<uint32>(i);
+        }
+    });
+
+    // 2) 코드 기준 안정 정렬 (같은 코드는 원래 순서 유지 -> 아래 Delta 에서 인덱스로 구분)
+    RadixSortPairs(Codes, Order, MortonBits);
 
-    // 정렬된 결과를 ActorArray에 다시 저장
-    for (int i = 0; i < N; ++i) {
-        PrimArray[i] = primCodePairs[i].first;
+    TArray<int32> SortedSlots;
+    TArray<FBound> SortedBounds;
+    SortedSlots.resize(N);
+    SortedBounds.resize(N);
+    FJobSystem::ParallelFor(N, LBVHMinBatch, [&](int32 Begin, int32 End)
+    {
+        for (int32 i = Begin; i < End; ++i)
+        {
+            SortedSlots[i] = PrimArraySlots[Order[i]];
+            SortedBounds[i] = PrimBounds[Order[i]];
+        }
+    });
+    PrimArraySlots = std::move(SortedSlots);
+    PrimArrayBounds = std::move(SortedBounds);
+
+    Nodes.clear();
+    Nodes.reserve(std::max(1, 2 * N - 1));
+    if (N == 1)
+    {
+        FLBVHNode Leaf;
+        Leaf.First = 0;
+        Leaf.Count = 1;
+        Leaf.Bounds = PrimArrayBounds[0];
+        Nodes.push_back(Leaf);
+        return;
     }
 
-    // 재귀 빌드(중앙 분할; 리프 MaxObjects)
-    Nodes.reserve(std::max(1, 2 * N));
+    // 3) 기수 트리: 내부 노드 0..N-2, 자식 참조는 내부 노드면 인덱스, 리프(프리미티브)면 ~인덱스
+    const int32 NumInternal = N - 1;
+    TArray<int32> ChildL, ChildR, RangeFirst, RangeLast, InternalParent, LeafParent;
+    ChildL.resize(NumInternal);
+    ChildR.resize(NumInternal);
+    RangeFirst.resize(NumInternal);
+    RangeLast.resize(NumInternal);
+    InternalParent.resize(NumInternal);
+    LeafParent.resize(N);
+    InternalParent[0] = -1;
+
+    // 공통 접두 비트 길이 (코드가 같으면 인덱스로 이어서 비교해 모든 키를 유일하게 취급)
+    auto Delta = [&](int64 i, int64 j) -> int32
+    {
+        if (j < 0 || j >= N) return -1;
+        const uint64 a = Codes[i];
+        const uint64 b = Codes[j];
+        if (a == b) return 64 + std::countl_zero(static_cast<uint32>(i ^ j));
+        return std::countl_zero(a ^ b);
+    };
 
+    FJobSystem::ParallelFor(NumInternal, LBVHMinBatch, [&](int32 Begin, int32 End)
+    {
+        for (int32 i = Begin; i < End; ++i)
+        {
+            // 범위 방향과 길이 상한
+            const int32 d = (Delta(i, i + 1) - Delta(i, i - 1)) >= 0 ? 1 : -1;
+            const int32 dMin = Delta(i, i - d);
+            int64 lMax = 2;
+            while (Delta(i, i + lMax * d) > dMin) lMax *= 2;
+
+            // 이분 탐색으로 반대쪽 끝 j
+            int64 l = 0;
+            for (int64 t = lMax / 2; t >= 1; t /= 2)
+                if (Delta(i, i + (l + t) * d) > dMin) l += t;
+            const int64 j = i + l * d;
+
+            // 분할 위치 gamma
+            const int32 dNode = Delta(i, j);
+            int64 sSplit = 0;
+            for (int64 t = (l + 1) / 2; ; t = (t + 1) / 2)
+            {
+                if (Delta(i, i + (sSplit + t) * d) > dNode) sSplit += t;
+                if (t <= 1) break;
+            }
+            const int32 gamma = static_cast<int32>(i + sSplit * d + std::min(d, 0));
+
+            const int32 first = static_cast<int32>(std::min<int64>(i, j));
+            const int32 last = static_cast<int32>(std::max<int64>(i, j));
+            RangeFirst[i] = first;
+            RangeLast[i] = last;
+
+            // 각 자식의 부모는 정확히 하나이므로 서로 다른 원소에만 쓴다
+            if (first == gamma) { ChildL[i] = ~gamma; LeafParent[gamma] = i; }
+            else                { ChildL[i] = gamma;  InternalParent[gamma] = i; }
+            if (last == gamma + 1) { ChildR[i] = ~(gamma + 1); LeafParent[gamma + 1] = i; }
+            else                   { ChildR[i] = gamma + 1;    InternalParent[gamma + 1] = i; }
+        }
+    });
+
+    // 4) 바운드 상향 전파: 두 번째로 도착한 스레드만 부모를 계산
+    TArray<FBound> InternalBounds;
+    InternalBounds.resize(NumInternal);
+    std::unique_ptr<std::atomic<uint32>[]> VisitCount(new std::atomic<uint32>[NumInternal]());
+    auto RefBounds = [&](int32 Ref) -> const FBound& { return Ref < 0 ? PrimArrayBounds[~Ref] : InternalBounds[Ref]; };
+
+    FJobSystem::ParallelFor(N, LBVHMinBatch, [&](int32 Begin, int32 End)
+    {
+        for (int32 Leaf = Begin; Leaf < End; ++Leaf)
+        {
+            int32 Node = LeafParent[Leaf];
+            while (Node >= 0)
+            {
+                if (VisitCount[Node].fetch_add(1, std::memory_order_acq_rel) == 0) break;
+                InternalBounds[Node] = UnionBounds(RefBounds(ChildL[Node]), RefBounds(ChildR[Node]));
+                Node = InternalParent[Node];
+            }
+        }
+    });
+
+    // 5) 전위 순서로 최종 노드 배열 작성 (루트가 0번, 부모 인덱스 < 자식 인덱스)
+    struct FEmitItem
+    {
+        int32 Ref;
+        int32 Parent;
+        bool bRight;
+    };
+    TArray<FEmitItem> Stack;
+    Stack.push_back({ 0, -1, false });
+    while (!Stack.empty())
+    {
+        const FEmitItem Item = Stack.back();
+        Stack.pop_back();
+
+        const int32 NodeIdx = static_cast<int32>(Nodes.size());
+        Nodes.push_back(FLBVHNode{});
+        FLBVHNode& Node = Nodes[NodeIdx];
+        Node.Parent = Item.Parent;
+        Node.Bounds = RefBounds(Item.Ref);
+        if (Item.Parent >= 0)
+        {
+            if (Item.bRight) Nodes[Item.Parent].Right = NodeIdx;
+            else             Nodes[Item.Parent].Left = NodeIdx;
+        }
+
+        const int32 First = Item.Ref < 0 ? ~Item.Ref : RangeFirst[Item.Ref];
+        const int32 Last = Item.Ref < 0 ? ~Item.Ref : RangeLast[Item.Ref];
+        if (Last - First + 1 <= MaxObjects)
+        {
+            Node.First = First;
+            Node.Count = Last - First + 1;
+            continue;
+        }
+
+        Stack.push_back({ ChildR[Item.Ref], NodeIdx, true });
+        Stack.push_back({ ChildL[Item.Ref], NodeIdx, false });
+    }
+}
+
+void FBVHierachy::BuildBinnedSAH()
+{
+    const int N = static_cast<int>(PrimArraySlots.size());
+
+    TArray<FBuildPrim> BuildPrims;
+    BuildPrims.resize(N);
+    for (int i = 0; i < N; ++i)
+    {
+        BuildPrims[i].Slot = PrimArraySlots[i];
+        BuildPrims[i].Box = PrimArrayBounds[i];
+        BuildPrims[i].Center = BuildPrims[i].Box.GetCenter();
+    }
+
+    Nodes.reserve(std::max(1, 2 * N));
     Nodes.clear();
-    BuildRange(0, N);
+    BuildSAHRange(BuildPrims, 0, N, -1, 0);
+
+    // 분할 과정에서 섞인 순서를 리프 레인지와 맞춘다
+    for (int i = 0; i < N; ++i)
+    {
+        PrimArraySlots[i] = BuildPrims[i].Slot;
+        PrimArrayBounds[i] = BuildPrims[i].Box;
+    }
 }
 
-int FBVHierachy::BuildRange(int s, int e)
+int FBVHierachy::BuildSAHRange(TArray<FBuildPrim>& Prims, int s, int e, int parent, int depth)
 {
     int nodeIdx = static_cast<int>(Nodes.size());
     Nodes.push_back(FLBVHNode{});
-    FLBVHNode& node = Nodes[nodeIdx];
+    Nodes[nodeIdx].Parent = parent;
+
+    FBound NodeBounds = Prims[s].Box;
+    FBound CentroidBounds(Prims[s].Center, Prims[s].Center);
+    for (int i = s + 1; i < e; ++i)
+    {
+        NodeBounds = UnionBounds(NodeBounds, Prims[i].Box);
+        CentroidBounds = UnionBounds(CentroidBounds, FBound(Prims[i].Center, Prims[i].Center));
+    }
+    Nodes[nodeIdx].Bounds = NodeBounds;
 
-    int count = e - s;
+    const int count = e - s;
+    auto MakeLeaf = [&]()
+    {
+        Nodes[nodeIdx].First = s;
+        Nodes[nodeIdx].Count = count;
+        return nodeIdx;
+    };
     if (count <= MaxObjects)
+        return MakeLeaf();
+
+    // 축마다 중심점을 SAHBinCount개 구간으로 나누고, 구간 경계 중 SAH 비용이 최소인 분할을 찾는다
+    struct FBin
     {
-        node.First = s;
-        node.Count = count;
-        bool inited = false;
-        FBound acc;
+        FBound Box;
+        int Count = 0;
+    };
+    const FVector CentroidExtent = CentroidBounds.Max - CentroidBounds.Min;
+    float BestCost = FLT_MAX;
+    int BestAxis = -1;
+    int BestSplit = -1;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (CentroidExtent[axis] <= 1e-6f) continue;
+
+        FBin Bins[SAHBinCount];
+        const float Scale = SAHBinCount / CentroidExtent[axis];
         for (int i = s; i < e; ++i)
         {
-            const FBound* b = PrimLastBounds.Find(PrimArray[i]);
-            if (!b) continue;
-            if (!inited) { acc = *b; inited = true; }
-            else acc = UnionBounds(acc, *b);
+            const int b = std::min(SAHBinCount - 1, (int)((Prims[i].Center[axis] - CentroidBounds.Min[axis]) * Scale));
+            Bins[b].Box = Bins[b].Count ? UnionBounds(Bins[b].Box, Prims[i].Box) : Prims[i].Box;
+            ++Bins[b].Count;
         }
-        node.Bounds = inited ? acc : Bounds;
-        return nodeIdx;
+
+        // 왼쪽 누적 (경계 b: [0, b) 가 왼쪽)
+        float LeftCost[SAHBinCount];
+        FBound Acc;
+        int AccCount = 0;
+        for (int b = 1; b < SAHBinCount; ++b)
+        {
+            const FBin& Bin = Bins[b - 1];
+            if (Bin.Count)
+            {
+                Acc = AccCount ? UnionBounds(Acc, Bin.Box) : Bin.Box;
+                AccCount += Bin.Count;
+            }
+            LeftCost[b] = AccCount ? SurfaceArea(Acc) * AccCount : -1.0f;
+        }
+
+        // 오른쪽 누적하면서 비용 평가
+        AccCount = 0;
+        for (int b = SAHBinCount - 1; b >= 1; --b)
+        {
+            const FBin& Bin = Bins[b];
+            if (Bin.Count)
+            {
+                Acc = AccCount ? UnionBounds(Acc, Bin.Box) : Bin.Box;
+                AccCount += Bin.Count;
+            }
+            if (AccCount == 0 || LeftCost[b] < 0.0f) continue;
+            const float Cost = LeftCost[b] + SurfaceArea(Acc) * AccCount;
+            if (Cost < BestCost)
+            {
+                BestCost = Cost;
+                BestAxis = axis;
+                BestSplit = b;
+            }
+        }
+    }
+
+    int mid = -1;
+    if (BestAxis >= 0 && depth < SAHMaxDepth)
+    {
+        // 순회 비용(노드 면적) + 자식 교차 비용 vs 리프로 두는 비용
+        const float NodeArea = SurfaceArea(NodeBounds);
+        const float SplitCost = NodeArea + BestCost;
+        const float LeafCost = NodeArea * count;
+        if (SplitCost >= LeafCost && count <= MaxObjects * 4)
+            return MakeLeaf();
+
+        const float Scale = SAHBinCount / CentroidExtent[BestAxis];
+        const float AxisMin = CentroidBounds.Min[BestAxis];
+        auto it = std::partition(Prims.begin() + s, Prims.begin() + e, [&](const FBuildPrim& P)
+        {
+            const int b = std::min(SAHBinCount - 1, (int)((P.Center[BestAxis] - AxisMin) * Scale));
+            return b < BestSplit;
+        });
+        mid = static_cast<int>(it - Prims.begin());
+    }
+
+    // 중심점이 모두 겹치거나 분할이 한쪽으로 쏠리면 가장 긴 축 중앙값 분할
+    if (mid <= s || mid >= e)
+    {
+        const FVector NodeExtent = NodeBounds.Max - NodeBounds.Min;
+        int axis = 0;
+        if (NodeExtent.Y > NodeExtent[axis]) axis = 1;
+        if (NodeExtent.Z > NodeExtent[axis]) axis = 2;
+        mid = (s + e) / 2;
+        std::nth_element(Prims.begin() + s, Prims.begin() + mid, Prims.begin() + e,
+            [axis](const FBuildPrim& A, const FBuildPrim& B) { return A.Center[axis] < B.Center[axis]; });
     }
 
-    int mid = (s + e) / 2;
-    int L = BuildRange(s, mid);
-    int R = BuildRange(mid, e);
-    node.Left = L; node.Right = R; node.First = -1; node.Count = 0;
-    node.Bounds = UnionBounds(Nodes[L].Bounds, Nodes[R].Bounds);
+    const int L = BuildSAHRange(Prims, s, mid, nodeIdx, depth + 1);
+    const int R = BuildSAHRange(Prims, mid, e, nodeIdx, depth + 1);
+    Nodes[nodeIdx].Left = L;
+    Nodes[nodeIdx].Right = R;
     return nodeIdx;
 }
 
+FBVHQualityReport FBVHierachy::ComputeQualityReport() const
+{
+    FBVHQualityReport Report;
+    if (Nodes.empty()) return Report;
+
+    const float RootArea = SurfaceArea(Nodes[0].Bounds);
+    const float InvRootArea = RootArea > 0.0f ? 1.0f / RootArea : 0.0f;
+
+    int64 DepthSum = 0;
+    TArray<std::pair<int32, int32>> Stack; // (node, depth)
+    Stack.push_back({ 0, 0 });
+    while (!Stack.empty())
+    {
+        const auto [Idx, D] = Stack.back();
+        Stack.pop_back();
+        const FLBVHNode& Node = Nodes[Idx];
+        const float Area = SurfaceArea(Node.Bounds) * InvRootArea;
+        Report.MaxDepth = std::max(Report.MaxDepth, D);
+        if (Node.IsLeaf())
+        {
+            Report.SAHCost += Area * Node.Count;
+            ++Report.LeafCount;
+            DepthSum += D;
+            continue;
+        }
+
+        Report.SAHCost += Area;
+        // 형제 노드 겹침: 두 자식 AABB 교집합의 면적
+        const FBound& A = Nodes[Node.Left].Bounds;
+        const FBound& B = Nodes[Node.Right].Bounds;
+        if (A.Intersects(B))
+        {
+            const FBound Overlap(
+                FVector(std::max(A.Min.X, B.Min.X), std::max(A.Min.Y, B.Min.Y), std::max(A.Min.Z, B.Min.Z)),
+                FVector(std::min(A.Max.X, B.Max.X), std::min(A.Max.Y, B.Max.Y), std::min(A.Max.Z, B.Max.Z)));
+            Report.Overlap += SurfaceArea(Overlap) * InvRootArea;
+        }
+        Stack.push_back({ Node.Left, D + 1 });
+        Stack.push_back({ Node.Right, D + 1 });
+    }
+    Report.AvgLeafDepth = Report.LeafCount ? float(DepthSum) / Report.LeafCount : 0.0f;
+    return Report;
+}
+
+FBound FBVHierachy::ComputeLeafBounds(const FLBVHNode& Node) const
+{
+    bool inited = false;
+    FBound acc;
+    for (int i = Node.First; i < Node.First + Node.Count; ++i)
+    {
+        if (!PrimArray[i]) continue;
+        if (!inited) { acc = PrimArrayBounds[i]; inited = true; }
+        else acc = UnionBounds(acc, PrimArrayBounds[i]);
+    }
+    return inited ? acc : Bounds;
+}
+
+float FBVHierachy::SurfaceArea(const FBound& B)
+{
+    const FVector D = B.Max - B.Min;
+    return 2.0f * (D.X * D.Y + D.Y * D.Z + D.Z * D.X);
+}
+
+float FBVHierachy::NodeCostArea(const FLBVHNode& Node)
+{
+    const float Area = SurfaceArea(Node.Bounds);
+    return Node.IsLeaf() ? Area * static_cast<float>(Node.Count) : Area;
+}
+
+float FBVHierachy::CurrentCostRatio() const
+{
+    if (Nodes.empty()) return 0.0f;
+    const float RootArea = SurfaceArea(Nodes[0].Bounds);
+    return RootArea > 0.0f ? TotalCostArea / RootArea : 0.0f;
+}
+
+void FBVHierachy::RefitDirtyLeaves()
+{
+    // 더티 리프부터 루트 방향으로 바운드를 다시 계산하고, 변화가 없으면 그 경로는 중단
+    for (int32 LeafIdx : DirtyLeaves)
+    {
+        int32 Idx = LeafIdx;
+        while (Idx >= 0)
+        {
+            FLBVHNode& Node = Nodes[Idx];
+            const FBound NewBounds = Node.IsLeaf()
+                ? ComputeLeafBounds(Node)
+                : UnionBounds(Nodes[Node.Left].Bounds, Nodes[Node.Right].Bounds);
+            if (BoundsEqual(Node.Bounds, NewBounds))
+                break;
+
+            TotalCostArea -= NodeCostArea(Node);
+            Node.Bounds = NewBounds;
+            TotalCostArea += NodeCostArea(Node);
+            WriteWideLane(Idx);
+            Idx = Node.Parent;
+        }
+    }
+    DirtyLeaves.clear();
+    Bounds = Nodes[0].Bounds;
+    ++RefitCount;
+}
+
 void FBVHierachy::QueryRayClosest(const FRay& Ray, AActor*& OutActor, OUT float& OutBestT) const
 {
     OutActor = nullptr;
@@ -421,6 +1401,7 @@ void FBVHierachy::QueryRayClosest(const FRay& Ray, AActor*& OutActor, OUT float&
 
     std::priority_queue<HeapItem> heap;
     heap.push({ 0, tminRoot });
+    LastRayNodeVisits = 0;
 
     const float Epsilon = 1e-3f;
     bool isPick = false;
@@ -428,6 +1409,7 @@ void FBVHierachy::QueryRayClosest(const FRay& Ray, AActor*& OutActor, OUT float&
     {
         HeapItem entry = heap.top();
         heap.pop();
+        ++LastRayNodeVisits;
 
         if (OutActor && entry.TMin > OutBestT + Epsilon)
             break;
@@ -437,14 +1419,13 @@ void FBVHierachy::QueryRayClosest(const FRay& Ray, AActor*& OutActor, OUT float&
         {
             for (int i = 0; i < node.Count; ++i)
             {
-                UPrimitiveComponent* Prim = PrimArray[node.First + i];
-                if (!Prim) continue;
-                AActor* A = Prim->GetOwner();
+                const int32 Idx = node.First + i;
+                if (!PrimArray[Idx]) continue;
+                AActor* A = SlotOwners[PrimArraySlots[Idx]];
                 if (!A) continue;
                 if (A->GetActorHiddenInGame()) continue;
 
-                const FBound* Cached = PrimLastBounds.Find(Prim);
-                const FBound Box = Cached ? *Cached : Prim->GetWorldAABB();
+                const FBound& Box = PrimArrayBounds[Idx];
 
                 float tmin, tmax;
                 if (!RayAABB_IntersectT(Ray, Box, tmin, tmax))
@@ -490,11 +1471,130 @@ void FBVHierachy::QueryRayClosest(const FRay& Ray, AActor*& OutActor, OUT float&
     }
 }
 
+void FBVHierachy::QueryRaysClosest(const TArray<FRay>& Rays, OUT TArray<FRayHit>& OutHits) const
+{
+    const int32 NumRays = static_cast<int32>(Rays.size());
+    OutHits.assign(NumRays, FRayHit());
+    LastRayNodeVisits = 0;
+    if (Nodes.empty() || NumRays == 0) return;
+
+    // 패킷 경로는 AVX 전용. 그 미만이면 레이마다 단일 쿼리 (방문 수는 합산)
+    if (!FSimd::IsAtLeast(ESimdLevel::AVX2))
+    {
+        uint32 TotalVisits = 0;
+        for (int32 i = 0; i < NumRays; ++i)
+        {
+            float BestT = std::numeric_limits<float>::infinity();
+            QueryRayClosest(Rays[i], OutHits[i].Actor, BestT);
+            if (OutHits[i].Actor) OutHits[i].Distance = BestT;
+            TotalVisits += LastRayNodeVisits;
+        }
+        LastRayNodeVisits = TotalVisits;
+        return;
+    }
+
+    const float Epsilon = 1e-3f;
+    TArray<int32>& Stack = RayTraversalStack;
+
+    for (int32 Base = 0; Base < NumRays; Base += 8)
+    {
+        const int32 Count = std::min(8, NumRays - Base);
+        const int LaneMask = (1 << Count) - 1;
+
+        // 패킷 구성 (남는 레인은 첫 레이를 복제하고 마스크로 제외)
+        alignas(32) float OX[8], OY[8], OZ[8], IX[8], IY[8], IZ[8];
+        alignas(32) float BestT[8];
+        for (int32 Lane = 0; Lane < 8; ++Lane)
+        {
+            const FRay& R = Rays[Base + (Lane < Count ? Lane : 0)];
+            OX[Lane] = R.Origin.X;
+            OY[Lane] = R.Origin.Y;
+            OZ[Lane] = R.Origin.Z;
+            IX[Lane] = SafeInverse(R.Direction.X);
+            IY[Lane] = SafeInverse(R.Direction.Y);
+            IZ[Lane] = SafeInverse(R.Direction.Z);
+            BestT[Lane] = std::numeric_limits<float>::infinity();
+        }
+        FRayPacket8 Packet;
+        Packet.OX = _mm256_load_ps(OX);
+        Packet.OY = _mm256_load_ps(OY);
+        Packet.OZ = _mm256_load_ps(OZ);
+        Packet.IX = _mm256_load_ps(IX);
+        Packet.IY = _mm256_load_ps(IY);
+        Packet.IZ = _mm256_load_ps(IZ);
+        const FVector& LeadDir = Rays[Base].Direction;
+
+        Stack.clear();
+        Stack.push_back(0);
+        while (!Stack.empty())
+        {
+            const int32 Idx = Stack.back();
+            Stack.pop_back();
+            ++LastRayNodeVisits;
+
+            // 이미 찾은 히트보다 먼 노드는 레인별로 제외 (모든 레인이 빠지면 서브트리 전체 스킵)
+            const __m256 MaxT = _mm256_add_ps(_mm256_load_ps(BestT), _mm256_set1_ps(Epsilon));
+            const int Mask = RayPacketAABB8(Packet, Nodes[Idx].Bounds, MaxT) & LaneMask;
+            if (!Mask) continue;
+
+            const FLBVHNode& Node = Nodes[Idx];
+            if (Node.IsLeaf())
+            {
+                for (int32 i = Node.First; i < Node.First + Node.Count; ++i)
+                {
+                    if (!PrimArray[i]) continue;
+                    AActor* A = SlotOwners[PrimArraySlots[i]];
+                    if (!A || A->GetActorHiddenInGame()) continue;
+
+                    int PrimMask = RayPacketAABB8(Packet, PrimArrayBounds[i],
+                        _mm256_add_ps(_mm256_load_ps(BestT), _mm256_set1_ps(Epsilon))) & Mask;
+                    while (PrimMask)
+                    {
+                        const int Lane = std::countr_zero(static_cast<uint32>(PrimMask));
+                        PrimMask &= PrimMask - 1;
+
+                        float HitDistance;
+                        if (CPickingSystem::CheckActorPicking(A, Rays[Base + Lane], HitDistance) && HitDistance < BestT[Lane])
+                        {
+                            BestT[Lane] = HitDistance;
+                            OutHits[Base + Lane].Actor = A;
+                            OutHits[Base + Lane].Distance = HitDistance;
+                        }
+                    }
+                }
+                continue;
+            }
+
+            // 패킷 대표 레이 방향 기준으로 가까운 자식을 나중에 넣어 먼저 방문
+            const FVector CL = Nodes[Node.Left].Bounds.GetCenter();
+            const FVector CR = Nodes[Node.Right].Bounds.GetCenter();
+            const FVector Sep = CR - CL;
+            int Axis = 0;
+            if (std::abs(Sep.Y) > std::abs(Sep[Axis])) Axis = 1;
+            if (std::abs(Sep.Z) > std::abs(Sep[Axis])) Axis = 2;
+            const bool bLeftFirst = (LeadDir[Axis] >= 0.0f) == (Sep[Axis] >= 0.0f);
+            Stack.push_back(bLeftFirst ? Node.Right : Node.Left);
+            Stack.push_back(bLeftFirst ? Node.Left : Node.Right);
+        }
+    }
+}
+
 void FBVHierachy::FlushRebuild()
 {
     if (bPendingRebuild)
     {
-        BuildLBVHFromMap();
+        BuildTreeFromSlots();
         bPendingRebuild = false;
+        return;
+    }
+    if (DirtyLeaves.empty() || Nodes.empty())
+        return;
+
+    RefitDirtyLeaves();
+
+    // 리핏으로 노드가 과하게 부풀었으면(SAH 비용 증가) 전체 재빌드
+    if (BuildCostRatio > 0.0f && CurrentCostRatio() > BuildCostRatio * RefitRebuildThreshold)
+    {
+        BuildTreeFromSlots();
     }
 }
@@ -7,6 +7,31 @@ struct FRay; // forward declaration for ray type
 class UPrimitiveComponent;
 class AActor;
 
+enum class EBVHBuildMode : uint8
+{
+    LBVH,       // 모튼 코드 정렬 + 중앙 분할 (빌드 빠름)
+    BinnedSAH,  // 비닝 SAH 분할 (빌드 느림, 뭉친 배치에서 쿼리 노드 수 감소)
+};
+
+// 트리 품질 리포트 (면적은 루트 면적으로 정규화)
+struct FBVHQualityReport
+{
+    float SAHCost = 0.0f;       // 순회 비용 1, 교차 비용 1 기준
+    float Overlap = 0.0f;       // 형제 노드 겹침 면적 합
+    int32 MaxDepth = 0;
+    float AvgLeafDepth = 0.0f;
+    int32 LeafCount = 0;
+};
+
+// 레이 배치 쿼리 결과 (레이별 가장 가까운 액터와 거리, 못 맞췄으면 Actor == nullptr)
+struct FRayHit
+{
+    AActor* Actor = nullptr;
+    float Distance = std::numeric_limits<float>::infinity();
+};
+
+struct FScreenSizeCullParams;
+
 class FBVHierachy
 {
 public:
@@ -25,14 +50,35 @@ public:
 
     bool Contains(const FBound& Box) const;
 
+    // 등록된 프리미티브의 고정 핸들 (슬롯 인덱스). 등록 해제 전까지 바뀌지 않으며, 미등록이면 InvalidHandle
+    static constexpr int32 InvalidHandle = -1;
+    int32 FindPrimitiveHandle(UPrimitiveComponent* InPrimitive) const;
+
     // Partition Manager Interface (액터 단위 래퍼)
     void Remove(AActor* InActor);
     void Update(AActor* InActor);
 
     void FlushRebuild();
+    // 위치만 바뀐 프리미티브는 리핏(상향 바운드 전파), 트리 품질이 임계치를 넘으면 전체 재빌드
+    void SetRefitRebuildThreshold(float InThreshold) { RefitRebuildThreshold = InThreshold; }
+
+    // 빌드 방식 선택 (변경 시 즉시 재빌드)
+    void SetBuildMode(EBVHBuildMode InMode);
+    EBVHBuildMode GetBuildMode() const { return BuildMode; }
 
     void QueryRayClosest(const FRay& Ray, AActor*& OutActor, OUT float& OutBestT) const;
-    void QueryFrustum(const Frustum& InFrustum);
+    // N개 레이를 8개씩 묶어 AVX 슬랩 테스트로 함께 순회 (AVX2 미만 CPU 에선 레이마다 QueryRayClosest). OutHits 는 Rays 와 같은 크기로 채워짐
+    // 같은 패킷의 레이는 방향이 비슷할수록(화면 인접 픽셀, 같은 방향 산포 등) 효율이 좋다
+    void QueryRaysClosest(const TArray<FRay>& Rays, OUT TArray<FRayHit>& OutHits) const;
+    // 보이는 프리미티브를 OutVisible 뒤에 추가한다 (컴포넌트 상태는 건드리지 않음)
+    // ScreenSize 가 주어지면 화면에서 임계 픽셀보다 작은 프리미티브/서브트리도 제외
+    void QueryFrustum(const Frustum& InFrustum, TArray<UPrimitiveComponent*>& OutVisible, const FScreenSizeCullParams* ScreenSize = nullptr);
+    // 여러 뷰의 프러스텀을 한 번의 순회로 테스트 (최대 MaxMultiViews 개)
+    // OutPrimitives 는 하나 이상의 뷰에서 보이는 프리미티브, OutViewMasks[i] 의 비트 v 는 뷰 v 에서 보임
+    static constexpr int32 MaxMultiViews = 8;
+    // ScreenSizes 가 주어지면 InFrustums 와 같은 순서의 뷰별 화면 크기 컬링 파라미터
+    void QueryFrustumMulti(const TArray<Frustum>& InFrustums, OUT TArray<UPrimitiveComponent*>& OutPrimitives, OUT TArray<uint8>& OutViewMasks,
+        const TArray<FScreenSizeCullParams>* ScreenSizes = nullptr);
 
     void DebugDraw(URenderer* Renderer) const;
 
@@ -41,6 +87,11 @@ public:
     int TotalActorCount() const;
     int MaxOccupiedDepth() const;
     void DebugDump() const;
+    FBVHQualityReport ComputeQualityReport() const;
+    uint32 GetLastFrustumNodeVisits() const { return LastFrustumNodeVisits; }
+    uint32 GetLastFrustumPlaneTests() const { return LastFrustumPlaneTests; }
+    uint32 GetLastScreenSizeCulled() const { return LastScreenSizeCulled; }
+    uint32 GetLastRayNodeVisits() const { return LastRayNodeVisits; }
     const FBound& GetBounds() const { return Bounds; }
 
 private:
@@ -50,17 +101,56 @@ private:
     struct FLBVHNode
     {
         FBound Bounds;
+        int32 Parent = -1;
         int32 Left = -1;
         int32 Right = -1;
         int32 First = -1;
         int32 Count = 0;
         bool IsLeaf() const { return Count > 0; }
     };
-    void BuildLBVHFromMap();
+    void BuildTreeFromSlots();
+    void BuildLBVH();
+    void BuildBinnedSAH();
 
-private:
-    int BuildRange(int s, int e);
+    // SAH 빌드용 작업 데이터
+    struct FBuildPrim
+    {
+        int32 Slot = InvalidHandle;
+        FBound Box;
+        FVector Center;
+    };
+    static constexpr int SAHBinCount = 16;
+    static constexpr int SAHMaxDepth = 64;
+    int BuildSAHRange(TArray<FBuildPrim>& Prims, int s, int e, int parent, int depth);
+
+    // === BVH8 (프러스텀 컬링 전용, 바이너리 트리를 8-wide 로 접은 것) ===
+    struct FWideNode
+    {
+        FBound8 ChildBounds;
+        int32 Child[8];         // >=0: 와이드 노드 인덱스, <0: ~(바이너리 리프 노드 인덱스)
+        int32 PrimFirst[8];     // 레인 서브트리가 덮는 PrimArray 구간 (완전 내부 시 통째로 수락)
+        int32 PrimCount[8];
+        uint8 ChildMask = 0;    // 유효한 레인 비트
+        uint8 LastRejectPlane = 0; // 지난 쿼리에서 자식 전체를 탈락시킨 평면 (다음 쿼리에서 먼저 테스트)
+    };
+    void BuildWideNodes();
+    void WriteWideLane(int32 NodeIdx);
+
+    // === 프리미티브 레지스트리 (슬롯 맵) ===
+    // 새 프리미티브면 슬롯을 할당(구조 변경 -> 재빌드), 이미 트리에 있으면 바운드만 갱신(리핏)
+    void UpsertPrimitive(UPrimitiveComponent* InPrimitive, const FBound& InBounds);
+    int32 AllocateSlot(UPrimitiveComponent* InPrimitive, const FBound& InBounds);
+    void FreeSlot(int32 Slot);
+
+    // === Refit ===
+    void RefitDirtyLeaves();
+    FBound ComputeLeafBounds(const FLBVHNode& Node) const;
+    static float SurfaceArea(const FBound& B);
+    // SAH 근사 비용에 쓰이는 노드 기여도 (내부: 면적, 리프: 면적 * 개수)
+    static float NodeCostArea(const FLBVHNode& Node);
+    float CurrentCostRatio() const;
 
+private:
     int Depth;
     int MaxDepth;
     int MaxObjects;
@@ -69,12 +159,66 @@ private:
     // 리프 페이로드(컴포넌트)
     TArray<UPrimitiveComponent*> Primitives;
 
-    // 컴포넌트의 마지막 바운드 캐시
-    TMap<UPrimitiveComponent*, FBound> PrimLastBounds;
+    // 슬롯 배열: 핸들로 인덱싱 (빈 슬롯은 Flags 에 Alive 비트가 없음)
+    enum EPrimSlotFlags : uint8
+    {
+        PrimSlot_Alive = 1 << 0,
+    };
+    TArray<UPrimitiveComponent*> SlotPrims;
+    TArray<FBound> SlotBounds;      // 마지막으로 받은 바운드
+    TArray<AActor*> SlotOwners;
+    TArray<uint8> SlotFlags;
+    TArray<int32> SlotOrder;        // 슬롯 -> PrimArray 위치 (트리에 없으면 -1)
+    TArray<int32> SlotLeaf;         // 슬롯 -> 자신을 담은 리프 노드 (리핏 시 역추적용, 트리에 없으면 -1)
+    TArray<int32> FreeSlots;
+    int32 LiveSlotCount = 0;
+    TMap<UPrimitiveComponent*, int32> PrimToSlot;
+    TMap<AActor*, TArray<int32>> ActorSlots;   // 액터 등록 해제를 액터의 프리미티브 수에 비례하게
+
+    // 리프 순서로 정렬된 프리미티브/바운드/슬롯 (노드의 First/Count 가 가리키는 구간, 순회 시 연속 접근)
     TArray<UPrimitiveComponent*> PrimArray;
+    TArray<FBound> PrimArrayBounds;
+    TArray<int32> PrimArraySlots;
+    // PrimArrayBounds 의 SoA 사본 (큰 리프를 스트림 배치 컬링으로 한 번에 테스트)
+    FBoundSoA PrimArrayBoundsSoA;
+    // 이 개수 이상 든 리프는 프리미티브를 하나씩 대신 스트림 배치 컬링으로 테스트
+    static constexpr int32 LeafStreamCullMin = 4;
+    // 리프 스트림 컬링 결과 (호출마다 재할당하지 않도록 유지)
+    TArray<uint32> LeafVisibleIndices;
 
     // LBVH nodes
     TArray<FLBVHNode> Nodes;
 
+    // BVH8 노드와, 바이너리 노드 -> (와이드 노드 * 8 + 레인) 역참조 (리핏 시 레인 갱신용, 레인이 아니면 -1)
+    TArray<FWideNode> WideNodes;
+    TArray<int32> WideSlotOfNode;
+    // 리프 노드별 지난 쿼리에서 프리미티브를 탈락시킨 평면
+    TArray<uint8> LeafRejectPlane;
+
+    TSet<int32> DirtyLeaves;
+
+    // 트리 품질: 마지막 전체 빌드 시점 대비 SAH 비용 비율이 임계치를 넘으면 재빌드
+    float TotalCostArea = 0.0f;
+    float BuildCostRatio = 0.0f;
+    float RefitRebuildThreshold = 1.5f;
+    uint32 RefitCount = 0;
+
+    EBVHBuildMode BuildMode = EBVHBuildMode::LBVH;
+    FBVHQualityReport BuildReport;
+
+    // 마지막 쿼리에서 방문한 노드 수 (빌드 방식 비교용)
+    uint32 LastFrustumNodeVisits = 0;
+    uint32 LastFrustumPlaneTests = 0;
+    uint32 LastScreenSizeCulled = 0;    // 화면 크기로 제외된 서브트리 + 프리미티브 수
+    mutable uint32 LastRayNodeVisits = 0;
+
+    // 멀티 뷰 쿼리용 프리미티브별 뷰 마스크 (PrimArray 와 같은 순서, 쿼리 밖에서는 항상 0)
+    TArray<uint8> MultiViewPrimMasks;
+    // 이번 멀티 뷰 쿼리에서 마스크를 켠 PrimArray 인덱스 (내보내기/초기화를 방문한 것만 하도록)
+    TArray<int32> MultiViewTouched;
+
+    // 배치 레이 쿼리용 순회 스택 (호출마다 재할당하지 않도록 유지)
+    mutable TArray<int32> RayTraversalStack;
+
     bool bPendingRebuild = false;
 };
@@ -0,0 +1,60 @@
+﻿#include "ConstantRingAllocator.h"
+#include <bit>
+
+void FConstantRingAllocator::Initialize(uint32 InCapacity)
+{
+    Capacity = AlignSize(InCapacity);
+    DesiredCapacity = std::max(DesiredCapacity, Capacity);
+    Cursor = 0;
+    FrameBytes = 0;
+    bFrameMapped = false;
+}
+
+void FConstantRingAllocator::BeginFrame()
+{
+    Cursor = 0;
+    FrameBytes = 0;
+    bFrameMapped = false;
+    LastStats = Stats;
+    Stats = FConstantRingStats();
+}
+
+void FConstantRingAllocator::RequestCapacity(uint32 Bytes)
+{
+    // 2의 거듭제곱으로 키워 재생성 횟수를 줄인다
+    const uint32 Wanted = std::bit_ceil(std::max(Bytes, Alignment));
+    DesiredCapacity = std::max(DesiredCapacity, Wanted);
+}
+
+bool FConstantRingAllocator::Allocate(uint32 Bytes, uint32& OutOffset, bool& bOutDiscard)
+{
+    const uint32 Size = AlignSize(std::max(Bytes, 1u));
+    if (Size > Capacity)
+    {
+        ++Stats.Failures;
+        RequestCapacity(FrameBytes + Size);
+        return false;
+    }
+
+    bOutDiscard = !bFrameMapped;
+    if (Cursor + Size > Capacity)
+    {
+        Cursor = 0;
+        bOutDiscard = true;
+        ++Stats.Wraps;
+    }
+    bFrameMapped = true;
+
+    OutOffset = Cursor;
+    Cursor += Size;
+    FrameBytes += Size;
+    if (FrameBytes > Capacity)
+    {
+        RequestCapacity(FrameBytes);
+    }
+
+    ++Stats.Allocations;
+    Stats.Bytes += Size;
+    if (bOutDiscard) ++Stats.Discards;
+    return true;
+}
@@ -0,0 +1,56 @@
+﻿#pragma once
+#include "UEContainer.h"
+
+// ------------------------------------------------------------
+// 프레임 상수 링 할당기 (GPU 없이 오프셋 계산만)
+//  - 큰 버퍼 하나를 Alignment(256바이트 = 상수 16개, D3D11.1 오프셋 바인딩 단위) 단위로 앞에서부터 잘라 쓴다
+//  - 프레임의 첫 매핑은 WRITE_DISCARD, 이후는 WRITE_NO_OVERWRITE 로 이어 쓴다
+//  - 끝에 닿으면 0 으로 되감고 DISCARD 로 매핑한다 (드라이버가 새 메모리를 주므로 이미 제출한 드로우는 안전)
+//  - 버퍼보다 큰 요청은 실패시키고 다음 프레임에 키울 크기(GetDesiredCapacity)를 남긴다
+// ------------------------------------------------------------
+struct FConstantRingStats
+{
+    uint32 Allocations = 0;
+    uint32 Bytes = 0;           // 정렬 포함 할당 바이트
+    uint32 Discards = 0;        // WRITE_DISCARD 로 매핑해야 했던 할당 (프레임 첫 매핑 + 되감기)
+    uint32 Wraps = 0;
+    uint32 Failures = 0;        // 버퍼보다 커서 실패 (호출자는 개별 업데이트로 폴백)
+};
+
+class FConstantRingAllocator
+{
+public:
+    static constexpr uint32 Alignment = 256;
+
+    static uint32 AlignSize(uint32 Bytes) { return (Bytes + Alignment - 1) & ~(Alignment - 1); }
+
+    // 용량은 Alignment 배수로 올린다. 커서는 처음으로 (통계는 유지, 키울 때도 같은 함수)
+    void Initialize(uint32 InCapacity);
+
+    // 프레임 시작: 커서를 되돌리고 지난 프레임 통계를 넘긴다
+    void BeginFrame();
+
+    // Bytes 연속 공간 예약. bOutDiscard 면 이번 매핑은 WRITE_DISCARD 여야 한다
+    bool Allocate(uint32 Bytes, uint32& OutOffset, bool& bOutDiscard);
+
+    uint32 GetCapacity() const { return Capacity; }
+    uint32 GetUsedBytes() const { return Cursor; }
+    // 지난 프레임들에서 되감기/실패 없이 한 프레임을 담으려면 필요한 용량 (Capacity 보다 크면 키울 때)
+    uint32 GetDesiredCapacity() const { return DesiredCapacity; }
+    bool NeedsGrow() const { return DesiredCapacity > Capacity; }
+
+    const FConstantRingStats& GetStats() const { return Stats; }
+    const FConstantRingStats& GetLastStats() const { return LastStats; }
+
+private:
+    uint32 Capacity = 0;
+    uint32 Cursor = 0;
+    uint32 FrameBytes = 0;          // 이번 프레임 누적 (되감기 포함)
+    uint32 DesiredCapacity = 0;
+    bool bFrameMapped = false;      // 이번 프레임에 이미 DISCARD 매핑을 했는지
+
+    FConstantRingStats Stats;
+    FConstantRingStats LastStats;
+
+    void RequestCapacity(uint32 Bytes);
+};
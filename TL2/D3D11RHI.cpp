@@ -117,6 +117,9 @@ void D3D11RHI::Release()
     if (PixelConstCB) { PixelConstCB->Release(); PixelConstCB = nullptr; }
     if (UVScrollCB) { UVScrollCB->Release(); UVScrollCB = nullptr; }
     if (ConstantBuffer) { ConstantBuffer->Release(); ConstantBuffer = nullptr; }
+    if (ConstantRingBuffer) { ConstantRingBuffer->Release(); ConstantRingBuffer = nullptr; }
+    if (DeviceContext1) { DeviceContext1->Release(); DeviceContext1 = nullptr; }
+    bViewProjCached = false;
 
     // 상태 객체
     if (DepthStencilState) { DepthStencilState->Release(); DepthStencilState = nullptr; }
@@ -288,15 +291,11 @@ void D3D11RHI::UpdateConstantBuffers(const FMatrix& ModelMatrix, const FMatrix&
     UpdateViewProjectionBuffers(ViewMatrix, ProjMatrix);
 }
 
-// 뷰/프로젝션은 프레임당 한 번만 업데이트
+// 뷰/프로젝션은 바뀔 때만 업데이트 (상수 링이 b1 을 가져가면 캐시를 버린다)
 void D3D11RHI::UpdateViewProjectionBuffers(const FMatrix& ViewMatrix, const FMatrix& ProjMatrix)
 {
-    static FMatrix LastViewMatrix;
-    static FMatrix LastProjMatrix;
-    static bool bFirstTime = true;
-    
     // 뷰/프로젝션이 변경되었을 때만 업데이트
-    if (bFirstTime || ViewMatrix != LastViewMatrix || ProjMatrix != LastProjMatrix)
+    if (!bViewProjCached || ViewMatrix != LastViewMatrix || ProjMatrix != LastProjMatrix)
     {
         D3D11_MAPPED_SUBRESOURCE mapped;
         DeviceContext->Map(ViewProjCB, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
@@ -310,7 +309,7 @@ void D3D11RHI::UpdateViewProjectionBuffers(const FMatrix& ViewMatrix, const FMat
         
         LastViewMatrix = ViewMatrix;
         LastProjMatrix = ProjMatrix;
-        bFirstTime = false;
+        bViewProjCached = true;
     }
 }
 
@@ -327,6 +326,56 @@ void D3D11RHI::UpdateModelBuffer(const FMatrix& ModelMatrix)
     DeviceContext->VSSetConstantBuffers(0, 1, &ModelCB); // b0 슬롯
 }
 
+void D3D11RHI::BeginConstantRingFrame()
+{
+    if (!ConstantRingBuffer) return;
+
+    ConstantRing.BeginFrame();
+    // 지난 프레임에 되감기/실패가 있었으면 한 프레임이 다 들어가도록 키운다
+    if (ConstantRing.NeedsGrow() && ConstantRing.GetCapacity() < MAX_CONSTANT_RING_SIZE)
+    {
+        CreateConstantRing(std::min(ConstantRing.GetDesiredCapacity(), MAX_CONSTANT_RING_SIZE));
+    }
+}
+
+uint8* D3D11RHI::MapConstantRing(uint32 Bytes, uint32& OutOffset)
+{
+    if (!ConstantRingBuffer || bConstantRingMapped) return nullptr;
+
+    bool bDiscard = false;
+    if (!ConstantRing.Allocate(Bytes, OutOffset, bDiscard)) return nullptr;
+
+    // 프레임 첫 매핑/되감기는 DISCARD, 나머지는 앞서 쓴 구간을 건드리지 않으므로 NO_OVERWRITE
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (FAILED(DeviceContext->Map(ConstantRingBuffer, 0, bDiscard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0, &mapped)))
+    {
+        return nullptr;
+    }
+    bConstantRingMapped = true;
+    return static_cast<uint8*>(mapped.pData) + OutOffset;
+}
+
+void D3D11RHI::UnmapConstantRing()
+{
+    if (!bConstantRingMapped) return;
+
+    DeviceContext->Unmap(ConstantRingBuffer, 0);
+    bConstantRingMapped = false;
+}
+
+void D3D11RHI::VSSetConstantRing(uint32 Slot, uint32 Offset, uint32 Bytes)
+{
+    // 오프셋/크기는 상수(16바이트) 단위, 16개(256바이트) 배수여야 한다
+    const UINT FirstConstant = Offset / 16;
+    const UINT NumConstants = FConstantRingAllocator::AlignSize(Bytes) / 16;
+    DeviceContext1->VSSetConstantBuffers1(Slot, 1, &ConstantRingBuffer, &FirstConstant, &NumConstants);
+
+    if (Slot == 1)
+    {
+        bViewProjCached = false;
+    }
+}
+
 void D3D11RHI::UpdateBillboardConstantBuffers(const FVector& pos, const FMatrix& ViewMatrix, const FMatrix& ProjMatrix,
     const FVector& CameraRight, const FVector& CameraUp)
 {
@@ -551,6 +600,23 @@ void D3D11RHI::CreateRasterizerState()
     Device->CreateRasterizerState(&nocullRasterizerDesc, &NoCullRasterizerState);
 }
 
+void D3D11RHI::CreateConstantRing(uint32 Capacity)
+{
+    if (ConstantRingBuffer) { ConstantRingBuffer->Release(); ConstantRingBuffer = nullptr; }
+
+    ConstantRing.Initialize(Capacity);
+
+    D3D11_BUFFER_DESC ringDesc = {};
+    ringDesc.Usage = D3D11_USAGE_DYNAMIC;
+    ringDesc.ByteWidth = ConstantRing.GetCapacity();
+    ringDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+    ringDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    if (FAILED(Device->CreateBuffer(&ringDesc, nullptr, &ConstantRingBuffer)))
+    {
+        ConstantRingBuffer = nullptr; // 링 없이 개별 업데이트로 그린다
+    }
+}
+
 void D3D11RHI::CreateConstantBuffer()
 {
     D3D11_BUFFER_DESC modelDesc = {};
@@ -579,6 +645,7 @@ void D3D11RHI::CreateConstantBuffer()
     vpDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
     vpDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
     Device->CreateBuffer(&vpDesc, nullptr, &ViewProjCB);
+    bViewProjCached = false;
 
     // b2 : HighLightBuffer  (← 기존 코드에서 vpDesc를 다시 써서 버그났던 부분)
     D3D11_BUFFER_DESC hlDesc = {};
@@ -621,6 +688,15 @@ void D3D11RHI::CreateConstantBuffer()
         }
         DeviceContext->PSSetConstantBuffers(5, 1, &UVScrollCB);
     }
+
+    // 프레임 상수 링: 오프셋 바인딩과 동적 상수 버퍼 NO_OVERWRITE 가 둘 다 되는 11.1 런타임에서만 만든다
+    D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+    if (SUCCEEDED(Device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options)))
+        && options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer
+        && SUCCEEDED(DeviceContext->QueryInterface(__uuidof(ID3D11DeviceContext1), reinterpret_cast<void**>(&DeviceContext1))))
+    {
+        CreateConstantRing(INITIAL_CONSTANT_RING_SIZE);
+    }
 }
 
 void D3D11RHI::UpdateUVScrollConstantBuffers(const FVector2D& Speed, float TimeSec)
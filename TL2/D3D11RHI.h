@@ -1,6 +1,8 @@
 ﻿#pragma once
 #include "RHIDevice.h"
 #include "ResourceManager.h"
+#include "ConstantRingAllocator.h"
+#include <d3d11_1.h>
 #include "VertexData.h"
 class D3D11RHI : public URHIDevice
 {
@@ -52,6 +54,12 @@ public:
     void UpdateColorConstantBuffers(const FVector4& InColor) override;
     void UpdateUVScrollConstantBuffers(const FVector2D& Speed, float TimeSec) override;
 
+    void BeginConstantRingFrame() override;
+    uint8* MapConstantRing(uint32 Bytes, uint32& OutOffset) override;
+    void UnmapConstantRing() override;
+    void VSSetConstantRing(uint32 Slot, uint32 Offset, uint32 Bytes) override;
+    const FConstantRingAllocator* GetConstantRing() const override { return ConstantRingBuffer ? &ConstantRing : nullptr; }
+
     void IASetPrimitiveTopology() override;
     void RSSetState(EViewModeIndex ViewModeIndex) override;
     void RSSetViewport() override;
@@ -103,6 +111,7 @@ private:
     void CreateConstantBuffer() override;
     void CreateDepthStencilState() override;
 	void CreateSamplerState();
+    void CreateConstantRing(uint32 Capacity);
 
     // release
 	void ReleaseSamplerState();
@@ -153,6 +162,19 @@ private:
 
     ID3D11Buffer* ConstantBuffer{};
 
+    // 프레임 상수 링 (D3D11.1 상수 버퍼 오프셋 바인딩이 될 때만)
+    ID3D11DeviceContext1* DeviceContext1{};
+    ID3D11Buffer* ConstantRingBuffer{};
+    FConstantRingAllocator ConstantRing;
+    bool bConstantRingMapped = false;
+    static constexpr uint32 INITIAL_CONSTANT_RING_SIZE = 1u << 20;  // 1MB = 256바이트 블록 4096개
+    static constexpr uint32 MAX_CONSTANT_RING_SIZE = 64u << 20;
+
+    // b1 뷰/프로젝션 캐시 (같은 값이면 Map 생략)
+    FMatrix LastViewMatrix;
+    FMatrix LastProjMatrix;
+    bool bViewProjCached = false;
+
     ID3D11SamplerState* DefaultSamplerState = nullptr;
 };
 
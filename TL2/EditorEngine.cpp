@@ -1,6 +1,7 @@
 ﻿#include "pch.h"
 #include "EditorEngine.h"
 #include "USlateManager.h"
+#include "SimdDispatch.h"
 #include <ObjManager.h>
 
 float UEditorEngine::ClientWidth = 1024.0f;
@@ -159,6 +160,12 @@ bool UEditorEngine::Startup(HINSTANCE hInstance)
 {
     LoadIniFile();
 
+    // SIMD 커널 상한 강제 (SimdLevel = SSE2 등, 없거나 Auto 면 CPU 감지 결과 사용)
+    if (EditorINI.count("SimdLevel"))
+    {
+        FSimd::SetForcedLevel(FSimd::ParseLevelName(EditorINI["SimdLevel"]));
+    }
+
     if (!CreateMainWindow(hInstance))
         return false;
 
@@ -40,11 +40,12 @@ void FViewportClient::Draw(FViewport* Viewport)
     float ViewportAspectRatio = static_cast<float>(Viewport->GetSizeX()) / static_cast<float>(Viewport->GetSizeY());
     if (Viewport->GetSizeY() == 0) ViewportAspectRatio = 1.0f; // 0으로 나누기 방지
 
+    ApplyViewportCamera();
+
     switch (ViewportType)
     {
     case EViewportType::Perspective:
     {
-        Camera->GetCameraComponent()->SetProjectionMode(ECameraProjectionMode::Perspective);
         PerspectiveCameraPosition = Camera->GetActorLocation();
         PerspectiveCameraRotation = Camera->GetActorRotation();
         PerspectiveCameraFov = Camera->GetCameraComponent()->GetFOV();
@@ -62,8 +63,6 @@ void FViewportClient::Draw(FViewport* Viewport)
     case EViewportType::Orthographic_Bottom:
     case EViewportType::Orthographic_Right:
     {
-        Camera->GetCameraComponent()->SetProjectionMode(ECameraProjectionMode::Orthographic);
-        SetupCameraMode();
         if (World)
         {
             World->GetRenderSettings().SetViewModeIndex(ViewModeIndex);
@@ -74,6 +73,21 @@ void FViewportClient::Draw(FViewport* Viewport)
     }
 }
 
+void FViewportClient::ApplyViewportCamera()
+{
+    if (!Camera) return;
+
+    if (ViewportType == EViewportType::Perspective)
+    {
+        Camera->GetCameraComponent()->SetProjectionMode(ECameraProjectionMode::Perspective);
+    }
+    else
+    {
+        Camera->GetCameraComponent()->SetProjectionMode(ECameraProjectionMode::Orthographic);
+        SetupCameraMode();
+    }
+}
+
 void FViewportClient::SetupCameraMode()
 {
     switch (ViewportType)
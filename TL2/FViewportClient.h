@@ -43,10 +43,16 @@ public:
 
     // 뷰포트별 카메라 설정
     void SetupCameraMode();
+    // 뷰포트 타입에 맞게 투영 모드/카메라 배치 적용 (Draw 전에 여러 번 불러도 같은 결과)
+    void ApplyViewportCamera();
     void SetViewModeIndex(EViewModeIndex InViewModeIndex) { ViewModeIndex = InViewModeIndex; }
 
     EViewModeIndex GetViewModeIndex() { return ViewModeIndex;}
 
+    // 화면 크기 컬링 임계값 배율 (0 이면 이 뷰포트에서는 끔)
+    void SetScreenSizeCullScale(float InScale) { ScreenSizeCullScale = InScale < 0.0f ? 0.0f : InScale; }
+    float GetScreenSizeCullScale() const { return ScreenSizeCullScale; }
+
 
 protected:
     EViewportType ViewportType = EViewportType::Perspective;
@@ -65,6 +71,7 @@ protected:
     float OrthographicZoom = 30.0f;
     //뷰모드
     EViewModeIndex ViewModeIndex = EViewModeIndex::VMI_Lit;
+    float ScreenSizeCullScale = 1.0f;
 
     //원근 투영
     bool PerspectiveCameraInput = false;
@@ -3,68 +3,10 @@
 #include "Frustum.h"
 #include "AABoundingBoxComponent.h"
 #include "CameraComponent.h"
-#include <immintrin.h> // For SSE, AVX, FMA instructions
 
 
 
 
-inline float     Dot3(const FVector4& A, const FVector4& B)
-{
-    // Use SSE4.1's dot product instruction. It's faster than manual shuffling.
-    // 0x71 = (0111 0001b)
-    //   - Low 4 bits (0111): Multiply and sum the first three components (X, Y, Z).
-    //   - High 4 bits (0001): Store the result in the first component of the destination.
-    __m128 dp = _mm_dp_ps(A.SimdData, B.SimdData, 0x71);
-    float result;
-    _mm_store_ss(&result, dp);
-    return result;
-}
-
-inline FVector4  Cross3(const FVector4& A, const FVector4& B)
-{
-    // Use shuffles and FMA (Fused Multiply-Add) for an efficient cross product.
-    // Formula:
-    // C.x = A.y * B.z - A.z * B.y
-    // C.y = A.z * B.x - A.x * B.z
-    // C.z = A.x * B.y - A.y * B.x
-
-    // Shuffle A and B to align components for multiplication
-    __m128 a_yzx = _mm_shuffle_ps(A.SimdData, A.SimdData, _MM_SHUFFLE(3, 0, 2, 1)); // (Ay, Az, Ax, Aw)
-    __m128 b_zxy = _mm_shuffle_ps(B.SimdData, B.SimdData, _MM_SHUFFLE(3, 1, 0, 2)); // (Bz, Bx, By, Bw)
-    __m128 a_zxy = _mm_shuffle_ps(A.SimdData, A.SimdData, _MM_SHUFFLE(3, 1, 0, 2)); // (Az, Ax, Ay, Aw)
-    __m128 b_yzx = _mm_shuffle_ps(B.SimdData, B.SimdData, _MM_SHUFFLE(3, 0, 2, 1)); // (By, Bz, Bx, Bw)
-
-    // term1 = (Ay*Bz, Az*Bx, Ax*By, ...)
-    __m128 term1 = _mm_mul_ps(a_yzx, b_zxy);
-
-    // result = term1 - (a_zxy * b_yzx) using FMA
-    // _mm_fnmadd_ps(a, b, c) computes c - (a * b)
-    __m128 sub = _mm_fnmadd_ps(a_zxy, b_yzx, term1);
-
-    FVector4 result(sub);
-    result.W = 0.0f;
-    return result;
-}
-inline float     Length3(const FVector4& V)
-{
-    float dot = Dot3(V, V);
-    return std::sqrt(dot);
-}
-inline FVector4  Normalize3(const FVector4& V)
-{
-    float len = Length3(V);
-    if (len > 0.0f)
-    {
-        __m128 v = _mm_load_ps(&V.X);
-        __m128 len_v = _mm_set1_ps(len);
-        __m128 result_v = _mm_div_ps(v, len_v);
-        FVector4 result;
-        _mm_store_ps(&result.X, result_v);
-        result.W = 0.0f;
-        return result;
-    }
-    return FVector4(0, 0, 0, 0);
-}
 // ------------------------------------------------------------
 // 절두체(Frustum)/평면 유틸
 //  - 평면 식:  dot(N, X) - D = 0
@@ -152,74 +94,6 @@ Frustum CreateFrustumFromCamera(const UCameraComponent& Camera, float OverrideAs
     return Result;
 }
 
-// ------------------------------------------------------------
-// AABB vs 프러스텀 판정
-//  - 각 평면에 대해: 중심의 부호 + 박스의 "프로젝션 반경"으로 배제 테스트
-//  - 규약: 안쪽 ≥ 0  ⇒  Distance + Radius >= 0 이면 그 평면을 통과(겹침)
-//  - 하나라도 실패하면(음수) 절두체 밖 → 즉시 탈락
-// ------------------------------------------------------------
-bool Intersects(const Plane& P, const FVector4& Center, const FVector4& Extents) 
-{
-	// 평면과 박스사이의 거리 (양수면 평면의 법선 방향, 음수면 반대 방향)
-    const float Distance = Dot3(P.Normal, Center) - P.Distance;
-    // AABB를 평면 법선 방향으로 투영했을 때의 최대 반경
-    // Radius = abs(Normal.X) * Extents.X + abs(Normal.Y) * Extents.Y + abs(Normal.Z) * Extents.Z
-    __m128 abs_normal = _mm_andnot_ps(_mm_set1_ps(-0.0f), P.Normal.SimdData); // abs for all components
-    __m128 dp = _mm_dp_ps(abs_normal, Extents.SimdData, 0x71);
-    float radius;
-    _mm_store_ss(&radius, dp);
-	//  최대 반경은 항상 양수이므로, Distance + Radius < 0 이면 절두체의 바깥
-    return Distance + radius >= 0.0f;
-}
-
-bool IsAABBVisible(const Frustum& Frustum, const FBound& Bound)
-{
-    // AABB 중심/반길이
-    const FVector Center3 = (Bound.Min + Bound.Max) * 0.5f;
-    const FVector Extents3 = (Bound.Max - Bound.Min) * 0.5f; // 항상 양수
-    const FVector4 Center = MakePoint4(Center3);
-    const FVector4 Extents = MakeDir4(Extents3); // 항상 양수
-    // 6면 모두 통과해야 절두체의 안쪽이므로 "보이는 것"
-    return Intersects(Frustum.LeftFace, Center, Extents) && 
-           Intersects(Frustum.RightFace, Center, Extents)  &&
-           Intersects(Frustum.TopFace, Center, Extents) &&
-           Intersects(Frustum.BottomFace, Center, Extents) &&
-           Intersects(Frustum.NearFace, Center, Extents) &&
-           Intersects(Frustum.FarFace, Center, Extents);
-}
-
-bool IsAABBIntersects(const Frustum& F, const FBound& B)
-{
-    // 부분 교차(Intersect)만 true. 완전 내부/완전 외부는 false.
-    const FVector Center3 = (B.Min + B.Max) * 0.5f;
-    const FVector Extents3 = (B.Max - B.Min) * 0.5f;
-    const FVector4 Center = MakePoint4(Center3);
-    const FVector4 Extents = MakeDir4(Extents3);
-
-    const Plane planes[6] = { F.LeftFace, F.RightFace, F.TopFace, F.BottomFace, F.NearFace, F.FarFace };
-
-    bool fullyInside = true;
-    for (int i = 0; i < 6; ++i)
-    {
-        const Plane& P = planes[i];
-        const float Distance = Dot3(P.Normal, Center) - P.Distance;
-        const float Radius = std::abs(P.Normal.X) * Extents.X + std::abs(P.Normal.Y) * Extents.Y + std::abs(P.Normal.Z) * Extents.Z;
-
-        if (Distance + Radius < 0.0f)
-        {
-            // 완전 외부 → 교차 아님
-            return false;
-        }
-        if (Distance - Radius < 0.0f)
-        {
-            // 이 평면 기준으로는 완전 내부가 아님 → 교차 가능성
-            fullyInside = false;
-        }
-    }
-    // 모든 평면 기준으로 완전 내부면 false, 일부 평면에서만 내부가 아니면 true
-    return !fullyInside;
-}
-
 
 // 추후에 절두체를 VP 행렬에서 바로 추출하는 방법도 필요하다면 아래를 참고.
 // ---------- VP(=View*Proj)에서 평면 추출 ----------
@@ -324,105 +198,62 @@ bool IsAABBVisible(const Frustum& F, const FBound& B)
 
 */
 
-// AVX-optimized culling for 8 AABBs
-uint8_t AreAABBsVisible_8_AVX(const Frustum& Frustum, const FBound Bounds[8])
+float ComputeScreenPixels(const FScreenSizeCullParams& Params, const FBound& Bound)
 {
-    // This function performs frustum culling for 8 AABBs simultaneously using AVX2.
-    // It works by testing all 8 boxes against each of the 6 frustum planes.
-
-    // 1. Transpose AoS to SoA using a combination of SSE and AVX instructions.
-    // This is faster than a scalar loop. The FBound struct (6 floats) is not
-    // naturally aligned for SIMD, so this process is complex but efficient.
-
-    // --- Transpose Part 1: Boxes 0-3 ---
-    __m128 r0 = _mm_loadu_ps(&Bounds[0].Min.X); // {m0x, m0y, m0z, M0x}
-    __m128 r1 = _mm_loadu_ps(&Bounds[1].Min.X); // {m1x, m1y, m1z, M1x}
-    __m128 r2 = _mm_loadu_ps(&Bounds[2].Min.X); // {m2x, m2y, m2z, M2x}
-    __m128 r3 = _mm_loadu_ps(&Bounds[3].Min.X); // {m3x, m3y, m3z, M3x}
-    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
-    __m128 b0_3_min_x = r0;
-    __m128 b0_3_min_y = r1;
-    __m128 b0_3_min_z = r2;
-    __m128 b0_3_max_x = r3;
-
-    __m128 myz01 = _mm_castpd_ps(_mm_unpacklo_pd(_mm_load_sd((double*)&Bounds[0].Max.Y), _mm_load_sd((double*)&Bounds[1].Max.Y)));
-    __m128 myz23 = _mm_castpd_ps(_mm_unpacklo_pd(_mm_load_sd((double*)&Bounds[2].Max.Y), _mm_load_sd((double*)&Bounds[3].Max.Y)));
-    __m128 b0_3_max_y = _mm_shuffle_ps(myz01, myz23, _MM_SHUFFLE(2, 0, 2, 0));
-    __m128 b0_3_max_z = _mm_shuffle_ps(myz01, myz23, _MM_SHUFFLE(3, 1, 3, 1));
-
-    // --- Transpose Part 2: Boxes 4-7 ---
-    r0 = _mm_loadu_ps(&Bounds[4].Min.X);
-    r1 = _mm_loadu_ps(&Bounds[5].Min.X);
-    r2 = _mm_loadu_ps(&Bounds[6].Min.X);
-    r3 = _mm_loadu_ps(&Bounds[7].Min.X);
-    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
-    __m128 b4_7_min_x = r0;
-    __m128 b4_7_min_y = r1;
-    __m128 b4_7_min_z = r2;
-    __m128 b4_7_max_x = r3;
-
-    myz01 = _mm_castpd_ps(_mm_unpacklo_pd(_mm_load_sd((double*)&Bounds[4].Max.Y), _mm_load_sd((double*)&Bounds[5].Max.Y)));
-    myz23 = _mm_castpd_ps(_mm_unpacklo_pd(_mm_load_sd((double*)&Bounds[6].Max.Y), _mm_load_sd((double*)&Bounds[7].Max.Y)));
-    __m128 b4_7_max_y = _mm_shuffle_ps(myz01, myz23, _MM_SHUFFLE(2, 0, 2, 0));
-    __m128 b4_7_max_z = _mm_shuffle_ps(myz01, myz23, _MM_SHUFFLE(3, 1, 3, 1));
-
-    // --- Transpose Part 3: Combine into __m256 ---
-    __m256 min_x = _mm256_set_m128(b4_7_min_x, b0_3_min_x);
-    __m256 min_y = _mm256_set_m128(b4_7_min_y, b0_3_min_y);
-    __m256 min_z = _mm256_set_m128(b4_7_min_z, b0_3_min_z);
-    __m256 max_x = _mm256_set_m128(b4_7_max_x, b0_3_max_x);
-    __m256 max_y = _mm256_set_m128(b4_7_max_y, b0_3_max_y);
-    __m256 max_z = _mm256_set_m128(b4_7_max_z, b0_3_max_z);
-
-    // 2. Calculate centers and extents
-    const __m256 half = _mm256_set1_ps(0.5f);
-    __m256 centers_x = _mm256_mul_ps(_mm256_add_ps(max_x, min_x), half);
-    __m256 centers_y = _mm256_mul_ps(_mm256_add_ps(max_y, min_y), half);
-    __m256 centers_z = _mm256_mul_ps(_mm256_add_ps(max_z, min_z), half);
-    __m256 extents_x = _mm256_mul_ps(_mm256_sub_ps(max_x, min_x), half);
-    __m256 extents_y = _mm256_mul_ps(_mm256_sub_ps(max_y, min_y), half);
-    __m256 extents_z = _mm256_mul_ps(_mm256_sub_ps(max_z, min_z), half);
-
-    // 3. Perform Culling (This part was correct before)
-    const Plane* planes = &Frustum.TopFace;
-    uint32_t all_visible_mask = 0xFF;
-
-    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
-
-    for (int i = 0; i < 6; ++i)
+    const FVector Diagonal = Bound.Max - Bound.Min;
+    const float Diameter = Diagonal.Size();
+    if (Params.bOrthographic)
     {
-        const Plane& p = planes[i];
-        __m256 plane_nx = _mm256_set1_ps(p.Normal.X);
-        __m256 plane_ny = _mm256_set1_ps(p.Normal.Y);
-        __m256 plane_nz = _mm256_set1_ps(p.Normal.Z);
-        __m256 plane_d = _mm256_set1_ps(p.Distance);
-
-        __m256 dist = _mm256_sub_ps(
-            _mm256_add_ps(
-                _mm256_add_ps(_mm256_mul_ps(centers_x, plane_nx), _mm256_mul_ps(centers_y, plane_ny)),
-                _mm256_mul_ps(centers_z, plane_nz)
-            ),
-            plane_d
-        );
-
-        __m256 radius = _mm256_add_ps(
-            _mm256_add_ps(
-                _mm256_mul_ps(extents_x, _mm256_andnot_ps(sign_mask, plane_nx)),
-                _mm256_mul_ps(extents_y, _mm256_andnot_ps(sign_mask, plane_ny))
-            ),
-            _mm256_mul_ps(extents_z, _mm256_andnot_ps(sign_mask, plane_nz))
-        );
-
-        __m256 comparison = _mm256_cmp_ps(_mm256_add_ps(dist, radius), _mm256_setzero_ps(), _CMP_GE_OQ);
-        
-        int plane_mask = _mm256_movemask_ps(comparison);
-        all_visible_mask &= plane_mask;
-
-        if (all_visible_mask == 0)
+        return Diameter * Params.PixelScale;
+    }
+
+    const FVector Center = (Bound.Min + Bound.Max) * 0.5f;
+    const float Distance = (Center - Params.ViewOrigin).Size();
+    if (Distance <= Diameter * 0.5f)
+    {
+        return std::numeric_limits<float>::max(); // 카메라가 바운드 안에 있음
+    }
+    return Diameter * Params.PixelScale / Distance;
+}
+
+bool IsSubtreeBelowScreenSize(const FScreenSizeCullParams& Params, const FBound& NodeBound)
+{
+    if (!Params.IsEnabled() || Params.MinPixels <= 0.0f) return false;
+
+    // 자식 바운드는 노드 안에 있으므로 지름은 노드 지름 이하, 거리는 (노드 중심 거리 - 반지름) 이상
+    const FVector Diagonal = NodeBound.Max - NodeBound.Min;
+    const float Diameter = Diagonal.Size();
+    if (Params.bOrthographic)
+    {
+        return Diameter * Params.PixelScale < Params.MinPixels;
+    }
+
+    const FVector Center = (NodeBound.Min + NodeBound.Max) * 0.5f;
+    const float NearestDistance = (Center - Params.ViewOrigin).Size() - Diameter * 0.5f;
+    if (NearestDistance <= 0.0f) return false;
+    return Diameter * Params.PixelScale < Params.MinPixels * NearestDistance;
+}
+
+bool IsPrimitiveBelowScreenSize(const FScreenSizeCullParams& Params, const UClass* Class, const FBound& Bound)
+{
+    if (!Params.IsEnabled()) return false;
+
+    const float Pixels = ComputeScreenPixels(Params, Bound);
+    if (Pixels >= Params.MaxPixels) return false;
+    if (Pixels < Params.MinPixels) return true;
+
+    // 경계 구간만 클래스 임계값을 찾는다 (가까운 상위 클래스 설정 우선)
+    float Threshold = Params.DefaultMinPixels;
+    if (Params.ClassMinPixels)
+    {
+        for (const UClass* C = Class; C; C = C->Super)
         {
-            return 0;
+            if (const float* Found = Params.ClassMinPixels->Find(C))
+            {
+                Threshold = *Found;
+                break;
+            }
         }
     }
-
-    return static_cast<uint8_t>(all_visible_mask);
-}
\ No newline at end of file
+    return Pixels < Threshold * Params.ThresholdScale;
+}
@@ -1,36 +1,35 @@
 ﻿#pragma once
 #include "CameraComponent.h"
+#include "FrustumCulling.h"
 
 
 class UCameraComponent;
-struct FBound;
 
-struct Plane
-{
-    // unit vector
-    FVector4 Normal = { 0.f, 1.f, 0.f , 0.f };
-
-    // 평면이 원점에서 법선 N 방향으로 얼마만큼 떨어져 있는지
-    float Distance = 0.f;
-};
+Frustum CreateFrustumFromCamera(const UCameraComponent& Camera, float OverrideAspect = -1.0f);
 
-struct Frustum
+// ------------------------------------------------------------
+// 화면 크기(Projected size) 컬링
+//  - 바운드 지름이 화면에서 차지하는 세로 픽셀 = Diameter * PixelScale / Distance (직교는 거리와 무관)
+//  - 클래스별 임계값은 상위 클래스 설정을 물려받고, 없으면 DefaultMinPixels
+//  - 모든 임계값에는 뷰포트 배율(ThresholdScale)을 곱해 쓴다
+// ------------------------------------------------------------
+struct FScreenSizeCullParams
 {
-    Plane TopFace;
-    Plane BottomFace;
-    Plane RightFace;
-    Plane LeftFace;
-    Plane NearFace;
-    Plane FarFace;
+    FVector ViewOrigin{};
+    float PixelScale = 0.0f;            // Proj.M[1][1] * 뷰포트 높이 / 2 (0 이면 비활성)
+    bool bOrthographic = false;
+    float ThresholdScale = 1.0f;        // 뷰포트별 배율
+    float DefaultMinPixels = 0.0f;
+    const TMap<const UClass*, float>* ClassMinPixels = nullptr;
+    float MinPixels = 0.0f;             // 배율 적용된 임계값 중 최소 (서브트리 스킵 기준)
+    float MaxPixels = 0.0f;             // 배율 적용된 임계값 중 최대 (이 이상이면 클래스 확인 생략)
+
+    bool IsEnabled() const { return PixelScale > 0.0f && MaxPixels > 0.0f; }
 };
 
-Frustum CreateFrustumFromCamera(const UCameraComponent& Camera, float OverrideAspect = -1.0f);
-bool IsAABBVisible(const Frustum& Frustum, const FBound& Bound);
-bool IsAABBIntersects(const Frustum& Frustum, const FBound& Bound);
-
-// AVX-optimized culling for 8 AABBs
-// Processes 8 AABBs against the frustum.
-// Returns an 8-bit mask: bit i is set if box i is visible.
-uint8_t AreAABBsVisible_8_AVX(const Frustum& Frustum, const FBound Bounds[8]);
-
-bool Intersects(const Plane& P, const FVector4& Center, const FVector4& Extents);
\ No newline at end of file
+// 바운드가 화면에서 차지하는 세로 픽셀 수
+float ComputeScreenPixels(const FScreenSizeCullParams& Params, const FBound& Bound);
+// 서브트리 안의 어떤 프리미티브도 MinPixels 에 못 미치면 true (노드 바운드 기준, 보수적)
+bool IsSubtreeBelowScreenSize(const FScreenSizeCullParams& Params, const FBound& NodeBound);
+// 프리미티브가 자기 클래스 임계값보다 작게 보이면 true
+bool IsPrimitiveBelowScreenSize(const FScreenSizeCullParams& Params, const UClass* Class, const FBound& Bound);
\ No newline at end of file
@@ -0,0 +1,773 @@
+﻿#include "FrustumCulling.h"
+#include <immintrin.h>
+#include <bit>
+#include <cfloat>
+#include <limits>
+#include <random>
+
+// ------------------------------------------------------------
+// AABB vs 프러스텀 판정
+//  - 각 평면에 대해: 중심의 부호 + 박스의 "프로젝션 반경"으로 배제 테스트
+//  - 규약: 안쪽 ≥ 0  ⇒  Distance + Radius >= 0 이면 그 평면을 통과(겹침)
+//  - 하나라도 실패하면(음수) 절두체 밖 → 즉시 탈락
+// ------------------------------------------------------------
+bool Intersects(const Plane& P, const FVector4& Center, const FVector4& Extents) 
+{
+	// 평면과 박스사이의 거리 (양수면 평면의 법선 방향, 음수면 반대 방향)
+    const float Distance = Dot3(P.Normal, Center) - P.Distance;
+    // AABB를 평면 법선 방향으로 투영했을 때의 최대 반경
+    // Radius = abs(Normal.X) * Extents.X + abs(Normal.Y) * Extents.Y + abs(Normal.Z) * Extents.Z
+    const FVector4 AbsNormal(_mm_andnot_ps(_mm_set1_ps(-0.0f), P.Normal.SimdData)); // abs for all components
+    const float radius = Dot3(AbsNormal, Extents);
+	//  최대 반경은 항상 양수이므로, Distance + Radius < 0 이면 절두체의 바깥
+    return Distance + radius >= 0.0f;
+}
+
+bool IsAABBVisible(const Frustum& Frustum, const FBound& Bound)
+{
+    // AABB 중심/반길이
+    const FVector Center3 = (Bound.Min + Bound.Max) * 0.5f;
+    const FVector Extents3 = (Bound.Max - Bound.Min) * 0.5f; // 항상 양수
+    const FVector4 Center = MakePoint4(Center3);
+    const FVector4 Extents = MakeDir4(Extents3); // 항상 양수
+    // 6면 모두 통과해야 절두체의 안쪽이므로 "보이는 것"
+    return Intersects(Frustum.LeftFace, Center, Extents) && 
+           Intersects(Frustum.RightFace, Center, Extents)  &&
+           Intersects(Frustum.TopFace, Center, Extents) &&
+           Intersects(Frustum.BottomFace, Center, Extents) &&
+           Intersects(Frustum.NearFace, Center, Extents) &&
+           Intersects(Frustum.FarFace, Center, Extents);
+}
+
+bool IsAABBIntersects(const Frustum& F, const FBound& B)
+{
+    // 부분 교차(Intersect)만 true. 완전 내부/완전 외부는 false.
+    const FVector Center3 = (B.Min + B.Max) * 0.5f;
+    const FVector Extents3 = (B.Max - B.Min) * 0.5f;
+    const FVector4 Center = MakePoint4(Center3);
+    const FVector4 Extents = MakeDir4(Extents3);
+
+    const Plane planes[6] = { F.LeftFace, F.RightFace, F.TopFace, F.BottomFace, F.NearFace, F.FarFace };
+
+    bool fullyInside = true;
+    for (int i = 0; i < 6; ++i)
+    {
+        const Plane& P = planes[i];
+        const float Distance = Dot3(P.Normal, Center) - P.Distance;
+        const float Radius = std::abs(P.Normal.X) * Extents.X + std::abs(P.Normal.Y) * Extents.Y + std::abs(P.Normal.Z) * Extents.Z;
+
+        if (Distance + Radius < 0.0f)
+        {
+            // 완전 외부 → 교차 아님
+            return false;
+        }
+        if (Distance - Radius < 0.0f)
+        {
+            // 이 평면 기준으로는 완전 내부가 아님 → 교차 가능성
+            fullyInside = false;
+        }
+    }
+    // 모든 평면 기준으로 완전 내부면 false, 일부 평면에서만 내부가 아니면 true
+    return !fullyInside;
+}
+
+bool IsAABBVisibleMasked(const Frustum& Frustum, const FBound& Bound, uint32& InOutPlaneMask, uint8& InOutRejectPlane, uint32& OutPlaneTests)
+{
+    if (InOutPlaneMask == 0) return true;
+
+    const FVector4 Center = MakePoint4((Bound.Min + Bound.Max) * 0.5f);
+    const FVector4 Extents = MakeDir4((Bound.Max - Bound.Min) * 0.5f);
+    const Plane* Planes = &Frustum.TopFace;
+    const __m128 SignMask = _mm_set1_ps(-0.0f);
+
+    for (int k = 0; k < 6; ++k)
+    {
+        const int p = (InOutRejectPlane + k) % 6;
+        if (!(InOutPlaneMask & (1u << p))) continue;
+
+        const Plane& P = Planes[p];
+        const float Distance = Dot3(P.Normal, Center) - P.Distance;
+        const float Radius = Dot3(FVector4(_mm_andnot_ps(SignMask, P.Normal.SimdData)), Extents);
+        ++OutPlaneTests;
+
+        if (Distance + Radius < 0.0f)
+        {
+            InOutRejectPlane = static_cast<uint8>(p);
+            return false;
+        }
+        if (Distance - Radius >= 0.0f)
+        {
+            InOutPlaneMask &= ~(1u << p);
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------
+// 8박스 평면 마스크 컬링 커널 (Scalar / SSE2 / AVX2+FMA)
+//  - 레인 판정: dist + radius >= 0 이 아니면(NaN 포함, 빈 레인) 밖, dist - radius >= 0 이면 그 평면 기준 완전 안쪽
+//  - 평면 순서와 조기 종료 지점이 같아 변형끼리 PlaneTests 까지 일치한다
+// ------------------------------------------------------------
+namespace
+{
+    FCullResult8 CullAABBs8Masked_Scalar(const Frustum& Frustum, const FBound8& Bounds, uint8_t LaneMask, uint32 PlaneMask, int32 FirstPlane)
+    {
+        FCullResult8 Result;
+        Result.Visible = LaneMask;
+        if (LaneMask == 0) return Result;
+
+        float CX[8], CY[8], CZ[8], EX[8], EY[8], EZ[8];
+        for (int Lane = 0; Lane < 8; ++Lane)
+        {
+            CX[Lane] = (Bounds.MaxX[Lane] + Bounds.MinX[Lane]) * 0.5f;
+            CY[Lane] = (Bounds.MaxY[Lane] + Bounds.MinY[Lane]) * 0.5f;
+            CZ[Lane] = (Bounds.MaxZ[Lane] + Bounds.MinZ[Lane]) * 0.5f;
+            EX[Lane] = (Bounds.MaxX[Lane] - Bounds.MinX[Lane]) * 0.5f;
+            EY[Lane] = (Bounds.MaxY[Lane] - Bounds.MinY[Lane]) * 0.5f;
+            EZ[Lane] = (Bounds.MaxZ[Lane] - Bounds.MinZ[Lane]) * 0.5f;
+        }
+
+        const Plane* Planes = &Frustum.TopFace;
+        for (int k = 0; k < 6; ++k)
+        {
+            const int p = (FirstPlane + k) % 6;
+            if (!(PlaneMask & (1u << p))) continue;
+
+            const Plane& P = Planes[p];
+            const float NX = P.Normal.X, NY = P.Normal.Y, NZ = P.Normal.Z;
+            const float AX = std::abs(NX), AY = std::abs(NY), AZ = std::abs(NZ);
+
+            Result.PlaneTests += static_cast<uint32>(std::popcount(Result.Visible));
+
+            uint8_t NotOutside = 0, Inside = 0;
+            for (int Lane = 0; Lane < 8; ++Lane)
+            {
+                const float Dist = CX[Lane] * NX + CY[Lane] * NY + CZ[Lane] * NZ - P.Distance;
+                const float Radius = EX[Lane] * AX + EY[Lane] * AY + EZ[Lane] * AZ;
+                if (Dist + Radius >= 0.0f) NotOutside |= static_cast<uint8_t>(1u << Lane);
+                if (Dist - Radius >= 0.0f) Inside |= static_cast<uint8_t>(1u << Lane);
+            }
+            Result.Visible &= NotOutside;
+            Result.Inside[p] = Inside & Result.Visible;
+
+            if (Result.Visible == 0)
+            {
+                Result.RejectPlane = p;
+                break;
+            }
+        }
+        return Result;
+    }
+
+    // 4레인 두 번 (SSE2 만 사용)
+    FCullResult8 CullAABBs8Masked_SSE2(const Frustum& Frustum, const FBound8& Bounds, uint8_t LaneMask, uint32 PlaneMask, int32 FirstPlane)
+    {
+        FCullResult8 Result;
+        Result.Visible = LaneMask;
+        if (LaneMask == 0) return Result;
+
+        const __m128 half = _mm_set1_ps(0.5f);
+        __m128 centers_x[2], centers_y[2], centers_z[2], extents_x[2], extents_y[2], extents_z[2];
+        for (int h = 0; h < 2; ++h)
+        {
+            const __m128 min_x = _mm_load_ps(Bounds.MinX + 4 * h), max_x = _mm_load_ps(Bounds.MaxX + 4 * h);
+            const __m128 min_y = _mm_load_ps(Bounds.MinY + 4 * h), max_y = _mm_load_ps(Bounds.MaxY + 4 * h);
+            const __m128 min_z = _mm_load_ps(Bounds.MinZ + 4 * h), max_z = _mm_load_ps(Bounds.MaxZ + 4 * h);
+            centers_x[h] = _mm_mul_ps(_mm_add_ps(max_x, min_x), half);
+            centers_y[h] = _mm_mul_ps(_mm_add_ps(max_y, min_y), half);
+            centers_z[h] = _mm_mul_ps(_mm_add_ps(max_z, min_z), half);
+            extents_x[h] = _mm_mul_ps(_mm_sub_ps(max_x, min_x), half);
+            extents_y[h] = _mm_mul_ps(_mm_sub_ps(max_y, min_y), half);
+            extents_z[h] = _mm_mul_ps(_mm_sub_ps(max_z, min_z), half);
+        }
+        const __m128 sign_mask = _mm_set1_ps(-0.0f);
+        const __m128 zero = _mm_setzero_ps();
+
+        const Plane* planes = &Frustum.TopFace;
+        for (int k = 0; k < 6; ++k)
+        {
+            const int p = (FirstPlane + k) % 6;
+            if (!(PlaneMask & (1u << p))) continue;
+
+            const Plane& P = planes[p];
+            const __m128 plane_nx = _mm_set1_ps(P.Normal.X);
+            const __m128 plane_ny = _mm_set1_ps(P.Normal.Y);
+            const __m128 plane_nz = _mm_set1_ps(P.Normal.Z);
+            const __m128 plane_d = _mm_set1_ps(P.Distance);
+            const __m128 abs_nx = _mm_andnot_ps(sign_mask, plane_nx);
+            const __m128 abs_ny = _mm_andnot_ps(sign_mask, plane_ny);
+            const __m128 abs_nz = _mm_andnot_ps(sign_mask, plane_nz);
+
+            Result.PlaneTests += static_cast<uint32>(std::popcount(Result.Visible));
+
+            int not_outside = 0, inside = 0;
+            for (int h = 0; h < 2; ++h)
+            {
+                const __m128 dist = _mm_sub_ps(
+                    _mm_add_ps(_mm_add_ps(_mm_mul_ps(centers_x[h], plane_nx), _mm_mul_ps(centers_y[h], plane_ny)),
+                        _mm_mul_ps(centers_z[h], plane_nz)),
+                    plane_d);
+                const __m128 radius = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(extents_x[h], abs_nx), _mm_mul_ps(extents_y[h], abs_ny)),
+                    _mm_mul_ps(extents_z[h], abs_nz));
+                not_outside |= _mm_movemask_ps(_mm_cmpge_ps(_mm_add_ps(dist, radius), zero)) << (4 * h);
+                inside |= _mm_movemask_ps(_mm_cmpge_ps(_mm_sub_ps(dist, radius), zero)) << (4 * h);
+            }
+            Result.Visible &= static_cast<uint8_t>(not_outside);
+            Result.Inside[p] = static_cast<uint8_t>(inside) & Result.Visible;
+
+            if (Result.Visible == 0)
+            {
+                Result.RejectPlane = p;
+                break;
+            }
+        }
+        return Result;
+    }
+
+    SIMD_TARGET_AVX2 FCullResult8 CullAABBs8Masked_AVX2(const Frustum& Frustum, const FBound8& Bounds, uint8_t LaneMask, uint32 PlaneMask, int32 FirstPlane)
+    {
+        FCullResult8 Result;
+        Result.Visible = LaneMask;
+        if (LaneMask == 0) return Result;
+
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 min_x = _mm256_load_ps(Bounds.MinX), max_x = _mm256_load_ps(Bounds.MaxX);
+        const __m256 min_y = _mm256_load_ps(Bounds.MinY), max_y = _mm256_load_ps(Bounds.MaxY);
+        const __m256 min_z = _mm256_load_ps(Bounds.MinZ), max_z = _mm256_load_ps(Bounds.MaxZ);
+        const __m256 centers_x = _mm256_mul_ps(_mm256_add_ps(max_x, min_x), half);
+        const __m256 centers_y = _mm256_mul_ps(_mm256_add_ps(max_y, min_y), half);
+        const __m256 centers_z = _mm256_mul_ps(_mm256_add_ps(max_z, min_z), half);
+        const __m256 extents_x = _mm256_mul_ps(_mm256_sub_ps(max_x, min_x), half);
+        const __m256 extents_y = _mm256_mul_ps(_mm256_sub_ps(max_y, min_y), half);
+        const __m256 extents_z = _mm256_mul_ps(_mm256_sub_ps(max_z, min_z), half);
+        const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+        const __m256 zero = _mm256_setzero_ps();
+
+        const Plane* planes = &Frustum.TopFace;
+        for (int k = 0; k < 6; ++k)
+        {
+            const int p = (FirstPlane + k) % 6;
+            if (!(PlaneMask & (1u << p))) continue;
+
+            const Plane& P = planes[p];
+            const __m256 plane_nx = _mm256_set1_ps(P.Normal.X);
+            const __m256 plane_ny = _mm256_set1_ps(P.Normal.Y);
+            const __m256 plane_nz = _mm256_set1_ps(P.Normal.Z);
+
+            const __m256 dist = _mm256_sub_ps(
+                _mm256_fmadd_ps(centers_z, plane_nz, _mm256_fmadd_ps(centers_y, plane_ny, _mm256_mul_ps(centers_x, plane_nx))),
+                _mm256_set1_ps(P.Distance));
+            const __m256 radius = _mm256_fmadd_ps(extents_z, _mm256_andnot_ps(sign_mask, plane_nz),
+                _mm256_fmadd_ps(extents_y, _mm256_andnot_ps(sign_mask, plane_ny),
+                    _mm256_mul_ps(extents_x, _mm256_andnot_ps(sign_mask, plane_nx))));
+
+            Result.PlaneTests += static_cast<uint32>(std::popcount(Result.Visible));
+
+            const int not_outside = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_add_ps(dist, radius), zero, _CMP_GE_OQ));
+            const int inside = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_sub_ps(dist, radius), zero, _CMP_GE_OQ));
+            Result.Visible &= static_cast<uint8_t>(not_outside);
+            Result.Inside[p] = static_cast<uint8_t>(inside) & Result.Visible;
+
+            if (Result.Visible == 0)
+            {
+                Result.RejectPlane = p;
+                break;
+            }
+        }
+        return Result;
+    }
+
+    using FCullAABBs8Fn = FCullResult8(*)(const Frustum&, const FBound8&, uint8_t, uint32, int32);
+    const TSimdKernel<FCullAABBs8Fn> CullAABBs8Kernel{
+        { ESimdLevel::Scalar, &CullAABBs8Masked_Scalar },
+        { ESimdLevel::SSE2, &CullAABBs8Masked_SSE2 },
+        { ESimdLevel::AVX2, &CullAABBs8Masked_AVX2 },
+    };
+
+    // ------------------------------------------------------------
+    // AABB 변환 커널 (행벡터: p' = p * M)
+    // ------------------------------------------------------------
+    FBound TransformAABB_Scalar(const FBound& B, const FMatrix& M)
+    {
+        const FVector C = (B.Min + B.Max) * 0.5f;
+        const FVector E = (B.Max - B.Min) * 0.5f;
+        const FVector WorldCenter(
+            C.X * M.M[0][0] + C.Y * M.M[1][0] + C.Z * M.M[2][0] + M.M[3][0],
+            C.X * M.M[0][1] + C.Y * M.M[1][1] + C.Z * M.M[2][1] + M.M[3][1],
+            C.X * M.M[0][2] + C.Y * M.M[1][2] + C.Z * M.M[2][2] + M.M[3][2]);
+        const FVector WorldExtents(
+            E.X * std::abs(M.M[0][0]) + E.Y * std::abs(M.M[1][0]) + E.Z * std::abs(M.M[2][0]),
+            E.X * std::abs(M.M[0][1]) + E.Y * std::abs(M.M[1][1]) + E.Z * std::abs(M.M[2][1]),
+            E.X * std::abs(M.M[0][2]) + E.Y * std::abs(M.M[1][2]) + E.Z * std::abs(M.M[2][2]));
+        return FBound(WorldCenter - WorldExtents, WorldCenter + WorldExtents);
+    }
+
+    FBound TransformAABB_SSE2(const FBound& B, const FMatrix& M)
+    {
+        const FVector C = (B.Min + B.Max) * 0.5f;
+        const FVector E = (B.Max - B.Min) * 0.5f;
+        const __m128 SignMask = _mm_set1_ps(-0.0f);
+
+        const __m128 Center = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(_mm_set1_ps(C.X), M.Rows[0]),
+            _mm_mul_ps(_mm_set1_ps(C.Y), M.Rows[1])),
+            _mm_mul_ps(_mm_set1_ps(C.Z), M.Rows[2])),
+            M.Rows[3]);
+        const __m128 Extents = _mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(_mm_set1_ps(E.X), _mm_andnot_ps(SignMask, M.Rows[0])),
+            _mm_mul_ps(_mm_set1_ps(E.Y), _mm_andnot_ps(SignMask, M.Rows[1]))),
+            _mm_mul_ps(_mm_set1_ps(E.Z), _mm_andnot_ps(SignMask, M.Rows[2])));
+
+        alignas(16) float Lo[4], Hi[4];
+        _mm_store_ps(Lo, _mm_sub_ps(Center, Extents));
+        _mm_store_ps(Hi, _mm_add_ps(Center, Extents));
+        return FBound(FVector(Lo[0], Lo[1], Lo[2]), FVector(Hi[0], Hi[1], Hi[2]));
+    }
+
+    SIMD_TARGET_AVX2 FBound TransformAABB_AVX2(const FBound& B, const FMatrix& M)
+    {
+        const FVector C = (B.Min + B.Max) * 0.5f;
+        const FVector E = (B.Max - B.Min) * 0.5f;
+        const __m128 SignMask = _mm_set1_ps(-0.0f);
+
+        const __m128 Center = _mm_fmadd_ps(_mm_set1_ps(C.Z), M.Rows[2],
+            _mm_fmadd_ps(_mm_set1_ps(C.Y), M.Rows[1],
+                _mm_fmadd_ps(_mm_set1_ps(C.X), M.Rows[0], M.Rows[3])));
+        const __m128 Extents = _mm_fmadd_ps(_mm_set1_ps(E.Z), _mm_andnot_ps(SignMask, M.Rows[2]),
+            _mm_fmadd_ps(_mm_set1_ps(E.Y), _mm_andnot_ps(SignMask, M.Rows[1]),
+                _mm_mul_ps(_mm_set1_ps(E.X), _mm_andnot_ps(SignMask, M.Rows[0]))));
+
+        alignas(16) float Lo[4], Hi[4];
+        _mm_store_ps(Lo, _mm_sub_ps(Center, Extents));
+        _mm_store_ps(Hi, _mm_add_ps(Center, Extents));
+        return FBound(FVector(Lo[0], Lo[1], Lo[2]), FVector(Hi[0], Hi[1], Hi[2]));
+    }
+
+    using FTransformAABBFn = FBound(*)(const FBound&, const FMatrix&);
+    const TSimdKernel<FTransformAABBFn> TransformAABBKernel{
+        { ESimdLevel::Scalar, &TransformAABB_Scalar },
+        { ESimdLevel::SSE2, &TransformAABB_SSE2 },
+        { ESimdLevel::AVX2, &TransformAABB_AVX2 },
+    };
+
+    // ------------------------------------------------------------
+    // SoA 스트림 배치 컬링 커널 (Scalar / SSE2 / AVX2+FMA / AVX-512)
+    //  - 커널은 SIMD 폭 단위 블록을 돌고, 폭으로 나누어떨어지지 않는 꼬리는 스칼라로 마무리
+    //  - 폭(4/8/16)이 64 의 약수라 블록 마스크가 워드 경계를 넘지 않는다
+    // ------------------------------------------------------------
+    struct FStreamPlanes
+    {
+        float NX[6], NY[6], NZ[6];
+        float AX[6], AY[6], AZ[6];     // |법선|
+        float D[6];
+        int32 Count = 0;
+    };
+
+    FStreamPlanes GatherStreamPlanes(const Frustum& Frustum, uint32 PlaneMask)
+    {
+        FStreamPlanes Out;
+        const Plane* Planes = &Frustum.TopFace;
+        for (int p = 0; p < 6; ++p)
+        {
+            if (!(PlaneMask & (1u << p))) continue;
+            const Plane& P = Planes[p];
+            const int32 k = Out.Count++;
+            Out.NX[k] = P.Normal.X; Out.NY[k] = P.Normal.Y; Out.NZ[k] = P.Normal.Z;
+            Out.AX[k] = std::abs(P.Normal.X); Out.AY[k] = std::abs(P.Normal.Y); Out.AZ[k] = std::abs(P.Normal.Z);
+            Out.D[k] = P.Distance;
+        }
+        return Out;
+    }
+
+    int32 CullStreamTail(const FStreamPlanes& P, const FBoundStream& S, int32 Begin, uint64* OutMask)
+    {
+        int32 Visible = 0;
+        for (int32 i = Begin; i < S.Count; ++i)
+        {
+            const float CX = (S.MaxX[i] + S.MinX[i]) * 0.5f, EX = (S.MaxX[i] - S.MinX[i]) * 0.5f;
+            const float CY = (S.MaxY[i] + S.MinY[i]) * 0.5f, EY = (S.MaxY[i] - S.MinY[i]) * 0.5f;
+            const float CZ = (S.MaxZ[i] + S.MinZ[i]) * 0.5f, EZ = (S.MaxZ[i] - S.MinZ[i]) * 0.5f;
+            bool bVisible = true;
+            for (int32 k = 0; k < P.Count && bVisible; ++k)
+            {
+                const float Dist = CX * P.NX[k] + CY * P.NY[k] + CZ * P.NZ[k] - P.D[k];
+                const float Radius = EX * P.AX[k] + EY * P.AY[k] + EZ * P.AZ[k];
+                bVisible = Dist + Radius >= 0.0f;
+            }
+            if (bVisible)
+            {
+                OutMask[i >> 6] |= 1ull << (i & 63);
+                ++Visible;
+            }
+        }
+        return Visible;
+    }
+
+    int32 CullStream_Scalar(const FStreamPlanes& P, const FBoundStream& S, uint64* OutMask)
+    {
+        return CullStreamTail(P, S, 0, OutMask);
+    }
+
+    int32 CullStream_SSE2(const FStreamPlanes& P, const FBoundStream& S, uint64* OutMask)
+    {
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 zero = _mm_setzero_ps();
+        int32 Visible = 0;
+        int32 i = 0;
+        for (; i + 4 <= S.Count; i += 4)
+        {
+            const __m128 min_x = _mm_loadu_ps(S.MinX + i), max_x = _mm_loadu_ps(S.MaxX + i);
+            const __m128 min_y = _mm_loadu_ps(S.MinY + i), max_y = _mm_loadu_ps(S.MaxY + i);
+            const __m128 min_z = _mm_loadu_ps(S.MinZ + i), max_z = _mm_loadu_ps(S.MaxZ + i);
+            const __m128 centers_x = _mm_mul_ps(_mm_add_ps(max_x, min_x), half);
+            const __m128 centers_y = _mm_mul_ps(_mm_add_ps(max_y, min_y), half);
+            const __m128 centers_z = _mm_mul_ps(_mm_add_ps(max_z, min_z), half);
+            const __m128 extents_x = _mm_mul_ps(_mm_sub_ps(max_x, min_x), half);
+            const __m128 extents_y = _mm_mul_ps(_mm_sub_ps(max_y, min_y), half);
+            const __m128 extents_z = _mm_mul_ps(_mm_sub_ps(max_z, min_z), half);
+
+            __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (int32 k = 0; k < P.Count; ++k)
+            {
+                const __m128 dist = _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(centers_x, _mm_set1_ps(P.NX[k])),
+                    _mm_mul_ps(centers_y, _mm_set1_ps(P.NY[k]))),
+                    _mm_mul_ps(centers_z, _mm_set1_ps(P.NZ[k]))),
+                    _mm_set1_ps(P.D[k]));
+                const __m128 radius = _mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(extents_x, _mm_set1_ps(P.AX[k])),
+                    _mm_mul_ps(extents_y, _mm_set1_ps(P.AY[k]))),
+                    _mm_mul_ps(extents_z, _mm_set1_ps(P.AZ[k])));
+                visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(dist, radius), zero));
+            }
+            const uint32 Bits = static_cast<uint32>(_mm_movemask_ps(visible));
+            OutMask[i >> 6] |= static_cast<uint64>(Bits) << (i & 63);
+            Visible += std::popcount(Bits);
+        }
+        return Visible + CullStreamTail(P, S, i, OutMask);
+    }
+
+    SIMD_TARGET_AVX2 int32 CullStream_AVX2(const FStreamPlanes& P, const FBoundStream& S, uint64* OutMask)
+    {
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 zero = _mm256_setzero_ps();
+        int32 Visible = 0;
+        int32 i = 0;
+        for (; i + 8 <= S.Count; i += 8)
+        {
+            const __m256 min_x = _mm256_loadu_ps(S.MinX + i), max_x = _mm256_loadu_ps(S.MaxX + i);
+            const __m256 min_y = _mm256_loadu_ps(S.MinY + i), max_y = _mm256_loadu_ps(S.MaxY + i);
+            const __m256 min_z = _mm256_loadu_ps(S.MinZ + i), max_z = _mm256_loadu_ps(S.MaxZ + i);
+            const __m256 centers_x = _mm256_mul_ps(_mm256_add_ps(max_x, min_x), half);
+            const __m256 centers_y = _mm256_mul_ps(_mm256_add_ps(max_y, min_y), half);
+            const __m256 centers_z = _mm256_mul_ps(_mm256_add_ps(max_z, min_z), half);
+            const __m256 extents_x = _mm256_mul_ps(_mm256_sub_ps(max_x, min_x), half);
+            const __m256 extents_y = _mm256_mul_ps(_mm256_sub_ps(max_y, min_y), half);
+            const __m256 extents_z = _mm256_mul_ps(_mm256_sub_ps(max_z, min_z), half);
+
+            __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+            for (int32 k = 0; k < P.Count; ++k)
+            {
+                const __m256 dist = _mm256_sub_ps(
+                    _mm256_fmadd_ps(centers_z, _mm256_set1_ps(P.NZ[k]),
+                        _mm256_fmadd_ps(centers_y, _mm256_set1_ps(P.NY[k]), _mm256_mul_ps(centers_x, _mm256_set1_ps(P.NX[k])))),
+                    _mm256_set1_ps(P.D[k]));
+                const __m256 radius = _mm256_fmadd_ps(extents_z, _mm256_set1_ps(P.AZ[k]),
+                    _mm256_fmadd_ps(extents_y, _mm256_set1_ps(P.AY[k]), _mm256_mul_ps(extents_x, _mm256_set1_ps(P.AX[k]))));
+                visible = _mm256_and_ps(visible, _mm256_cmp_ps(_mm256_add_ps(dist, radius), zero, _CMP_GE_OQ));
+            }
+            const uint32 Bits = static_cast<uint32>(_mm256_movemask_ps(visible));
+            OutMask[i >> 6] |= static_cast<uint64>(Bits) << (i & 63);
+            Visible += std::popcount(Bits);
+        }
+        return Visible + CullStreamTail(P, S, i, OutMask);
+    }
+
+    SIMD_TARGET_AVX512 int32 CullStream_AVX512(const FStreamPlanes& P, const FBoundStream& S, uint64* OutMask)
+    {
+        const __m512 half = _mm512_set1_ps(0.5f);
+        const __m512 zero = _mm512_setzero_ps();
+        int32 Visible = 0;
+        int32 i = 0;
+        for (; i + 16 <= S.Count; i += 16)
+        {
+            const __m512 min_x = _mm512_loadu_ps(S.MinX + i), max_x = _mm512_loadu_ps(S.MaxX + i);
+            const __m512 min_y = _mm512_loadu_ps(S.MinY + i), max_y = _mm512_loadu_ps(S.MaxY + i);
+            const __m512 min_z = _mm512_loadu_ps(S.MinZ + i), max_z = _mm512_loadu_ps(S.MaxZ + i);
+            const __m512 centers_x = _mm512_mul_ps(_mm512_add_ps(max_x, min_x), half);
+            const __m512 centers_y = _mm512_mul_ps(_mm512_add_ps(max_y, min_y), half);
+            const __m512 centers_z = _mm512_mul_ps(_mm512_add_ps(max_z, min_z), half);
+            const __m512 extents_x = _mm512_mul_ps(_mm512_sub_ps(max_x, min_x), half);
+            const __m512 extents_y = _mm512_mul_ps(_mm512_sub_ps(max_y, min_y), half);
+            const __m512 extents_z = _mm512_mul_ps(_mm512_sub_ps(max_z, min_z), half);
+
+            // 레인 마스크로 바로 누적 (이미 탈락한 레인은 비교하지 않음)
+            __mmask16 visible = 0xFFFF;
+            for (int32 k = 0; k < P.Count && visible; ++k)
+            {
+                const __m512 dist = _mm512_sub_ps(
+                    _mm512_fmadd_ps(centers_z, _mm512_set1_ps(P.NZ[k]),
+                        _mm512_fmadd_ps(centers_y, _mm512_set1_ps(P.NY[k]), _mm512_mul_ps(centers_x, _mm512_set1_ps(P.NX[k])))),
+                    _mm512_set1_ps(P.D[k]));
+                const __m512 radius = _mm512_fmadd_ps(extents_z, _mm512_set1_ps(P.AZ[k]),
+                    _mm512_fmadd_ps(extents_y, _mm512_set1_ps(P.AY[k]), _mm512_mul_ps(extents_x, _mm512_set1_ps(P.AX[k]))));
+                visible = _mm512_mask_cmp_ps_mask(visible, _mm512_add_ps(dist, radius), zero, _CMP_GE_OQ);
+            }
+            const uint32 Bits = static_cast<uint32>(visible);
+            OutMask[i >> 6] |= static_cast<uint64>(Bits) << (i & 63);
+            Visible += std::popcount(Bits);
+        }
+        return Visible + CullStreamTail(P, S, i, OutMask);
+    }
+
+    using FCullStreamFn = int32(*)(const FStreamPlanes&, const FBoundStream&, uint64*);
+    const TSimdKernel<FCullStreamFn> CullStreamKernel{
+        { ESimdLevel::Scalar, &CullStream_Scalar },
+        { ESimdLevel::SSE2, &CullStream_SSE2 },
+        { ESimdLevel::AVX2, &CullStream_AVX2 },
+        { ESimdLevel::AVX512, &CullStream_AVX512 },
+    };
+
+    int32 CullStreamToMask(FCullStreamFn Kernel, const FStreamPlanes& Planes, const FBoundStream& Stream, uint64* OutMask)
+    {
+        if (Stream.Count <= 0) return 0;
+        const int32 Words = (Stream.Count + 63) / 64;
+        std::fill(OutMask, OutMask + Words, 0ull);
+        if (Planes.Count == 0)
+        {
+            // 테스트할 평면이 없으면 전부 보임
+            std::fill(OutMask, OutMask + Words, ~0ull);
+            if (Stream.Count & 63) OutMask[Words - 1] = (1ull << (Stream.Count & 63)) - 1;
+            return Stream.Count;
+        }
+        return Kernel(Planes, Stream, OutMask);
+    }
+
+    FBoundStream SubStream(const FBoundStream& S, int32 First, int32 Count)
+    {
+        FBoundStream Out;
+        Out.MinX = S.MinX + First; Out.MinY = S.MinY + First; Out.MinZ = S.MinZ + First;
+        Out.MaxX = S.MaxX + First; Out.MaxY = S.MaxY + First; Out.MaxZ = S.MaxZ + First;
+        Out.Count = Count;
+        return Out;
+    }
+}
+
+FCullResult8 CullAABBs8Masked(const Frustum& Frustum, const FBound8& Bounds, uint8_t LaneMask, uint32 PlaneMask, int32 FirstPlane)
+{
+    return CullAABBs8Kernel.Get()(Frustum, Bounds, LaneMask, PlaneMask, FirstPlane);
+}
+
+uint8_t AreAABBsVisible_8(const Frustum& Frustum, const FBound8& Bounds)
+{
+    return CullAABBs8Masked(Frustum, Bounds, 0xFF, FrustumAllPlanes, 0).Visible;
+}
+
+uint8_t AreAABBsVisible_8(const Frustum& Frustum, const FBound Bounds[8])
+{
+    FBound8 SoA;
+    for (int32 Lane = 0; Lane < 8; ++Lane)
+    {
+        SoA.Set(Lane, Bounds[Lane]);
+    }
+    return AreAABBsVisible_8(Frustum, SoA);
+}
+
+FBound TransformAABB(const FBound& LocalBound, const FMatrix& World)
+{
+    return TransformAABBKernel.Get()(LocalBound, World);
+}
+
+int32 CullAABBStreamMask(const Frustum& Frustum, const FBoundStream& Stream, uint64* OutMask, uint32 PlaneMask)
+{
+    return CullStreamToMask(CullStreamKernel.Get(), GatherStreamPlanes(Frustum, PlaneMask), Stream, OutMask);
+}
+
+int32 CullAABBStream(const Frustum& Frustum, const FBoundStream& Stream, uint32* OutIndices, uint32 PlaneMask)
+{
+    // 블록 단위로 마스크를 받아 곧바로 인덱스로 펼친다 (스트림 길이만큼 임시 마스크를 잡지 않는다)
+    constexpr int32 BlockBoxes = 1024;
+    uint64 BlockMask[BlockBoxes / 64];
+    const FCullStreamFn Kernel = CullStreamKernel.Get();
+    const FStreamPlanes Planes = GatherStreamPlanes(Frustum, PlaneMask);
+
+    int32 NumVisible = 0;
+    for (int32 Base = 0; Base < Stream.Count; Base += BlockBoxes)
+    {
+        const int32 Count = std::min(BlockBoxes, Stream.Count - Base);
+        if (CullStreamToMask(Kernel, Planes, SubStream(Stream, Base, Count), BlockMask) == 0) continue;
+
+        for (int32 w = 0; w < (Count + 63) / 64; ++w)
+        {
+            uint64 Bits = BlockMask[w];
+            while (Bits)
+            {
+                OutIndices[NumVisible++] = static_cast<uint32>(Base + w * 64 + std::countr_zero(Bits));
+                Bits &= Bits - 1;
+            }
+        }
+    }
+    return NumVisible;
+}
+
+bool ValidateCullingKernels(uint32 Seed, int32 Iterations, TArray<FCullingKernelReport>& OutReports)
+{
+    std::mt19937 Rng(Seed);
+    std::uniform_real_distribution<float> Unit(-1.0f, 1.0f);
+    auto Range = [&](float Lo, float Hi) { return Lo + (Hi - Lo) * (Unit(Rng) * 0.5f + 0.5f); };
+
+    // FMA 변형은 반올림이 한 번 적으므로 평면 경계에 걸친 박스는 비교에서 뺀다
+    constexpr float BoundaryEpsilon = 1e-3f;
+    auto IsNearBoundary = [&](const Frustum& F, const FBound8& Bounds, int32 Lane)
+    {
+        const FBound B = Bounds.Get(Lane);
+        const FVector C = B.GetCenter();
+        const FVector E = B.GetExtent();
+        const Plane* Planes = &F.TopFace;
+        for (int p = 0; p < 6; ++p)
+        {
+            const Plane& P = Planes[p];
+            const float Dist = C.X * P.Normal.X + C.Y * P.Normal.Y + C.Z * P.Normal.Z - P.Distance;
+            const float Radius = E.X * std::abs(P.Normal.X) + E.Y * std::abs(P.Normal.Y) + E.Z * std::abs(P.Normal.Z);
+            if (std::abs(Dist + Radius) < BoundaryEpsilon || std::abs(Dist - Radius) < BoundaryEpsilon) return true;
+        }
+        return false;
+    };
+
+    bool bAllPassed = true;
+    for (int L = static_cast<int>(ESimdLevel::SSE2); L <= static_cast<int>(FSimd::GetDetectedLevel()); ++L)
+    {
+        const ESimdLevel Level = static_cast<ESimdLevel>(L);
+        const bool bCull = CullAABBs8Kernel.HasVariant(Level);
+        const bool bTransform = TransformAABBKernel.HasVariant(Level);
+        const bool bStream = CullStreamKernel.HasVariant(Level);
+        if (!bCull && !bTransform && !bStream) continue;
+
+        const FCullAABBs8Fn CullFn = CullAABBs8Kernel.GetVariant(Level);
+        const FTransformAABBFn TransformFn = TransformAABBKernel.GetVariant(Level);
+        const FCullStreamFn StreamFn = CullStreamKernel.GetVariant(Level);
+        int32 CullMismatches = 0, CullSkipped = 0, TransformMismatches = 0, StreamMismatches = 0;
+
+        for (int32 Iter = 0; Iter < Iterations; ++Iter)
+        {
+            // 임의 평면 6장 (절두체 모양일 필요는 없다)
+            Frustum F;
+            Plane* Planes = &F.TopFace;
+            for (int p = 0; p < 6; ++p)
+            {
+                const FVector4 N = Normalize3(FVector4(Unit(Rng), Unit(Rng), Unit(Rng), 0.0f));
+                Planes[p].Normal = N.X == 0.0f && N.Y == 0.0f && N.Z == 0.0f ? FVector4(0.0f, 0.0f, 1.0f, 0.0f) : N;
+                Planes[p].Distance = Range(-60.0f, 20.0f);
+            }
+
+            FBound8 Bounds;
+            bool bNearBoundary = false;
+            for (int32 Lane = 0; Lane < 8; ++Lane)
+            {
+                if ((Rng() & 15) == 0)
+                {
+                    Bounds.SetEmpty(Lane);
+                    continue;
+                }
+                const FVector C(Range(-100.0f, 100.0f), Range(-100.0f, 100.0f), Range(-100.0f, 100.0f));
+                const FVector E(Range(0.0f, 20.0f), Range(0.0f, 20.0f), Range(0.0f, 20.0f));
+                Bounds.Set(Lane, FBound(C - E, C + E));
+                bNearBoundary |= IsNearBoundary(F, Bounds, Lane);
+            }
+
+            if (bCull)
+            {
+                const uint8_t LaneMask = static_cast<uint8_t>(Rng());
+                const uint32 PlaneMask = Rng() & FrustumAllPlanes;
+                const int32 FirstPlane = static_cast<int32>(Rng() % 6);
+                const FCullResult8 Ref = CullAABBs8Masked_Scalar(F, Bounds, LaneMask, PlaneMask, FirstPlane);
+                const FCullResult8 Got = CullFn(F, Bounds, LaneMask, PlaneMask, FirstPlane);
+                const bool bSame = Ref.Visible == Got.Visible && Ref.RejectPlane == Got.RejectPlane &&
+                    Ref.PlaneTests == Got.PlaneTests && std::equal(Ref.Inside, Ref.Inside + 6, Got.Inside);
+                if (!bSame)
+                {
+                    if (bNearBoundary) ++CullSkipped;
+                    else ++CullMismatches;
+                }
+            }
+
+            if (bStream)
+            {
+                // 폭으로 나누어떨어지지 않는 길이, 빈 박스, NaN 박스를 섞는다
+                const int32 Count = static_cast<int32>(Rng() % 70);
+                FBoundSoA Boxes;
+                Boxes.Reset(Count);
+                for (int32 i = 0; i < Count; ++i)
+                {
+                    const uint32 Kind = Rng() & 31;
+                    if (Kind == 0)
+                    {
+                        Boxes.Add(FBound(FVector(FLT_MAX, FLT_MAX, FLT_MAX), FVector(-FLT_MAX, -FLT_MAX, -FLT_MAX)));
+                        continue;
+                    }
+                    const FVector C(Range(-100.0f, 100.0f), Range(-100.0f, 100.0f), Range(-100.0f, 100.0f));
+                    const FVector E(Range(0.0f, 20.0f), Range(0.0f, 20.0f), Range(0.0f, 20.0f));
+                    Boxes.Add(FBound(C - E, C + E));
+                    if (Kind == 1) Boxes.MinY[i] = std::numeric_limits<float>::quiet_NaN();
+                }
+
+                const uint32 PlaneMask = Rng() & FrustumAllPlanes;
+                const FStreamPlanes StreamPlanes = GatherStreamPlanes(F, PlaneMask);
+                const FBoundStream Stream = Boxes.MakeStream();
+                uint64 RefMask[2] = {}, GotMask[2] = {};
+                CullStreamToMask(&CullStream_Scalar, StreamPlanes, Stream, RefMask);
+                const int32 GotCount = CullStreamToMask(StreamFn, StreamPlanes, Stream, GotMask);
+
+                int32 GotBits = 0;
+                for (int32 i = 0; i < Count; ++i)
+                {
+                    const bool bRef = (RefMask[i >> 6] >> (i & 63)) & 1;
+                    const bool bGot = (GotMask[i >> 6] >> (i & 63)) & 1;
+                    GotBits += bGot ? 1 : 0;
+                    if (bRef == bGot) continue;
+
+                    FBound8 Single;
+                    for (int32 Lane = 0; Lane < 8; ++Lane) Single.SetEmpty(Lane);
+                    Single.Set(0, Boxes.Get(i));
+                    if (IsNearBoundary(F, Single, 0)) ++CullSkipped;
+                    else ++StreamMismatches;
+                }
+                bool bTailClean = true;
+                for (int32 i = Count; i < 128; ++i) bTailClean &= ((GotMask[i >> 6] >> (i & 63)) & 1) == 0;
+                if (GotBits != GotCount || !bTailClean) ++StreamMismatches;
+            }
+
+            if (bTransform)
+            {
+                FMatrix M;
+                for (int r = 0; r < 3; ++r)
+                    for (int c = 0; c < 4; ++c)
+                        M.M[r][c] = c < 3 ? Range(-2.0f, 2.0f) : 0.0f;
+                M.M[3][0] = Range(-100.0f, 100.0f);
+                M.M[3][1] = Range(-100.0f, 100.0f);
+                M.M[3][2] = Range(-100.0f, 100.0f);
+                M.M[3][3] = 1.0f;
+
+                const FVector C(Range(-10.0f, 10.0f), Range(-10.0f, 10.0f), Range(-10.0f, 10.0f));
+                const FVector E(Range(0.0f, 5.0f), Range(0.0f, 5.0f), Range(0.0f, 5.0f));
+                const FBound Local(C - E, C + E);
+                const FBound Ref = TransformAABB_Scalar(Local, M);
+                const FBound Got = TransformFn(Local, M);
+                for (int a = 0; a < 3; ++a)
+                {
+                    const float Tol = 1e-4f * (1.0f + std::abs(Ref.Min[a]) + std::abs(Ref.Max[a]));
+                    if (std::abs(Ref.Min[a] - Got.Min[a]) > Tol || std::abs(Ref.Max[a] - Got.Max[a]) > Tol)
+                    {
+                        ++TransformMismatches;
+                        break;
+                    }
+                }
+            }
+        }
+
+        bAllPassed &= CullMismatches == 0 && TransformMismatches == 0 && StreamMismatches == 0;
+        OutReports.push_back({ Level, CullMismatches, StreamMismatches, CullSkipped, TransformMismatches });
+    }
+    return bAllPassed;
+}
@@ -0,0 +1,141 @@
+﻿#pragma once
+
+#include "UEContainer.h"
+#include "Struct.h"
+#include "SimdDispatch.h"
+
+// 프러스텀 평면과 AABB 컬링 커널 (카메라/엔진 헤더 없이 쓰는 부분, 헤드리스 테스트에서도 빌드된다)
+// 카메라에서 프러스텀을 만드는 쪽과 화면 크기 컬링은 Frustum.h
+
+// 평면 계산용 SSE2 벡터 헬퍼 (xyz 만 사용)
+inline float     Dot3(const FVector4& A, const FVector4& B)
+{
+    // SSE2 만 사용: xyz 곱을 가로로 더한다 (dpps 는 SSE4.1 이라 기본 경로에서 가정하지 않는다)
+    const __m128 Mul = _mm_mul_ps(A.SimdData, B.SimdData);
+    const __m128 Y = _mm_shuffle_ps(Mul, Mul, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 Z = _mm_shuffle_ps(Mul, Mul, _MM_SHUFFLE(2, 2, 2, 2));
+    return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(Mul, Y), Z));
+}
+
+inline FVector4  Cross3(const FVector4& A, const FVector4& B)
+{
+    // Formula:
+    // C.x = A.y * B.z - A.z * B.y
+    // C.y = A.z * B.x - A.x * B.z
+    // C.z = A.x * B.y - A.y * B.x
+
+    // Shuffle A and B to align components for multiplication
+    __m128 a_yzx = _mm_shuffle_ps(A.SimdData, A.SimdData, _MM_SHUFFLE(3, 0, 2, 1)); // (Ay, Az, Ax, Aw)
+    __m128 b_zxy = _mm_shuffle_ps(B.SimdData, B.SimdData, _MM_SHUFFLE(3, 1, 0, 2)); // (Bz, Bx, By, Bw)
+    __m128 a_zxy = _mm_shuffle_ps(A.SimdData, A.SimdData, _MM_SHUFFLE(3, 1, 0, 2)); // (Az, Ax, Ay, Aw)
+    __m128 b_yzx = _mm_shuffle_ps(B.SimdData, B.SimdData, _MM_SHUFFLE(3, 0, 2, 1)); // (By, Bz, Bx, Bw)
+
+    // result = (a_yzx * b_zxy) - (a_zxy * b_yzx)  (프러스텀 생성 전용이라 FMA 없이 SSE2 로 충분)
+    __m128 sub = _mm_sub_ps(_mm_mul_ps(a_yzx, b_zxy), _mm_mul_ps(a_zxy, b_yzx));
+
+    FVector4 result(sub);
+    result.W = 0.0f;
+    return result;
+}
+inline float     Length3(const FVector4& V)
+{
+    float dot = Dot3(V, V);
+    return std::sqrt(dot);
+}
+inline FVector4  Normalize3(const FVector4& V)
+{
+    float len = Length3(V);
+    if (len > 0.0f)
+    {
+        __m128 v = _mm_load_ps(&V.X);
+        __m128 len_v = _mm_set1_ps(len);
+        __m128 result_v = _mm_div_ps(v, len_v);
+        FVector4 result;
+        _mm_store_ps(&result.X, result_v);
+        result.W = 0.0f;
+        return result;
+    }
+    return FVector4(0, 0, 0, 0);
+}
+
+struct Plane
+{
+    // unit vector
+    FVector4 Normal = { 0.f, 1.f, 0.f , 0.f };
+
+    // 평면이 원점에서 법선 N 방향으로 얼마만큼 떨어져 있는지
+    float Distance = 0.f;
+};
+
+struct Frustum
+{
+    Plane TopFace;
+    Plane BottomFace;
+    Plane RightFace;
+    Plane LeftFace;
+    Plane NearFace;
+    Plane FarFace;
+};
+
+bool IsAABBVisible(const Frustum& Frustum, const FBound& Bound);
+bool IsAABBIntersects(const Frustum& Frustum, const FBound& Bound);
+
+// 8개 AABB 를 한 번에 6평면 테스트 (SIMD 레벨에 맞는 커널로 분기)
+// Returns an 8-bit mask: bit i is set if box i is visible.
+uint8_t AreAABBsVisible_8(const Frustum& Frustum, const FBound Bounds[8]);
+// SoA 입력 버전: 전치 없이 바로 6평면 테스트
+uint8_t AreAABBsVisible_8(const Frustum& Frustum, const FBound8& Bounds);
+
+bool Intersects(const Plane& P, const FVector4& Center, const FVector4& Extents);
+
+// ------------------------------------------------------------
+// 평면 마스크 기반 계층 컬링
+//  - 평면 비트 순서는 Frustum 멤버 순서 (Top, Bottom, Right, Left, Near, Far)
+//  - 부모가 완전히 안쪽인 평면은 자식에서 테스트하지 않는다
+//  - FirstPlane: 먼저 테스트할 평면 (지난 프레임에 탈락시킨 평면을 넘기면 빨리 걸러진다)
+// ------------------------------------------------------------
+constexpr uint32 FrustumAllPlanes = 0x3F;
+
+// 단일 AABB. 밖이면 false, 아니면 InOutPlaneMask 에서 완전히 안쪽인 평면을 지운다 (0 이면 완전 내부)
+// 밖일 때 InOutRejectPlane 에 탈락시킨 평면을 기록. OutPlaneTests 에 수행한 평면 테스트 수를 더한다.
+bool IsAABBVisibleMasked(const Frustum& Frustum, const FBound& Bound, uint32& InOutPlaneMask, uint8& InOutRejectPlane, uint32& OutPlaneTests);
+
+struct FCullResult8
+{
+    uint8_t Visible = 0;        // 어느 활성 평면에서도 완전히 밖이 아닌 레인
+    uint8_t Inside[6] = {};     // 평면별로 완전히 안쪽인 레인
+    int32 RejectPlane = -1;     // 모든 레인이 탈락했다면 마지막으로 탈락시킨 평면
+    uint32 PlaneTests = 0;      // 수행한 (박스, 평면) 테스트 수
+};
+// Scalar / SSE2 / AVX2(FMA) 변형 중 FSimd 활성 레벨에 맞는 것을 쓴다 (8레인이라 AVX-512 는 AVX2 로 내려감)
+FCullResult8 CullAABBs8Masked(const Frustum& Frustum, const FBound8& Bounds, uint8_t LaneMask, uint32 PlaneMask, int32 FirstPlane);
+
+// ------------------------------------------------------------
+// SoA AABB 스트림 배치 컬링 (개수 제한 없음, 어느 서브시스템에서나 사용)
+//  - 활성 SIMD 폭(SSE2 4 / AVX2 8 / AVX-512 16)으로 돌고 남는 꼬리는 스칼라
+//  - PlaneMask 에 있는 평면만 테스트 (계층 컬링에서 부모가 완전히 안쪽인 평면은 빼고 넘긴다)
+//  - 판정은 IsAABBVisible 과 같다: 어느 평면에서든 dist + radius < 0 (NaN 포함) 이면 밖
+// ------------------------------------------------------------
+// 보이는 박스의 스트림 내 인덱스를 오름차순으로 OutIndices 에 채운다 (Stream.Count 개 공간 필요). 반환: 보이는 개수
+int32 CullAABBStream(const Frustum& Frustum, const FBoundStream& Stream, uint32* OutIndices, uint32 PlaneMask = FrustumAllPlanes);
+// 비트마스크 버전: 박스 i 가 보이면 OutMask[i / 64] 의 (i % 64) 비트 ((Count + 63) / 64 워드 필요, 남는 비트는 0). 반환: 보이는 개수
+int32 CullAABBStreamMask(const Frustum& Frustum, const FBoundStream& Stream, uint64* OutMask, uint32 PlaneMask = FrustumAllPlanes);
+
+// ------------------------------------------------------------
+// 로컬 AABB → 월드 AABB (Arvo: 중심은 변환, 익스텐트는 |선형부| 로 투영)
+//  - Scalar / SSE2 / AVX2(FMA) 변형 중 활성 레벨에 맞는 것을 쓴다
+// ------------------------------------------------------------
+FBound TransformAABB(const FBound& LocalBound, const FMatrix& World);
+
+// 컬링 커널(8박스 평면 테스트, 스트림 배치 컬링, AABB 변환)의 SIMD 변형을 스칼라 기준 구현과 비교
+//  - 감지 레벨 이하에서 변형이 있는 레벨마다 보고서 하나. 불일치가 없으면 true
+//  - FMA 변형은 반올림이 한 번 적으므로 평면 경계에 걸친 박스의 불일치는 BoundarySkipped 로 따로 센다
+struct FCullingKernelReport
+{
+    ESimdLevel Level;
+    int32 CullMismatches;
+    int32 StreamMismatches;
+    int32 BoundarySkipped;
+    int32 TransformMismatches;
+};
+bool ValidateCullingKernels(uint32 Seed, int32 Iterations, TArray<FCullingKernelReport>& OutReports);
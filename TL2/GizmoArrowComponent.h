@@ -7,6 +7,8 @@ public:
     UGizmoArrowComponent();
     
     void Render(URenderer* Renderer, const FMatrix& View, const FMatrix& Proj) override;
+    // 오버레이 상태/화면 고정 스케일이 필요해 항상 Render 로 그린다
+    bool EmitDrawCommands(FDrawCommandList& OutList, const FMatrix& View) override { return false; }
 
 protected:
     ~UGizmoArrowComponent() override;
@@ -0,0 +1,116 @@
+﻿#include "JobSystem.h"
+
+FJobSystem& FJobSystem::Get()
+{
+    static FJobSystem Instance;
+    return Instance;
+}
+
+FJobSystem::FJobSystem()
+{
+    const uint32 HW = std::max(1u, std::thread::hardware_concurrency());
+    const uint32 NumWorkers = HW - 1;
+    Workers.reserve(NumWorkers);
+    for (uint32 i = 0; i < NumWorkers; ++i)
+        Workers.emplace_back([this]() { WorkerLoop(); });
+}
+
+FJobSystem::~FJobSystem()
+{
+    {
+        std::lock_guard<std::mutex> Lock(QueueMutex);
+        bStopping = true;
+    }
+    QueueCV.notify_all();
+    for (std::thread& Worker : Workers)
+        if (Worker.joinable()) Worker.join();
+}
+
+uint32 FJobSystem::GetWorkerCount()
+{
+    return static_cast<uint32>(Get().Workers.size());
+}
+
+void FJobSystem::WorkerLoop()
+{
+    for (;;)
+    {
+        FDispatch* Task = nullptr;
+        {
+            std::unique_lock<std::mutex> Lock(QueueMutex);
+            QueueCV.wait(Lock, [this]() { return bStopping || PendingHead != nullptr; });
+            if (!PendingHead) return;
+            Task = PendingHead;
+            ++Task->ActiveHelpers;
+            if (--Task->HelpersWanted == 0)
+            {
+                PendingHead = Task->Next;
+                Task->Next = nullptr;
+            }
+        }
+
+        RunChunks(*Task);
+
+        // 조인 카운터를 내리는 것이 Task 에 대한 마지막 접근 (이후 호출 스레드가 스택 상태를 버린다)
+        std::lock_guard<std::mutex> Lock(QueueMutex);
+        if (--Task->ActiveHelpers == 0)
+            JoinCV.notify_all();
+    }
+}
+
+int32 FJobSystem::GetChunkCount(int32 Count, int32 MinBatchSize)
+{
+    if (Count <= 0) return 0;
+    MinBatchSize = std::max(1, MinBatchSize);
+    const int32 MaxChunks = static_cast<int32>(GetWorkerCount()) + 1;
+    return std::clamp((Count + MinBatchSize - 1) / MinBatchSize, 1, MaxChunks);
+}
+
+void FJobSystem::RunChunks(FDispatch& State)
+{
+    for (;;)
+    {
+        const int32 Chunk = State.NextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (Chunk >= State.ChunkCount) return;
+        State.Invoke(State.Context, Chunk);
+    }
+}
+
+void FJobSystem::Dispatch(int32 ChunkCount, void* Context, FChunkInvoker Invoke)
+{
+    if (ChunkCount <= 0) return;
+    if (ChunkCount == 1 || GetWorkerCount() == 0)
+    {
+        for (int32 i = 0; i < ChunkCount; ++i) Invoke(Context, i);
+        return;
+    }
+
+    FJobSystem& System = Get();
+    FDispatch State;
+    State.Context = Context;
+    State.Invoke = Invoke;
+    State.ChunkCount = ChunkCount;
+    const int32 Helpers = std::min<int32>(ChunkCount - 1, static_cast<int32>(System.Workers.size()));
+    State.HelpersWanted = Helpers;
+    {
+        std::lock_guard<std::mutex> Lock(System.QueueMutex);
+        FDispatch** Link = &System.PendingHead;
+        while (*Link) Link = &(*Link)->Next;
+        *Link = &State;
+    }
+    if (Helpers == 1) System.QueueCV.notify_one();
+    else System.QueueCV.notify_all();
+
+    RunChunks(State);
+
+    // 청크는 모두 가져갔다. 아직 안 깨어난 도우미 자리는 회수하고, 청크를 돌고 있는 도우미만 기다린다
+    std::unique_lock<std::mutex> Lock(System.QueueMutex);
+    if (State.HelpersWanted > 0)
+    {
+        FDispatch** Link = &System.PendingHead;
+        while (*Link != &State) Link = &(*Link)->Next;
+        *Link = State.Next;
+        State.HelpersWanted = 0;
+    }
+    System.JoinCV.wait(Lock, [&State]() { return State.ActiveHelpers == 0; });
+}
@@ -0,0 +1,80 @@
+﻿#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include "UEContainer.h"
+
+// 고정 크기 워커 스레드 풀 + ParallelFor
+// - 호출 스레드도 작업을 나눠 처리하므로 워커 안에서 다시 ParallelFor 를 불러도 교착되지 않는다
+// - 청크 수는 Count / MinBatchSize 를 (워커 수 + 1) 로 제한한 값이라 청크 경계는 스레드 수에 따라 달라진다
+//   결과가 스레드 수와 무관해야 하면 청크 결과를 청크 순서대로 이어 붙이는 등 경계에 의존하지 않게 합칠 것
+// - 디스패치 상태는 호출 스레드 스택에 두고 Body 는 비소유 참조로 넘기므로, 한 번의 디스패치는 힙을 쓰지 않는다
+class FJobSystem
+{
+public:
+    // 워커 수 (호출 스레드 제외). 하드웨어 스레드 - 1, 최소 0
+    static uint32 GetWorkerCount();
+
+    // [0, Count) 를 MinBatchSize 이상 크기의 청크로 나눠 Body(Begin, End) 를 병렬 실행하고, 모두 끝날 때까지 대기
+    template<typename FnType>
+    static void ParallelFor(int32 Count, int32 MinBatchSize, FnType&& Body)
+    {
+        const int32 ChunkCount = GetChunkCount(Count, MinBatchSize);
+        if (ChunkCount == 0) return;
+
+        ParallelForChunks(ChunkCount, [&](int32 Chunk)
+        {
+            const int32 Begin = static_cast<int32>(static_cast<int64>(Count) * Chunk / ChunkCount);
+            const int32 End = static_cast<int32>(static_cast<int64>(Count) * (Chunk + 1) / ChunkCount);
+            Body(Begin, End);
+        });
+    }
+
+    // 청크 수를 직접 정하는 버전: Body(ChunkIndex) 를 ChunkCount 번 병렬 실행
+    template<typename FnType>
+    static void ParallelForChunks(int32 ChunkCount, FnType&& Body)
+    {
+        using FBody = std::remove_reference_t<FnType>;
+        Dispatch(ChunkCount, const_cast<void*>(static_cast<const void*>(&Body)),
+            [](void* Context, int32 Chunk) { (*static_cast<FBody*>(Context))(Chunk); });
+    }
+
+    // ParallelFor 가 실제로 만들 청크 수 (청크별 임시 버퍼를 미리 잡을 때 사용)
+    static int32 GetChunkCount(int32 Count, int32 MinBatchSize);
+
+private:
+    using FChunkInvoker = void(*)(void* Context, int32 ChunkIndex);
+
+    // 디스패치 한 번의 상태. 호출 스레드 스택에 있고, 도우미가 모두 빠져나갈 때까지 호출 스레드가 반환하지 않는다
+    struct FDispatch
+    {
+        void* Context = nullptr;
+        FChunkInvoker Invoke = nullptr;
+        int32 ChunkCount = 0;
+        std::atomic<int32> NextChunk{ 0 };
+
+        // 아래는 QueueMutex 로 보호
+        int32 HelpersWanted = 0;        // 아직 워커가 가져가지 않은 도우미 자리 (0 이 되면 대기 목록에서 빠짐)
+        int32 ActiveHelpers = 0;        // 조인 카운터: 이 디스패치를 가져가 아직 끝내지 않은 워커 수
+        FDispatch* Next = nullptr;      // 대기 목록 링크
+    };
+
+    FJobSystem();
+    ~FJobSystem();
+    static FJobSystem& Get();
+
+    static void Dispatch(int32 ChunkCount, void* Context, FChunkInvoker Invoke);
+    static void RunChunks(FDispatch& State);
+    void WorkerLoop();
+
+    TArray<std::thread> Workers;
+    FDispatch* PendingHead = nullptr;   // 도우미를 기다리는 디스패치 (먼저 온 순서)
+    std::mutex QueueMutex;
+    std::condition_variable QueueCV;    // 워커 깨우기
+    std::condition_variable JoinCV;     // 조인 카운터가 0 이 됨
+    bool bStopping = false;
+};
@@ -1,192 +1,331 @@
 ﻿#include "pch.h"
 #include "MeshBVH.h"
+#include <bit>
+#include <immintrin.h>
+
+namespace
+{
+	// 축에 평행한 방향은 아주 작은 값으로 바꿔 역수가 inf 가 되지 않게 한다 (0 * inf = NaN 방지)
+	inline float SafeInverse(float d)
+	{
+		if (std::abs(d) < 1e-6f) d = (d < 0.0f) ? -1e-6f : 1e-6f;
+		return 1.0f / d;
+	}
+
+	// 현재 최근접 거리(MaxT)보다 먼 박스는 실패로 처리하는 슬랩 테스트
+	inline bool RayBoxOverlap(const FBound& B, const FVector& Origin, const FVector& InvDir, float MaxT)
+	{
+		float tx1 = (B.Min.X - Origin.X) * InvDir.X, tx2 = (B.Max.X - Origin.X) * InvDir.X;
+		float ty1 = (B.Min.Y - Origin.Y) * InvDir.Y, ty2 = (B.Max.Y - Origin.Y) * InvDir.Y;
+		float tz1 = (B.Min.Z - Origin.Z) * InvDir.Z, tz2 = (B.Max.Z - Origin.Z) * InvDir.Z;
+
+		const float tmin = std::max({ std::min(tx1, tx2), std::min(ty1, ty2), std::min(tz1, tz2), 0.0f });
+		const float tmax = std::min({ std::max(tx1, tx2), std::max(ty1, ty2), std::max(tz1, tz2), MaxT });
+		return tmin <= tmax;
+	}
+
+	inline float SurfaceArea(const FBound& B)
+	{
+		const FVector E = B.Max - B.Min;
+		return 2.0f * (E.X * E.Y + E.Y * E.Z + E.Z * E.X);
+	}
+
+	inline void GrowBounds(FBound& InOut, const FBound& Other)
+	{
+		InOut.Min = InOut.Min.ComponentMin(Other.Min);
+		InOut.Max = InOut.Max.ComponentMax(Other.Max);
+	}
+
+	inline float BlockCount(uint32 TriCount)
+	{
+		return static_cast<float>((TriCount + 3) / 4);
+	}
+
+	// 레이(브로드캐스트) vs 삼각형 4개 Möller–Trumbore. IntersectRayTriangleMT 와 같은 허용 오차를 쓴다
+	// 맞은 레인 중 MaxT 보다 가까운 최소 거리를 InOutT 에 기록
+	struct FRayLanes4
+	{
+		__m128 OX, OY, OZ;
+		__m128 DX, DY, DZ;
+	};
+
+	inline bool IntersectTriBlock4(const FRayLanes4& R, const FMeshTriBlock4& Tri, float& InOutT)
+	{
+		const __m128 Eps = _mm_set1_ps(KINDA_SMALL_NUMBER);
+		const __m128 NegEps = _mm_set1_ps(-KINDA_SMALL_NUMBER);
+		const __m128 OnePlusEps = _mm_set1_ps(1.0f + KINDA_SMALL_NUMBER);
+		const __m128 SignMask = _mm_set1_ps(-0.0f);
+
+		const __m128 E1X = _mm_load_ps(Tri.E1X), E1Y = _mm_load_ps(Tri.E1Y), E1Z = _mm_load_ps(Tri.E1Z);
+		const __m128 E2X = _mm_load_ps(Tri.E2X), E2Y = _mm_load_ps(Tri.E2Y), E2Z = _mm_load_ps(Tri.E2Z);
+
+		// P = D x E2, Det = E1 . P
+		const __m128 PX = _mm_sub_ps(_mm_mul_ps(R.DY, E2Z), _mm_mul_ps(R.DZ, E2Y));
+		const __m128 PY = _mm_sub_ps(_mm_mul_ps(R.DZ, E2X), _mm_mul_ps(R.DX, E2Z));
+		const __m128 PZ = _mm_sub_ps(_mm_mul_ps(R.DX, E2Y), _mm_mul_ps(R.DY, E2X));
+		const __m128 Det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(E1X, PX), _mm_mul_ps(E1Y, PY)), _mm_mul_ps(E1Z, PZ));
+
+		__m128 Valid = _mm_cmpge_ps(_mm_andnot_ps(SignMask, Det), Eps);
+		if (_mm_movemask_ps(Valid) == 0) return false;
+
+		const __m128 InvDet = _mm_div_ps(_mm_set1_ps(1.0f), Det);
+
+		// T = O - V0, U = (T . P) / Det
+		const __m128 TX = _mm_sub_ps(R.OX, _mm_load_ps(Tri.V0X));
+		const __m128 TY = _mm_sub_ps(R.OY, _mm_load_ps(Tri.V0Y));
+		const __m128 TZ = _mm_sub_ps(R.OZ, _mm_load_ps(Tri.V0Z));
+		const __m128 U = _mm_mul_ps(InvDet,
+			_mm_add_ps(_mm_add_ps(_mm_mul_ps(TX, PX), _mm_mul_ps(TY, PY)), _mm_mul_ps(TZ, PZ)));
+		Valid = _mm_and_ps(Valid, _mm_and_ps(_mm_cmpge_ps(U, NegEps), _mm_cmple_ps(U, OnePlusEps)));
+
+		// Q = T x E1, V = (D . Q) / Det, Dist = (E2 . Q) / Det
+		const __m128 QX = _mm_sub_ps(_mm_mul_ps(TY, E1Z), _mm_mul_ps(TZ, E1Y));
+		const __m128 QY = _mm_sub_ps(_mm_mul_ps(TZ, E1X), _mm_mul_ps(TX, E1Z));
+		const __m128 QZ = _mm_sub_ps(_mm_mul_ps(TX, E1Y), _mm_mul_ps(TY, E1X));
+		const __m128 V = _mm_mul_ps(InvDet,
+			_mm_add_ps(_mm_add_ps(_mm_mul_ps(R.DX, QX), _mm_mul_ps(R.DY, QY)), _mm_mul_ps(R.DZ, QZ)));
+		Valid = _mm_and_ps(Valid, _mm_and_ps(_mm_cmpge_ps(V, NegEps), _mm_cmple_ps(_mm_add_ps(U, V), OnePlusEps)));
+
+		const __m128 Dist = _mm_mul_ps(InvDet,
+			_mm_add_ps(_mm_add_ps(_mm_mul_ps(E2X, QX), _mm_mul_ps(E2Y, QY)), _mm_mul_ps(E2Z, QZ)));
+		Valid = _mm_and_ps(Valid, _mm_and_ps(_mm_cmpgt_ps(Dist, Eps), _mm_cmplt_ps(Dist, _mm_set1_ps(InOutT))));
+
+		int Mask = _mm_movemask_ps(Valid);
+		if (Mask == 0) return false;
+
+		alignas(16) float DistLanes[4];
+		_mm_store_ps(DistLanes, Dist);
+		while (Mask)
+		{
+			const int Lane = std::countr_zero(static_cast<uint32>(Mask));
+			Mask &= Mask - 1;
+			InOutT = std::min(InOutT, DistLanes[Lane]);
+		}
+		return true;
+	}
+}
 
 void FMeshBVH::Build(const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices)
 {
 	TriIndices.Empty();
 	Nodes.Empty();
+	TriBlocks.Empty();
+	SourceVertexCount = static_cast<uint32>(Vertices.Num());
+	SourceIndexCount = static_cast<uint32>(Indices.Num());
 	uint32 TriCount = Indices.Num() / 3;
 	if (TriCount == 0) return;
 
+	FBuildInput Input{ Vertices, Indices };
+	Input.TriBounds.resize(TriCount);
+	Input.TriCenters.resize(TriCount);
 	TriIndices.Reserve(TriCount);
 	for (uint32 t = 0; t < TriCount; ++t)
+	{
 		TriIndices.Add(t);
+		Input.TriBounds[t] = ComputeTriBounds(t, Vertices, Indices);
+		Input.TriCenters[t] = ComputeTriCenter(t, Vertices, Indices);
+	}
 
-	BuildRecursive(0, TriCount, Vertices, Indices);
+	Nodes.Reserve(2 * TriCount / MinLeafSize + 1);
+	TriBlocks.Reserve(TriCount / 2 + 1);
+	BuildRecursive(0, TriCount, 0, Input);
 }
 
-// 삼각형과 맞을 경우 , BVH를 따라 내려가면서 교차 가능성 있는 노드만 검사한다. 
-// Möller–Trumbore로 교차 체크 ! 
-bool FMeshBVH::IntersectRay(const FRay& InLocalRay,
-	const TArray<FNormalVertex>& InVertices,
-	const TArray<uint32>& InIndices,
-	float& OutHitDistance)
+void FMeshBVH::SaveCooked(FArchive& Ar) const
 {
-	if (Nodes.Num() == 0)
+	uint32 Magic = CookMagic;
+	uint32 Version = CookVersion;
+	uint32 VertexCount = SourceVertexCount;
+	uint32 IndexCount = SourceIndexCount;
+	Ar << Magic;
+	Ar << Version;
+	Ar << VertexCount;
+	Ar << IndexCount;
+	Serialization::WriteArray(Ar, Nodes);
+	Serialization::WriteArray(Ar, TriBlocks);
+}
+
+bool FMeshBVH::LoadCooked(FArchive& Ar, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices)
+{
+	Reset();
+
+	const uint32 ExpectedVertexCount = static_cast<uint32>(Vertices.Num());
+	const uint32 ExpectedIndexCount = static_cast<uint32>(Indices.Num());
+
+	uint32 Magic = 0, Version = 0, VertexCount = 0, IndexCount = 0;
+	Ar << Magic;
+	Ar << Version;
+	Ar << VertexCount;
+	Ar << IndexCount;
+	if (Ar.IsError() || Magic != CookMagic || Version != CookVersion
+		|| VertexCount != ExpectedVertexCount || IndexCount != ExpectedIndexCount)
 	{
 		return false;
 	}
 
-	float RootEntry, RootExit;
-	if (!Nodes[0].Bounds.RayAABB_IntersectT(InLocalRay, RootEntry, RootExit))
+	// 개수 상한은 파일이 아니라 실제 메시의 삼각형 수로 건다 (손상된 파일이 거대한 할당을 일으키지 않도록)
+	// 리프마다 4개 단위로 패딩되므로 블록 수는 삼각형 수를 넘지 않는다
+	const uint32 TriCount = ExpectedIndexCount / 3;
+	uint32 NodeCount = 0, BlockCount = 0;
+	Ar << NodeCount;
+	if (Ar.IsError() || NodeCount > 2 * TriCount + 1 || (NodeCount == 0) != (TriCount == 0))
 	{
 		return false;
 	}
+	Nodes.resize(NodeCount);
+	if (NodeCount > 0)
+		Ar.Serialize(Nodes.data(), sizeof(FMeshBVHNode) * NodeCount);
 
-	struct FHeapItem
+	Ar << BlockCount;
+	if (Ar.IsError() || BlockCount > TriCount)
 	{
-		int NodeIndex;
-		float EntryDistance;
+		Reset();
+		return false;
+	}
+	TriBlocks.resize(BlockCount);
+	if (BlockCount > 0)
+		Ar.Serialize(TriBlocks.data(), sizeof(FMeshTriBlock4) * BlockCount);
 
-		bool operator>(const FHeapItem& Other) const
-		{
-			return EntryDistance > Other.EntryDistance; // 최소 힙
-		}
-	};
+	if (Ar.IsError() || !ValidateNodes())
+	{
+		Reset();
+		return false;
+	}
+
+	SourceVertexCount = VertexCount;
+	SourceIndexCount = IndexCount;
+	return true;
+}
+
+bool FMeshBVH::ValidateNodes() const
+{
+	const uint32 NodeCount = static_cast<uint32>(Nodes.Num());
+	const uint64 BlockCount = static_cast<uint64>(TriBlocks.Num());
+	if (NodeCount == 0)
+	{
+		return true;
+	}
 
-	std::priority_queue<FHeapItem, TArray<FHeapItem>, std::greater<FHeapItem>> Heap;
-	Heap.push({ 0, RootEntry });
+	// 자식 인덱스는 항상 부모보다 뒤에 있으므로 앞에서부터 한 번 훑으며 깊이를 전파한다
+	// 부모가 없거나 두 번 참조되는 노드는 DFS 평탄화 결과가 아니므로 거부
+	constexpr uint32 Unreached = ~0u;
+	TArray<uint32> Depths;
+	Depths.resize(NodeCount, Unreached);
+	Depths[0] = 0;
 
-	while (!Heap.empty())
+	for (uint32 i = 0; i < NodeCount; ++i)
 	{
-		FHeapItem Current = Heap.top();
-		Heap.pop();
+		const FMeshBVHNode& Node = Nodes[i];
+		const uint32 Depth = Depths[i];
+		if (Depth == Unreached || Depth > MaxDepth)
+		{
+			return false;
+		}
 
-		const FMeshBVHNode& Node = Nodes[Current.NodeIndex];
 		if (Node.IsLeaf())
 		{
-			for (uint32 TriOffset = 0; TriOffset < Node.Count; ++TriOffset)
+			if (static_cast<uint64>(Node.Start) + Node.Count > BlockCount)
 			{
-				const uint32 TriangleID = TriIndices[Node.Start + TriOffset];
-				const uint32 V0 = InIndices[3 * TriangleID + 0];
-				const uint32 V1 = InIndices[3 * TriangleID + 1];
-				const uint32 V2 = InIndices[3 * TriangleID + 2];
-
-				const FVector& A = InVertices[V0].pos;
-				const FVector& B = InVertices[V1].pos;
-				const FVector& C = InVertices[V2].pos;
-
-				float HitT = 0.0f;
-				if (IntersectRayTriangleMT(InLocalRay, A, B, C, HitT))
-				{
-					OutHitDistance = HitT;
-					return true; // 🚀 첫 번째 히트 → 바로 종료
-				}
+				return false;
 			}
+			continue;
 		}
-		else
+
+		// 순회 스택은 MaxDepth 칸이라 내부 노드는 MaxDepth 보다 얕아야 한다
+		const uint32 Left = i + 1;
+		if (Node.Axis >= 3 || Depth >= MaxDepth
+			|| Node.Right <= static_cast<int>(Left) || static_cast<uint32>(Node.Right) >= NodeCount)
+		{
+			return false;
+		}
+		const uint32 Right = static_cast<uint32>(Node.Right);
+		if (Depths[Left] != Unreached || Depths[Right] != Unreached)
+		{
+			return false;
+		}
+		Depths[Left] = Depth + 1;
+		Depths[Right] = Depth + 1;
+	}
+	return true;
+}
+
+void FMeshBVH::Reset()
+{
+	Nodes.Empty();
+	TriBlocks.Empty();
+	TriIndices.Empty();
+	SourceVertexCount = 0;
+	SourceIndexCount = 0;
+}
+
+// 가까운 자식부터 내려가면서 현재 최근접 거리보다 먼 노드는 스킵한다.
+// 리프에서는 미리 계산한 삼각형 블록을 4개씩 SIMD Möller–Trumbore 로 검사
+bool FMeshBVH::IntersectRay(const FRay& InLocalRay, float& OutHitDistance) const
+{
+	if (Nodes.Num() == 0)
+	{
+		return false;
+	}
+
+	const FVector& Origin = InLocalRay.Origin;
+	const FVector& Dir = InLocalRay.Direction;
+	const FVector InvDir(SafeInverse(Dir.X), SafeInverse(Dir.Y), SafeInverse(Dir.Z));
+	const bool DirNegative[3] = { Dir.X < 0.0f, Dir.Y < 0.0f, Dir.Z < 0.0f };
+
+	FRayLanes4 Lanes;
+	Lanes.OX = _mm_set1_ps(Origin.X);
+	Lanes.OY = _mm_set1_ps(Origin.Y);
+	Lanes.OZ = _mm_set1_ps(Origin.Z);
+	Lanes.DX = _mm_set1_ps(Dir.X);
+	Lanes.DY = _mm_set1_ps(Dir.Y);
+	Lanes.DZ = _mm_set1_ps(Dir.Z);
+
+	float ClosestHitDistance = std::numeric_limits<float>::infinity();
+	bool bHasHit = false;
+
+	// 빌드 깊이가 MaxDepth 로 제한되므로 고정 크기 스택으로 충분하다
+	int Stack[MaxDepth + 1];
+	int StackSize = 0;
+	int NodeIndex = 0;
+
+	while (true)
+	{
+		const FMeshBVHNode& Node = Nodes[NodeIndex];
+		if (RayBoxOverlap(Node.Bounds, Origin, InvDir, ClosestHitDistance))
 		{
-			if (Node.Left >= 0)
+			if (!Node.IsLeaf())
 			{
-				float ChildEntry, ChildExit;
-				if (Nodes[Node.Left].Bounds.RayAABB_IntersectT(InLocalRay, ChildEntry, ChildExit))
+				// 분할 축에서 레이가 음의 방향이면 오른쪽 자식이 더 가깝다
+				if (DirNegative[Node.Axis])
 				{
-					Heap.push({ Node.Left, ChildEntry });
+					Stack[StackSize++] = NodeIndex + 1;
+					NodeIndex = Node.Right;
 				}
-			}
-			if (Node.Right >= 0)
-			{
-				float ChildEntry, ChildExit;
-				if (Nodes[Node.Right].Bounds.RayAABB_IntersectT(InLocalRay, ChildEntry, ChildExit))
+				else
 				{
-					Heap.push({ Node.Right, ChildEntry });
+					Stack[StackSize++] = Node.Right;
+					NodeIndex = NodeIndex + 1;
 				}
+				continue;
+			}
+
+			for (uint32 Block = Node.Start; Block < Node.Start + Node.Count; ++Block)
+			{
+				bHasHit |= IntersectTriBlock4(Lanes, TriBlocks[Block], ClosestHitDistance);
 			}
 		}
+
+		if (StackSize == 0) break;
+		NodeIndex = Stack[--StackSize];
 	}
 
+	if (bHasHit)
+	{
+		OutHitDistance = ClosestHitDistance;
+		return true;
+	}
 	return false;
 }
-//bool FMeshBVH::IntersectRay(const FRay& InLocalRay, const TArray<FNormalVertex>& InVertices, const TArray<uint32>& InIndices, float& OutHitDistance)
-//{
-//	if (Nodes.Num() == 0)
-//	{
-//		return false;
-//	}
-//
-//	TArray<FStackItem> NodeStack;
-//
-//	float RootEntryDistance, RootExitDistance;
-//	// 루트 노드가 안맞으면 바로 리턴 
-//	if (!Nodes[0].Bounds.RayAABB_IntersectT(InLocalRay, RootEntryDistance, RootExitDistance))
-//	{
-//		return false;
-//	}
-//	// 가장 늦게 나간 RootEntryDistance
-//	// 삼각형 리스트 인덱스 , 디스턴스 값 저장 
-//	NodeStack.Add({ 0, RootEntryDistance });
-//	bool bHasHit = false;
-//	float ClosestHitDistance = std::numeric_limits<float>::infinity();
-//
-//	// 깊이 우선 탐색 (DFS). 
-//	// 이미 더 가까운 교차가 있으면 멀리 있는 노드는 스킵.
-//	while (!NodeStack.IsEmpty())
-//	{
-//		const FStackItem CurrentItem = NodeStack.Pop();
-//		// 이미 가까운 교차가 있으면 무시 
-//		if (CurrentItem.EntryDistance > ClosestHitDistance)
-//		{
-//			continue;
-//		}
-//
-//		const FMeshBVHNode& CurrentNode = Nodes[CurrentItem.NodeIndex];
-//		if (CurrentNode.IsLeaf())
-//		{
-//			// 총 삼각형의 개수 만큼 돈다. 
-//			for (uint32 TriangleOffset = 0; TriangleOffset < CurrentNode.Count; ++TriangleOffset)
-//			{
-//				// 삼각형 배열에서 시작 위치 Start, TriangleOffset 삼각형의 총 개수만큼 돈다. 
-//				// 그쪽 영역의 삼각형이기 때문이다
-//				const uint32 TriangleID = TriIndices[CurrentNode.Start + TriangleOffset];
-//
-//				const uint32 VertexIndex0 = InIndices[3 * TriangleID + 0];
-//				const uint32 VertexIndex1 = InIndices[3 * TriangleID + 1];
-//				const uint32 VertexIndex2 = InIndices[3 * TriangleID + 2];
-//
-//				const FVector& VertexA = InVertices[VertexIndex0].pos;
-//				const FVector& VertexB = InVertices[VertexIndex1].pos;
-//				const FVector& VertexC = InVertices[VertexIndex2].pos;
-//
-//				float HitDistance = 0.0f;
-//				if (IntersectRayTriangleMT(InLocalRay, VertexA, VertexB, VertexC, HitDistance))
-//				{
-//					if (HitDistance < ClosestHitDistance)
-//					{
-//						ClosestHitDistance = HitDistance;
-//						bHasHit = true;
-//					}
-//				}
-//			}
-//			continue;
-//		}
-//
-//		// 내부 노드 → 자식 검사
-//		// 삼각형에 맞으면, 검사 영역에 넣어주고 맞지 않으면 넣어주지 않는다. 
-//		if (CurrentNode.Left >= 0)
-//		{
-//			float ChildEntry, ChildExit;
-//			if (Nodes[CurrentNode.Left].Bounds.RayAABB_IntersectT(InLocalRay, ChildEntry, ChildExit))
-//			{
-//				NodeStack.Add({ CurrentNode.Left, ChildEntry });
-//			}
-//		}
-//		if (CurrentNode.Right >= 0)
-//		{
-//			float ChildEntry, ChildExit;
-//			if (Nodes[CurrentNode.Right].Bounds.RayAABB_IntersectT(InLocalRay, ChildEntry, ChildExit))
-//			{
-//				NodeStack.Add({ CurrentNode.Right, ChildEntry });
-//			}
-//		}
-//	}
-//
-//	if (bHasHit)
-//	{
-//		OutHitDistance = ClosestHitDistance;
-//		return true;
-//	}
-//	return false;
-//}
 
 FBound FMeshBVH::ComputeTriBounds(uint32 TriangleID, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const
 {
@@ -240,94 +379,174 @@ FVector FMeshBVH::ComputeTriCenter(uint32 TriangleID, const TArray<FNormalVertex
 	return TriangleCenter;
 }
 
-// 여러 삼각형을 한 번에 감싸는 AABB를 계산 
-FBound FMeshBVH::ComputeBounds(uint32 Start, uint32 Count, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const
+// BVH 트리 -> 재귀 구축 (Binned SAH, 노드는 전위 순서로 추가되므로 왼쪽 자식 = 부모 + 1)
+int FMeshBVH::BuildRecursive(uint32 Start, uint32 Count, uint32 Depth, const FBuildInput& Input)
 {
-	// 첫 번째 삼각형 ID로 AABB 초기화 
-	FBound Bounds = ComputeTriBounds(TriIndices[Start], Vertices, Indices);
-	// Start+1 ~ Start+Count-1 까지 모든 삼각형에 대해 반복 
-	// 가장 큰 MIN , MAX 찾아낸다. 
-	for (uint32 i = 1; i < Count; i++)
+	// 현재 노드 인덱스 확보 & 추가 -> 자식으로 쪼갤 때 사용 
+	const int NodeIndex = Nodes.Num();
+	Nodes.Add(FMeshBVHNode());
+
+	// 이 노드가 감싸는 AABB 와 삼각형 중심들의 AABB
+	FBound Bounds = Input.TriBounds[TriIndices[Start]];
+	FBound CenterBounds(Input.TriCenters[TriIndices[Start]], Input.TriCenters[TriIndices[Start]]);
+	for (uint32 i = 1; i < Count; ++i)
 	{
-		FBound TB = ComputeTriBounds(TriIndices[Start + i], Vertices, Indices);
-		Bounds.Min = Bounds.Min.ComponentMin(TB.Min);
-		Bounds.Max = Bounds.Max.ComponentMax(TB.Max);
+		const uint32 Tri = TriIndices[Start + i];
+		GrowBounds(Bounds, Input.TriBounds[Tri]);
+		CenterBounds.Min = CenterBounds.Min.ComponentMin(Input.TriCenters[Tri]);
+		CenterBounds.Max = CenterBounds.Max.ComponentMax(Input.TriCenters[Tri]);
 	}
-	return Bounds;
-}
-
-// BVH 트리 -> 재귀 구축 
-int FMeshBVH::BuildRecursive(uint32 Start, uint32 Count, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices)
-{
-	FMeshBVHNode Node;
-	Node.Start = Start;
-	Node.Count = Count;
+	Nodes[NodeIndex].Bounds = Bounds;
 
-	// 이 노드가 감싸는 AABB 계산
-	Node.Bounds = ComputeBounds(Start, Count, Vertices, Indices);
-
-	// 현재 노드 인덱스 확보 & 추가 -> 자식으로 쪼갤 때 사용 
-	int NodeIndex = Nodes.Num();
-	Nodes.Add(Node);
-
-	// 리프 조건: 삼각형 개수가 LeafSize 이하
-	if (Count <= LeafSize)
+	// 리프 조건: 삼각형이 충분히 적거나 깊이 한도 도달
+	if (Count <= MinLeafSize || Depth >= MaxDepth)
 	{
+		EmitLeaf(NodeIndex, Start, Count, Input);
 		return NodeIndex;
 	}
 
 	// -------------------------------
-	// 분할 축 선택 (가장 긴 축)
+	// 분할 축 선택 (중심 분포가 가장 긴 축)
 	// -------------------------------
-	FVector Extent = Node.Bounds.GetExtent();
-	EAxis Axis = EAxis::X;
+	const FVector Extent = CenterBounds.Max - CenterBounds.Min;
+	int Axis = 0;
+	if (Extent.Y > Extent[Axis]) Axis = 1;
+	if (Extent.Z > Extent[Axis]) Axis = 2;
 
-	if (Extent.Y > Extent.X && Extent.Y >= Extent.Z)
-		Axis = EAxis::Y;
-	else if (Extent.Z > Extent.X && Extent.Z >= Extent.Y)
-		Axis = EAxis::Z;
+	uint32 Mid = Start;
+	if (Extent[Axis] > 1e-8f)
+	{
+		// -------------------------------
+		// Binned SAH: 중심을 빈에 분배하고 빈 경계 중 비용이 가장 낮은 곳에서 분할
+		// -------------------------------
+		struct FBin { FBound Bounds; uint32 Count = 0; };
+		FBin Bins[SAHBinCount];
+		const float AxisMin = CenterBounds.Min[Axis];
+		const float Scale = SAHBinCount / Extent[Axis];
+		auto BinOf = [&](uint32 Tri)
+		{
+			const int Bin = static_cast<int>((Input.TriCenters[Tri][Axis] - AxisMin) * Scale);
+			return std::min(Bin, static_cast<int>(SAHBinCount) - 1);
+		};
 
-	// 중간 지점 -> 반으로 쪼갤 준비하기 
-	uint32 Mid = Start + Count / 2;
+		for (uint32 i = 0; i < Count; ++i)
+		{
+			const uint32 Tri = TriIndices[Start + i];
+			FBin& Bin = Bins[BinOf(Tri)];
+			if (Bin.Count++ == 0) Bin.Bounds = Input.TriBounds[Tri];
+			else GrowBounds(Bin.Bounds, Input.TriBounds[Tri]);
+		}
 
-	// -------------------------------
-	// 삼각형 중심 좌표 기준으로 분할
-	// -------------------------------
-	// 오른쪽 왼쪽으로 나누기 좋은 
-	// nth_element 가이드 
-	// nth_element(first, nth, last, comp)
-	// nth 위치에 "정렬했을 때 올 원소"를 제자리에 넣음
-	// 왼쪽 구간 [first, nth) 에는 그 원소보다 "작은 것들"만
-	// 오른쪽 구간 [nth+1, last) 에는 "큰 것들"만 놓음
-
-	// 선택된 Axis를 방향으로 왼쪽과 오른쪽으로 나눈다. 
-	// 전체를 정렬하지 않고, n번째 작은 원소를 찾아서 놓는다. 
-	std::nth_element(
-		TriIndices.begin() + Start, // 분할할 구간 시작
-		TriIndices.begin() + Mid, // 중간 값의 위치 
-		TriIndices.begin() + Start + Count, // 분할할 구간의 끝 
-		[&](uint32 A, uint32 B)			// 비교함수 
+		// 오른쪽에서 왼쪽으로 누적한 면적/개수
+		float RightArea[SAHBinCount];
+		uint32 RightCount[SAHBinCount];
+		FBound Acc;
+		uint32 AccCount = 0;
+		for (int b = SAHBinCount - 1; b > 0; --b)
+		{
+			if (Bins[b].Count > 0)
+			{
+				if (AccCount == 0) Acc = Bins[b].Bounds;
+				else GrowBounds(Acc, Bins[b].Bounds);
+				AccCount += Bins[b].Count;
+			}
+			RightArea[b] = AccCount ? SurfaceArea(Acc) : 0.0f;
+			RightCount[b] = AccCount;
+		}
+
+		// 비용 = 자식 면적 * 자식 블록 수 (삼각형 4개를 한 번에 검사하므로 블록 단위)
+		float BestCost = std::numeric_limits<float>::infinity();
+		int BestSplit = -1;
+		AccCount = 0;
+		for (uint32 b = 0; b + 1 < SAHBinCount; ++b)
 		{
-			FVector CenterA = ComputeTriCenter(A, Vertices, Indices);
-			FVector CenterB = ComputeTriCenter(B, Vertices, Indices);
+			if (Bins[b].Count > 0)
+			{
+				if (AccCount == 0) Acc = Bins[b].Bounds;
+				else GrowBounds(Acc, Bins[b].Bounds);
+				AccCount += Bins[b].Count;
+			}
+			if (AccCount == 0 || RightCount[b + 1] == 0) continue;
 
-			switch (Axis)
+			const float Cost = SurfaceArea(Acc) * BlockCount(AccCount) + RightArea[b + 1] * BlockCount(RightCount[b + 1]);
+			if (Cost < BestCost)
 			{
-			case EAxis::X: return CenterA.X < CenterB.X;
-			case EAxis::Y: return CenterA.Y < CenterB.Y;
-			case EAxis::Z: return CenterA.Z < CenterB.Z;
-			default:       return CenterA.X < CenterB.X;
+				BestCost = Cost;
+				BestSplit = static_cast<int>(b);
 			}
-		});
+		}
+
+		// 분할 비용(노드 순회 1 + 자식 비용)이 리프보다 비싸면 그대로 리프
+		const float ParentArea = std::max(SurfaceArea(Bounds), 1e-12f);
+		const float LeafCost = BlockCount(Count);
+		const float SplitCost = 1.0f + BestCost / ParentArea;
+		if (BestSplit < 0 || (Count <= MaxLeafSize && LeafCost <= SplitCost))
+		{
+			if (Count <= MaxLeafSize)
+			{
+				EmitLeaf(NodeIndex, Start, Count, Input);
+				return NodeIndex;
+			}
+		}
+		else
+		{
+			Mid = static_cast<uint32>(std::partition(
+				TriIndices.begin() + Start,
+				TriIndices.begin() + Start + Count,
+				[&](uint32 Tri) { return BinOf(Tri) <= BestSplit; }) - TriIndices.begin());
+		}
+	}
+	else if (Count <= MaxLeafSize)
+	{
+		// 중심이 모두 겹친 작은 묶음은 나눠도 이득이 없다
+		EmitLeaf(NodeIndex, Start, Count, Input);
+		return NodeIndex;
+	}
+
+	// SAH 분할이 한쪽으로 쏠렸으면 캐시된 중심 기준 중앙값 분할로 대체
+	if (Mid == Start || Mid == Start + Count)
+	{
+		Mid = Start + Count / 2;
+		std::nth_element(
+			TriIndices.begin() + Start,
+			TriIndices.begin() + Mid,
+			TriIndices.begin() + Start + Count,
+			[&](uint32 A, uint32 B) { return Input.TriCenters[A][Axis] < Input.TriCenters[B][Axis]; });
+	}
 
 	// -------------------------------
 	// 내부 노드로 전환 & 자식 생성
 	// -------------------------------
-	// 자식 생성으로 본인 Count 초기화.
-	// Left, Right에 자식 달기 
-	Nodes[NodeIndex].Count = 0;
-	Nodes[NodeIndex].Left = BuildRecursive(Start, Mid - Start, Vertices, Indices);
-	Nodes[NodeIndex].Right = BuildRecursive(Mid, Start + Count - Mid, Vertices, Indices);
+	Nodes[NodeIndex].Axis = static_cast<uint8>(Axis);
+	BuildRecursive(Start, Mid - Start, Depth + 1, Input);
+	const int Right = BuildRecursive(Mid, Start + Count - Mid, Depth + 1, Input);
+	Nodes[NodeIndex].Right = Right;
 
 	return NodeIndex;
 }
+
+// 리프 삼각형을 4개씩 SoA 블록으로 복사 (남는 레인은 0 으로 채워 교차 테스트에서 빠지게 한다)
+void FMeshBVH::EmitLeaf(int NodeIndex, uint32 Start, uint32 Count, const FBuildInput& Input)
+{
+	Nodes[NodeIndex].Start = TriBlocks.Num();
+	Nodes[NodeIndex].Count = (Count + 3) / 4;
+
+	for (uint32 i = 0; i < Count; i += 4)
+	{
+		FMeshTriBlock4 Block{};
+		for (uint32 Lane = 0; Lane < 4 && i + Lane < Count; ++Lane)
+		{
+			const uint32 TriangleID = TriIndices[Start + i + Lane];
+			const FVector& A = Input.Vertices[Input.Indices[3 * TriangleID + 0]].pos;
+			const FVector& B = Input.Vertices[Input.Indices[3 * TriangleID + 1]].pos;
+			const FVector& C = Input.Vertices[Input.Indices[3 * TriangleID + 2]].pos;
+			const FVector E1 = B - A;
+			const FVector E2 = C - A;
+
+			Block.V0X[Lane] = A.X;  Block.V0Y[Lane] = A.Y;  Block.V0Z[Lane] = A.Z;
+			Block.E1X[Lane] = E1.X; Block.E1Y[Lane] = E1.Y; Block.E1Z[Lane] = E1.Z;
+			Block.E2X[Lane] = E2.X; Block.E2Y[Lane] = E2.Y; Block.E2Z[Lane] = E2.Z;
+		}
+		TriBlocks.Add(Block);
+	}
+}
@@ -1,47 +1,87 @@
 ﻿#pragma once
 #include "AABoundingBoxComponent.h"
+#include "Archive.h"
 
+// 깊이 우선(DFS) 순서로 평탄화된 노드. 내부 노드의 왼쪽 자식은 항상 바로 다음 인덱스에 있다
 struct FMeshBVHNode
 {
 	FBound Bounds;     // 이 노드가 감싸는 AABB
-	int Left = -1;     // 왼쪽 자식 인덱스
-	int Right = -1;    // 오른쪽 자식 인덱스
-	uint32 Start = 0;  // TriIndices 배열에서 시작 위치
-	uint32 Count = 0;  // 리프 노드라면 포함된 삼각형 개수 
+	int Right = -1;    // 오른쪽 자식 인덱스 (왼쪽 자식 = 자기 인덱스 + 1)
+	uint32 Start = 0;  // 리프 노드라면 TriBlocks 배열에서 시작 위치
+	uint32 Count = 0;  // 리프 노드라면 포함된 삼각형 블록 개수
+	uint8 Axis = 0;    // 내부 노드의 분할 축 (순회 시 가까운 자식 결정용)
 
 	bool IsLeaf() const { return Count > 0; }
 };
 
-struct FStackItem
+// 삼각형 4개를 SoA 로 묶은 교차 테스트용 데이터 (V0, Edge1 = V1 - V0, Edge2 = V2 - V0)
+// 빈 레인은 Edge 가 0 이라 행렬식이 0 이 되어 자동으로 제외된다
+struct alignas(16) FMeshTriBlock4
 {
-	int32 NodeIndex;
-	float EntryDistance;
+	float V0X[4], V0Y[4], V0Z[4];
+	float E1X[4], E1Y[4], E1Z[4];
+	float E2X[4], E2Y[4], E2Z[4];
 };
+
 class FMeshBVH
 {
 public:
 
 	void Build(const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices);
 
-	bool IntersectRay(const FRay& InLocalRay, const TArray<FNormalVertex>& InVertices, const TArray<uint32>& InIndices, float& OutHitDistance);
+	// 가장 가까운 삼각형까지의 거리 (로컬 레이 파라미터). 스레드 안전, 힙 할당 없음
+	bool IntersectRay(const FRay& InLocalRay, float& OutHitDistance) const;
+
+	// 메시 bin 옆에 저장되는 BVH bin 직렬화
+	void SaveCooked(FArchive& Ar) const;
+
+	// 헤더/버전/메시 크기가 맞지 않거나, 읽다 끊기거나, 노드 구조가 잘못됐으면 false 와 빈 BVH 를 남긴다
+	// 순회는 인덱스를 검사하지 않으므로 false 면 호출 측에서 Build 로 다시 만들어야 한다
+	bool LoadCooked(FArchive& Ar, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices);
 
+	static constexpr uint32 MaxDepth = 64;
 
 private:
+	// 빌드 중에만 쓰는 삼각형별 캐시 (분할 비교마다 다시 계산하지 않도록)
+	struct FBuildInput
+	{
+		const TArray<FNormalVertex>& Vertices;
+		const TArray<uint32>& Indices;
+		TArray<FBound> TriBounds;
+		TArray<FVector> TriCenters;
+	};
+
 	// Helper 함수들
 	FBound ComputeTriBounds(uint32 TriangleID, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const;
 
 	FVector ComputeTriCenter(uint32 TriangleID, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const;
 
-	FBound ComputeBounds(uint32 Start, uint32 Count, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices) const;
+	int BuildRecursive(uint32 Start, uint32 Count, uint32 Depth, const FBuildInput& Input);
+
+	void EmitLeaf(int NodeIndex, uint32 Start, uint32 Count, const FBuildInput& Input);
 
-	int BuildRecursive(uint32 Start, uint32 Count, const TArray<FNormalVertex>& Vertices, const TArray<uint32>& Indices);
+	// 로드한 노드가 순회에서 범위를 벗어나지 않는지 검사 (자식/블록 인덱스, 분할 축, 깊이)
+	bool ValidateNodes() const;
+
+	void Reset();
 
 private:
 
 	TArray<FMeshBVHNode> Nodes;
+	// 리프 순서대로 재배치된 삼각형 블록
+	TArray<FMeshTriBlock4> TriBlocks;
 	//삼각형 ID(번호) 목록 , 삼각형의 인덱스를 의미한다. 
 	//삼각형 순서만 재배치  , 정점 좌표와 인덱스 버퍼를 직접적으로 건들면 안되기 때문이다.
 	TArray<uint32> TriIndices;
-	const uint32 LeafSize = 4;
-};
 
+	// 빌드에 사용된 메시 크기 (쿠킹 데이터 검증용)
+	uint32 SourceVertexCount = 0;
+	uint32 SourceIndexCount = 0;
+
+	static constexpr uint32 CookMagic = 0x4856424D; // 'MBVH'
+	static constexpr uint32 CookVersion = 1;        // 노드/블록 레이아웃이 바뀌면 올린다
+
+	static constexpr uint32 MinLeafSize = 2;   // 이 이하면 바로 리프
+	static constexpr uint32 MaxLeafSize = 8;   // 이 초과면 SAH 비용과 무관하게 분할
+	static constexpr uint32 SAHBinCount = 16;
+};
@@ -3,6 +3,7 @@
 
 #include "ObjectIterator.h"
 #include "StaticMesh.h"
+#include "MeshBVH.h"
 #include "Enums.h"
 #include "WindowsBinReader.h"
 #include "WindowsBinWriter.h"
@@ -101,7 +102,8 @@ FStaticMesh* FObjManager::LoadObjStaticMeshAsset(const FString& PathFileName)
     WithoutExtensionPath.replace_extension("");
     const FString StemPath = WithoutExtensionPath.string(); // 확장자를 제외한 경로
     const FString BinPathFileName = StemPath + ".bin";
-    if (std::filesystem::exists(BinPathFileName))
+    const bool bLoadedFromBin = std::filesystem::exists(BinPathFileName);
+    if (bLoadedFromBin)
     {
         // obj 정보 bin으로 가져오기
         FWindowsBinReader Reader(BinPathFileName);
@@ -174,6 +176,27 @@ FStaticMesh* FObjManager::LoadObjStaticMeshAsset(const FString& PathFileName)
         MatWriter.Close();
     }
 
+    // 메시 BVH 도 bin 으로 가져오기 (없거나 메시와 맞지 않으면 빌드 후 저장)
+    // 첫 피킹 때 대형 메시 BVH 를 빌드하느라 멈추지 않도록 메시와 함께 준비해 둔다
+    const FString BVHBinPathFileName = StemPath + "BVH.bin";
+    FMeshBVH* MeshBVH = new FMeshBVH();
+    bool bBVHLoaded = false;
+    if (bLoadedFromBin && std::filesystem::exists(BVHBinPathFileName))
+    {
+        FWindowsBinReader BVHReader(BVHBinPathFileName);
+        bBVHLoaded = MeshBVH->LoadCooked(BVHReader, NewFStaticMesh->Vertices, NewFStaticMesh->Indices);
+        BVHReader.Close();
+    }
+    if (!bBVHLoaded)
+    {
+        MeshBVH->Build(NewFStaticMesh->Vertices, NewFStaticMesh->Indices);
+
+        FWindowsBinWriter BVHWriter(BVHBinPathFileName);
+        MeshBVH->SaveCooked(BVHWriter);
+        BVHWriter.Close();
+    }
+    UResourceManager::GetInstance().AddMeshBVH(NewFStaticMesh->PathFileName, MeshBVH);
+
     // 리소스 매니저에 Material 리소스 맵핑 (중복 방지)
     for (const FObjMaterialInfo& InMaterialInfo : MaterialInfos)
     {
@@ -0,0 +1,90 @@
+﻿#include "pch.h"
+#include "Occlusion.h"
+
+const FOccluderMesh* FOcclusionCullingManagerCPU::GetOccluderMesh(const FStaticMesh* Asset)
+{
+	if (!Asset) return nullptr;
+
+	if (const FOccluderMesh* Cached = OccluderMeshCache.Find(Asset))
+		return Cached->IsEmpty() ? nullptr : Cached;
+
+	// 실패해도 빈 메시로 캐시해 매 프레임 다시 만들지 않음
+	FOccluderMesh& Mesh = OccluderMeshCache[Asset];
+	BuildOccluderMesh(*Asset, MaxOccluderTriangles, Mesh);
+	return Mesh.IsEmpty() ? nullptr : &Mesh;
+}
+
+bool FOcclusionCullingManagerCPU::BuildOccluderMesh(const FStaticMesh& Asset, int32 MaxTriangles, FOccluderMesh& OutMesh)
+{
+	OutMesh.Positions.clear();
+	OutMesh.Indices.clear();
+
+	const uint32 NumVerts = uint32(Asset.Vertices.size());
+	if (NumVerts == 0 || Asset.Indices.size() < 3) return false;
+
+	// 1) 위치 용접: 위치로 정렬해 같은 위치는 하나의 인덱스로
+	TArray<uint32> Order(NumVerts);
+	for (uint32 i = 0; i < NumVerts; ++i) Order[i] = i;
+	auto PosLess = [&](uint32 A, uint32 B)
+		{
+			const FVector& PA = Asset.Vertices[A].pos;
+			const FVector& PB = Asset.Vertices[B].pos;
+			return std::tie(PA.X, PA.Y, PA.Z) < std::tie(PB.X, PB.Y, PB.Z);
+		};
+	std::sort(Order.begin(), Order.end(), PosLess);
+
+	TArray<uint32> Remap(NumVerts);
+	TArray<FVector> Welded;
+	for (uint32 i = 0; i < NumVerts; ++i)
+	{
+		if (i == 0 || PosLess(Order[i - 1], Order[i]))
+			Welded.push_back(Asset.Vertices[Order[i]].pos);
+		Remap[Order[i]] = uint32(Welded.size() - 1);
+	}
+
+	// 2) 퇴화 삼각형 제거 + 면적 기록
+	struct FTri { uint32 I[3]; float Area; uint32 Order; };
+	TArray<FTri> Tris;
+	Tris.reserve(Asset.Indices.size() / 3);
+	for (size_t i = 0; i + 2 < Asset.Indices.size(); i += 3)
+	{
+		const uint32 A = Asset.Indices[i], B = Asset.Indices[i + 1], C = Asset.Indices[i + 2];
+		if (A >= NumVerts || B >= NumVerts || C >= NumVerts) continue;
+
+		FTri T{ { Remap[A], Remap[B], Remap[C] }, 0.0f, uint32(Tris.size()) };
+		if (T.I[0] == T.I[1] || T.I[1] == T.I[2] || T.I[2] == T.I[0]) continue;
+
+		const FVector E1 = Welded[T.I[1]] - Welded[T.I[0]];
+		const FVector E2 = Welded[T.I[2]] - Welded[T.I[0]];
+		T.Area = FVector::Cross(E1, E2).Size() * 0.5f;
+		if (!(T.Area > 1e-12f)) continue;
+
+		Tris.push_back(T);
+	}
+
+	// 3) 예산 초과 시 면적 큰 삼각형만 남기고, 원래 순서로 되돌림(결과 결정적)
+	if (MaxTriangles > 0 && Tris.size() > size_t(MaxTriangles))
+	{
+		std::nth_element(Tris.begin(), Tris.begin() + MaxTriangles, Tris.end(),
+			[](const FTri& L, const FTri& R) { return L.Area != R.Area ? L.Area > R.Area : L.Order < R.Order; });
+		Tris.resize(size_t(MaxTriangles));
+		std::sort(Tris.begin(), Tris.end(), [](const FTri& L, const FTri& R) { return L.Order < R.Order; });
+	}
+
+	// 4) 실제로 쓰는 정점만 압축
+	TArray<uint32> Compact(Welded.size(), UINT32_MAX);
+	OutMesh.Indices.reserve(Tris.size() * 3);
+	for (const FTri& T : Tris)
+	{
+		for (uint32 Corner : T.I)
+		{
+			if (Compact[Corner] == UINT32_MAX)
+			{
+				Compact[Corner] = uint32(OutMesh.Positions.size());
+				OutMesh.Positions.push_back(Welded[Corner]);
+			}
+			OutMesh.Indices.push_back(Compact[Corner]);
+		}
+	}
+	return !OutMesh.IsEmpty();
+}
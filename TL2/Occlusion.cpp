@@ -1,7 +1,8 @@
-﻿#include "pch.h"
-#include "Occlusion.h"
-#include "AABoundingBoxComponent.h"
-#include "Frustum.h"
+﻿#include "Occlusion.h"
+#include "JobSystem.h"
+#include "PlatformTime.h"
+#include <immintrin.h>
+#include <random>
 
 // NDC Z가 [-1..1]인 프로젝션이면 아래 변환을 켜세요.
 // static inline float To01(float z_ndc) { return z_ndc * 0.5f + 0.5f; }
@@ -14,6 +15,37 @@ static inline float LinearizeZ01(float zView, float zNear, float zFar) {
 	return std::max(0.f, std::min(1.f, z));
 }
 
+// 일반 4x4 역행렬 (여인수 전개). 특이 행렬이면 false
+static bool InvertMatrix4(const FMatrix& In, FMatrix& Out)
+{
+	const float* m = &In.M[0][0];
+	float inv[16];
+	inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+	inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+	inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+	inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+	inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+	inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+	inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+	inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+	inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+	inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+	inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+	inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+	inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+	inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+	inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+	inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+	const float Det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+	if (std::fabs(Det) < 1e-20f) return false;
+
+	const float InvDet = 1.0f / Det;
+	float* o = &Out.M[0][0];
+	for (int i = 0; i < 16; ++i) o[i] = inv[i] * InvDet;
+	return true;
+}
+
 // FBound(Min/Max) → 8코너
 static inline void MakeAabbCornersMinMax(const FBound& B, FVector Corners[8])
 {
@@ -83,66 +115,1234 @@ bool FOcclusionCullingManagerCPU::ComputeRectAndMinZ(
 	OutR.ActorIndex = D.ActorIndex;
 	return true;
 }
-void FOcclusionCullingManagerCPU::BuildOccluderDepth(
-	const TArray<FCandidateDrawable>& Occluders, int ViewW, int ViewH)
+namespace
 {
-	Grid.Clear();
+	// 삼각형 하나를 타일 하나에 그릴 때 행 커널이 쓰는 값 (RasterizeTriangleDepthMin 이 채움)
+	struct FTriangleRasterSetup
+	{
+		int MinPX, MaxPX, MinPY, MaxPY;     // 삼각형 bbox ∩ 타일
+		int TileMinX, TileMaxX;
+		float EA[3], EB[3], EC[3];          // E(p) = A*px + B*py + C
+		float X0, Y0;
+		float W0, Q0;                       // 정점0의 1/w, 뷰 z / w
+		float WDx, WDy, QDx, QDy;           // 화면 공간 기울기
+		float MaxZView, ZNear, InvRange;
+	};
 
-	const int GW = Grid.GetWidth();
-	const int GH = Grid.GetHeight();
+	bool MakeTriangleRasterSetup(const FOcclusionTriangle& Tri, const FOcclusionTile& Tile, FTriangleRasterSetup& S)
+	{
+		const float* X = Tri.X;
+		const float* Y = Tri.Y;
+
+		// 부호 있는 면적. 음수면 두 정점을 바꿔 세 변의 edge function이 내부에서 양수가 되게 한다
+		int I1 = 1, I2 = 2;
+		float Area = (X[1] - X[0]) * (Y[2] - Y[0]) - (X[2] - X[0]) * (Y[1] - Y[0]);
+		if (Area < 0.0f) { std::swap(I1, I2); Area = -Area; }
+		if (Area < 1e-6f) return false;
+
+		const float X0 = X[0], Y0 = Y[0];
+		const float X1 = X[I1], Y1 = Y[I1];
+		const float X2 = X[I2], Y2 = Y[I2];
+
+		// 삼각형 bbox와 타일이 겹치는 범위만 순회
+		S.MinPX = std::max(Tile.MinX, Tri.MinPX);
+		S.MaxPX = std::min(Tile.MaxX, Tri.MaxPX);
+		S.MinPY = std::max(Tile.MinY, Tri.MinPY);
+		S.MaxPY = std::min(Tile.MaxY, Tri.MaxPY);
+		if (S.MinPX > S.MaxPX || S.MinPY > S.MaxPY) return false;
+		S.TileMinX = Tile.MinX;
+		S.TileMaxX = Tile.MaxX;
+
+		// Edge function E_ab(p) = (bx-ax)(py-ay) - (by-ay)(px-ax) = A*px + B*py + C
+		S.EA[0] = Y0 - Y1; S.EA[1] = Y1 - Y2; S.EA[2] = Y2 - Y0;
+		S.EB[0] = X1 - X0; S.EB[1] = X2 - X1; S.EB[2] = X0 - X2;
+		S.EC[0] = (Y1 - Y0) * X0 - (X1 - X0) * Y0;
+		S.EC[1] = (Y2 - Y1) * X1 - (X2 - X1) * Y1;
+		S.EC[2] = (Y0 - Y2) * X2 - (X0 - X2) * Y2;
+
+		// 화면 공간 평면: f(px,py) = f0 + dfdx*(px-X0) + dfdy*(py-Y0)
+		const float InvArea = 1.0f / Area;
+		auto PlaneGradient = [&](const float F[3], float& OutDx, float& OutDy)
+			{
+				const float F10 = F[I1] - F[0];
+				const float F20 = F[I2] - F[0];
+				OutDx = (F10 * (Y2 - Y0) - F20 * (Y1 - Y0)) * InvArea;
+				OutDy = (F20 * (X1 - X0) - F10 * (X2 - X0)) * InvArea;
+			};
+		PlaneGradient(Tri.InvW, S.WDx, S.WDy);
+		PlaneGradient(Tri.ZOverW, S.QDx, S.QDy);
+
+		S.X0 = X0; S.Y0 = Y0;
+		S.W0 = Tri.InvW[0];
+		S.Q0 = Tri.ZOverW[0];
+		S.MaxZView = Tri.MaxZView;
+		S.ZNear = Tri.ZNear;
+		S.InvRange = 1.0f / (Tri.ZFar - Tri.ZNear);
+		return true;
+	}
+
+	// ------------------------------------------------------------
+	// 삼각형 래스터 커널 (Scalar / SSE2 / SSE4.1 / AVX2 / AVX-512)
+	//  - 모든 변형이 같은 순서의 곱/합(FMA 없음)과 나눗셈을 쓰므로 기록 깊이가 비트 단위로 같다
+	//  - N픽셀 묶음은 행 끝에서 타일 안쪽으로 당겨 재처리 (min 누적이라 중복 기록해도 결과 동일, 타일 밖은 건드리지 않음)
+	//  - 타일이 묶음 폭보다 좁으면 한 단계 좁은 변형으로 넘긴다
+	// ------------------------------------------------------------
+	void RasterTriangle_Scalar(const FTriangleRasterSetup& S, float* Level0, int Stride)
+	{
+		for (int y = S.MinPY; y <= S.MaxPY; ++y)
+		{
+			float* Row = Level0 + size_t(y) * Stride;
+			const float CY = float(y) + 0.5f;
+			const float Ey0 = S.EB[0] * CY + S.EC[0];
+			const float Ey1 = S.EB[1] * CY + S.EC[1];
+			const float Ey2 = S.EB[2] * CY + S.EC[2];
+			// 픽셀 윗변(y) 기준 평면값. x는 0에서 시작하도록 상수항에 접어둔다
+			const float WRow = S.W0 - S.WDx * S.X0 + S.WDy * (float(y) - S.Y0);
+			const float QRow = S.Q0 - S.QDx * S.X0 + S.QDy * (float(y) - S.Y0);
+
+			for (int x = S.MinPX; x <= S.MaxPX; ++x)
+			{
+				const float PX = float(x);
+				const float CX = PX + 0.5f;
+				if (!(S.EA[0] * CX + Ey0 >= 0.0f && S.EA[1] * CX + Ey1 >= 0.0f && S.EA[2] * CX + Ey2 >= 0.0f)) continue;
+
+				// 픽셀 네 모서리의 뷰 z 중 최댓값 (보수적: 픽셀 안 어느 점보다도 멀다)
+				const float W00 = WRow + S.WDx * PX, Q00 = QRow + S.QDx * PX;
+				const float W10 = W00 + S.WDx, Q10 = Q00 + S.QDx;
+				const float W01 = W00 + S.WDy, Q01 = Q00 + S.QDy;
+				const float W11 = W10 + S.WDy, Q11 = Q10 + S.QDy;
+				float Z = std::max(
+					std::max(Q00 / std::max(W00, 1e-12f), Q10 / std::max(W10, 1e-12f)),
+					std::max(Q01 / std::max(W01, 1e-12f), Q11 / std::max(W11, 1e-12f)));
+				// 삼각형 위 어떤 점도 가장 먼 정점보다 멀 수는 없음 (모서리 외삽값 상한)
+				Z = std::min(Z, S.MaxZView);
+				Z = (Z - S.ZNear) * S.InvRange;
+				Z = std::min(std::max(Z, 0.0f), 1.0f);
+
+				Row[x] = std::min(Row[x], Z);
+			}
+		}
+	}
+
+	// SSE2 / SSE4.1 변형이 공유하는 4픽셀 묶음 계산 (SSE2 명령만 사용, 변형마다 다른 것은 저장 방식뿐)
+	struct FRasterQuadSSE
+	{
+		explicit FRasterQuadSSE(const FTriangleRasterSetup& InS)
+			: S(InS)
+			, LaneOffs(_mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f))
+			, Half(_mm_set1_ps(0.5f))
+			, Zero(_mm_setzero_ps())
+			, One(_mm_set1_ps(1.0f))
+			, MinWv(_mm_set1_ps(1e-12f))
+			, MinXv(_mm_set1_ps(float(InS.MinPX)))
+			, MaxXv(_mm_set1_ps(float(InS.MaxPX)))
+			, MaxZv(_mm_set1_ps(InS.MaxZView))
+			, NearV(_mm_set1_ps(InS.ZNear))
+			, InvRangeV(_mm_set1_ps(InS.InvRange))
+			, EAv0(_mm_set1_ps(InS.EA[0])), EAv1(_mm_set1_ps(InS.EA[1])), EAv2(_mm_set1_ps(InS.EA[2]))
+			, WDxV(_mm_set1_ps(InS.WDx)), WDyV(_mm_set1_ps(InS.WDy))
+			, QDxV(_mm_set1_ps(InS.QDx)), QDyV(_mm_set1_ps(InS.QDy))
+		{
+		}
+
+		void BeginRow(int y)
+		{
+			const float CY = float(y) + 0.5f;
+			Ey0 = _mm_set1_ps(S.EB[0] * CY + S.EC[0]);
+			Ey1 = _mm_set1_ps(S.EB[1] * CY + S.EC[1]);
+			Ey2 = _mm_set1_ps(S.EB[2] * CY + S.EC[2]);
+			WRow = _mm_set1_ps(S.W0 - S.WDx * S.X0 + S.WDy * (float(y) - S.Y0));
+			QRow = _mm_set1_ps(S.Q0 - S.QDx * S.X0 + S.QDy * (float(y) - S.Y0));
+		}
+
+		// XS 부터 4픽셀의 커버리지 마스크와 깊이. 덮는 픽셀이 없으면 false
+		bool Shade(int XS, __m128& OutInside, __m128& OutZ) const
+		{
+			const __m128 PX = _mm_add_ps(_mm_set1_ps(float(XS)), LaneOffs);
+			const __m128 CX = _mm_add_ps(PX, Half);
+
+			const __m128 E0 = _mm_add_ps(_mm_mul_ps(EAv0, CX), Ey0);
+			const __m128 E1 = _mm_add_ps(_mm_mul_ps(EAv1, CX), Ey1);
+			const __m128 E2 = _mm_add_ps(_mm_mul_ps(EAv2, CX), Ey2);
+			__m128 Inside = _mm_and_ps(_mm_cmpge_ps(E0, Zero), _mm_cmpge_ps(E1, Zero));
+			Inside = _mm_and_ps(Inside, _mm_cmpge_ps(E2, Zero));
+			Inside = _mm_and_ps(Inside, _mm_and_ps(_mm_cmpge_ps(PX, MinXv), _mm_cmple_ps(PX, MaxXv)));
+			if (_mm_movemask_ps(Inside) == 0) return false;
+
+			const __m128 W00 = _mm_add_ps(WRow, _mm_mul_ps(WDxV, PX));
+			const __m128 Q00 = _mm_add_ps(QRow, _mm_mul_ps(QDxV, PX));
+			const __m128 W10 = _mm_add_ps(W00, WDxV), Q10 = _mm_add_ps(Q00, QDxV);
+			const __m128 W01 = _mm_add_ps(W00, WDyV), Q01 = _mm_add_ps(Q00, QDyV);
+			const __m128 W11 = _mm_add_ps(W10, WDyV), Q11 = _mm_add_ps(Q10, QDyV);
+			__m128 Z = _mm_max_ps(
+				_mm_max_ps(_mm_div_ps(Q00, _mm_max_ps(W00, MinWv)), _mm_div_ps(Q10, _mm_max_ps(W10, MinWv))),
+				_mm_max_ps(_mm_div_ps(Q01, _mm_max_ps(W01, MinWv)), _mm_div_ps(Q11, _mm_max_ps(W11, MinWv))));
+			Z = _mm_min_ps(Z, MaxZv);
+			Z = _mm_mul_ps(_mm_sub_ps(Z, NearV), InvRangeV);
+			OutZ = _mm_min_ps(_mm_max_ps(Z, Zero), One);
+			OutInside = Inside;
+			return true;
+		}
+
+		const FTriangleRasterSetup& S;
+		const __m128 LaneOffs, Half, Zero, One, MinWv, MinXv, MaxXv, MaxZv, NearV, InvRangeV;
+		const __m128 EAv0, EAv1, EAv2, WDxV, WDyV, QDxV, QDyV;
+		__m128 Ey0, Ey1, Ey2, WRow, QRow;
+	};
+
+	void RasterTriangle_SSE2(const FTriangleRasterSetup& S, float* Level0, int Stride)
+	{
+		if (S.TileMaxX - S.TileMinX + 1 < 4)
+		{
+			RasterTriangle_Scalar(S, Level0, Stride);
+			return;
+		}
+
+		FRasterQuadSSE Quad(S);
+		for (int y = S.MinPY; y <= S.MaxPY; ++y)
+		{
+			float* Row = Level0 + size_t(y) * Stride;
+			Quad.BeginRow(y);
+			for (int x = S.MinPX; x <= S.MaxPX; x += 4)
+			{
+				const int XS = std::min(x, S.TileMaxX - 3);
+				__m128 Inside, Z;
+				if (!Quad.Shade(XS, Inside, Z)) continue;
+
+				const __m128 Cur = _mm_loadu_ps(Row + XS);
+				const __m128 New = _mm_min_ps(Cur, Z);
+				_mm_storeu_ps(Row + XS, _mm_or_ps(_mm_and_ps(Inside, New), _mm_andnot_ps(Inside, Cur)));
+			}
+		}
+	}
+
+	SIMD_TARGET_SSE41 void RasterTriangle_SSE41(const FTriangleRasterSetup& S, float* Level0, int Stride)
+	{
+		if (S.TileMaxX - S.TileMinX + 1 < 4)
+		{
+			RasterTriangle_Scalar(S, Level0, Stride);
+			return;
+		}
+
+		FRasterQuadSSE Quad(S);
+		for (int y = S.MinPY; y <= S.MaxPY; ++y)
+		{
+			float* Row = Level0 + size_t(y) * Stride;
+			Quad.BeginRow(y);
+			for (int x = S.MinPX; x <= S.MaxPX; x += 4)
+			{
+				const int XS = std::min(x, S.TileMaxX - 3);
+				__m128 Inside, Z;
+				if (!Quad.Shade(XS, Inside, Z)) continue;
+
+				const __m128 Cur = _mm_loadu_ps(Row + XS);
+				_mm_storeu_ps(Row + XS, _mm_blendv_ps(Cur, _mm_min_ps(Cur, Z), Inside));
+			}
+		}
+	}
+
+	SIMD_TARGET_AVX2 void RasterTriangle_AVX2(const FTriangleRasterSetup& S, float* Level0, int Stride)
+	{
+		if (S.TileMaxX - S.TileMinX + 1 < 8)
+		{
+			RasterTriangle_SSE41(S, Level0, Stride);
+			return;
+		}
+
+		const __m256 LaneOffs = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+		const __m256 Half = _mm256_set1_ps(0.5f);
+		const __m256 Zero = _mm256_setzero_ps();
+		const __m256 One = _mm256_set1_ps(1.0f);
+		const __m256 MinWv = _mm256_set1_ps(1e-12f);
+		const __m256 MinXv = _mm256_set1_ps(float(S.MinPX));
+		const __m256 MaxXv = _mm256_set1_ps(float(S.MaxPX));
+		const __m256 MaxZv = _mm256_set1_ps(S.MaxZView);
+		const __m256 NearV = _mm256_set1_ps(S.ZNear);
+		const __m256 InvRangeV = _mm256_set1_ps(S.InvRange);
+		const __m256 EAv0 = _mm256_set1_ps(S.EA[0]), EAv1 = _mm256_set1_ps(S.EA[1]), EAv2 = _mm256_set1_ps(S.EA[2]);
+		const __m256 WDxV = _mm256_set1_ps(S.WDx), WDyV = _mm256_set1_ps(S.WDy);
+		const __m256 QDxV = _mm256_set1_ps(S.QDx), QDyV = _mm256_set1_ps(S.QDy);
+
+		for (int y = S.MinPY; y <= S.MaxPY; ++y)
+		{
+			float* Row = Level0 + size_t(y) * Stride;
+			const float CY = float(y) + 0.5f;
+			const __m256 Ey0 = _mm256_set1_ps(S.EB[0] * CY + S.EC[0]);
+			const __m256 Ey1 = _mm256_set1_ps(S.EB[1] * CY + S.EC[1]);
+			const __m256 Ey2 = _mm256_set1_ps(S.EB[2] * CY + S.EC[2]);
+			const __m256 WRow = _mm256_set1_ps(S.W0 - S.WDx * S.X0 + S.WDy * (float(y) - S.Y0));
+			const __m256 QRow = _mm256_set1_ps(S.Q0 - S.QDx * S.X0 + S.QDy * (float(y) - S.Y0));
+
+			for (int x = S.MinPX; x <= S.MaxPX; x += 8)
+			{
+				const int XS = std::min(x, S.TileMaxX - 7);
+				const __m256 PX = _mm256_add_ps(_mm256_set1_ps(float(XS)), LaneOffs);
+				const __m256 CX = _mm256_add_ps(PX, Half);
+
+				const __m256 E0 = _mm256_add_ps(_mm256_mul_ps(EAv0, CX), Ey0);
+				const __m256 E1 = _mm256_add_ps(_mm256_mul_ps(EAv1, CX), Ey1);
+				const __m256 E2 = _mm256_add_ps(_mm256_mul_ps(EAv2, CX), Ey2);
+				__m256 Inside = _mm256_and_ps(_mm256_cmp_ps(E0, Zero, _CMP_GE_OQ), _mm256_cmp_ps(E1, Zero, _CMP_GE_OQ));
+				Inside = _mm256_and_ps(Inside, _mm256_cmp_ps(E2, Zero, _CMP_GE_OQ));
+				Inside = _mm256_and_ps(Inside, _mm256_and_ps(_mm256_cmp_ps(PX, MinXv, _CMP_GE_OQ), _mm256_cmp_ps(PX, MaxXv, _CMP_LE_OQ)));
+				if (_mm256_movemask_ps(Inside) == 0) continue;
+
+				const __m256 W00 = _mm256_add_ps(WRow, _mm256_mul_ps(WDxV, PX));
+				const __m256 Q00 = _mm256_add_ps(QRow, _mm256_mul_ps(QDxV, PX));
+				const __m256 W10 = _mm256_add_ps(W00, WDxV), Q10 = _mm256_add_ps(Q00, QDxV);
+				const __m256 W01 = _mm256_add_ps(W00, WDyV), Q01 = _mm256_add_ps(Q00, QDyV);
+				const __m256 W11 = _mm256_add_ps(W10, WDyV), Q11 = _mm256_add_ps(Q10, QDyV);
+				__m256 Z = _mm256_max_ps(
+					_mm256_max_ps(_mm256_div_ps(Q00, _mm256_max_ps(W00, MinWv)), _mm256_div_ps(Q10, _mm256_max_ps(W10, MinWv))),
+					_mm256_max_ps(_mm256_div_ps(Q01, _mm256_max_ps(W01, MinWv)), _mm256_div_ps(Q11, _mm256_max_ps(W11, MinWv))));
+				Z = _mm256_min_ps(Z, MaxZv);
+				Z = _mm256_mul_ps(_mm256_sub_ps(Z, NearV), InvRangeV);
+				Z = _mm256_min_ps(_mm256_max_ps(Z, Zero), One);
+
+				const __m256 Cur = _mm256_loadu_ps(Row + XS);
+				_mm256_storeu_ps(Row + XS, _mm256_blendv_ps(Cur, _mm256_min_ps(Cur, Z), Inside));
+			}
+		}
+	}
+
+	// 전체 마스크 max/min. GCC 12 의 _mm512_max_ps/_mm512_min_ps 는 내부 _mm512_undefined_ps 때문에
+	// -Wmaybe-uninitialized 오경고를 내서 maskz 형태로 쓴다 (마스크가 상수 전체라 같은 vmaxps/vminps 로 나온다)
+	SIMD_TARGET_AVX512 inline __m512 Max512(__m512 A, __m512 B) { return _mm512_maskz_max_ps(0xFFFF, A, B); }
+	SIMD_TARGET_AVX512 inline __m512 Min512(__m512 A, __m512 B) { return _mm512_maskz_min_ps(0xFFFF, A, B); }
+
+	SIMD_TARGET_AVX512 void RasterTriangle_AVX512(const FTriangleRasterSetup& S, float* Level0, int Stride)
+	{
+		if (S.TileMaxX - S.TileMinX + 1 < 16)
+		{
+			RasterTriangle_AVX2(S, Level0, Stride);
+			return;
+		}
+
+		const __m512 LaneOffs = _mm512_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f,
+			8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f);
+		const __m512 Half = _mm512_set1_ps(0.5f);
+		const __m512 Zero = _mm512_setzero_ps();
+		const __m512 One = _mm512_set1_ps(1.0f);
+		const __m512 MinWv = _mm512_set1_ps(1e-12f);
+		const __m512 MinXv = _mm512_set1_ps(float(S.MinPX));
+		const __m512 MaxXv = _mm512_set1_ps(float(S.MaxPX));
+		const __m512 MaxZv = _mm512_set1_ps(S.MaxZView);
+		const __m512 NearV = _mm512_set1_ps(S.ZNear);
+		const __m512 InvRangeV = _mm512_set1_ps(S.InvRange);
+		const __m512 EAv0 = _mm512_set1_ps(S.EA[0]), EAv1 = _mm512_set1_ps(S.EA[1]), EAv2 = _mm512_set1_ps(S.EA[2]);
+		const __m512 WDxV = _mm512_set1_ps(S.WDx), WDyV = _mm512_set1_ps(S.WDy);
+		const __m512 QDxV = _mm512_set1_ps(S.QDx), QDyV = _mm512_set1_ps(S.QDy);
+
+		for (int y = S.MinPY; y <= S.MaxPY; ++y)
+		{
+			float* Row = Level0 + size_t(y) * Stride;
+			const float CY = float(y) + 0.5f;
+			const __m512 Ey0 = _mm512_set1_ps(S.EB[0] * CY + S.EC[0]);
+			const __m512 Ey1 = _mm512_set1_ps(S.EB[1] * CY + S.EC[1]);
+			const __m512 Ey2 = _mm512_set1_ps(S.EB[2] * CY + S.EC[2]);
+			const __m512 WRow = _mm512_set1_ps(S.W0 - S.WDx * S.X0 + S.WDy * (float(y) - S.Y0));
+			const __m512 QRow = _mm512_set1_ps(S.Q0 - S.QDx * S.X0 + S.QDy * (float(y) - S.Y0));
+
+			for (int x = S.MinPX; x <= S.MaxPX; x += 16)
+			{
+				const int XS = std::min(x, S.TileMaxX - 15);
+				const __m512 PX = _mm512_add_ps(_mm512_set1_ps(float(XS)), LaneOffs);
+				const __m512 CX = _mm512_add_ps(PX, Half);
+
+				// 비교 결과를 마스크 레지스터로 받아 그대로 마스크 저장에 쓴다
+				__mmask16 Inside = _mm512_cmp_ps_mask(_mm512_add_ps(_mm512_mul_ps(EAv0, CX), Ey0), Zero, _CMP_GE_OQ);
+				Inside = _mm512_mask_cmp_ps_mask(Inside, _mm512_add_ps(_mm512_mul_ps(EAv1, CX), Ey1), Zero, _CMP_GE_OQ);
+				Inside = _mm512_mask_cmp_ps_mask(Inside, _mm512_add_ps(_mm512_mul_ps(EAv2, CX), Ey2), Zero, _CMP_GE_OQ);
+				Inside = _mm512_mask_cmp_ps_mask(Inside, PX, MinXv, _CMP_GE_OQ);
+				Inside = _mm512_mask_cmp_ps_mask(Inside, PX, MaxXv, _CMP_LE_OQ);
+				if (Inside == 0) continue;
+
+				const __m512 W00 = _mm512_add_ps(WRow, _mm512_mul_ps(WDxV, PX));
+				const __m512 Q00 = _mm512_add_ps(QRow, _mm512_mul_ps(QDxV, PX));
+				const __m512 W10 = _mm512_add_ps(W00, WDxV), Q10 = _mm512_add_ps(Q00, QDxV);
+				const __m512 W01 = _mm512_add_ps(W00, WDyV), Q01 = _mm512_add_ps(Q00, QDyV);
+				const __m512 W11 = _mm512_add_ps(W10, WDyV), Q11 = _mm512_add_ps(Q10, QDyV);
+				__m512 Z = Max512(
+					Max512(_mm512_div_ps(Q00, Max512(W00, MinWv)), _mm512_div_ps(Q10, Max512(W10, MinWv))),
+					Max512(_mm512_div_ps(Q01, Max512(W01, MinWv)), _mm512_div_ps(Q11, Max512(W11, MinWv))));
+				Z = Min512(Z, MaxZv);
+				Z = _mm512_mul_ps(_mm512_sub_ps(Z, NearV), InvRangeV);
+				Z = Min512(Max512(Z, Zero), One);
+
+				const __m512 Cur = _mm512_loadu_ps(Row + XS);
+				_mm512_mask_storeu_ps(Row + XS, Inside, Min512(Cur, Z));
+			}
+		}
+	}
+
+	using FRasterTriangleFn = void(*)(const FTriangleRasterSetup&, float*, int);
+	const TSimdKernel<FRasterTriangleFn> RasterTriangleKernel{
+		{ ESimdLevel::Scalar, &RasterTriangle_Scalar },
+		{ ESimdLevel::SSE2, &RasterTriangle_SSE2 },
+		{ ESimdLevel::SSE41, &RasterTriangle_SSE41 },
+		{ ESimdLevel::AVX2, &RasterTriangle_AVX2 },
+		{ ESimdLevel::AVX512, &RasterTriangle_AVX512 },
+	};
+
+	// ------------------------------------------------------------
+	// HZB 2x2 MAX 행 축소 커널 (출력 X 부터 DstWidth 까지)
+	//  - 입력 2행 x 2N열 → 출력 N텍셀. 넓은 변형은 stride 안에 들어오는 구간만 처리하고 나머지는 좁은 변형에 넘긴다
+	//  - 패딩 열까지 읽고 쓰지만 패딩 값은 다음 레벨의 패딩으로만 흘러간다
+	// ------------------------------------------------------------
+	void ReduceRowMax_Scalar(const float* R0, const float* R1, float* Out, int X, int DstWidth, int, int)
+	{
+		for (int x = X; x < DstWidth; ++x)
+			Out[x] = std::max(std::max(R0[2 * x], R1[2 * x]), std::max(R0[2 * x + 1], R1[2 * x + 1]));
+	}
+
+	// 출력 4텍셀 = 입력 2행 x 8열. 행/오프셋이 32바이트 정렬이라 정렬 load/store 사용
+	void ReduceRowMax_SSE2(const float* R0, const float* R1, float* Out, int X, int DstWidth, int, int)
+	{
+		for (int x = X; x < DstWidth; x += 4)
+		{
+			const __m128 M0 = _mm_max_ps(_mm_load_ps(R0 + 2 * x), _mm_load_ps(R1 + 2 * x));
+			const __m128 M1 = _mm_max_ps(_mm_load_ps(R0 + 2 * x + 4), _mm_load_ps(R1 + 2 * x + 4));
+			const __m128 Even = _mm_shuffle_ps(M0, M1, _MM_SHUFFLE(2, 0, 2, 0));
+			const __m128 Odd = _mm_shuffle_ps(M0, M1, _MM_SHUFFLE(3, 1, 3, 1));
+			_mm_store_ps(Out + x, _mm_max_ps(Even, Odd));
+		}
+	}
+
+	// 출력 8텍셀 = 입력 2행 x 16열. 128비트 레인 안에서 짝/홀을 모은 뒤 64비트 단위로 순서를 맞춘다
+	SIMD_TARGET_AVX2 void ReduceRowMax_AVX2(const float* R0, const float* R1, float* Out, int X, int DstWidth, int SrcStride, int DstStride)
+	{
+		int x = X;
+		for (; x < DstWidth && 2 * x + 16 <= SrcStride && x + 8 <= DstStride; x += 8)
+		{
+			const __m256 M0 = _mm256_max_ps(_mm256_load_ps(R0 + 2 * x), _mm256_load_ps(R1 + 2 * x));
+			const __m256 M1 = _mm256_max_ps(_mm256_load_ps(R0 + 2 * x + 8), _mm256_load_ps(R1 + 2 * x + 8));
+			const __m256 Even = _mm256_shuffle_ps(M0, M1, _MM_SHUFFLE(2, 0, 2, 0));
+			const __m256 Odd = _mm256_shuffle_ps(M0, M1, _MM_SHUFFLE(3, 1, 3, 1));
+			const __m256 Max = _mm256_max_ps(Even, Odd); // 0 1 4 5 | 2 3 6 7
+			_mm256_store_ps(Out + x, _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(Max), _MM_SHUFFLE(3, 1, 2, 0))));
+		}
+		ReduceRowMax_SSE2(R0, R1, Out, x, DstWidth, SrcStride, DstStride);
+	}
+
+	// 출력 16텍셀 = 입력 2행 x 32열. 두 레지스터에 걸친 짝/홀 수집은 permutex2var 한 번씩
+	SIMD_TARGET_AVX512 void ReduceRowMax_AVX512(const float* R0, const float* R1, float* Out, int X, int DstWidth, int SrcStride, int DstStride)
+	{
+		const __m512i EvenIdx = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+		const __m512i OddIdx = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+		int x = X;
+		for (; x < DstWidth && 2 * x + 32 <= SrcStride && x + 16 <= DstStride; x += 16)
+		{
+			// 행 시작은 32바이트 정렬까지만 보장되므로 비정렬 load/store
+			const __m512 M0 = Max512(_mm512_loadu_ps(R0 + 2 * x), _mm512_loadu_ps(R1 + 2 * x));
+			const __m512 M1 = Max512(_mm512_loadu_ps(R0 + 2 * x + 16), _mm512_loadu_ps(R1 + 2 * x + 16));
+			const __m512 Even = _mm512_permutex2var_ps(M0, EvenIdx, M1);
+			const __m512 Odd = _mm512_permutex2var_ps(M0, OddIdx, M1);
+			_mm512_storeu_ps(Out + x, Max512(Even, Odd));
+		}
+		ReduceRowMax_AVX2(R0, R1, Out, x, DstWidth, SrcStride, DstStride);
+	}
+
+	const TSimdKernel<FOcclusionGrid::FReduceRowFn> ReduceRowMaxKernel{
+		{ ESimdLevel::Scalar, &ReduceRowMax_Scalar },
+		{ ESimdLevel::SSE2, &ReduceRowMax_SSE2 },
+		{ ESimdLevel::AVX2, &ReduceRowMax_AVX2 },
+		{ ESimdLevel::AVX512, &ReduceRowMax_AVX512 },
+	};
+}
+
+void FOcclusionGrid::RasterizeTriangleDepthMin(const FOcclusionTriangle& Tri, const FOcclusionTile& Tile)
+{
+	FTriangleRasterSetup Setup;
+	if (!MakeTriangleRasterSetup(Tri, Tile, Setup)) return;
+	RasterTriangleKernel.Get()(Setup, GetLevelData(0), Levels[0].Stride);
+}
+
+void FOcclusionGrid::Initialize(int InWidth, int InHeight)
+{
+	InWidth = std::max(1, InWidth);
+	InHeight = std::max(1, InHeight);
+	if (InWidth == Width && InHeight == Height && NumLevels > 0) return;
+
+	Width = InWidth; Height = InHeight;
+
+	// 레벨 레이아웃: stride = 8의 배수 ≥ 너비 + 1, 다음 레벨은 올림 크기
+	size_t Offset = 0;
+	NumLevels = 0;
+	int W = Width, H = Height;
+	for (;;)
+	{
+		FLevel& Lv = Levels[NumLevels++];
+		Lv.Width = W;
+		Lv.Height = H;
+		Lv.Stride = (W + 1 + 7) & ~7;
+		Lv.Offset = Offset;
+		Offset += size_t(Lv.Stride) * size_t(H);
+
+		if ((W == 1 && H == 1) || NumLevels == MaxLevels) break;
+		W = (W + 1) / 2;
+		H = (H + 1) / 2;
+	}
+
+	// 해상도가 줄면 기존 저장소를 그대로 재사용
+	const size_t NumBlocks = Offset / 8;
+	if (Storage.size() < NumBlocks)
+		Storage.resize(NumBlocks, FDepthBlock{ { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f } });
+
+	Clear();
+}
+
+void FOcclusionGrid::BuildHZB()
+{
+	BuildHZBWith(ReduceRowMaxKernel.Get());
+}
+
+void FOcclusionGrid::BuildHZBWith(FReduceRowFn ReduceRow)
+{
+	for (int L = 0; L + 1 < NumLevels; ++L)
+	{
+		const FLevel& Src = Levels[L];
+		const FLevel& Dst = Levels[L + 1];
+		float* SrcData = GetLevelData(L);
+		float* DstData = GetLevelData(L + 1);
+
+		// 홀수 너비: 끝 열을 패딩 첫 칸에 복제해 마지막 2x2가 경계 값만 보도록
+		if (Src.Width & 1)
+		{
+			for (int y = 0; y < Src.Height; ++y)
+			{
+				float* Row = SrcData + size_t(y) * Src.Stride;
+				Row[Src.Width] = Row[Src.Width - 1];
+			}
+		}
+
+		for (int y = 0; y < Dst.Height; ++y)
+		{
+			// 홀수 높이: 마지막 행은 자기 자신과 짝
+			const float* R0 = SrcData + size_t(2 * y) * Src.Stride;
+			const float* R1 = SrcData + size_t(std::min(2 * y + 1, Src.Height - 1)) * Src.Stride;
+			float* Out = DstData + size_t(y) * Dst.Stride;
+			ReduceRow(R0, R1, Out, 0, Dst.Width, Src.Stride, Dst.Stride);
+		}
+	}
+}
+
+bool FOcclusionGrid::ValidateKernels(uint32 Seed, int32 Iterations, TArray<FKernelReport>& OutReports)
+{
+	std::mt19937 Rng(Seed);
+	auto Range = [&](float Lo, float Hi) { return std::uniform_real_distribution<float>(Lo, Hi)(Rng); };
+
+	bool bAllPassed = true;
+	for (int L = static_cast<int>(ESimdLevel::SSE2); L <= static_cast<int>(FSimd::GetDetectedLevel()); ++L)
+	{
+		const ESimdLevel Level = static_cast<ESimdLevel>(L);
+		if (!RasterTriangleKernel.HasVariant(Level) && !ReduceRowMaxKernel.HasVariant(Level)) continue;
+
+		const FRasterTriangleFn RasterFn = RasterTriangleKernel.GetVariant(Level);
+		const FReduceRowFn ReduceFn = ReduceRowMaxKernel.GetVariant(Level);
+		int32 RasterMismatches = 0, HZBMismatches = 0;
+
+		for (int32 Iter = 0; Iter < Iterations; ++Iter)
+		{
+			// NPOT, 1픽셀 폭, 타일보다 좁은 그리드까지 섞는다
+			const int W = 1 + int(Rng() % 300);
+			const int H = 1 + int(Rng() % 200);
+			FOcclusionGrid Ref, Test;
+			Ref.Initialize(W, H);
+			Test.Initialize(W, H);
+
+			// 폭이 제각각인 세로 띠 타일 (좁은 타일의 하위 변형 대체 경로도 검사)
+			TArray<FOcclusionTile> Tiles;
+			for (int X = 0; X < W;)
+			{
+				const int TileW = 1 + int(Rng() % 80);
+				Tiles.push_back({ X, 0, std::min(W - 1, X + TileW - 1), H - 1 });
+				X += TileW;
+			}
+
+			const int NumTriangles = 1 + int(Rng() % 24);
+			for (int t = 0; t < NumTriangles; ++t)
+			{
+				FOcclusionTriangle Tri;
+				float MinX = FLT_MAX, MinY = FLT_MAX, MaxX = -FLT_MAX, MaxY = -FLT_MAX;
+				Tri.MaxZView = 0.0f;
+				Tri.ZNear = 0.1f;
+				Tri.ZFar = 100.0f;
+				for (int v = 0; v < 3; ++v)
+				{
+					Tri.X[v] = Range(-20.0f, W + 20.0f);
+					Tri.Y[v] = Range(-20.0f, H + 20.0f);
+					const float ZView = Range(Tri.ZNear, Tri.ZFar);
+					Tri.InvW[v] = 1.0f / ZView;
+					Tri.ZOverW[v] = 1.0f;
+					Tri.MaxZView = std::max(Tri.MaxZView, ZView);
+					MinX = std::min(MinX, Tri.X[v]); MaxX = std::max(MaxX, Tri.X[v]);
+					MinY = std::min(MinY, Tri.Y[v]); MaxY = std::max(MaxY, Tri.Y[v]);
+				}
+				Tri.MinPX = std::max(0, int(std::floor(MinX)));
+				Tri.MinPY = std::max(0, int(std::floor(MinY)));
+				Tri.MaxPX = std::min(W - 1, int(std::ceil(MaxX)));
+				Tri.MaxPY = std::min(H - 1, int(std::ceil(MaxY)));
+
+				for (const FOcclusionTile& Tile : Tiles)
+				{
+					FTriangleRasterSetup Setup;
+					if (!MakeTriangleRasterSetup(Tri, Tile, Setup)) continue;
+					RasterTriangle_Scalar(Setup, Ref.GetLevelData(0), Ref.Levels[0].Stride);
+					RasterFn(Setup, Test.GetLevelData(0), Test.Levels[0].Stride);
+				}
+			}
+
+			auto LevelsMatch = [&](int FirstLevel, int LastLevel)
+			{
+				for (int Mip = FirstLevel; Mip <= LastLevel; ++Mip)
+					for (int y = 0; y < Ref.Levels[Mip].Height; ++y)
+						if (!std::equal(Ref.GetRow(Mip, y), Ref.GetRow(Mip, y) + Ref.Levels[Mip].Width, Test.GetRow(Mip, y)))
+							return false;
+				return true;
+			};
+			if (!LevelsMatch(0, 0)) ++RasterMismatches;
+
+			Ref.BuildHZBWith(&ReduceRowMax_Scalar);
+			Test.BuildHZBWith(ReduceFn);
+			if (!LevelsMatch(1, Ref.NumLevels - 1)) ++HZBMismatches;
+		}
+
+		bAllPassed &= RasterMismatches == 0 && HZBMismatches == 0;
+		OutReports.push_back({ Level, RasterMismatches, HZBMismatches });
+	}
+	return bAllPassed;
+}
+
+void FOcclusionCullingManagerCPU::SetupOccluderTriangles(const FCandidateDrawable& D, int GridW, int GridH,
+	TArray<float>& ClipScratch, TArray<FOcclusionTriangle>& OutTris)
+{
+	const FOccluderMesh& Mesh = *D.OccluderMesh;
+	const float GW = float(GridW);
+	const float GH = float(GridH);
+
+	// 정점 변환: 클립 x, y, w + 뷰 z (모두 로컬 위치에 선형이라 근평면 클리핑 때 그대로 보간 가능)
+	const size_t NumVerts = Mesh.Positions.size();
+	ClipScratch.resize(NumVerts * 4);
+	for (size_t i = 0; i < NumVerts; ++i)
+	{
+		const FVector& P = Mesh.Positions[i];
+		const float p[4] = { P.X, P.Y, P.Z, 1.0f };
+		float c[4], v[4];
+		MulPointRow(p, D.MeshWorldViewProj, c);
+		MulPointRow(p, D.MeshWorldView, v);
+		float* Out = &ClipScratch[i * 4];
+		Out[0] = c[0]; Out[1] = c[1]; Out[2] = c[3]; Out[3] = v[2];
+	}
+
+	const float NearZ = D.ZNear;
+	const float* V = ClipScratch.data();
+
+	for (size_t t = 0; t + 2 < Mesh.Indices.size(); t += 3)
+	{
+		const float* In[3] = {
+			V + size_t(Mesh.Indices[t + 0]) * 4,
+			V + size_t(Mesh.Indices[t + 1]) * 4,
+			V + size_t(Mesh.Indices[t + 2]) * 4 };
+
+		// 근평면(뷰 z >= ZNear)으로 자르기: 삼각형 → 최대 사각형
+		float Poly[4][4];
+		int NumPoly = 0;
+		int NumInside = 0;
+		for (int e = 0; e < 3; ++e)
+		{
+			const float* A = In[e];
+			const float* B = In[(e + 1) % 3];
+			const bool bAIn = A[3] >= NearZ;
+			const bool bBIn = B[3] >= NearZ;
+			if (bAIn)
+			{
+				std::copy(A, A + 4, Poly[NumPoly++]);
+				++NumInside;
+			}
+			if (bAIn != bBIn)
+			{
+				const float T = (NearZ - A[3]) / (B[3] - A[3]);
+				for (int k = 0; k < 4; ++k) Poly[NumPoly][k] = A[k] + (B[k] - A[k]) * T;
+				Poly[NumPoly][3] = NearZ;
+				++NumPoly;
+			}
+		}
+		if (NumInside == 0 || NumPoly < 3) continue;
+
+		// 그리드 좌표로 투영
+		float PX[4], PY[4], PInvW[4], PZOverW[4];
+		bool bValid = true;
+		for (int k = 0; k < NumPoly; ++k)
+		{
+			const float W = Poly[k][2];
+			if (W <= KINDA_SMALL_NUMBER) { bValid = false; break; }
+			const float InvW = 1.0f / W;
+			PX[k] = (Poly[k][0] * InvW * 0.5f + 0.5f) * GW;
+			PY[k] = (Poly[k][1] * InvW * 0.5f + 0.5f) * GH;
+			PInvW[k] = InvW;
+			PZOverW[k] = Poly[k][3] * InvW;
+		}
+		if (!bValid) continue;
+
+		// 팬 분할
+		for (int k = 1; k + 1 < NumPoly; ++k)
+		{
+			const int C[3] = { 0, k, k + 1 };
+			FOcclusionTriangle Tri;
+			for (int j = 0; j < 3; ++j)
+			{
+				Tri.X[j] = PX[C[j]];
+				Tri.Y[j] = PY[C[j]];
+				Tri.InvW[j] = PInvW[C[j]];
+				Tri.ZOverW[j] = PZOverW[C[j]];
+			}
+			Tri.MaxZView = std::max({ Poly[0][3], Poly[k][3], Poly[k + 1][3] });
+			Tri.ZNear = D.ZNear;
+			Tri.ZFar = D.ZFar;
+
+			// 픽셀 중심(x+0.5)이 삼각형 bbox 안에 들어오는 범위 (비닝/래스터 공용)
+			Tri.MinPX = std::max(0, int(std::ceil(std::min({ Tri.X[0], Tri.X[1], Tri.X[2] }) - 0.5f)));
+			Tri.MaxPX = std::min(GridW - 1, int(std::floor(std::max({ Tri.X[0], Tri.X[1], Tri.X[2] }) - 0.5f)));
+			Tri.MinPY = std::max(0, int(std::ceil(std::min({ Tri.Y[0], Tri.Y[1], Tri.Y[2] }) - 0.5f)));
+			Tri.MaxPY = std::min(GridH - 1, int(std::floor(std::max({ Tri.Y[0], Tri.Y[1], Tri.Y[2] }) - 0.5f)));
+			if (Tri.MinPX > Tri.MaxPX || Tri.MinPY > Tri.MaxPY) continue;
+
+			OutTris.push_back(Tri);
+		}
+	}
+}
 
+bool FOcclusionCullingManagerCPU::SetupOccluderRect(const FCandidateDrawable& D, int ViewW, int ViewH, int GW, int GH,
+	FOcclusionRectSplat& OutRect)
+{
 	// --- 튜닝 파라미터 ---
 	const float ErodeScale = 0.5f;     // 0.5배 축소
-	const int   Dilate = 1;        // 경계 1px 팽창
 	const int   MinPxEdge = 8;        // 너무 작은 사각형은 erosion 스킵
 	const float MaxCover = 0.6f;     // 화면의 60% 이상 덮으면 erosion 스킵
 
-	for (const auto& D : Occluders)
+	FOcclusionRect R;
+	if (!ComputeRectAndMinZ(D, ViewW, ViewH, R))
+		return false;
+
+	int minPX = (int)std::floor(R.MinX * GW);
+	int minPY = (int)std::floor(R.MinY * GH);
+	int maxPX = (int)std::ceil(R.MaxX * GW) - 1;
+	int maxPY = (int)std::ceil(R.MaxY * GH) - 1;
+
+	// --- 화면 사각형 erosion(오클루더 영향 완화) ---
+	int w = std::max(0, maxPX - minPX + 1);
+	int h = std::max(0, maxPY - minPY + 1);
+	const bool bigCover =
+		(w >= int(MaxCover * GW)) || (h >= int(MaxCover * GH));
+	if (ErodeScale < 1.0f && w >= MinPxEdge && h >= MinPxEdge && !bigCover)
+	{
+		const float cx = 0.5f * float(minPX + maxPX);
+		const float cy = 0.5f * float(minPY + maxPY);
+		const float hw = 0.5f * float(w) * ErodeScale;
+		const float hh = 0.5f * float(h) * ErodeScale;
+
+		minPX = int(std::floor(cx - hw));
+		maxPX = int(std::ceil(cx + hw));
+		minPY = int(std::floor(cy - hh));
+		maxPY = int(std::ceil(cy + hh));
+	}
+
+	// 화면 경계 클램프
+	minPX = std::max(0, std::min(GW - 1, minPX));
+	minPY = std::max(0, std::min(GH - 1, minPY));
+	maxPX = std::max(0, std::min(GW - 1, maxPX));
+	maxPY = std::max(0, std::min(GH - 1, maxPY));
+	if (minPX > maxPX || minPY > maxPY) return false;
+
+	OutRect = { minPX, minPY, maxPX, maxPY, R.MaxZ };
+	return true;
+}
+
+void FOcclusionCullingManagerCPU::UpdateTiles(int GW, int GH)
+{
+	if (GW == TiledWidth && GH == TiledHeight) return;
+	TiledWidth = GW;
+	TiledHeight = GH;
+
+	// 마지막 열/행 타일이 나머지를 흡수 → 모든 타일 너비가 TileWidth 이상(그리드가 더 좁으면 그리드 너비)
+	TilesX = std::max(1, GW / TileWidth);
+	TilesY = std::max(1, GH / TileHeight);
+
+	Tiles.clear();
+	Tiles.reserve(size_t(TilesX * TilesY));
+	for (int ty = 0; ty < TilesY; ++ty)
 	{
+		for (int tx = 0; tx < TilesX; ++tx)
+		{
+			FOcclusionTile T;
+			T.MinX = tx * TileWidth;
+			T.MinY = ty * TileHeight;
+			T.MaxX = (tx == TilesX - 1) ? GW - 1 : (tx + 1) * TileWidth - 1;
+			T.MaxY = (ty == TilesY - 1) ? GH - 1 : (ty + 1) * TileHeight - 1;
+			Tiles.push_back(T);
+		}
+	}
+	TileBins.resize(Tiles.size());
+}
+
+void FOcclusionCullingManagerCPU::SelectOccluders(const TArray<FCandidateDrawable>& Candidates, TArray<FCandidateDrawable>& OutOccluders)
+{
+	FScopeCycleCounter SelectCounter;
+
+	Stats = FOcclusionStats();
+	Stats.Candidates = static_cast<uint32>(Candidates.size());
+	OutOccluders.clear();
+
+	const FOccluderSelectionSettings& S = SelectionSettings;
+	const float GW = float(Grid.GetWidth());
+	const float GH = float(Grid.GetHeight());
+
+	// 1) 점수 계산: 투영 사각형 넓이(px^2)에 가까울수록 큰 가중치
+	OccluderScores.clear();
+	for (int32 i = 0; i < static_cast<int32>(Candidates.size()); ++i)
+	{
+		// 재투영 모드: 지난 프레임에 가려졌던 것은 깊이에 기여하지 않았으므로 다시 그리지 않음
+		if (bHistoryUsable)
+		{
+			const uint32 Id = Candidates[i].ActorIndex;
+			const TArray<uint8_t>& WasVisible = ActiveHistory->WasVisible;
+			if (Id < WasVisible.size() && WasVisible[Id] == 0)
+			{
+				++Stats.SkippedHidden;
+				continue;
+			}
+		}
+
 		FOcclusionRect R;
-		if (!ComputeRectAndMinZ(D, ViewW, ViewH, R))
+		if (!ComputeRectAndMinZ(Candidates[i], 0, 0, R))
+		{
+			++Stats.SkippedSmall;
 			continue;
+		}
 
-		int minPX = (int)std::floor(R.MinX * GW);
-		int minPY = (int)std::floor(R.MinY * GH);
-		int maxPX = (int)std::ceil(R.MaxX * GW) - 1;
-		int maxPY = (int)std::ceil(R.MaxY * GH) - 1;
+		const float PxW = (R.MaxX - R.MinX) * GW;
+		const float PxH = (R.MaxY - R.MinY) * GH;
+		const float Area = PxW * PxH;
+		if (std::min(PxW, PxH) < S.MinScreenThickness || Area < S.MinScreenArea)
+		{
+			++Stats.SkippedSmall;
+			continue;
+		}
 
-		// --- 화면 사각형 erosion(오클루더 영향 완화) ---
-		int w = std::max(0, maxPX - minPX + 1);
-		int h = std::max(0, maxPY - minPY + 1);
-		const bool bigCover =
-			(w >= int(MaxCover * GW)) || (h >= int(MaxCover * GH));
-		if (ErodeScale < 1.0f && w >= MinPxEdge && h >= MinPxEdge && !bigCover)
+		const float Nearness = 1.0f - R.MinZ;
+		OccluderScores.push_back({ Area * std::pow(Nearness, S.DepthWeight), i });
+	}
+
+	// 2) 점수 내림차순 (동점은 후보 순서) → 예산 안에서 채택. 큰 메시가 예산을 넘으면 건너뛰고 더 작은 것으로 채운다
+	std::sort(OccluderScores.begin(), OccluderScores.end(), [](const FOccluderScore& A, const FOccluderScore& B)
 		{
-			const float cx = 0.5f * float(minPX + maxPX);
-			const float cy = 0.5f * float(minPY + maxPY);
-			const float hw = 0.5f * float(w) * ErodeScale;
-			const float hh = 0.5f * float(h) * ErodeScale;
+			return A.Score != B.Score ? A.Score > B.Score : A.Index < B.Index;
+		});
 
-			minPX = int(std::floor(cx - hw));
-			maxPX = int(std::ceil(cx + hw));
-			minPY = int(std::floor(cy - hh));
-			maxPY = int(std::ceil(cy + hh));
+	uint32 UsedTriangles = 0;
+	uint32 UsedRects = 0;
+	for (const FOccluderScore& Scored : OccluderScores)
+	{
+		const FCandidateDrawable& D = Candidates[Scored.Index];
+		if (D.OccluderMesh)
+		{
+			const uint32 Cost = uint32(D.OccluderMesh->NumTriangles());
+			if (UsedTriangles + Cost > uint32(std::max(0, S.MaxTriangles)))
+			{
+				++Stats.SkippedBudget;
+				continue;
+			}
+			UsedTriangles += Cost;
+		}
+		else
+		{
+			if (UsedRects >= uint32(std::max(0, S.MaxRects)))
+			{
+				++Stats.SkippedBudget;
+				continue;
+			}
+			++UsedRects;
 		}
+		OutOccluders.push_back(D);
+	}
 
+	Stats.SelectedOccluders = static_cast<uint32>(OutOccluders.size());
+	Stats.OccluderTriangles = UsedTriangles;
+	Stats.OccluderRects = UsedRects;
+	Stats.SelectMs = FPlatformTime::ToMilliseconds(SelectCounter.Finish());
+}
 
-		// 화면 경계 클램프
-		minPX = std::max(0, std::min(GW - 1, minPX));
-		minPY = std::max(0, std::min(GH - 1, minPY));
-		maxPX = std::max(0, std::min(GW - 1, maxPX));
-		maxPY = std::max(0, std::min(GH - 1, maxPY));
-		if (minPX > maxPX || minPY > maxPY) continue;
+void FOcclusionCullingManagerCPU::BuildHZB()
+{
+	FScopeCycleCounter HZBCounter;
+	Grid.BuildHZB();
+	Stats.HZBMs = FPlatformTime::ToMilliseconds(HZBCounter.Finish());
+}
+
+void FOcclusionCullingManagerCPU::BuildOccluderDepth(
+	const TArray<FCandidateDrawable>& Occluders, int ViewW, int ViewH)
+{
+	FScopeCycleCounter RasterCounter;
+	Grid.Clear();
+
+	const int GW = Grid.GetWidth();
+	const int GH = Grid.GetHeight();
+	if (GW <= 0 || GH <= 0) return;
+	UpdateTiles(GW, GH);
+
+	// 1) 오클루더 셋업(변환/근평면 클리핑/투영) - 청크 단위 병렬
+	//    청크 결과를 청크 순서대로 이어붙이므로 최종 순서는 오클루더 순서 그대로 (스레드 수와 무관)
+	const int32 NumOccluders = static_cast<int32>(Occluders.size());
+	const int32 ChunkCount = FJobSystem::GetChunkCount(NumOccluders, OccluderSetupMinBatch);
+	if (SetupChunks.size() < size_t(ChunkCount)) SetupChunks.resize(size_t(ChunkCount));
+
+	FJobSystem::ParallelForChunks(ChunkCount, [&](int32 Chunk)
+	{
+		FOccluderSetupChunk& Out = SetupChunks[Chunk];
+		Out.Triangles.clear();
+		Out.Rects.clear();
+
+		const int32 Begin = static_cast<int32>(static_cast<int64>(NumOccluders) * Chunk / ChunkCount);
+		const int32 End = static_cast<int32>(static_cast<int64>(NumOccluders) * (Chunk + 1) / ChunkCount);
+		for (int32 i = Begin; i < End; ++i)
+		{
+			const FCandidateDrawable& D = Occluders[i];
+
+			// 오클루더 메시가 있으면 삼각형 단위로 정확히 그린다
+			if (D.OccluderMesh)
+			{
+				SetupOccluderTriangles(D, GW, GH, Out.ClipScratch, Out.Triangles);
+				continue;
+			}
+
+			FOcclusionRectSplat R;
+			if (SetupOccluderRect(D, ViewW, ViewH, GW, GH, R))
+				Out.Rects.push_back(R);
+		}
+	});
+
+	Triangles.clear();
+	Rects.clear();
+	for (int32 Chunk = 0; Chunk < ChunkCount; ++Chunk)
+	{
+		const FOccluderSetupChunk& C = SetupChunks[Chunk];
+		Triangles.insert(Triangles.end(), C.Triangles.begin(), C.Triangles.end());
+		Rects.insert(Rects.end(), C.Rects.begin(), C.Rects.end());
+	}
+
+	// 2) 타일 비닝 (픽셀 bbox가 걸치는 모든 타일에 등록)
+	for (FOcclusionTileBin& Bin : TileBins)
+	{
+		Bin.Triangles.clear();
+		Bin.Rects.clear();
+	}
+	auto ForEachTile = [&](int MinPX, int MinPY, int MaxPX, int MaxPY, auto&& Fn)
+	{
+		const int TX0 = std::min(TilesX - 1, MinPX / TileWidth);
+		const int TX1 = std::min(TilesX - 1, MaxPX / TileWidth);
+		const int TY0 = std::min(TilesY - 1, MinPY / TileHeight);
+		const int TY1 = std::min(TilesY - 1, MaxPY / TileHeight);
+		for (int ty = TY0; ty <= TY1; ++ty)
+			for (int tx = TX0; tx <= TX1; ++tx)
+				Fn(TileBins[size_t(ty * TilesX + tx)]);
+	};
+	for (uint32 i = 0; i < uint32(Rects.size()); ++i)
+	{
+		const FOcclusionRectSplat& R = Rects[i];
+		ForEachTile(R.MinPX, R.MinPY, R.MaxPX, R.MaxPY, [i](FOcclusionTileBin& Bin) { Bin.Rects.push_back(i); });
+	}
+	for (uint32 i = 0; i < uint32(Triangles.size()); ++i)
+	{
+		const FOcclusionTriangle& T = Triangles[i];
+		ForEachTile(T.MinPX, T.MinPY, T.MaxPX, T.MaxPY, [i](FOcclusionTileBin& Bin) { Bin.Triangles.push_back(i); });
+	}
+
+	// 3) 타일별 병렬 래스터
+	//    타일끼리 픽셀이 겹치지 않아 잠금이 필요 없고, min 누적은 순서와 무관하므로 결과가 항상 같다
+	FJobSystem::ParallelForChunks(static_cast<int32>(Tiles.size()), [&](int32 TileIndex)
+	{
+		const FOcclusionTile& Tile = Tiles[TileIndex];
+		const FOcclusionTileBin& Bin = TileBins[TileIndex];
 
-		Grid.RasterizeRectDepthMin(minPX, minPY, maxPX, maxPY, R.MaxZ);
+		for (uint32 RectIndex : Bin.Rects)
+		{
+			const FOcclusionRectSplat& R = Rects[RectIndex];
+			Grid.RasterizeRectDepthMin(
+				std::max(R.MinPX, Tile.MinX), std::max(R.MinPY, Tile.MinY),
+				std::min(R.MaxPX, Tile.MaxX), std::min(R.MaxPY, Tile.MaxY), R.MaxZ);
+		}
+		for (uint32 TriIndex : Bin.Triangles)
+			Grid.RasterizeTriangleDepthMin(Triangles[TriIndex], Tile);
+	});
+
+	Stats.RasterMs = FPlatformTime::ToMilliseconds(RasterCounter.Finish());
+
+	// 4) 시간 재투영: 이번 래스터 결과를 보관한 뒤 지난 프레임 깊이를 덧그림
+	if (ActiveHistory)
+	{
+		FScopeCycleCounter ReprojectCounter;
+		CaptureRasterDepth();
+		if (bHistoryUsable)
+			ReprojectHistory(*ActiveHistory);
+		Stats.ReprojectMs = FPlatformTime::ToMilliseconds(ReprojectCounter.Finish());
 	}
 }
 
-// 2) 후보 가시성 판정(HZB 샘플)
-void FOcclusionCullingManagerCPU::TestOcclusion(const TArray<FCandidateDrawable>& Candidates, int ViewW, int ViewH, TArray<uint8_t>& OutVisibleFlags)
+void FOcclusionCullingManagerCPU::SetTemporalReprojectionEnabled(bool bEnabled)
+{
+	if (bTemporalReprojection == bEnabled) return;
+	bTemporalReprojection = bEnabled;
+	++SettingsRevision;
+	InvalidateHistory();
+}
+
+void FOcclusionCullingManagerCPU::SetSelectionSettings(const FOccluderSelectionSettings& InSettings)
+{
+	if (SelectionSettings == InSettings) return;
+	SelectionSettings = InSettings;
+	++SettingsRevision;
+}
+
+void FOcclusionCullingManagerCPU::InvalidateHistory()
+{
+	for (auto& Pair : Histories)
+		Pair.second.bValid = false;
+}
+
+void FOcclusionCullingManagerCPU::BeginView(const void* ViewKey, uint32 ViewPass, uint32 SceneGeneration,
+	const FMatrix& View, const FMatrix& Proj, float ZNear, float ZFar)
+{
+	CurView = View;
+	CurViewProj = View * Proj;
+	CurZNear = ZNear;
+	CurZFar = ZFar;
+	CurViewPass = ViewPass;
+	CurSceneGeneration = SceneGeneration;
+
+	ActiveHistory = bTemporalReprojection ? &Histories[ViewKey] : nullptr;
+	if (!ActiveHistory)
+	{
+		bHistoryUsable = false;
+		return;
+	}
+
+	// 장면이 바뀌었거나 직전 패스의 것이 아니면(오클루전 꺼짐/캐시로 건너뜀) 버린다
+	FOcclusionHistory& History = *ActiveHistory;
+	if (History.SceneGeneration != SceneGeneration || History.ViewPass + 1 != ViewPass)
+	{
+		History.bValid = false;
+	}
+	bHistoryUsable = History.bValid
+		&& History.GridWidth == Grid.GetWidth() && History.GridHeight == Grid.GetHeight()
+		&& History.ZNear == ZNear && History.ZFar == ZFar;
+}
+
+void FOcclusionCullingManagerCPU::EndView(const TArray<uint8_t>& VisibleFlags)
+{
+	if (!ActiveHistory) return;
+
+	FOcclusionHistory& History = *ActiveHistory;
+	ActiveHistory = nullptr;
+	bHistoryUsable = false;
+	History.ViewPass = CurViewPass;
+	History.SceneGeneration = CurSceneGeneration;
+
+	// 역행렬이 없으면 다음 프레임에 재투영 불가
+	History.bValid = InvertMatrix4(CurViewProj, History.InvViewProj);
+	if (!History.bValid) return;
+
+	// 버퍼를 맞바꿔 재할당 없이 보관
+	std::swap(History.Depth, PendingDepth);
+	History.GridWidth = Grid.GetWidth();
+	History.GridHeight = Grid.GetHeight();
+	History.Width = (History.GridWidth + 1) / 2;
+	History.Height = (History.GridHeight + 1) / 2;
+	History.View = CurView;
+	History.ZNear = CurZNear;
+	History.ZFar = CurZFar;
+	History.WasVisible = VisibleFlags;
+}
+
+void FOcclusionCullingManagerCPU::CaptureRasterDepth()
+{
+	const int GW = Grid.GetWidth();
+	const int GH = Grid.GetHeight();
+	const int HW = (GW + 1) / 2;
+	const int HH = (GH + 1) / 2;
+	PendingDepth.resize(size_t(HW) * HH);
+
+	for (int y = 0; y < HH; ++y)
+	{
+		const float* R0 = Grid.GetRow(0, 2 * y);
+		const float* R1 = Grid.GetRow(0, std::min(2 * y + 1, GH - 1));
+		float* Out = &PendingDepth[size_t(y) * HW];
+		for (int x = 0; x < HW; ++x)
+		{
+			const int X0 = 2 * x;
+			const int X1 = std::min(2 * x + 1, GW - 1);
+			Out[x] = std::max(std::max(R0[X0], R0[X1]), std::max(R1[X0], R1[X1]));
+		}
+	}
+}
+
+void FOcclusionCullingManagerCPU::ReprojectHistory(const FOcclusionHistory& History)
+{
+	const int GW = Grid.GetWidth();
+	const int GH = Grid.GetHeight();
+	const int HW = History.Width;
+	const int HH = History.Height;
+	if (History.Depth.size() != size_t(HW) * HH) return;
+
+	// 1) 블록 코너 격자: 지난 뷰의 광선을 새 클립 공간/뷰 z 의 z-선형식으로
+	const int CW = HW + 1;
+	const int CH = HH + 1;
+	ReprojectCorners.resize(size_t(CW) * CH);
+	for (int cy = 0; cy < CH; ++cy)
+	{
+		const float V = float(std::min(2 * cy, GH)) / float(GH);
+		for (int cx = 0; cx < CW; ++cx)
+		{
+			const float U = float(std::min(2 * cx, GW)) / float(GW);
+			FReprojectCorner& C = ReprojectCorners[size_t(cy) * CW + cx];
+			C.bValid = false;
+
+			// 광선 위 두 점 (NDC z = 0, 0.5) → 월드
+			float A[4], B[4];
+			const float NA[4] = { U * 2.0f - 1.0f, V * 2.0f - 1.0f, 0.0f, 1.0f };
+			const float NB[4] = { NA[0], NA[1], 0.5f, 1.0f };
+			MulPointRow(NA, History.InvViewProj, A);
+			MulPointRow(NB, History.InvViewProj, B);
+			if (std::fabs(A[3]) < 1e-12f || std::fabs(B[3]) < 1e-12f) continue;
+			for (int k = 0; k < 3; ++k) { A[k] /= A[3]; B[k] /= B[3]; }
+			A[3] = B[3] = 1.0f;
+
+			float VA[4], VB[4];
+			MulPointRow(A, History.View, VA);
+			MulPointRow(B, History.View, VB);
+			const float DZ = VB[2] - VA[2];
+			if (std::fabs(DZ) < 1e-12f) continue;
+
+			// P(z) = O + D*z (z = 지난 뷰 z)
+			float O[4], D[4];
+			for (int k = 0; k < 3; ++k)
+			{
+				D[k] = (B[k] - A[k]) / DZ;
+				O[k] = A[k] - D[k] * VA[2];
+			}
+			O[3] = 1.0f; D[3] = 0.0f;
+
+			float VO[4], VD[4];
+			MulPointRow(O, CurViewProj, C.ClipO);
+			MulPointRow(D, CurViewProj, C.ClipD);
+			MulPointRow(O, CurView, VO);
+			MulPointRow(D, CurView, VD);
+			C.ViewZO = VO[2];
+			C.ViewZD = VD[2];
+			C.bValid = true;
+		}
+	}
+
+	// 2) 블록마다 네 코너를 옮기고, 안쪽 사각형에 완전히 들어간 픽셀에 가장 먼 새 깊이 기록
+	const float Inset = 0.5f - 1e-3f;   // 픽셀 전체가 블록 안 (정지 카메라에서 부동소수 오차로 빠지지 않게 약간 여유)
+	const float OldRange = History.ZFar - History.ZNear;
+	const float InvNewRange = 1.0f / (CurZFar - CurZNear);
+	uint32 Texels = 0;
+
+	for (int y = 0; y < HH; ++y)
+	{
+		const float* Row = &History.Depth[size_t(y) * HW];
+		for (int x = 0; x < HW; ++x)
+		{
+			const float D01 = Row[x];
+			if (D01 >= 1.0f) continue;   // 구멍 (지난 프레임에 아무 오클루더도 없던 곳)
+
+			const float ZOld = History.ZNear + D01 * OldRange;
+			const FReprojectCorner* Corners[4] = {
+				&ReprojectCorners[size_t(y) * CW + x],
+				&ReprojectCorners[size_t(y) * CW + x + 1],
+				&ReprojectCorners[size_t(y + 1) * CW + x],
+				&ReprojectCorners[size_t(y + 1) * CW + x + 1] };
+
+			float SX[4], SY[4];
+			float MaxZ = 0.0f;
+			bool bValid = true;
+			for (int k = 0; k < 4 && bValid; ++k)
+			{
+				const FReprojectCorner& C = *Corners[k];
+				const float W = C.ClipO[3] + ZOld * C.ClipD[3];
+				const float ZNew = C.ViewZO + ZOld * C.ViewZD;
+				if (!C.bValid || W <= KINDA_SMALL_NUMBER || ZNew < CurZNear) { bValid = false; break; }
+
+				const float InvW = 1.0f / W;
+				SX[k] = ((C.ClipO[0] + ZOld * C.ClipD[0]) * InvW * 0.5f + 0.5f) * GW;
+				SY[k] = ((C.ClipO[1] + ZOld * C.ClipD[1]) * InvW * 0.5f + 0.5f) * GH;
+				MaxZ = std::max(MaxZ, ZNew);
+			}
+			if (!bValid) continue;
+
+			// 코너 순서: (0,0) (1,0) (0,1) (1,1) → 안쪽 사각형 (뒤집히면 버림)
+			const float MinX = std::max(SX[0], SX[2]);
+			const float MaxX = std::min(SX[1], SX[3]);
+			const float MinY = std::max(SY[0], SY[1]);
+			const float MaxY = std::min(SY[2], SY[3]);
+
+			const int MinPX = std::max(0, int(std::ceil(MinX - 0.5f + Inset)));
+			const int MaxPX = std::min(GW - 1, int(std::floor(MaxX - 0.5f - Inset)));
+			const int MinPY = std::max(0, int(std::ceil(MinY - 0.5f + Inset)));
+			const int MaxPY = std::min(GH - 1, int(std::floor(MaxY - 0.5f - Inset)));
+			if (MinPX > MaxPX || MinPY > MaxPY) continue;
+
+			const float Z01 = std::max(0.0f, std::min(1.0f, (MaxZ - CurZNear) * InvNewRange));
+			Grid.RasterizeRectDepthMin(MinPX, MinPY, MaxPX, MaxPY, Z01);
+			++Texels;
+		}
+	}
+	Stats.ReprojectedTexels = Texels;
+}
+
+// 후보 하나의 이번 프레임 판정 (그리드 읽기만 하므로 스레드 안전)
+uint8_t FOcclusionCullingManagerCPU::ClassifyCandidate(const FCandidateDrawable& D, int ViewW, int ViewH) const
 {
 	const float eps = 2e-3f;  // 1차 바이어스
 	const float eps2 = 2 * eps;  // 레벨0 재검증 바이어스(조금 더 큼)
+
+	FOcclusionRect R;
+	if (!ComputeRectAndMinZ(D, ViewW, ViewH, R))
+		return TestResult_Offscreen;
+
+	const float rw = std::max(0.0f, R.MaxX - R.MinX);
+	const float rh = std::max(0.0f, R.MaxY - R.MinY);
+	const float pxW = rw * GetGrid().GetWidth();
+	const float pxH = rh * GetGrid().GetHeight();
+
+	// --- 작은 사각형 가드: 한 변이라도 2px 미만이면 컬링하지 않음 ---
+	if (std::min(pxW, pxH) < 2.0f)
+		return TestResult_TooSmall;
+
+	// --- 보수적 mip 선택 ---
+	int mip = std::max(0, Grid.ChooseMip(rw, rh) - 1);
+	if (pxW < 48.0f || pxH < 48.0f)
+		mip = std::max(0, mip - 1);
+
+	// --- MAX HZB 적응형 샘플 ---
+	const float hzbMax = Grid.SampleMaxRectAdaptive(R.MinX, R.MinY, R.MaxX, R.MaxY, mip);
+
+	bool occluded = ((hzbMax + eps) <= R.MinZ);
+
+	// --- 레벨0 정밀 재검증(occluded일 때만) ---
+	if (occluded)
+	{
+		if (!Grid.FullyOccludedAtLevel0(R.MinX, R.MinY, R.MaxX, R.MaxY, R.MinZ, eps2))
+			occluded = false;
+	}
+	return occluded ? TestResult_Occluded : TestResult_Visible;
+}
+
+// 2) 후보 가시성 판정(HZB 샘플)
+void FOcclusionCullingManagerCPU::TestOcclusion(const TArray<FCandidateDrawable>& Candidates, int ViewW, int ViewH, TArray<uint8_t>& OutVisibleFlags)
+{
+	FScopeCycleCounter TestCounter;
+
 	// --- 크기 보장 ---
 	uint32_t maxId = 0;
 	for (auto& c : Candidates) maxId = std::max(maxId, c.ActorIndex);
@@ -152,12 +1352,23 @@ void FOcclusionCullingManagerCPU::TestOcclusion(const TArray<FCandidateDrawable>
 	if (OccludedStreak.size() <= maxId) OccludedStreak.resize(maxId + 1, 0);
 	if (LastState.size() <= maxId) LastState.resize(maxId + 1, 1); // 초기=보임
 
-	for (const auto& D : Candidates)
+	// --- 1) HZB 판정: 후보 단위 병렬 (결과는 후보 인덱스 자리에 기록) ---
+	const int32 NumCandidates = static_cast<int32>(Candidates.size());
+	TestResults.resize(size_t(NumCandidates));
+	FJobSystem::ParallelFor(NumCandidates, OcclusionTestMinBatch, [&](int32 Begin, int32 End)
 	{
-		uint32_t id = D.ActorIndex;
+		for (int32 i = Begin; i < End; ++i)
+			TestResults[i] = ClassifyCandidate(Candidates[i], ViewW, ViewH);
+	});
 
-		FOcclusionRect R;
-		if (!ComputeRectAndMinZ(D, ViewW, ViewH, R))
+	// --- 2) 히스테리시스: 후보 순서대로 직렬 적용 (streak 상태 갱신이 결정적) ---
+	Stats.PendingTransitions = 0;
+	for (int32 i = 0; i < NumCandidates; ++i)
+	{
+		uint32_t id = Candidates[i].ActorIndex;
+		const uint8_t Result = TestResults[i];
+
+		if (Result == TestResult_Offscreen)
 		{
 			// 화면 밖(또는 w<=0 코너만) → 가려짐으로 처리
 			OutVisibleFlags[id] = 0;
@@ -167,14 +1378,7 @@ void FOcclusionCullingManagerCPU::TestOcclusion(const TArray<FCandidateDrawable>
 			LastState[id] = 0;
 			continue;
 		}
-
-		const float rw = std::max(0.0f, R.MaxX - R.MinX);
-		const float rh = std::max(0.0f, R.MaxY - R.MinY);
-		const float pxW = rw * GetGrid().GetWidth();
-		const float pxH = rh * GetGrid().GetHeight();
-
-		// --- 작은 사각형 가드: 한 변이라도 2px 미만이면 컬링하지 않음 ---
-		if (std::min(pxW, pxH) < 2.0f)
+		if (Result == TestResult_TooSmall)
 		{
 			OutVisibleFlags[id] = 1;
 			VisibleStreak[id] = std::min<uint8_t>(255, VisibleStreak[id] + 1);
@@ -183,23 +1387,7 @@ void FOcclusionCullingManagerCPU::TestOcclusion(const TArray<FCandidateDrawable>
 			continue;
 		}
 
-		// --- 보수적 mip 선택 ---
-		int mip = std::max(0, Grid.ChooseMip(rw, rh) - 1);
-		if (pxW < 48.0f || pxH < 48.0f)
-			mip = std::max(0, mip - 1);
-
-
-		// --- MAX HZB 적응형 샘플 ---
-		const float hzbMax = Grid.SampleMaxRectAdaptive(R.MinX, R.MinY, R.MaxX, R.MaxY, mip);
-
-		bool occluded = ((hzbMax + eps) <= R.MinZ);
-
-		// --- 레벨0 정밀 재검증(occluded일 때만) ---
-		if (occluded)
-		{
-			if (!Grid.FullyOccludedAtLevel0(R.MinX, R.MinY, R.MaxX, R.MaxY, R.MinZ, eps2))
-				occluded = false;
-		}
+		bool occluded = (Result == TestResult_Occluded);
 
 		// --- 양방향 히스테리시스(2~3프레임 연속일 때만 상태 전환) ---
 		const int thresh = 2; // 2~3 추천
@@ -211,7 +1399,10 @@ void FOcclusionCullingManagerCPU::TestOcclusion(const TArray<FCandidateDrawable>
 
 			// 직전이 보임이면, thresh 미만 동안은 보임 유지
 			if (LastState[id] == 1 && OccludedStreak[id] < thresh)
+			{
 				occluded = false;
+				++Stats.PendingTransitions;
+			}
 		}
 		else
 		{
@@ -220,10 +1411,19 @@ void FOcclusionCullingManagerCPU::TestOcclusion(const TArray<FCandidateDrawable>
 
 			// 직전이 가려짐이면, thresh 미만 동안은 가려짐 유지
 			if (LastState[id] == 0 && VisibleStreak[id] < thresh)
+			{
 				occluded = true;
+				++Stats.PendingTransitions;
+			}
 		}
 
 		LastState[id] = occluded ? 0 : 1;
 		OutVisibleFlags[id] = occluded ? 0 : 1;
 	}
-}
\ No newline at end of file
+
+	Stats.Occludees = static_cast<uint32>(NumCandidates);
+	Stats.Occluded = 0;
+	for (const FCandidateDrawable& D : Candidates)
+		Stats.Occluded += (OutVisibleFlags[D.ActorIndex] == 0) ? 1u : 0u;
+	Stats.TestMs = FPlatformTime::ToMilliseconds(TestCounter.Finish());
+}
@@ -1,9 +1,23 @@
 ﻿#pragma once
 
-struct FVector;
-struct FVector4;
-struct FMatrix; // row-major, p' = p * M 가정(네 컨벤션대로)
-struct FBound; // AABB
+#include "UEContainer.h"
+#include "Struct.h"
+#include "SimdDispatch.h"
+
+// FMatrix 는 row-major, p' = p * M 가정(네 컨벤션대로)
+struct FStaticMesh;
+
+// 오클루더 전용 단순화 메시 (로컬 위치 + 인덱스만 보관)
+//  - 위치가 같은 정점은 하나로 합치고(노멀/UV 분리 정점 제거), 퇴화 삼각형은 버린다.
+//  - 삼각형 예산을 넘으면 면적이 큰 순으로만 남긴다. 삼각형을 빼는 것은 가림을 줄일 뿐이라 보수성이 유지된다.
+struct FOccluderMesh
+{
+    TArray<FVector> Positions;
+    TArray<uint32>  Indices;
+
+    int32 NumTriangles() const { return int32(Indices.size() / 3); }
+    bool IsEmpty() const { return Indices.empty(); }
+};
 
 struct FCandidateDrawable
 {
@@ -13,6 +27,11 @@ struct FCandidateDrawable
     FMatrix  WorldView;    // ★ 추가: World-space * View  (여기서는 View만 주면 됨)
     float    ZNear;        // ★ 추가
     float    ZFar;         // ★ 추가
+
+    // 오클루더 삼각형 래스터화용 (nullptr이면 AABB 사각형 경로로 대체)
+    const FOccluderMesh* OccluderMesh = nullptr;
+    FMatrix  MeshWorldViewProj; // 메시 로컬 → 클립
+    FMatrix  MeshWorldView;     // 메시 로컬 → 뷰
 };
 
 // 교체 (MaxZ 추가)
@@ -24,22 +43,81 @@ struct FOcclusionRect
     uint32_t ActorIndex;
 };
 
-// 저해상도 깊이맵 + HZB(min) - CPU 전용
+// 투영/근평면 클리핑을 마친 오클루더 삼각형 (타일 비닝 단위)
+struct FOcclusionTriangle
+{
+    float X[3], Y[3];           // 그리드 픽셀 좌표
+    float InvW[3], ZOverW[3];   // 화면 공간에서 선형인 1/w, 뷰 z / w
+    float MaxZView;             // 세 정점 중 가장 먼 뷰 z
+    float ZNear, ZFar;
+    int   MinPX, MinPY, MaxPX, MaxPY; // 픽셀 중심 기준 bbox (그리드 범위로 클램프)
+};
+
+// 사각형 경로 오클루더 (erosion까지 끝난 픽셀 범위 + 기록 깊이)
+struct FOcclusionRectSplat
+{
+    int   MinPX, MinPY, MaxPX, MaxPY;
+    float MaxZ;
+};
+
+// 그리드 타일 (양 끝 포함 픽셀 범위)
+struct FOcclusionTile
+{
+    int MinX, MinY, MaxX, MaxY;
+};
+
+// 오클루더 선정 기준 (화면 크기는 오클루전 그리드 픽셀 단위)
+struct FOccluderSelectionSettings
+{
+    int32 MaxTriangles = 8192;          // 패스당 오클루더 메시 삼각형 예산
+    int32 MaxRects = 64;                // 메시 없는 (사각형 경로) 오클루더 예산
+    float MinScreenArea = 64.0f;        // 투영 사각형 넓이가 이보다 작으면 제외 (px^2)
+    float MinScreenThickness = 4.0f;    // 투영 사각형의 짧은 변이 이보다 얇으면 제외 (px)
+    float DepthWeight = 2.0f;           // 점수 = 넓이 * (1 - 가장 가까운 선형 깊이)^DepthWeight
+
+    bool operator==(const FOccluderSelectionSettings&) const = default;
+};
+
+// 마지막 오클루전 패스(뷰포트 하나) 통계
+struct FOcclusionStats
+{
+    uint32 Candidates = 0;          // 오클루더 후보 수
+    uint32 SelectedOccluders = 0;
+    uint32 SkippedSmall = 0;        // 화면 밖이거나 작거나 얇아서 제외
+    uint32 SkippedBudget = 0;       // 예산 초과로 제외
+    uint32 SkippedHidden = 0;       // 재투영 모드: 지난 프레임에 가려져 오클루더 후보에서 제외
+    uint32 ReprojectedTexels = 0;   // 재투영 모드: 지난 프레임 깊이에서 옮겨 그린 텍셀 수
+    uint32 OccluderTriangles = 0;   // 선정된 오클루더 메시 삼각형 합 (클리핑 전)
+    uint32 OccluderRects = 0;
+    uint32 Occludees = 0;
+    uint32 Occluded = 0;            // 가려짐으로 판정된 오클루디 수
+    uint32 PendingTransitions = 0;  // 히스테리시스 때문에 이번 판정과 다른 상태로 유지된 오클루디 수 (0 이면 결과가 안정)
+    double SelectMs = 0.0;
+    double RasterMs = 0.0;
+    double ReprojectMs = 0.0;
+    double HZBMs = 0.0;
+    double TestMs = 0.0;
+
+    double GetTotalMs() const { return SelectMs + RasterMs + ReprojectMs + HZBMs + TestMs; }
+};
+
+// 저해상도 깊이맵 + HZB(max) - CPU 전용
+//  - 모든 mip을 32바이트 정렬된 버퍼 하나에 이어 붙여 두고, 해상도가 바뀔 때만 레이아웃을 다시 잡는다
+//  - 각 행은 8 float 배수 stride로 정렬되며 너비 + 1 칸 이상을 갖는다 (홀수 너비의 끝 열 복제용)
+//  - 상위 mip 크기는 올림((W + 1) / 2)이라 NPOT 해상도에서도 가장자리 열/행이 버려지지 않는다
 class FOcclusionGrid
 {
 public:
-    void Initialize(int InWidth, int InHeight)
-    {
-        Width = InWidth; Height = InHeight;
-        // 교체: 1.0f (Far)
-        Depth.assign(size_t(Width * Height), 1.0f);
-        BuildLevels.clear();
-    }
+    static constexpr int MaxLevels = 16;
+
+    // 크기가 같으면 아무것도 하지 않음. 저장소는 더 커져야 할 때만 재할당
+    void Initialize(int InWidth, int InHeight);
+
     void Clear()
     {
-        // Clear 도 동일하게 1.0f로
-        std::fill(Depth.begin(), Depth.end(), 1.0f);
-        BuildLevels.clear();
+        // 레벨0(패딩 포함)만 1.0f (Far)로
+        float* L0 = GetLevelData(0);
+        std::fill(L0, L0 + size_t(Levels[0].Stride) * Levels[0].Height, 1.0f);
     }
 
     /*
@@ -58,7 +136,7 @@ public:
         MaxPX = std::min(Width - 1, MaxPX); MaxPY = std::min(Height - 1, MaxPY);
         for (int y = MinPY; y <= MaxPY; ++y)
         {
-            float* Row = &Depth[size_t(y) * Width];
+            float* Row = GetRow(0, y);
             for (int x = MinPX; x <= MaxPX; ++x)
             {
                 Row[x] = std::min(Row[x], MaxZ); // 가장 가까운 깊이로 갱신
@@ -66,32 +144,34 @@ public:
         }
     }
 
-    void BuildHZB()
+    /*
+        삼각형 half-space 래스터화 (SIMD 레벨에 따라 1/4/8/16픽셀 단위). Tile 밖 픽셀은 읽지도 쓰지도 않으므로
+        서로 다른 타일은 여러 스레드에서 동시에 그려도 된다.
+
+        정점은 그리드 픽셀 좌표(X, Y)와 클립 w의 역수(InvW), 뷰 z / w(ZOverW)로 받는다.
+        둘 다 화면 공간에서 선형이므로 뷰 z = ZOverW / InvW 를 픽셀 네 모서리에서 구해 최댓값을 쓴다.
+        선형 분수 함수라 사각형 안의 최댓값은 모서리에서 나오므로, 기록 깊이는 픽셀 안 실제 깊이보다 항상 멀다.
+        커버리지는 픽셀 중심 포함 여부로 판정하고, 기존 사각형 경로와 같이 min 누적한다.
+    */
+    void RasterizeTriangleDepthMin(const FOcclusionTriangle& Tri, const FOcclusionTile& Tile);
+
+    // 2x2 MAX 축소로 mip 체인 생성 (SIMD 레벨별 행 커널, 할당 없음)
+    void BuildHZB();
+
+    // HZB 행 축소 커널: (R0, R1, Out, 시작 X, DstWidth, SrcStride, DstStride)
+    using FReduceRowFn = void(*)(const float*, const float*, float*, int, int, int, int);
+
+    // SIMD 레벨 하나의 커널 검증 결과
+    struct FKernelReport
     {
-        BuildLevels.clear();
-        BuildLevels.push_back(Depth); // level 0
+        ESimdLevel Level;
+        int32 RasterMismatches;
+        int32 HZBMismatches;
+    };
 
-        int W = Width, H = Height;
-        while (W > 1 || H > 1)
-        {
-            int NW = std::max(1, W >> 1);
-            int NH = std::max(1, H >> 1);
-            TArray<float> Next(size_t(NW * NH), +FLT_MAX);
-
-            for (int y = 0; y < NH; ++y)
-                for (int x = 0; x < NW; ++x)
-                {
-                    int sx = x * 2, sy = y * 2;
-                    float a = SampleSafe(BuildLevels.back(), W, H, sx + 0, sy + 0);
-                    float b = SampleSafe(BuildLevels.back(), W, H, sx + 1, sy + 0);
-                    float c = SampleSafe(BuildLevels.back(), W, H, sx + 0, sy + 1);
-                    float d = SampleSafe(BuildLevels.back(), W, H, sx + 1, sy + 1);
-                    Next[size_t(y) * NW + x] = std::max(std::max(a, b), std::max(c, d));
-                }
-            BuildLevels.push_back(std::move(Next));
-            W = NW; H = NH;
-        }
-    }
+    // 래스터/HZB 커널의 SIMD 변형을 스칼라 기준 구현과 비교 (기록 깊이와 모든 mip 이 비트 단위로 같아야 통과)
+    // 검사한 레벨마다 OutReports 에 결과를 남긴다 (로그는 호출하는 쪽에서)
+    static bool ValidateKernels(uint32 Seed, int32 Iterations, TArray<FKernelReport>& OutReports);
 
     int ChooseMip(float RectW01, float RectH01) const
     {
@@ -99,27 +179,13 @@ public:
         float pxH = RectH01 * Height;
         float s = std::max(pxW, pxH);
         int mip = int(std::floor(std::log2(std::max(1.0f, s))));
-        mip = std::max(0, std::min(mip, int(BuildLevels.size() - 1)));
+        mip = std::max(0, std::min(mip, NumLevels - 1));
         return mip;
     }
 
     float SampleMaxRect(float MinX01, float MinY01, float MaxX01, float MaxY01, int Mip) const
     {
-        const TArray<float>& L = BuildLevels[size_t(Mip)];
-        int W = std::max(1, Width >> Mip);
-        int H = std::max(1, Height >> Mip);
-
-        auto ToPx = [&](float u, float v)->std::pair<int, int> {
-            int x = int(u * W + 0.5f);
-            int y = int(v * H + 0.5f);
-            x = std::max(0, std::min(W - 1, x));
-            y = std::max(0, std::min(H - 1, y));
-            return { x,y };
-            };
-        auto Smp = [&](float u, float v)->float {
-            auto [x, y] = ToPx(u, v);
-            return L[size_t(y) * W + x];
-            };
+        auto Smp = [&](float u, float v)->float { return SampleLevel(Mip, u, v); };
 
         float cx = 0.5f * (MinX01 + MaxX01);
         float cy = 0.5f * (MinY01 + MaxY01);
@@ -135,21 +201,7 @@ public:
     // FOcclusionGrid 내부에 추가
     float SampleMaxRectAdaptive(float MinX01, float MinY01, float MaxX01, float MaxY01, int Mip) const
     {
-        const TArray<float>& L = BuildLevels[size_t(Mip)];
-        const int W = std::max(1, Width >> Mip);
-        const int H = std::max(1, Height >> Mip);
-
-        auto ToPx = [&](float u, float v)->std::pair<int, int> {
-            int x = int(u * W + 0.5f);
-            int y = int(v * H + 0.5f);
-            x = std::max(0, std::min(W - 1, x));
-            y = std::max(0, std::min(H - 1, y));
-            return { x,y };
-            };
-        auto Smp = [&](float u, float v)->float {
-            auto [x, y] = ToPx(u, v);
-            return L[size_t(y) * W + x];
-            };
+        auto Smp = [&](float u, float v)->float { return SampleLevel(Mip, u, v); };
 
         // 샘플 밀도: 화면 픽셀 크기에 비례 (최대 5x5)
         const int grid = ((MaxX01 - MinX01) * Width + (MaxY01 - MinY01) * Height > 80) ? 5 :
@@ -170,7 +222,6 @@ public:
     // FOcclusionGrid 내부에 추가 (레벨0 정밀 검사)
     bool FullyOccludedAtLevel0(float MinX01, float MinY01, float MaxX01, float MaxY01, float MinZ, float eps2) const
     {
-        const TArray<float>& L0 = BuildLevels[0];
         const int W = Width, H = Height;
 
         int x0 = std::max(0, std::min(W - 1, int(MinX01 * W)));
@@ -186,7 +237,7 @@ public:
 
         for (int y = y0; y <= y1; y += step)
         {
-            const float* row = &L0[size_t(y) * W];
+            const float* row = GetRow(0, y);
             for (int x = x0; x <= x1; x += step)
             {
                 float z = row[x];           // 레벨0의 MAX-기반 값(=멀리 기록한 것들의 min 축약 결과 아님!)
@@ -202,20 +253,42 @@ public:
     int GetHeight() const { return Height; }
 
 
+    // 레벨 Mip의 y행 시작 (행 stride는 레벨마다 다름)
+    float* GetRow(int Mip, int Y) { return GetLevelData(Mip) + size_t(Y) * Levels[Mip].Stride; }
+    const float* GetRow(int Mip, int Y) const { return GetLevelData(Mip) + size_t(Y) * Levels[Mip].Stride; }
+
 private:
-    static float SampleSafe(const TArray<float>& L, int W, int H, int X, int Y)
+    struct FLevel
+    {
+        int Width = 0, Height = 0;
+        int Stride = 0;         // float 단위, 8의 배수
+        size_t Offset = 0;      // 저장소 시작부터 float 단위
+    };
+
+    // 32바이트 정렬 단위 (TArray가 over-aligned 타입의 정렬을 보장)
+    struct alignas(32) FDepthBlock
+    {
+        float V[8];
+    };
+
+    void BuildHZBWith(FReduceRowFn ReduceRow);
+
+    float* GetLevelData(int Mip) { return reinterpret_cast<float*>(Storage.data()) + Levels[Mip].Offset; }
+    const float* GetLevelData(int Mip) const { return reinterpret_cast<const float*>(Storage.data()) + Levels[Mip].Offset; }
+
+    // 정규화 좌표 → 레벨0 픽셀 → Mip 텍셀 (올림 크기라 시프트 결과가 항상 레벨 안에 있음)
+    float SampleLevel(int Mip, float u, float v) const
     {
-        X = std::max(0, std::min(W - 1, X));
-        Y = std::max(0, std::min(H - 1, Y));
-        return L[size_t(Y) * W + X];
+        const int x = std::max(0, std::min(Width - 1, int(u * Width + 0.5f))) >> Mip;
+        const int y = std::max(0, std::min(Height - 1, int(v * Height + 0.5f))) >> Mip;
+        return GetRow(Mip, y)[x];
     }
 
 private:
     int Width = 0, Height = 0;
-    TArray<float> Depth;                     // level 0
-    TArray<TArray<float>> BuildLevels;  // [0..N-1], min chain
-
-
+    int NumLevels = 0;
+    FLevel Levels[MaxLevels];
+    TArray<FDepthBlock> Storage;    // 모든 레벨 (level 0 = 래스터 대상)
 };
 
 // CPU 오클루전 매니저
@@ -225,18 +298,128 @@ public:
     void Initialize(int GridW, int GridH) { Grid.Initialize(GridW, GridH); }
     void Shutdown() {}
 
-    // 1) 오클루더로 저해상도 Depth 채우기
+    /*
+        시간 재투영 (선택)
+
+        켜면 뷰(ViewKey)마다 지난 프레임에 새로 래스터한 깊이(2x2 MAX)와 판정 결과를 보관한다.
+        다음 프레임에는
+          - 지난 프레임에 보였던 후보만 오클루더로 다시 그리고 (가려졌던 것은 깊이에 기여하지 않음)
+          - 지난 깊이를 새 뷰-프로젝션으로 옮겨 그 위에 min 누적한다.
+        옮길 때 깊이는 블록의 가장 먼 값을 새 뷰 z로 다시 구하고, 커버리지는 옮겨진 블록 안쪽 사각형에
+        중심이 0.5px 이상 들어간 픽셀만 인정한다. 아무것도 안 떨어진 구멍은 Far(1.0)로 남아 보수적이다.
+        보관하는 깊이는 그 프레임의 래스터 결과뿐이라 재투영 오차가 프레임을 넘어 누적되지 않는다.
+    */
+    void SetTemporalReprojectionEnabled(bool bEnabled);
+    bool IsTemporalReprojectionEnabled() const { return bTemporalReprojection; }
+
+    // 오클루전 패스 시작/끝 (ViewKey 는 뷰포트 식별용 포인터)
+    //  - ViewPass: 그 뷰포트를 그린 횟수. 오클루전을 건너뛴 패스(꺼짐, 가시성 캐시 재사용)도 세어야 한다
+    //  - SceneGeneration: 파티션의 장면 세대 (등록/해제/이동/숨김, 월드가 바뀌어도 달라진다)
+    //  히스토리는 같은 세대에서 바로 직전 패스(ViewPass - 1)에 쓴 것일 때만 쓴다.
+    //  그 사이 오클루더가 움직였거나 사라졌으면 지난 깊이와 WasVisible 을 믿을 수 없기 때문
+    void BeginView(const void* ViewKey, uint32 ViewPass, uint32 SceneGeneration,
+        const FMatrix& View, const FMatrix& Proj, float ZNear, float ZFar);
+    void EndView(const TArray<uint8_t>& VisibleFlags);
+
+    // 0) 후보 중 오클루더 선정: 작거나 얇은 것은 버리고, 넓고 가까운 순으로 예산 안에서 채택
+    void SelectOccluders(const TArray<FCandidateDrawable>& Candidates, TArray<FCandidateDrawable>& OutOccluders);
+
+    // 1) 오클루더로 저해상도 Depth 채우기 (셋업 → 타일 비닝 → 타일별 병렬 래스터)
     void BuildOccluderDepth(const TArray<FCandidateDrawable>& Occluders, int ViewW, int ViewH);
 
     // 2) CPU HZB
-    void BuildHZB() { Grid.BuildHZB(); }
+    void BuildHZB();
 
-    // 3) 후보 가시성 판정
+    // 3) 후보 가시성 판정 (HZB 판정은 병렬, 히스테리시스는 후보 순서대로 직렬)
     void TestOcclusion(const TArray<FCandidateDrawable>& Candidates, int ViewW, int ViewH, TArray<uint8_t>& OutVisibleFlags);
 
     const FOcclusionGrid& GetGrid() const { return Grid; }
 
+    const FOccluderSelectionSettings& GetSelectionSettings() const { return SelectionSettings; }
+    void SetSelectionSettings(const FOccluderSelectionSettings& InSettings);
+    // 선정 기준/재투영 설정이 바뀔 때마다 증가 (판정 결과를 캐시하는 쪽의 무효화용)
+    uint32 GetSettingsRevision() const { return SettingsRevision; }
+    const FOcclusionStats& GetLastStats() const { return Stats; }
+
+    // 스태틱 메시 에셋의 오클루더 메시 (처음 요청될 때 만들어 캐시)
+    const FOccluderMesh* GetOccluderMesh(const FStaticMesh* Asset);
+    static bool BuildOccluderMesh(const FStaticMesh& Asset, int32 MaxTriangles, FOccluderMesh& OutMesh);
+
+    static constexpr int32 MaxOccluderTriangles = 1024;
+
+    // 타일 크기 (너비는 SIMD 4픽셀 묶음의 배수)
+    static constexpr int TileWidth = 64;
+    static constexpr int TileHeight = 32;
+    static constexpr int32 OccluderSetupMinBatch = 8;
+    static constexpr int32 OcclusionTestMinBatch = 64;
+
 private:
+    enum : uint8_t
+    {
+        TestResult_Offscreen,
+        TestResult_TooSmall,
+        TestResult_Visible,
+        TestResult_Occluded,
+    };
+
+    struct FOcclusionHistory
+    {
+        bool bValid = false;
+        int GridWidth = 0, GridHeight = 0;  // 저장 당시 그리드 크기
+        int Width = 0, Height = 0;          // Depth 크기 (그리드의 올림 절반)
+        TArray<float> Depth;                // 래스터 결과의 2x2 MAX (선형 0..1)
+        FMatrix View;
+        FMatrix InvViewProj;
+        float ZNear = 0.0f, ZFar = 0.0f;
+        TArray<uint8_t> WasVisible;         // ActorIndex 별 지난 판정 (1=보임)
+        uint32 ViewPass = 0;                // 저장한 패스 (다음 패스에서만 유효)
+        uint32 SceneGeneration = 0;         // 저장 당시 장면 세대
+    };
+
+    // 지난 뷰 광선 P(z) = O + D*z 를 새 클립/뷰 z 에 대한 선형식으로 바꿔 둔 것
+    struct FReprojectCorner
+    {
+        float ClipO[4], ClipD[4];
+        float ViewZO, ViewZD;
+        bool bValid;
+    };
+
+    struct FOccluderScore
+    {
+        float Score;
+        int32 Index;
+    };
+
+    struct FOcclusionTileBin
+    {
+        TArray<uint32> Triangles;
+        TArray<uint32> Rects;
+    };
+
+    // 셋업 청크별 출력 (프레임 간 재사용)
+    struct FOccluderSetupChunk
+    {
+        TArray<float> ClipScratch;  // 정점 변환 결과 (클립 x, y, w, 뷰 z)
+        TArray<FOcclusionTriangle> Triangles;
+        TArray<FOcclusionRectSplat> Rects;
+    };
+
+    // 오클루더 메시 삼각형을 근평면으로 자르고 그리드 좌표로 투영
+    static void SetupOccluderTriangles(const FCandidateDrawable& D, int GridW, int GridH,
+        TArray<float>& ClipScratch, TArray<FOcclusionTriangle>& OutTris);
+    // 메시 없는 오클루더: AABB 화면 사각형을 erosion 후 픽셀 범위로
+    static bool SetupOccluderRect(const FCandidateDrawable& D, int ViewW, int ViewH, int GW, int GH, FOcclusionRectSplat& OutRect);
+
+    void UpdateTiles(int GW, int GH);
+    // 방금 래스터한 레벨0을 2x2 MAX로 줄여 PendingDepth 에 보관 (EndView 에서 히스토리로)
+    void CaptureRasterDepth();
+    // 히스토리 깊이를 현재 뷰로 옮겨 레벨0 에 min 누적
+    void ReprojectHistory(const FOcclusionHistory& History);
+    uint8_t ClassifyCandidate(const FCandidateDrawable& D, int ViewW, int ViewH) const;
+    // 재투영 설정이 바뀌어 보관한 히스토리를 전부 버릴 때
+    void InvalidateHistory();
+
+
     // AABB(Min/Max) → 화면 사각형 + MinZ (★이제 MinZ는 '선형 깊이 0..1')
     static bool ComputeRectAndMinZ(const FCandidateDrawable& D, int ViewW, int ViewH, FOcclusionRect& OutRect);
 
@@ -254,4 +437,34 @@ private:
     TArray<uint8_t> VisibleStreak;   // 연속 보임 프레임 수
     TArray<uint8_t> OccludedStreak;  // 연속 가림 프레임 수
     TArray<uint8_t> LastState;       // 0=occluded, 1=visible
+
+    TMap<const FStaticMesh*, FOccluderMesh> OccluderMeshCache;
+
+    // 타일 래스터 상태 (그리드 크기가 바뀔 때만 타일 재구성)
+    int TiledWidth = 0, TiledHeight = 0;
+    int TilesX = 0, TilesY = 0;
+    TArray<FOcclusionTile> Tiles;
+    TArray<FOcclusionTileBin> TileBins;
+    TArray<FOccluderSetupChunk> SetupChunks;
+    TArray<FOcclusionTriangle> Triangles;
+    TArray<FOcclusionRectSplat> Rects;
+    TArray<uint8_t> TestResults;
+
+    FOccluderSelectionSettings SelectionSettings;
+    uint32 SettingsRevision = 0;
+    FOcclusionStats Stats;          // SelectOccluders 에서 초기화, 이후 단계가 채움
+    TArray<FOccluderScore> OccluderScores;
+
+    // 시간 재투영 상태
+    bool bTemporalReprojection = false;
+    TMap<const void*, FOcclusionHistory> Histories;
+    FOcclusionHistory* ActiveHistory = nullptr;     // 이번 패스 뷰의 히스토리 (꺼져 있으면 nullptr)
+    bool bHistoryUsable = false;                    // 크기/근원평면이 맞아 이번 패스에 쓸 수 있는지
+    FMatrix CurView;
+    FMatrix CurViewProj;
+    float CurZNear = 0.0f, CurZFar = 1.0f;
+    uint32 CurViewPass = 0;
+    uint32 CurSceneGeneration = 0;
+    TArray<float> PendingDepth;
+    TArray<FReprojectCorner> ReprojectCorners;
 };
\ No newline at end of file
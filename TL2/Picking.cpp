@@ -847,7 +847,7 @@ bool CPickingSystem::CheckActorPicking(const AActor* Actor, const FRay& Ray, flo
 			if (BVH)
 			{
 				float THitLocal;
-				if (BVH->IntersectRay(LocalRay, StaticMesh->Vertices, StaticMesh->Indices, THitLocal))
+				if (BVH->IntersectRay(LocalRay, THitLocal))
 				{
 					const FVector HitLocal = FVector(
 						LocalOrigin4.X + LocalDir4.X * THitLocal,
@@ -999,7 +999,7 @@ bool CPickingSystem::CheckComponentPicking(const USceneComponent* Component, con
 		if (BVH)
 		{
 			float THitLocal;
-			if (BVH->IntersectRay(LocalRay, StaticMesh->Vertices, StaticMesh->Indices, THitLocal))
+			if (BVH->IntersectRay(LocalRay, THitLocal))
 			{
 				const FVector HitLocal = FVector(
 					LocalOrigin4.X + LocalDir4.X * THitLocal,
@@ -1,4 +1,3 @@
-#include "pch.h"
 #include "PlatformTime.h"
 
 // Define static members declared in FWindowsPlatformTime
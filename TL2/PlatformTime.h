@@ -1,5 +1,16 @@
 ﻿#pragma once
 
+#include "UEContainer.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <chrono>
+#endif
+
 class FWindowsPlatformTime
 {
 public:
@@ -31,9 +42,13 @@ public:
 	}
 	static uint64 GetFrequency()
 	{
+#ifdef _WIN32
 		LARGE_INTEGER Frequency;
 		QueryPerformanceFrequency(&Frequency);
 		return Frequency.QuadPart;
+#else
+		return uint64(std::chrono::steady_clock::period::den / std::chrono::steady_clock::period::num);
+#endif
 	}
 	static double ToMilliseconds(uint64 CycleDiff)
 	{
@@ -46,9 +61,14 @@ public:
 
 	static uint64 Cycles64()
 	{
+#ifdef _WIN32
 		LARGE_INTEGER CycleCount;
 		QueryPerformanceCounter(&CycleCount);
 		return (uint64)CycleCount.QuadPart;
+#else
+		// 헤드리스 테스트 빌드 (Windows 밖)
+		return (uint64)std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
 	}
 };
 
@@ -7,6 +7,7 @@
 #include "World.h"
 #include "WorldPartitionManager.h"
 #include "Renderer.h"
+#include "Frustum.h"
 
 void UPrimitiveComponent::SetMaterial(const FString& FilePath, EVertexLayoutType layoutType)
 {
@@ -39,33 +40,10 @@ void UPrimitiveComponent::Render(URenderer* Renderer, const FMatrix& View, const
 
 }
 
-// 월드 AABB 계산 유틸 (Arvo)
-FVector UPrimitiveComponent::ComputeWorldExtentsArvo(const FVector& E, const FMatrix& M) const
-{
-    const float Ex = E.X, Ey = E.Y, Ez = E.Z;
-    const float Wx = std::abs(M.M[0][0]) * Ex + std::abs(M.M[1][0]) * Ey + std::abs(M.M[2][0]) * Ez;
-    const float Wy = std::abs(M.M[0][1]) * Ex + std::abs(M.M[1][1]) * Ey + std::abs(M.M[2][1]) * Ez;
-    const float Wz = std::abs(M.M[0][2]) * Ex + std::abs(M.M[1][2]) * Ey + std::abs(M.M[2][2]) * Ez;
-    return FVector(Wx, Wy, Wz);
-}
-
 FBound UPrimitiveComponent::GetWorldAABB() const
 {
-    // 로컬 중심/익스텐트 계산 후 월드로 변환 (행벡터 규약)
-    const FVector LocalCenter = (LocalAABB.Min + LocalAABB.Max) * 0.5f;
-    const FVector LocalExtents = (LocalAABB.Max - LocalAABB.Min) * 0.5f;
-
-    const FMatrix WorldMat = GetWorldMatrix();
-
-    // Center' = Center * World
-    const FVector WorldCenter(
-        LocalCenter.X * WorldMat.M[0][0] + LocalCenter.Y * WorldMat.M[1][0] + LocalCenter.Z * WorldMat.M[2][0] + WorldMat.M[3][0],
-        LocalCenter.X * WorldMat.M[0][1] + LocalCenter.Y * WorldMat.M[1][1] + LocalCenter.Z * WorldMat.M[2][1] + WorldMat.M[3][1],
-        LocalCenter.X * WorldMat.M[0][2] + LocalCenter.Y * WorldMat.M[1][2] + LocalCenter.Z * WorldMat.M[2][2] + WorldMat.M[3][2]
-    );
-
-    const FVector WorldExtents = ComputeWorldExtentsArvo(LocalExtents, WorldMat);
-    return FBound(WorldCenter - WorldExtents, WorldCenter + WorldExtents);
+    // 로컬 중심/익스텐트를 월드로 변환 (Arvo, 행벡터 규약, SIMD 레벨별 커널)
+    return TransformAABB(LocalAABB, GetWorldMatrix());
 }
 
 void UPrimitiveComponent::MarkDirtyInBVH()
@@ -7,6 +7,7 @@
 struct FPrimitiveData;
 
 class URenderer;
+class FDrawCommandList;
 
 class UPrimitiveComponent :public USceneComponent
 {
@@ -24,15 +25,9 @@ public:
 
     virtual void Render(URenderer* Renderer, const FMatrix& View, const FMatrix& Proj);
 
-    void SetCulled(bool InCulled)
-    {
-        bIsCulled = InCulled;
-    }
-
-    bool GetCulled() const
-    {
-        return bIsCulled;
-    }
+    // 정렬 키 드로우 커맨드로 그릴 수 있으면 OutList 에 커맨드를 추가하고 true. false 면 Render 로 그린다
+    // 워커 스레드에서 다른 컴포넌트와 동시에 불린다 (OutList 는 워커 전용). 컴포넌트/리소스는 읽기만 할 것
+    virtual bool EmitDrawCommands(FDrawCommandList& OutList, const FMatrix& View) { return false; }
 
     // === Bounds API ===
     // 컴포넌트의 월드 AABB를 반환 (로컬 AABB와 월드 변환으로 계산)
@@ -55,14 +50,10 @@ public:
 
 protected:
     UMaterial* Material = nullptr;
-    bool bIsCulled = false;
 
     // 로컬 공간에서의 AABB (메쉬 로컬 기준)
     FBound LocalAABB; // Min/Max in local space
 
-    // 월드 AABB 계산 유틸리티 (Arvo 방식)
-    FVector ComputeWorldExtentsArvo(const FVector& LocalExtents, const FMatrix& World) const;
-
     // Helper function to mark this primitive dirty in BVH
     void MarkDirtyInBVH();
 
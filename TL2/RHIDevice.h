@@ -11,6 +11,9 @@ enum class EComparisonFunc
     Disable,
     LessEqualReadOnly,
 };
+
+class FConstantRingAllocator;
+
 class URHIDevice
 {
 public:
@@ -48,6 +51,13 @@ public:
     virtual void UpdateColorConstantBuffers(const FVector4& InColor) = 0;
     virtual void UpdateUVScrollConstantBuffers(const FVector2D& Speed, float TimeSec) = 0;
 
+    // 프레임 상수 링 (큰 동적 상수 버퍼 하나를 오프셋으로 나눠 바인딩). 지원하지 않으면 MapConstantRing 이 nullptr
+    virtual void BeginConstantRingFrame() = 0;
+    virtual uint8* MapConstantRing(uint32 Bytes, uint32& OutOffset) = 0;
+    virtual void UnmapConstantRing() = 0;
+    virtual void VSSetConstantRing(uint32 Slot, uint32 Offset, uint32 Bytes) = 0;
+    virtual const FConstantRingAllocator* GetConstantRing() const = 0;
+
     // clear
     virtual void ClearBackBuffer() = 0;
     virtual void ClearDepthBuffer(float Depth, UINT Stenci) = 0;
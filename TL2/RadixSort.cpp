@@ -0,0 +1,96 @@
+﻿#include "RadixSort.h"
+#include "JobSystem.h"
+#include <cassert>
+
+namespace
+{
+    constexpr int32 RadixBits = 8;
+    constexpr int32 RadixSize = 1 << RadixBits;
+    constexpr int32 RadixMinBatch = 16384;
+}
+
+void RadixSortPairs(TArray<uint64>& Keys, TArray<uint32>& Values, uint32 KeyBits)
+{
+    const int32 N = static_cast<int32>(Keys.size());
+    assert(static_cast<int32>(Values.size()) == N);
+    if (N <= 1) return;
+
+    TArray<uint64> TempKeys;
+    TArray<uint32> TempValues;
+    TempKeys.resize(N);
+    TempValues.resize(N);
+
+    // 청크 수(경계)는 워커 수에 따라 달라지지만, 자리값마다 청크 순서대로 시작 오프셋을 누적하고
+    // 청크 안에서는 원래 순서대로 분배하므로 결과는 스레드 수와 무관하다 (안정 정렬이라 결과도 유일)
+    const int32 ChunkCount = FJobSystem::GetChunkCount(N, RadixMinBatch);
+    TArray<uint32> Histograms;
+    Histograms.resize(static_cast<size_t>(ChunkCount) * RadixSize);
+
+    auto ChunkBegin = [&](int32 Chunk) { return static_cast<int32>(static_cast<int64>(N) * Chunk / ChunkCount); };
+
+    uint64* Src = Keys.data();
+    uint64* Dst = TempKeys.data();
+    uint32* SrcVal = Values.data();
+    uint32* DstVal = TempValues.data();
+
+    for (uint32 Shift = 0; Shift < KeyBits; Shift += RadixBits)
+    {
+        // 1) 청크별 히스토그램
+        FJobSystem::ParallelForChunks(ChunkCount, [&](int32 Chunk)
+        {
+            uint32* Hist = &Histograms[static_cast<size_t>(Chunk) * RadixSize];
+            std::fill(Hist, Hist + RadixSize, 0u);
+            const int32 End = ChunkBegin(Chunk + 1);
+            for (int32 i = ChunkBegin(Chunk); i < End; ++i)
+                ++Hist[(Src[i] >> Shift) & (RadixSize - 1)];
+        });
+
+        // 한 자리값에 모두 몰려 있으면 이 패스는 순서를 바꾸지 않는다
+        bool bTrivial = false;
+        for (int32 Digit = 0; Digit < RadixSize; ++Digit)
+        {
+            uint32 Total = 0;
+            for (int32 Chunk = 0; Chunk < ChunkCount; ++Chunk)
+                Total += Histograms[static_cast<size_t>(Chunk) * RadixSize + Digit];
+            if (Total == static_cast<uint32>(N)) { bTrivial = true; break; }
+            if (Total != 0) break;
+        }
+        if (bTrivial) continue;
+
+        // 2) (자리값, 청크) 순서로 누적해 청크별 시작 오프셋 계산
+        uint32 Offset = 0;
+        for (int32 Digit = 0; Digit < RadixSize; ++Digit)
+        {
+            for (int32 Chunk = 0; Chunk < ChunkCount; ++Chunk)
+            {
+                uint32& Slot = Histograms[static_cast<size_t>(Chunk) * RadixSize + Digit];
+                const uint32 Count = Slot;
+                Slot = Offset;
+                Offset += Count;
+            }
+        }
+
+        // 3) 청크별 분배 (청크 내부 순서 유지 -> 안정)
+        FJobSystem::ParallelForChunks(ChunkCount, [&](int32 Chunk)
+        {
+            uint32* Cursor = &Histograms[static_cast<size_t>(Chunk) * RadixSize];
+            const int32 End = ChunkBegin(Chunk + 1);
+            for (int32 i = ChunkBegin(Chunk); i < End; ++i)
+            {
+                const uint32 Dest = Cursor[(Src[i] >> Shift) & (RadixSize - 1)]++;
+                Dst[Dest] = Src[i];
+                DstVal[Dest] = SrcVal[i];
+            }
+        });
+
+        std::swap(Src, Dst);
+        std::swap(SrcVal, DstVal);
+    }
+
+    // 홀수 번 스왑됐으면 결과가 임시 버퍼에 있다
+    if (Src != Keys.data())
+    {
+        Keys.swap(TempKeys);
+        Values.swap(TempValues);
+    }
+}
@@ -0,0 +1,8 @@
+﻿#pragma once
+#include "UEContainer.h"
+
+// 64비트 키 + 32비트 값 쌍에 대한 LSD 기수 정렬 (안정 정렬, 8비트 자리씩)
+// - KeyBits 보다 위의 비트는 0 이라고 가정하고 해당 패스를 건너뛴다
+// - 모든 키가 같은 자리값을 가지는 패스도 건너뛴다
+// - 원소 수가 충분히 크면 FJobSystem 으로 히스토그램/분배를 병렬 처리한다
+void RadixSortPairs(TArray<uint64>& Keys, TArray<uint32>& Values, uint32 KeyBits = 64);
@@ -0,0 +1,414 @@
+﻿#include "RenderCommand.h"
+#include "RadixSort.h"
+#include <bit>
+#include <cstring>
+
+namespace
+{
+    constexpr uint64 FieldMask(uint32 Bits) { return (1ull << Bits) - 1ull; }
+
+    bool IsSameState(const FDrawCommand& A, const FDrawCommand& B)
+    {
+        return A.Shader == B.Shader && A.Material == B.Material && A.Mesh == B.Mesh;
+    }
+
+    bool IsSameSection(const FDrawCommand& A, const FDrawCommand& B)
+    {
+        return A.StartIndex == B.StartIndex && A.IndexCount == B.IndexCount;
+    }
+}
+
+uint32 DrawSortKey::QuantizeDepth(float ViewDepth)
+{
+    // 음수/NaN 은 0 (카메라 뒤나 근평면 바로 앞). 양수 float 는 비트 패턴이 값 순서와 같다
+    if (!(ViewDepth > 0.0f)) return 0u;
+    return std::bit_cast<uint32>(ViewDepth) >> (32 - DepthBits);
+}
+
+uint64 DrawSortKey::Make(ERenderPass Pass, uint32 ShaderId, uint32 MaterialId, uint32 MeshId, float ViewDepth)
+{
+    const uint64 P = static_cast<uint64>(Pass) & FieldMask(PassBits);
+    const uint64 S = ShaderId & FieldMask(ShaderBits);
+    const uint64 Mt = MaterialId & FieldMask(MaterialBits);
+    const uint64 Ms = MeshId & FieldMask(MeshBits);
+    const uint64 D = QuantizeDepth(ViewDepth);
+
+    if (Pass == ERenderPass::Translucent)
+    {
+        const uint64 FarFirst = ~D & FieldMask(DepthBits);
+        return (P << 60) | (FarFirst << 44) | (S << 32) | (Mt << 16) | Ms;
+    }
+    return (P << 60) | (S << 48) | (Mt << 32) | (Ms << 16) | D;
+}
+
+// ------------------------------------------------------------
+// FDrawCommandList
+// ------------------------------------------------------------
+void FDrawCommandList::Reset()
+{
+    Commands.clear();
+    Transforms.clear();
+    SortKeys.clear();
+    SortedOrder.clear();
+    Batches.clear();
+    InstanceTransforms.clear();
+    DrawTransforms.clear();
+}
+
+void FDrawCommandList::Reserve(int32 NumCommands, int32 NumTransforms)
+{
+    Commands.reserve(NumCommands);
+    Transforms.reserve(NumTransforms);
+}
+
+void FDrawCommandList::Append(const FDrawCommandList& Other)
+{
+    const uint32 TransformBase = static_cast<uint32>(Transforms.size());
+    const size_t CommandBase = Commands.size();
+    Transforms.insert(Transforms.end(), Other.Transforms.begin(), Other.Transforms.end());
+    Commands.insert(Commands.end(), Other.Commands.begin(), Other.Commands.end());
+    for (size_t i = CommandBase; i < Commands.size(); ++i)
+    {
+        Commands[i].TransformIndex += TransformBase;
+    }
+}
+
+void FDrawCommandList::Sort(uint32 MinInstances)
+{
+    const int32 N = Num();
+    SortKeys.resize(N);
+    SortedOrder.resize(N);
+    for (int32 i = 0; i < N; ++i)
+    {
+        SortKeys[i] = Commands[i].SortKey;
+        SortedOrder[i] = static_cast<uint32>(i);
+    }
+    RadixSortPairs(SortKeys, SortedOrder);
+
+    BuildBatches(MinInstances);
+}
+
+void FDrawCommandList::BuildBatches(uint32 MinInstances)
+{
+    Batches.clear();
+    InstanceTransforms.clear();
+    DrawTransforms.clear();
+
+    const bool bAllowInstancing = MinInstances > 0;
+    MinInstances = std::max(MinInstances, 2u);
+
+    const int32 N = static_cast<int32>(SortedOrder.size());
+    int32 RunBegin = 0;
+    while (RunBegin < N)
+    {
+        const FDrawCommand& First = Commands[SortedOrder[RunBegin]];
+
+        // 상태 런: 셰이더/머티리얼/메시가 같은 연속 구간 (키에서 셋이 깊이보다 위라 정렬 후 붙어 있다)
+        int32 RunEnd = RunBegin + 1;
+        if (bAllowInstancing && DrawSortKey::GetPass(First.SortKey) != ERenderPass::Translucent)
+        {
+            while (RunEnd < N && IsSameState(First, Commands[SortedOrder[RunEnd]]))
+            {
+                ++RunEnd;
+            }
+        }
+
+        const uint32 RunCount = static_cast<uint32>(RunEnd - RunBegin);
+        if (RunCount < MinInstances)
+        {
+            for (int32 i = RunBegin; i < RunEnd; ++i)
+            {
+                AddSingleBatch(SortedOrder[i]);
+            }
+            RunBegin = RunEnd;
+            continue;
+        }
+
+        // 런 안에서 섹션(인덱스 범위)별로 모은다. 보통 섹션은 하나라 분할 없이 끝난다
+        SectionMembers.assign(SortedOrder.begin() + RunBegin, SortedOrder.begin() + RunEnd);
+        while (!SectionMembers.empty())
+        {
+            const FDrawCommand& Section = Commands[SectionMembers[0]];
+            const auto SectionEnd = std::stable_partition(SectionMembers.begin(), SectionMembers.end(),
+                [&](uint32 Index) { return IsSameSection(Section, Commands[Index]); });
+            const uint32 Count = static_cast<uint32>(SectionEnd - SectionMembers.begin());
+
+            if (Count >= MinInstances)
+            {
+                AddInstancedBatch(SectionMembers.data(), Count);
+            }
+            else
+            {
+                for (uint32 i = 0; i < Count; ++i)
+                {
+                    AddSingleBatch(SectionMembers[i]);
+                }
+            }
+            SectionMembers.erase(SectionMembers.begin(), SectionEnd);
+        }
+        RunBegin = RunEnd;
+    }
+}
+
+void FDrawCommandList::AddSingleBatch(uint32 CommandIndex)
+{
+    FDrawBatch Batch;
+    Batch.FirstCommand = CommandIndex;
+
+    // 바로 앞 단일 드로우와 같은 트랜스폼(같은 컴포넌트의 다른 섹션)이면 상수 블록을 같이 쓴다
+    const uint32 TransformIndex = Commands[CommandIndex].TransformIndex;
+    if (!Batches.empty() && !Batches.back().bInstanced && Commands[Batches.back().FirstCommand].TransformIndex == TransformIndex)
+    {
+        Batch.FirstInstance = Batches.back().FirstInstance;
+    }
+    else
+    {
+        Batch.FirstInstance = static_cast<uint32>(DrawTransforms.size());
+        DrawTransforms.push_back(Transforms[TransformIndex]);
+    }
+    Batches.push_back(Batch);
+}
+
+void FDrawCommandList::AddInstancedBatch(const uint32* CommandIndices, uint32 Count)
+{
+    FDrawBatch Batch;
+    Batch.FirstCommand = CommandIndices[0];
+    Batch.FirstInstance = static_cast<uint32>(InstanceTransforms.size());
+    Batch.InstanceCount = Count;
+    Batch.bInstanced = true;
+    Batches.push_back(Batch);
+
+    for (uint32 i = 0; i < Count; ++i)
+    {
+        InstanceTransforms.push_back(Transforms[Commands[CommandIndices[i]].TransformIndex]);
+    }
+}
+
+// ------------------------------------------------------------
+// 제출
+// ------------------------------------------------------------
+FDrawSubmitStats SubmitDrawCommands(const FDrawCommandList& List, const FMatrix& View, const FMatrix& Proj, FRHIDrawBackend& Backend)
+{
+    FDrawSubmitStats Stats;
+    const TArray<FDrawCommand>& Commands = List.GetCommands();
+    const TArray<FMatrix>& InstanceTransforms = List.GetInstanceTransforms();
+    const TArray<FMatrix>& DrawTransforms = List.GetDrawTransforms();
+    Stats.Commands = static_cast<uint32>(Commands.size());
+
+    Backend.BeginDrawList(View, Proj);
+    if (!InstanceTransforms.empty())
+    {
+        Backend.SetInstanceTransforms(InstanceTransforms.data(), static_cast<uint32>(InstanceTransforms.size()));
+    }
+
+    // 상수 링: [뷰 블록][단일 드로우 월드 행렬 블록 ...] 을 한 번 매핑해서 다 쓰고, 드로우는 오프셋만 바꾼다
+    const uint32 ViewBlockBytes = FConstantRingAllocator::AlignSize(sizeof(FViewConstants));
+    const uint32 TransformBlockBytes = FConstantRingAllocator::AlignSize(sizeof(FMatrix));
+    uint32 RingBase = 0;
+    bool bUseRing = false;
+    if (!DrawTransforms.empty())
+    {
+        const uint32 RingBytes = ViewBlockBytes + TransformBlockBytes * static_cast<uint32>(DrawTransforms.size());
+        if (uint8* Dst = Backend.MapConstants(RingBytes, RingBase))
+        {
+            FViewConstants* ViewDst = reinterpret_cast<FViewConstants*>(Dst);
+            ViewDst->View = View;
+            ViewDst->Proj = Proj;
+
+            uint8* TransformDst = Dst + ViewBlockBytes;
+            for (const FMatrix& World : DrawTransforms)
+            {
+                std::memcpy(TransformDst, &World, sizeof(FMatrix));
+                TransformDst += TransformBlockBytes;
+            }
+            Backend.UnmapConstants();
+            Backend.SetViewConstants(RingBase);
+
+            bUseRing = true;
+            Stats.ConstantBytes = RingBytes;
+        }
+    }
+
+    UShader* CurShader = nullptr;
+    UStaticMesh* CurMesh = nullptr;
+    UMaterial* CurMaterial = nullptr;
+    uint32 CurTransform = UINT32_MAX;   // DrawTransforms 인덱스
+    bool bMaterialBound = false;    // nullptr 머티리얼도 "기본 머티리얼" 바인딩이라 따로 추적
+
+    for (const FDrawBatch& Batch : List.GetBatches())
+    {
+        const FDrawCommand& Cmd = Commands[Batch.FirstCommand];
+        if (!Cmd.Mesh || Cmd.IndexCount == 0) continue;
+
+        if (Cmd.Shader != CurShader)
+        {
+            Backend.SetShader(Cmd.Shader);
+            CurShader = Cmd.Shader;
+            ++Stats.ShaderBinds;
+        }
+        if (Cmd.Mesh != CurMesh)
+        {
+            Backend.SetMesh(Cmd.Mesh);
+            CurMesh = Cmd.Mesh;
+            ++Stats.MeshBinds;
+        }
+        if (!bMaterialBound || Cmd.Material != CurMaterial)
+        {
+            Backend.SetMaterial(Cmd.Material);
+            CurMaterial = Cmd.Material;
+            bMaterialBound = true;
+            ++Stats.MaterialBinds;
+        }
+
+        if (Batch.bInstanced)
+        {
+            if (Backend.SupportsInstancing(Cmd.Shader))
+            {
+                Backend.DrawIndexedInstanced(Cmd.IndexCount, Cmd.StartIndex, Batch.InstanceCount, Batch.FirstInstance);
+                ++Stats.DrawCalls;
+                ++Stats.InstancedDraws;
+                Stats.Instances += Batch.InstanceCount;
+            }
+            else
+            {
+                // 인스턴싱을 못 하는 셰이더: 같은 상태로 하나씩 그린다
+                for (uint32 i = 0; i < Batch.InstanceCount; ++i)
+                {
+                    Backend.SetTransform(InstanceTransforms[Batch.FirstInstance + i]);
+                    Backend.DrawIndexed(Cmd.IndexCount, Cmd.StartIndex);
+                    ++Stats.TransformUpdates;
+                    ++Stats.DrawCalls;
+                }
+                CurTransform = UINT32_MAX;
+            }
+            continue;
+        }
+
+        if (Batch.FirstInstance != CurTransform)
+        {
+            if (bUseRing)
+            {
+                Backend.SetTransformConstants(RingBase + ViewBlockBytes + Batch.FirstInstance * TransformBlockBytes);
+            }
+            else
+            {
+                Backend.SetTransform(DrawTransforms[Batch.FirstInstance]);
+            }
+            CurTransform = Batch.FirstInstance;
+            ++Stats.TransformUpdates;
+        }
+
+        Backend.DrawIndexed(Cmd.IndexCount, Cmd.StartIndex);
+        ++Stats.DrawCalls;
+    }
+
+    Backend.EndDrawList();
+    return Stats;
+}
+
+// ------------------------------------------------------------
+// FRecordingDrawBackend
+// ------------------------------------------------------------
+void FRecordingDrawBackend::Reset()
+{
+    Calls.clear();
+    RecordedTransforms.clear();
+    RecordedInstanceTransforms.clear();
+    RecordedViewConstants.clear();
+    for (uint32& Count : OpCounts) Count = 0;
+}
+
+void FRecordingDrawBackend::EnableConstantRing(uint32 Capacity)
+{
+    bConstantRingEnabled = Capacity > 0;
+    ConstantRing.Initialize(Capacity);
+    ConstantRingMemory.assign(ConstantRing.GetCapacity(), 0);
+}
+
+void FRecordingDrawBackend::BeginFrame()
+{
+    if (!bConstantRingEnabled) return;
+
+    ConstantRing.BeginFrame();
+    if (ConstantRing.NeedsGrow())
+    {
+        ConstantRing.Initialize(ConstantRing.GetDesiredCapacity());
+        ConstantRingMemory.assign(ConstantRing.GetCapacity(), 0);
+    }
+}
+
+void FRecordingDrawBackend::Record(ERecordedDrawOp Op, const void* Object, uint32 A, uint32 B, uint32 C, uint32 D)
+{
+    ++OpCounts[static_cast<int>(Op)];
+    if (bRecordCalls)
+    {
+        Calls.push_back({ Op, Object, A, B, C, D });
+    }
+}
+
+void FRecordingDrawBackend::BeginDrawList(const FMatrix& View, const FMatrix& Proj) { Record(ERecordedDrawOp::BeginDrawList); }
+void FRecordingDrawBackend::SetShader(UShader* Shader) { Record(ERecordedDrawOp::SetShader, Shader); }
+void FRecordingDrawBackend::SetMesh(UStaticMesh* Mesh) { Record(ERecordedDrawOp::SetMesh, Mesh); }
+void FRecordingDrawBackend::SetMaterial(UMaterial* Material) { Record(ERecordedDrawOp::SetMaterial, Material); }
+
+void FRecordingDrawBackend::SetTransform(const FMatrix& World)
+{
+    if (bRecordCalls)
+    {
+        RecordedTransforms.push_back(World);
+    }
+    Record(ERecordedDrawOp::SetTransform, nullptr, bRecordCalls ? static_cast<uint32>(RecordedTransforms.size() - 1) : 0u);
+}
+
+void FRecordingDrawBackend::DrawIndexed(uint32 IndexCount, uint32 StartIndex) { Record(ERecordedDrawOp::DrawIndexed, nullptr, IndexCount, StartIndex); }
+void FRecordingDrawBackend::EndDrawList() { Record(ERecordedDrawOp::EndDrawList); }
+
+void FRecordingDrawBackend::SetInstanceTransforms(const FMatrix* Transforms, uint32 Count)
+{
+    if (bRecordCalls)
+    {
+        RecordedInstanceTransforms.assign(Transforms, Transforms + Count);
+    }
+    Record(ERecordedDrawOp::SetInstanceTransforms, nullptr, Count);
+}
+
+void FRecordingDrawBackend::DrawIndexedInstanced(uint32 IndexCount, uint32 StartIndex, uint32 InstanceCount, uint32 FirstInstance)
+{
+    Record(ERecordedDrawOp::DrawIndexedInstanced, nullptr, IndexCount, StartIndex, InstanceCount, FirstInstance);
+}
+
+uint8* FRecordingDrawBackend::MapConstants(uint32 Bytes, uint32& OutOffset)
+{
+    if (!bConstantRingEnabled) return nullptr;
+
+    bool bDiscard = false;
+    if (!ConstantRing.Allocate(Bytes, OutOffset, bDiscard)) return nullptr;
+
+    Record(ERecordedDrawOp::MapConstants, nullptr, Bytes, OutOffset, bDiscard ? 1u : 0u);
+    return ConstantRingMemory.data() + OutOffset;
+}
+
+void FRecordingDrawBackend::UnmapConstants() { Record(ERecordedDrawOp::UnmapConstants); }
+
+void FRecordingDrawBackend::SetViewConstants(uint32 Offset)
+{
+    if (bRecordCalls)
+    {
+        FViewConstants Constants;
+        std::memcpy(&Constants, ConstantRingMemory.data() + Offset, sizeof(FViewConstants));
+        RecordedViewConstants.push_back(Constants);
+    }
+    Record(ERecordedDrawOp::SetViewConstants, nullptr, 0u, Offset);
+}
+
+void FRecordingDrawBackend::SetTransformConstants(uint32 Offset)
+{
+    // 링에서 다시 읽어 SetTransform 과 같은 형태로 남긴다 (재생 검증이 두 경로를 똑같이 본다)
+    if (bRecordCalls)
+    {
+        FMatrix World;
+        std::memcpy(&World, ConstantRingMemory.data() + Offset, sizeof(FMatrix));
+        RecordedTransforms.push_back(World);
+    }
+    Record(ERecordedDrawOp::SetTransformConstants, nullptr, bRecordCalls ? static_cast<uint32>(RecordedTransforms.size() - 1) : 0u, Offset);
+}
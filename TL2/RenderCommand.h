@@ -0,0 +1,283 @@
+﻿#pragma once
+#include "UEContainer.h"
+#include "Struct.h"
+#include "ConstantRingAllocator.h"
+
+class UShader;
+class UMaterial;
+class UStaticMesh;
+
+// ------------------------------------------------------------
+// 드로우 커맨드 레이어
+//  - 보이는 프리미티브가 고정 크기 커맨드(FDrawCommand)를 내보내고, 64비트 정렬 키로 기수 정렬한 뒤
+//    FRHIDrawBackend 로 제출한다. 제출기는 바뀐 상태만 백엔드에 넘긴다
+//  - 정렬 후 셰이더/머티리얼/메시/섹션이 같은 커맨드 묶음은 인스턴스 드로우 하나로 합친다
+//  - 드로우별 상수(월드 행렬)는 제출 순서대로 필드별 연속 배열에 모아 두고, 제출 때 상수 링에 한 번에 쓴 뒤 오프셋으로 바인딩한다
+//  - 리소스는 불투명 포인터로만 다루므로 정렬/제출은 D3D 없이 돈다 (FRecordingDrawBackend 로 헤드리스 측정)
+// ------------------------------------------------------------
+
+enum class ERenderPass : uint8
+{
+    Opaque,         // 상태 묶음 우선, 같은 상태 안에서는 앞→뒤
+    Translucent,    // 뒤→앞 우선
+    Overlay,
+    Count,
+};
+
+// 정렬 키 (상위 비트부터)
+//  Opaque/Overlay : Pass 4 | Shader 12 | Material 16 | Mesh 16 | Depth 16
+//  Translucent    : Pass 4 | ~Depth 16 | Shader 12 | Material 16 | Mesh 16
+//  - 리소스 ID 는 UUID 하위 비트 (충돌해도 정렬 순서만 영향, 상태 비교는 포인터로 한다)
+//  - 깊이는 양수 float 비트 패턴의 상위 16비트 (단조 증가, 가까울수록 정밀)
+namespace DrawSortKey
+{
+    constexpr uint32 PassBits = 4;
+    constexpr uint32 ShaderBits = 12;
+    constexpr uint32 MaterialBits = 16;
+    constexpr uint32 MeshBits = 16;
+    constexpr uint32 DepthBits = 16;
+
+    // 0 은 nullptr 용으로 남겨 둔다
+    // UUID 만 읽으므로 템플릿으로 두어 이 헤더가 UObject 계층(pch)에 묶이지 않게 한다 (호출 측에서 완전한 타입으로 인스턴스화)
+    template<typename TObject>
+    uint32 GetObjectId(const TObject* Object, uint32 Bits)
+    {
+        return Object ? static_cast<uint32>((Object->UUID % ((1ull << Bits) - 1ull)) + 1) : 0u;
+    }
+    template<typename TShader> uint32 GetShaderId(const TShader* Shader) { return GetObjectId(Shader, ShaderBits); }
+    template<typename TMaterial> uint32 GetMaterialId(const TMaterial* Material) { return GetObjectId(Material, MaterialBits); }
+    template<typename TMesh> uint32 GetMeshId(const TMesh* Mesh) { return GetObjectId(Mesh, MeshBits); }
+    uint32 QuantizeDepth(float ViewDepth);
+
+    uint64 Make(ERenderPass Pass, uint32 ShaderId, uint32 MaterialId, uint32 MeshId, float ViewDepth);
+    inline ERenderPass GetPass(uint64 Key) { return static_cast<ERenderPass>(Key >> (64 - PassBits)); }
+}
+
+// 행벡터 뷰 행렬(p' = p * View) 기준 뷰 공간 깊이
+inline float ComputeViewDepth(const FMatrix& View, const FVector& WorldPos)
+{
+    return WorldPos.X * View.M[0][2] + WorldPos.Y * View.M[1][2] + WorldPos.Z * View.M[2][2] + View.M[3][2];
+}
+
+// 드로우 한 번 (메시 섹션 하나). 트랜스폼은 리스트의 Transforms 배열 인덱스로 참조
+struct FDrawCommand
+{
+    uint64 SortKey = 0;
+    UShader* Shader = nullptr;
+    UMaterial* Material = nullptr;     // nullptr 이면 머티리얼 없는 메시 (기본 픽셀 상수)
+    UStaticMesh* Mesh = nullptr;
+    uint32 StartIndex = 0;
+    uint32 IndexCount = 0;
+    uint32 TransformIndex = 0;
+    uint32 Padding = 0;
+};
+static_assert(sizeof(FDrawCommand) <= 48, "FDrawCommand 는 고정 크기 48바이트 이하 (x64 기준 48)");
+
+// 상수 링의 뷰 블록 (StaticMeshShader 의 b1 ViewProjBuffer 와 같은 배치)
+struct FViewConstants
+{
+    FMatrix View;
+    FMatrix Proj;
+};
+
+// 정렬된 커맨드의 제출 단위
+//  - bInstanced 면 같은 섹션 InstanceCount 개를 한 번에 그리고, 트랜스폼은 InstanceTransforms[FirstInstance..] 에 있다
+//  - 아니면 FirstCommand 하나를 DrawTransforms[FirstInstance] 로 그린다
+struct FDrawBatch
+{
+    uint32 FirstCommand = 0;    // 대표 커맨드 (Commands 인덱스)
+    uint32 FirstInstance = 0;   // 인스턴스 배치면 InstanceTransforms, 아니면 DrawTransforms 인덱스
+    uint32 InstanceCount = 1;
+    bool bInstanced = false;
+};
+
+class FDrawCommandList
+{
+public:
+    void Reset();
+    void Reserve(int32 NumCommands, int32 NumTransforms);
+
+    uint32 AddTransform(const FMatrix& World)
+    {
+        Transforms.push_back(World);
+        return static_cast<uint32>(Transforms.size() - 1);
+    }
+    void AddCommand(const FDrawCommand& Command) { Commands.push_back(Command); }
+    // 다른 리스트(워커별 서브 리스트)의 커맨드/트랜스폼을 뒤에 이어 붙인다 (트랜스폼 인덱스는 다시 매김)
+    void Append(const FDrawCommandList& Other);
+
+    // 키 오름차순으로 정렬하고 제출 배치를 만든다 (같은 키는 추가한 순서 유지)
+    // 같은 셰이더/머티리얼/메시/섹션이 MinInstances 개 이상이면 인스턴스 배치 하나로 합친다 (0 이면 합치지 않음, 반투명 패스는 항상 개별)
+    void Sort(uint32 MinInstances = 2);
+
+    int32 Num() const { return static_cast<int32>(Commands.size()); }
+    bool IsEmpty() const { return Commands.empty(); }
+    const TArray<FDrawCommand>& GetCommands() const { return Commands; }
+    const TArray<FMatrix>& GetTransforms() const { return Transforms; }
+    const FMatrix& GetTransform(uint32 Index) const { return Transforms[Index]; }
+    // 이하 Sort 이후 유효
+    const TArray<uint32>& GetSortedOrder() const { return SortedOrder; }
+    const TArray<FDrawBatch>& GetBatches() const { return Batches; }
+    const TArray<FMatrix>& GetInstanceTransforms() const { return InstanceTransforms; }
+    const TArray<FMatrix>& GetDrawTransforms() const { return DrawTransforms; }
+
+private:
+    TArray<FDrawCommand> Commands;
+    TArray<FMatrix> Transforms;
+
+    // 정렬 작업 버퍼 (프레임마다 재할당하지 않도록 유지)
+    TArray<uint64> SortKeys;
+    TArray<uint32> SortedOrder;
+
+    TArray<FDrawBatch> Batches;
+    TArray<FMatrix> InstanceTransforms;     // 인스턴스 배치 트랜스폼 (배치 순서대로 연속, 인스턴스 버퍼로 그대로 올린다)
+    TArray<FMatrix> DrawTransforms;         // 단일 드로우 트랜스폼 (제출 순서대로 연속, 상수 링으로 그대로 올린다)
+    TArray<uint32> SectionMembers;          // 배치 구성 작업 버퍼
+
+    void BuildBatches(uint32 MinInstances);
+    void AddSingleBatch(uint32 CommandIndex);
+    void AddInstancedBatch(const uint32* CommandIndices, uint32 Count);
+};
+
+// ------------------------------------------------------------
+// 제출 대상 인터페이스. D3D11 구현은 URenderer 쪽(FRendererDrawBackend)
+// ------------------------------------------------------------
+class FRHIDrawBackend
+{
+public:
+    virtual ~FRHIDrawBackend() = default;
+
+    virtual void BeginDrawList(const FMatrix& View, const FMatrix& Proj) = 0;
+    virtual void SetShader(UShader* Shader) = 0;
+    virtual void SetMesh(UStaticMesh* Mesh) = 0;
+    virtual void SetMaterial(UMaterial* Material) = 0;
+    virtual void SetTransform(const FMatrix& World) = 0;
+    virtual void DrawIndexed(uint32 IndexCount, uint32 StartIndex) = 0;
+    virtual void EndDrawList() = 0;
+
+    // 인스턴싱: 지원하지 않는 셰이더의 인스턴스 배치는 제출기가 개별 드로우로 풀어서 넘긴다
+    virtual bool SupportsInstancing(const UShader* Shader) const = 0;
+    // 드로우 리스트의 인스턴스 트랜스폼 전체 (BeginDrawList 직후 한 번)
+    virtual void SetInstanceTransforms(const FMatrix* Transforms, uint32 Count) = 0;
+    virtual void DrawIndexedInstanced(uint32 IndexCount, uint32 StartIndex, uint32 InstanceCount, uint32 FirstInstance) = 0;
+
+    // 상수 링: 드로우 리스트의 상수 블록 전체(Bytes)를 쓸 곳을 매핑한다 (OutOffset 은 링 안의 바이트 오프셋)
+    // 링이 없거나 못 담으면 nullptr 이고, 제출기는 SetTransform(개별 업데이트)으로 폴백한다
+    virtual uint8* MapConstants(uint32 Bytes, uint32& OutOffset) = 0;
+    virtual void UnmapConstants() = 0;
+    virtual void SetViewConstants(uint32 Offset) = 0;       // FViewConstants 블록
+    virtual void SetTransformConstants(uint32 Offset) = 0;  // 월드 행렬 블록
+};
+
+struct FDrawSubmitStats
+{
+    uint32 Commands = 0;
+    uint32 DrawCalls = 0;
+    uint32 ShaderBinds = 0;
+    uint32 MaterialBinds = 0;
+    uint32 MeshBinds = 0;
+    uint32 TransformUpdates = 0;
+    uint32 InstancedDraws = 0;      // DrawCalls 중 인스턴스 드로우
+    uint32 Instances = 0;           // 인스턴스 드로우로 그린 커맨드 수
+    uint32 ConstantBytes = 0;       // 상수 링에 쓴 바이트 (0 이면 개별 업데이트로 그림)
+
+    void Accumulate(const FDrawSubmitStats& Other)
+    {
+        Commands += Other.Commands;
+        DrawCalls += Other.DrawCalls;
+        ShaderBinds += Other.ShaderBinds;
+        MaterialBinds += Other.MaterialBinds;
+        MeshBinds += Other.MeshBinds;
+        TransformUpdates += Other.TransformUpdates;
+        InstancedDraws += Other.InstancedDraws;
+        Instances += Other.Instances;
+        ConstantBytes += Other.ConstantBytes;
+    }
+};
+
+// 정렬된 배치 순서대로 제출 (Sort 이후). 셰이더/메시/머티리얼/트랜스폼은 직전과 다를 때만 백엔드에 넘긴다
+FDrawSubmitStats SubmitDrawCommands(const FDrawCommandList& List, const FMatrix& View, const FMatrix& Proj, FRHIDrawBackend& Backend);
+
+// ------------------------------------------------------------
+// 기록/널 백엔드: GPU 없이 호출 순서와 횟수만 남긴다 (빌드/정렬 벤치마크, 제출 결과 검증용)
+// ------------------------------------------------------------
+enum class ERecordedDrawOp : uint8
+{
+    BeginDrawList,
+    SetShader,
+    SetMesh,
+    SetMaterial,
+    SetTransform,
+    DrawIndexed,
+    EndDrawList,
+    SetInstanceTransforms,
+    DrawIndexedInstanced,
+    MapConstants,
+    UnmapConstants,
+    SetViewConstants,
+    SetTransformConstants,
+    Count,
+};
+
+struct FRecordedDrawCall
+{
+    ERecordedDrawOp Op = ERecordedDrawOp::BeginDrawList;
+    const void* Object = nullptr;   // 바인딩한 셰이더/메시/머티리얼
+    uint32 A = 0;                   // DrawIndexed(Instanced): IndexCount, SetInstanceTransforms/MapConstants: Count/Bytes, Set*Transform*: 기록한 트랜스폼 인덱스
+    uint32 B = 0;                   // DrawIndexed(Instanced): StartIndex, 상수 링: 오프셋
+    uint32 C = 0;                   // DrawIndexedInstanced: InstanceCount, MapConstants: DISCARD 여부
+    uint32 D = 0;                   // DrawIndexedInstanced: FirstInstance
+};
+
+class FRecordingDrawBackend : public FRHIDrawBackend
+{
+public:
+    // false 면 호출 횟수만 센다 (널 백엔드)
+    explicit FRecordingDrawBackend(bool bInRecordCalls = true, bool bInSupportsInstancing = true)
+        : bRecordCalls(bInRecordCalls), bSupportsInstancing(bInSupportsInstancing) {}
+
+    void Reset();
+
+    // 상수 링을 CPU 메모리로 흉내 낸다 (0 이면 링 없음 → 제출기가 SetTransform 으로 폴백)
+    void EnableConstantRing(uint32 Capacity);
+    // 프레임 경계: 링 커서를 되돌리고 필요하면 키운다
+    void BeginFrame();
+    const FConstantRingAllocator& GetConstantRing() const { return ConstantRing; }
+
+    void BeginDrawList(const FMatrix& View, const FMatrix& Proj) override;
+    void SetShader(UShader* Shader) override;
+    void SetMesh(UStaticMesh* Mesh) override;
+    void SetMaterial(UMaterial* Material) override;
+    void SetTransform(const FMatrix& World) override;
+    void DrawIndexed(uint32 IndexCount, uint32 StartIndex) override;
+    void EndDrawList() override;
+    bool SupportsInstancing(const UShader* Shader) const override { return bSupportsInstancing; }
+    void SetInstanceTransforms(const FMatrix* Transforms, uint32 Count) override;
+    void DrawIndexedInstanced(uint32 IndexCount, uint32 StartIndex, uint32 InstanceCount, uint32 FirstInstance) override;
+    uint8* MapConstants(uint32 Bytes, uint32& OutOffset) override;
+    void UnmapConstants() override;
+    void SetViewConstants(uint32 Offset) override;
+    void SetTransformConstants(uint32 Offset) override;
+
+    const TArray<FRecordedDrawCall>& GetCalls() const { return Calls; }
+    const TArray<FMatrix>& GetTransforms() const { return RecordedTransforms; }
+    const TArray<FMatrix>& GetInstanceTransforms() const { return RecordedInstanceTransforms; }
+    // SetViewConstants 로 바인딩한 링 내용
+    const TArray<FViewConstants>& GetViewConstants() const { return RecordedViewConstants; }
+    uint32 GetOpCount(ERecordedDrawOp Op) const { return OpCounts[static_cast<int>(Op)]; }
+
+private:
+    void Record(ERecordedDrawOp Op, const void* Object = nullptr, uint32 A = 0, uint32 B = 0, uint32 C = 0, uint32 D = 0);
+
+    bool bRecordCalls = true;
+    bool bSupportsInstancing = true;
+    TArray<FRecordedDrawCall> Calls;
+    TArray<FMatrix> RecordedTransforms;
+    TArray<FMatrix> RecordedInstanceTransforms;
+    TArray<FViewConstants> RecordedViewConstants;
+
+    FConstantRingAllocator ConstantRing;
+    TArray<uint8> ConstantRingMemory;
+    bool bConstantRingEnabled = false;
+    uint32 OpCounts[static_cast<int>(ERecordedDrawOp::Count)] = {};
+};
@@ -8,6 +8,7 @@
 #include "CameraActor.h"
 #include "CameraComponent.h"
 #include "PrimitiveComponent.h"
+#include "JobSystem.h"
 #include "StaticMeshActor.h"
 #include "StaticMeshComponent.h"
 #include "TextRenderComponent.h"
@@ -23,6 +24,7 @@
 #include "Material.h"
 #include "Texture.h"
 #include "RenderSettings.h"
+#include "PlatformTime.h"
 #include "SelectionManager.h"
 #include <EditorEngine.h>
 
@@ -38,6 +40,55 @@
 #include "GizmoRotateComponent.h"
 #include "GizmoScaleComponent.h"
 
+namespace
+{
+	// Plane 은 정렬 패딩이 있어 memcmp 대신 성분별로 비교
+	bool IsSameFrustum(const Frustum& A, const Frustum& B)
+	{
+		const Plane* PA = &A.TopFace;
+		const Plane* PB = &B.TopFace;
+		for (int32 i = 0; i < 6; ++i)
+		{
+			if (PA[i].Normal.X != PB[i].Normal.X || PA[i].Normal.Y != PB[i].Normal.Y ||
+				PA[i].Normal.Z != PB[i].Normal.Z || PA[i].Distance != PB[i].Distance)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool IsSameScreenSize(const FScreenSizeCullParams& A, const FScreenSizeCullParams& B)
+	{
+		return A.PixelScale == B.PixelScale && A.bOrthographic == B.bOrthographic &&
+			A.ThresholdScale == B.ThresholdScale && A.MinPixels == B.MinPixels && A.MaxPixels == B.MaxPixels &&
+			A.ViewOrigin.X == B.ViewOrigin.X && A.ViewOrigin.Y == B.ViewOrigin.Y && A.ViewOrigin.Z == B.ViewOrigin.Z;
+	}
+
+	// FMatrix::operator== 는 허용 오차 비교라 미세하게 움직이는 카메라를 같은 뷰로 본다. 캐시 키는 정확히 비교
+	bool IsSameMatrix(const FMatrix& A, const FMatrix& B)
+	{
+		for (int32 i = 0; i < 4; ++i)
+		{
+			for (int32 j = 0; j < 4; ++j)
+			{
+				if (A.M[i][j] != B.M[i][j]) return false;
+			}
+		}
+		return true;
+	}
+
+	// 오클루전은 히스테리시스가 있어 같은 키로 두 번 이상 돌려 상태가 수렴한 뒤에만 재사용
+	constexpr int32 ViewVisibilitySettlePasses = 2;
+
+	float GetViewportAspectRatio(FViewport* Viewport)
+	{
+		float AspectRatio = static_cast<float>(Viewport->GetSizeX()) / static_cast<float>(Viewport->GetSizeY());
+		if (Viewport->GetSizeY() == 0) AspectRatio = 1.0f; // 0으로 나누기 방지
+		return AspectRatio;
+	}
+}
+
 URenderManager::URenderManager()
 	: OcclusionCPU(new FOcclusionCullingManagerCPU())
 {
@@ -50,7 +101,7 @@ URenderManager::~URenderManager()
 bool URenderManager::ShouldRenderComponent(UPrimitiveComponent* Primitive) const
 {
 	if (!Primitive || !World) return false;
-	if (!Primitive->IsActive() || Primitive->GetCulled())
+	if (!Primitive->IsActive())
 		return false;
 	
 	// 기본 Primitive 플래그 체크
@@ -146,17 +197,22 @@ void URenderManager::RenderViewports(ACameraActor* Camera, FViewport* Viewport)
 	// === 2. Begin Line Batch for all actors ===
 	Renderer->BeginLineBatch();
 
-	// === 3. 컴링 단계 ===
-	PerformFrustumCulling(ViewFrustum);
+	// 오클루전을 건너뛰는 패스도 세어 두어야 끊긴 히스토리를 알아챈다
+	++ViewRenderPasses[Viewport];
+
+	// === 3~4. 컬링 단계 (카메라와 월드가 그대로면 지난 결과 재사용) ===
+	const FViewVisibilityKey VisibilityKey = MakeViewVisibilityKey(World, Camera, Viewport, ViewMatrix, ProjectionMatrix);
+	if (!RestoreViewVisibility(Viewport, VisibilityKey))
+	{
+		PerformFrustumCulling(Viewport, ViewFrustum, MakeScreenSizeCullParams(World, Camera, Viewport, ProjectionMatrix));
+		PerformOcclusionCulling(Viewport, ViewFrustum, ViewMatrix, ProjectionMatrix, zNear, zFar);
+		StoreViewVisibility(Viewport, VisibilityKey);
+	}
 	
 	Renderer->UpdateHighLightConstantBuffer(false, rgb, 0, 0, 0, 0);
 	
-	// === 4. 오클루전 컬링 ===
-	PerformOcclusionCulling(Viewport, ViewFrustum, ViewMatrix, ProjectionMatrix, zNear, zFar);
-	
 	// === 5. 액터 렌더링 ===
     RenderGameActors(ViewMatrix, ProjectionMatrix, EffectiveViewMode, visibleCount);
-    //RenderWithMaterialSorting(ViewMatrix, ProjectionMatrix, EffectiveViewMode, visibleCount);
 
 	// === 6. 에디터 전용 액터 렌더링 ===
 	RenderEditorActors(ViewMatrix, ProjectionMatrix, EffectiveViewMode);
@@ -176,224 +232,12 @@ void URenderManager::RenderViewports(ACameraActor* Camera, FViewport* Viewport)
 	}
 }
 
-// ==================== Material Sorting Implementation ====================
-void URenderManager::RenderWithMaterialSorting(const FMatrix& ViewMatrix, const FMatrix& ProjectionMatrix, 
-                                               EViewModeIndex EffectiveViewMode, int& visibleCount)
-{
-    if (!World->GetRenderSettings().IsShowFlagEnabled(EEngineShowFlags::SF_Primitives))
-        return;
-        
-    // 1. 렌더 배치 수집
-    TArray<FRenderBatch> RenderBatches;
-    CollectRenderBatches(RenderBatches);
-    
-    // 2. 머티리얼별로 소팅
-    SortRenderBatches(RenderBatches);
-    
-    // 3. 배치 실행
-    ExecuteRenderBatches(RenderBatches, ViewMatrix, ProjectionMatrix, visibleCount);
-}
-
-void URenderManager::CollectRenderBatches(TArray<FRenderBatch>& OutBatches)
-{
-    OutBatches.clear();
-    
-    // 머티리얼별로 배치를 그룹화하기 위한 맵
-    std::unordered_map<UMaterial*, std::unordered_map<UStaticMesh*, FRenderBatch*>> BatchMap;
-    
-    for (AActor* Actor : World->GetActors())
-    {
-        if (!Actor || Actor->GetActorHiddenInGame()) continue;
-        
-        // CPU 오클루전 컴링 처리
-        if (bUseCPUOcclusion)
-        {
-            uint32_t id = Actor->UUID;
-            if (id < VisibleFlags.size() && VisibleFlags[id] == 0)
-            {
-                continue; // 가려짐 → 스킵
-            }
-        }
-        
-        for (USceneComponent* Component : Actor->GetSceneComponents())
-        {
-            UStaticMeshComponent* StaticMeshComp = Cast<UStaticMeshComponent>(Component);
-            if (!StaticMeshComp || !ShouldRenderComponent(StaticMeshComp))
-                continue;
-            
-            // 프러스텀 컴링 체크 - UPrimitiveComponent에서 상속된 GetCulled() 사용
-            if (StaticMeshComp->GetCulled()) 
-            {
-                continue; // 프러스텀 밖에 있음 → 스킵
-            }
-                
-            UStaticMesh* Mesh = StaticMeshComp->GetStaticMesh();
-            UMaterial* Material = StaticMeshComp->GetMaterial();
-            
-            if (!Mesh || !Material) continue;
-            
-            // 배치 찾기 또는 생성
-            auto& MaterialMap = BatchMap[Material];
-            FRenderBatch* Batch = MaterialMap[Mesh];
-            
-            if (!Batch)
-            {
-                // 새로운 배치 생성 - Material과 Mesh가 모두 유효함을 이미 확인
-                OutBatches.emplace_back(Material, Mesh);
-                Batch = &OutBatches.back();
-                Batch->MaterialSortKey = GenerateMaterialSortKey(Material);
-                MaterialMap[Mesh] = Batch;
-            }
-            
-            // 유효한 컴포넌트만 배치에 추가
-            Batch->Components.push_back(StaticMeshComp);
-        }
-    }
-}
-
-void URenderManager::SortRenderBatches(TArray<FRenderBatch>& Batches)
-{
-    // 머티리얼 소팅 키로 정렬
-    std::sort(Batches.begin(), Batches.end(), 
-        [](const FRenderBatch& a, const FRenderBatch& b) {
-            return a.MaterialSortKey < b.MaterialSortKey;
-        });
-}
-
-void URenderManager::ExecuteRenderBatches(const TArray<FRenderBatch>& Batches, const FMatrix& ViewMatrix, 
-                                         const FMatrix& ProjectionMatrix, int& visibleCount)
-{
-    UMaterial* CurrentMaterial = nullptr;
-    UStaticMesh* CurrentMesh = nullptr;
-    URHIDevice* RHIDevice = Renderer->GetRHIDevice();
-    
-    for (const FRenderBatch& Batch : Batches)
-    {
-        // 배치 유효성 체크
-        if (Batch.Components.empty() || !Batch.Material || !Batch.StaticMesh) 
-        {
-            continue; // 비어있거나 null 데이터가 있으면 스킵
-        }
-        
-        // 머티리얼 변경 처리
-        if (CurrentMaterial != Batch.Material)
-        {
-            CurrentMaterial = Batch.Material;
-            
-            // 머티리얼 설정
-            if (CurrentMaterial)
-            {
-                const FObjMaterialInfo& MaterialInfo = CurrentMaterial->GetMaterialInfo();
-                bool bHasTexture = !MaterialInfo.DiffuseTextureFileName.empty();
-                
-                if (bHasTexture)
-                {
-                    FWideString WTextureFileName(MaterialInfo.DiffuseTextureFileName.begin(), 
-                                               MaterialInfo.DiffuseTextureFileName.end());
-                    FTextureData* TextureData = UResourceManager::GetInstance().CreateOrGetTextureData(WTextureFileName);
-                    if (TextureData)
-                    {
-                        RHIDevice->GetDeviceContext()->PSSetShaderResources(0, 1, &(TextureData->TextureSRV));
-                    }
-                }
-                
-                RHIDevice->UpdatePixelConstantBuffers(MaterialInfo, true, bHasTexture);
-                Renderer->PrepareShader(CurrentMaterial->GetShader());
-            }
-        }
-        
-        // 메시 변경 처리
-        if (CurrentMesh != Batch.StaticMesh)
-        {
-            CurrentMesh = Batch.StaticMesh;
-            
-            if (CurrentMesh)
-            {
-                // 버텍스/인덱스 버퍼 설정
-                UINT stride = sizeof(FVertexDynamic);
-                UINT offset = 0;
-                
-                ID3D11Buffer* VertexBuffer = CurrentMesh->GetVertexBuffer();
-                ID3D11Buffer* IndexBuffer = CurrentMesh->GetIndexBuffer();
-                
-                RHIDevice->GetDeviceContext()->IASetVertexBuffers(0, 1, &VertexBuffer, &stride, &offset);
-                RHIDevice->GetDeviceContext()->IASetIndexBuffer(IndexBuffer, DXGI_FORMAT_R32_UINT, 0);
-                RHIDevice->GetDeviceContext()->IASetPrimitiveTopology(D3D10_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-                RHIDevice->PSSetDefaultSampler(0);
-            }
-        }
-        
-        // 인스턴스 렌더링 (메시가 유효할 때만)
-        if (!CurrentMesh)
-        {
-            continue; // 메시가 null이면 스킵
-        }
-        
-        for (UStaticMeshComponent* Component : Batch.Components)
-        {
-            if (!Component) continue;
-            
-            // 변환 행렬 업데이트
-            Renderer->UpdateConstantBuffer(Component->GetWorldMatrix(), ViewMatrix, ProjectionMatrix);
-            
-            // 렌더링 실행 - CurrentMesh가 이미 null 체크됨
-            if (CurrentMesh->HasMaterial())
-            {
-                for (const FGroupInfo& GroupInfo : CurrentMesh->GetMeshGroupInfo())
-                {
-                    RHIDevice->GetDeviceContext()->DrawIndexed(GroupInfo.IndexCount, GroupInfo.StartIndex, 0);
-                }
-            }
-            else
-            {
-                uint32 IndexCount = CurrentMesh->GetIndexCount();
-                RHIDevice->GetDeviceContext()->DrawIndexed(IndexCount, 0, 0);
-            }
-            
-            visibleCount++;
-        }
-    }
-}
-
-int URenderManager::GenerateMaterialSortKey(UMaterial* Material) const
-{
-    if (!Material) return 0;
-    
-    // 머티리얼 속성에 기반한 소팅 키 생성
-    int SortKey = 0;
-    const FObjMaterialInfo& MaterialInfo = Material->GetMaterialInfo();
-    
-    // 1. 비투명도 (비투명 객체를 나중에 렌더링)
-    // Transparency 사용 (-1.f는 지정되지 않음을 의미)
-    bool bIsTransparent = (MaterialInfo.Transparency >= 0.0f && MaterialInfo.Transparency < 1.0f);
-    SortKey |= (bIsTransparent ? 1 : 0) << 31; // 최상위 비트
-    
-    // 2. 셰이더 포인터 기반 소팅 (셰이더 객체 자체를 해시)
-    if (Material->GetShader())
-    {
-        // 셰이더 객체의 포인터 값을 이용한 소팅
-        size_t ShaderHash = reinterpret_cast<size_t>(Material->GetShader());
-        SortKey |= ((ShaderHash >> 4) & 0xFF) << 16; // 상위 8비트 사용
-    }
-    
-    // 3. 텍스처 사용 여부
-    bool bHasTexture = !MaterialInfo.DiffuseTextureFileName.empty();
-    SortKey |= (bHasTexture ? 1 : 0) << 15;
-    
-    // 4. 머티리얼 자체의 해시값 (충돌 방지를 위해 하위 비트 사용)
-    size_t MaterialHash = std::hash<UMaterial*>{}(Material);
-    SortKey |= (MaterialHash & 0x7FFF); // 하위 15비트
-    
-    return SortKey;
-}
-
 void URenderManager::SetupRenderState(ACameraActor* Camera, FViewport* Viewport, 
                                      FMatrix& OutViewMatrix, FMatrix& OutProjectionMatrix, 
                                      Frustum& OutViewFrustum, EViewModeIndex& OutEffectiveViewMode)
 {
     // 뷰포트의 실제 크기로 aspect ratio 계산
-    float ViewportAspectRatio = static_cast<float>(Viewport->GetSizeX()) / static_cast<float>(Viewport->GetSizeY());
-    if (Viewport->GetSizeY() == 0) ViewportAspectRatio = 1.0f; // 0으로 나누기 방지
+    const float ViewportAspectRatio = GetViewportAspectRatio(Viewport);
     
     // Provide per-viewport size to renderer (used by overlay/gizmo scaling)
     Renderer->SetCurrentViewportSize(Viewport->GetSizeX(), Viewport->GetSizeY());
@@ -416,24 +260,242 @@ void URenderManager::SetupRenderState(ACameraActor* Camera, FViewport* Viewport,
     Renderer->SetViewModeType(OutEffectiveViewMode);
 }
 
-void URenderManager::PerformFrustumCulling(const Frustum& ViewFrustum)
+void URenderManager::BeginSharedViewCulling(const TArray<FViewport*>& InViewports)
 {
-    // 모든 액터의 컴포넌트를 culled로 설정
-    for (AActor* Actor : World->GetActors())
-    {
-        for (auto& Comp : Actor->GetSceneComponents())
-        {
-            if (UPrimitiveComponent* Prim = Cast<UPrimitiveComponent>(Comp))
-            {
-                Prim->SetCulled(true);
-            }
-        }
-    }
-    
-    // Partition Manager를 통한 frustum query로 가시성 검사
+	EndSharedViewCulling();
+
+	// 프레임마다 한 번 불리므로 여기서 캐시 통계를 넘긴다
+	LastViewCacheHits = ViewCacheHits;
+	LastViewCacheMisses = ViewCacheMisses;
+	ViewCacheHits = ViewCacheMisses = 0;
+
+	LastDrawStats = DrawStats;
+	LastLegacyDrawPrimitives = LegacyDrawCount;
+	LastDrawListBuildMs = DrawListBuildMs;
+	LastDrawListSortMs = DrawListSortMs;
+	DrawStats = FDrawSubmitStats();
+	LegacyDrawCount = 0;
+	DrawListBuildMs = DrawListSortMs = 0.0;
+
+	for (FViewport* Viewport : InViewports)
+	{
+		if (SharedCullViewports.Num() >= FBVHierachy::MaxMultiViews) break;
+
+		FViewportClient* Client = Viewport ? Viewport->GetViewportClient() : nullptr;
+		if (!Client || !Client->GetWorld() || !Client->GetCamera()) continue;
+		if (SharedCullWorld && Client->GetWorld() != SharedCullWorld) continue;
+
+		UCameraComponent* CamComp = Client->GetCamera()->GetCameraComponent();
+		if (!CamComp) continue;
+
+		// Draw 에서 적용될 카메라 상태를 미리 맞춰서 같은 프러스텀을 얻는다
+		Client->ApplyViewportCamera();
+		const float AspectRatio = GetViewportAspectRatio(Viewport);
+
+		// 캐시로 컬링을 건너뛸 뷰포트는 공유 쿼리에서도 뺀다
+		ACameraActor* Camera = Client->GetCamera();
+		const FViewVisibilityKey Key = MakeViewVisibilityKey(Client->GetWorld(), Camera, Viewport,
+			Camera->GetViewMatrix(), Camera->GetProjectionMatrix(AspectRatio, Viewport));
+		if (IsViewVisibilityCached(Viewport, Key)) continue;
+
+		SharedCullWorld = Client->GetWorld();
+		SharedCullViewports.Add(Viewport);
+		SharedCullFrustums.Add(CreateFrustumFromCamera(*CamComp, AspectRatio));
+		SharedCullScreenSizes.Add(MakeScreenSizeCullParams(SharedCullWorld, Client->GetCamera(), Viewport,
+			Client->GetCamera()->GetProjectionMatrix(AspectRatio, Viewport)));
+	}
+
+	// 뷰가 하나면 일반 단일 쿼리와 같으므로 공유하지 않는다
+	if (SharedCullViewports.Num() < 2 || !SharedCullWorld->GetPartitionManager())
+	{
+		EndSharedViewCulling();
+		return;
+	}
+
+	SharedCullWorld->GetPartitionManager()->FrustumQueryMulti(SharedCullFrustums, SharedCullPrimitives, SharedCullViewMasks, &SharedCullScreenSizes);
+}
+
+bool URenderManager::FViewVisibilityKey::operator==(const FViewVisibilityKey& Other) const
+{
+	return World == Other.World && SizeX == Other.SizeX && SizeY == Other.SizeY &&
+		SceneGeneration == Other.SceneGeneration && ScreenSizeCullRevision == Other.ScreenSizeCullRevision &&
+		ScreenSizeCullScale == Other.ScreenSizeCullScale &&
+		bOcclusion == Other.bOcclusion && OcclusionRevision == Other.OcclusionRevision &&
+		IsSameMatrix(View, Other.View) && IsSameMatrix(Proj, Other.Proj);
+}
+
+void URenderManager::SetViewVisibilityCacheEnabled(bool bEnabled)
+{
+	bUseViewVisibilityCache = bEnabled;
+	if (!bEnabled) ViewVisibilityCaches.clear();
+}
+
+URenderManager::FViewVisibilityKey URenderManager::MakeViewVisibilityKey(UWorld* InWorld, ACameraActor* Camera, FViewport* Viewport,
+	const FMatrix& ViewMatrix, const FMatrix& ProjectionMatrix) const
+{
+	FViewVisibilityKey Key;
+	Key.World = InWorld;
+	Key.View = ViewMatrix;
+	Key.Proj = ProjectionMatrix;
+	Key.SizeX = static_cast<int32>(Viewport->GetSizeX());
+	Key.SizeY = static_cast<int32>(Viewport->GetSizeY());
+	if (InWorld)
+	{
+		if (UWorldPartitionManager* Partition = InWorld->GetPartitionManager())
+		{
+			Key.SceneGeneration = Partition->GetSceneGeneration();
+		}
+		Key.ScreenSizeCullRevision = InWorld->GetRenderSettings().GetScreenSizeCullRevision();
+	}
+	if (const FViewportClient* Client = Viewport->GetViewportClient())
+	{
+		Key.ScreenSizeCullScale = Client->GetScreenSizeCullScale();
+	}
+	Key.bOcclusion = bUseCPUOcclusion;
+	Key.OcclusionRevision = bUseCPUOcclusion ? OcclusionCPU->GetSettingsRevision() : 0;
+	return Key;
+}
+
+bool URenderManager::IsViewVisibilityCached(FViewport* Viewport, const FViewVisibilityKey& Key) const
+{
+	if (!bUseViewVisibilityCache) return false;
+	const FViewVisibilityCache* Cache = ViewVisibilityCaches.Find(Viewport);
+	return Cache && Cache->bValid && Cache->Key == Key;
+}
+
+bool URenderManager::RestoreViewVisibility(FViewport* Viewport, const FViewVisibilityKey& Key)
+{
+	if (!IsViewVisibilityCached(Viewport, Key))
+	{
+		++ViewCacheMisses;
+		return false;
+	}
+	++ViewCacheHits;
+
+	const FViewVisibilityCache& Cache = ViewVisibilityCaches[Viewport];
+	VisiblePrimitives = Cache.Primitives;
+
+	// VisibleFlags 는 뷰포트끼리 공유하므로 이 뷰의 판정으로 되돌린다
+	if (Key.bOcclusion)
+	{
+		for (int32 i = 0; i < Cache.Primitives.Num(); ++i)
+		{
+			AActor* Owner = Cache.Primitives[i]->GetOwner();
+			if (!Owner) continue;
+			const uint32 Id = Owner->UUID;
+			if (VisibleFlags.size() <= size_t(Id)) VisibleFlags.resize(size_t(Id) + 1, 1);
+			VisibleFlags[Id] = Cache.OcclusionFlags[i];
+		}
+	}
+	return true;
+}
+
+void URenderManager::StoreViewVisibility(FViewport* Viewport, const FViewVisibilityKey& Key)
+{
+	if (!bUseViewVisibilityCache) return;
+
+	FViewVisibilityCache& Cache = ViewVisibilityCaches[Viewport];
+	if (Cache.StableCount > 0 && Cache.Key == Key)
+	{
+		++Cache.StableCount;
+	}
+	else
+	{
+		Cache.Key = Key;
+		Cache.StableCount = 1;
+	}
+
+	// 오클루전은 히스테리시스로 보류 중인 전환이 없어야 다음 패스도 같은 결과를 낸다
+	const bool bSettled = !Key.bOcclusion ||
+		(Cache.StableCount >= ViewVisibilitySettlePasses && OcclusionCPU->GetLastStats().PendingTransitions == 0);
+	Cache.bValid = bSettled;
+	if (!bSettled) return;
+
+	Cache.Primitives = VisiblePrimitives;
+	Cache.OcclusionFlags.clear();
+	if (Key.bOcclusion)
+	{
+		Cache.OcclusionFlags.reserve(VisiblePrimitives.size());
+		for (UPrimitiveComponent* Primitive : VisiblePrimitives)
+		{
+			AActor* Owner = Primitive->GetOwner();
+			const uint32 Id = Owner ? Owner->UUID : 0;
+			Cache.OcclusionFlags.push_back((Owner && Id < VisibleFlags.size()) ? VisibleFlags[Id] : 1);
+		}
+	}
+}
+
+void URenderManager::EndSharedViewCulling()
+{
+	SharedCullWorld = nullptr;
+	SharedCullViewports.clear();
+	SharedCullFrustums.clear();
+	SharedCullScreenSizes.clear();
+	SharedCullPrimitives.clear();
+	SharedCullViewMasks.clear();
+}
+
+FScreenSizeCullParams URenderManager::MakeScreenSizeCullParams(const UWorld* InWorld, ACameraActor* Camera, FViewport* Viewport, const FMatrix& ProjectionMatrix) const
+{
+	FScreenSizeCullParams Params;
+	if (!InWorld || !Camera || !Viewport) return Params;
+
+	const URenderSettings& Settings = InWorld->GetRenderSettings();
+	const FViewportClient* Client = Viewport->GetViewportClient();
+	const float Scale = Client ? Client->GetScreenSizeCullScale() : 1.0f;
+	if (!Settings.IsScreenSizeCullingEnabled() || Scale <= 0.0f) return Params;
+
+	// 거리 1 에서 길이 1 이 차지하는 세로 픽셀 (직교는 거리와 무관)
+	Params.PixelScale = ProjectionMatrix.M[1][1] * static_cast<float>(Viewport->GetSizeY()) * 0.5f;
+	Params.ViewOrigin = Camera->GetActorLocation();
+	if (UCameraComponent* CamComp = Camera->GetCameraComponent())
+	{
+		Params.bOrthographic = CamComp->GetProjectionMode() == ECameraProjectionMode::Orthographic;
+	}
+
+	Params.ThresholdScale = Scale;
+	Params.DefaultMinPixels = Settings.GetScreenSizeCullDefault();
+	Params.ClassMinPixels = &Settings.GetScreenSizeCullThresholds();
+	Params.MinPixels = Params.MaxPixels = Params.DefaultMinPixels;
+	for (const auto& Pair : Settings.GetScreenSizeCullThresholds())
+	{
+		Params.MinPixels = std::min(Params.MinPixels, Pair.second);
+		Params.MaxPixels = std::max(Params.MaxPixels, Pair.second);
+	}
+	Params.MinPixels *= Scale;
+	Params.MaxPixels *= Scale;
+	return Params;
+}
+
+void URenderManager::PerformFrustumCulling(FViewport* Viewport, const Frustum& ViewFrustum, const FScreenSizeCullParams& ScreenSize)
+{
+    // Partition Manager를 통한 frustum query로 보이는 프리미티브 목록 생성
+    VisiblePrimitives.clear();
+
+	// 멀티 뷰 컬링 결과가 이 뷰포트/프러스텀 그대로라면 자기 뷰 비트만 골라 쓴다
+	if (SharedCullWorld == World)
+	{
+		for (int32 v = 0; v < SharedCullViewports.Num(); ++v)
+		{
+			if (SharedCullViewports[v] != Viewport) continue;
+			if (!IsSameFrustum(SharedCullFrustums[v], ViewFrustum)) break;
+			if (!IsSameScreenSize(SharedCullScreenSizes[v], ScreenSize)) break;
+
+			const uint8 ViewBit = static_cast<uint8>(1u << v);
+			for (int32 i = 0; i < SharedCullPrimitives.Num(); ++i)
+			{
+				if (SharedCullViewMasks[i] & ViewBit)
+				{
+					VisiblePrimitives.push_back(SharedCullPrimitives[i]);
+				}
+			}
+			return;
+		}
+	}
+
     if (World->GetPartitionManager())
     {
-        World->GetPartitionManager()->FrustumQuery(ViewFrustum);
+        World->GetPartitionManager()->FrustumQuery(ViewFrustum, VisiblePrimitives, &ScreenSize);
     }
 }
 
@@ -445,9 +507,12 @@ void URenderManager::PerformOcclusionCulling(FViewport* Viewport, const Frustum&
     
     // 1) 그리드 사이즈 보정(해상도 변화 대응)
     UpdateOcclusionGridSizeForViewport(Viewport);
+    const uint32 SceneGeneration = World->GetPartitionManager() ? World->GetPartitionManager()->GetSceneGeneration() : 0;
+    OcclusionCPU->BeginView(Viewport, ViewRenderPasses[Viewport], SceneGeneration, ViewMatrix, ProjectionMatrix, zNear, zFar);
     
-    // 2) 오클루더/오클루디 수집
-    TArray<FCandidateDrawable> Occluders, Occludees;
+    // 2) 오클루더/오클루디 수집 (멤버 배열 재사용 → 정상 상태에서 재할당 없음)
+    TArray<FCandidateDrawable>& Occluders = OcclusionOccluders;
+    TArray<FCandidateDrawable>& Occludees = OcclusionOccludees;
     BuildCpuOcclusionSets(ViewFrustum, ViewMatrix, ProjectionMatrix, zNear, zFar,
         Occluders, Occludees);
     
@@ -463,6 +528,7 @@ void URenderManager::PerformOcclusionCulling(FViewport* Viewport, const Frustum&
         VisibleFlags.assign(size_t(maxUUID + 1), 1); // 기본 보임
     
     OcclusionCPU->TestOcclusion(Occludees, Viewport->GetSizeX(), Viewport->GetSizeY(), VisibleFlags);
+    OcclusionCPU->EndView(VisibleFlags);
 }
 
 void URenderManager::RenderGameActors(const FMatrix& ViewMatrix, const FMatrix& ProjectionMatrix, 
@@ -470,39 +536,93 @@ void URenderManager::RenderGameActors(const FMatrix& ViewMatrix, const FMatrix&
 {
     if (!World->GetRenderSettings().IsShowFlagEnabled(EEngineShowFlags::SF_Primitives))
         return;
-        
-    for (AActor* Actor : World->GetActors())
+
+    // 1. 커맨드 수집: 커맨드를 내는 프리미티브는 리스트로, 나머지는 기존 Render 경로로
+    //    프러스텀 컬링을 통과한 프리미티브를 청크로 나눠 워커마다 서브 리스트를 채운 뒤 청크 순서대로 합친다
+    //    합친 순서가 순회 순서 그대로이고 정렬이 안정 정렬이라, 키 순 결과는 스레드 수/청크 경계와 무관하다
+    FScopeCycleCounter BuildCounter;
+    DrawCommandList.Reset();
+    LegacyDrawPrimitives.clear();
+
+    const int32 NumVisible = static_cast<int32>(VisiblePrimitives.size());
+    const int32 ChunkCount = bUseParallelDrawListBuild ? FJobSystem::GetChunkCount(NumVisible, DrawListBuildMinBatch) : std::min(NumVisible, 1);
+    if (DrawListBuildChunks.size() < size_t(ChunkCount)) DrawListBuildChunks.resize(size_t(ChunkCount));
+
+    FJobSystem::ParallelForChunks(ChunkCount, [&](int32 Chunk)
     {
-        if (!Actor) continue;
-        if (Actor->GetActorHiddenInGame()) continue;
-        
-        // CPU 오클루전 컴링: UUID로 보임 여부 확인
-        if (bUseCPUOcclusion)
+        FDrawListBuildChunk& Out = DrawListBuildChunks[Chunk];
+        Out.Commands.Reset();
+        Out.LegacyPrimitives.clear();
+        Out.VisibleCount = 0;
+
+        const int32 Begin = static_cast<int32>(static_cast<int64>(NumVisible) * Chunk / ChunkCount);
+        const int32 End = static_cast<int32>(static_cast<int64>(NumVisible) * (Chunk + 1) / ChunkCount);
+        for (int32 i = Begin; i < End; ++i)
         {
-            uint32_t id = Actor->UUID;
-            if (id < VisibleFlags.size() && VisibleFlags[id] == 0)
+            if (BuildDrawCommands(VisiblePrimitives[i], ViewMatrix, Out.Commands, Out.LegacyPrimitives))
             {
-                continue; // 가려짐 → 스킵
+                Out.VisibleCount++;
             }
         }
-        
-        // 액터의 모든 컴포넌트 렌더링
-        for (USceneComponent* Component : Actor->GetSceneComponents())
+    });
+
+    for (int32 Chunk = 0; Chunk < ChunkCount; ++Chunk)
+    {
+        const FDrawListBuildChunk& C = DrawListBuildChunks[Chunk];
+        DrawCommandList.Append(C.Commands);
+        LegacyDrawPrimitives.insert(LegacyDrawPrimitives.end(), C.LegacyPrimitives.begin(), C.LegacyPrimitives.end());
+        visibleCount += C.VisibleCount;
+    }
+    DrawListBuildMs += FPlatformTime::ToMilliseconds(BuildCounter.Finish());
+
+    // 2. 정렬 키 순으로 제출 (바뀐 상태만 바인딩, 같은 메시 묶음은 인스턴스 드로우 하나)
+    if (!DrawCommandList.IsEmpty())
+    {
+        FScopeCycleCounter SortCounter;
+        DrawCommandList.Sort(bUseAutoInstancing ? MinInstanceCount : 0);
+        DrawListSortMs += FPlatformTime::ToMilliseconds(SortCounter.Finish());
+
+        Renderer->SetViewModeType(EffectiveViewMode);
+        FRendererDrawBackend Backend(Renderer, bUseConstantRing);
+        DrawStats.Accumulate(SubmitDrawCommands(DrawCommandList, ViewMatrix, ProjectionMatrix, Backend));
+        Renderer->OMSetDepthStencilState(EComparisonFunc::LessEqual);
+    }
+
+    // 3. 커맨드를 내지 않는 프리미티브
+    for (UPrimitiveComponent* Primitive : LegacyDrawPrimitives)
+    {
+        Renderer->SetViewModeType(EffectiveViewMode);
+        Primitive->Render(Renderer, ViewMatrix, ProjectionMatrix);
+        Renderer->OMSetDepthStencilState(EComparisonFunc::LessEqual);
+    }
+    LegacyDrawCount += static_cast<uint32>(LegacyDrawPrimitives.size());
+}
+
+bool URenderManager::BuildDrawCommands(UPrimitiveComponent* Primitive, const FMatrix& ViewMatrix,
+    FDrawCommandList& OutList, TArray<UPrimitiveComponent*>& OutLegacy) const
+{
+    AActor* Actor = Primitive->GetOwner();
+    if (!Actor) return false;
+    if (Actor->GetActorHiddenInGame()) return false;
+
+    // CPU 오클루전 컴링: UUID로 보임 여부 확인
+    if (bUseCPUOcclusion)
+    {
+        uint32_t id = Actor->UUID;
+        if (id < VisibleFlags.size() && VisibleFlags[id] == 0)
         {
-            if (UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Component))
-            {
-                if (ShouldRenderComponent(Primitive))
-                {
-                    Renderer->SetViewModeType(EffectiveViewMode);
-                    Primitive->Render(Renderer, ViewMatrix, ProjectionMatrix);
-                    Renderer->OMSetDepthStencilState(EComparisonFunc::LessEqual);
-                }
-                
-                if (!Primitive->GetCulled())
-                    visibleCount++;
-            }
+            return false; // 가려짐 → 스킵
+        }
+    }
+
+    if (ShouldRenderComponent(Primitive))
+    {
+        if (!bUseDrawCommandList || !Primitive->EmitDrawCommands(OutList, ViewMatrix))
+        {
+            OutLegacy.push_back(Primitive);
         }
     }
+    return true;
 }
 
 void URenderManager::RenderEditorActors(const FMatrix& ViewMatrix, const FMatrix& ProjectionMatrix, 
@@ -606,33 +726,24 @@ void URenderManager::BuildCpuOcclusionSets(
     OutOccluders.clear();
     OutOccludees.clear();
 
-    size_t estimatedCount = 0;
-    for (AActor* Actor : World->GetActors())
-    {
-        if (Actor && !Actor->GetActorHiddenInGame())
-        {
-            if (Actor->IsA<AStaticMeshActor>()) estimatedCount++;
-        }
-    }
-    OutOccluders.reserve(estimatedCount);
-    OutOccludees.reserve(estimatedCount);
+    // 프러스텀을 통과한 프리미티브만 후보 (전부 오클루디, 오클루더는 아래에서 선정)
+    OutOccludees.reserve(VisiblePrimitives.size());
 
     const FMatrix VP = View * Proj; // 행벡터: p_world * View * Proj
 
-    for (AActor* Actor : World->GetActors())
+    for (UPrimitiveComponent* Primitive : VisiblePrimitives)
     {
-        if (!Actor) continue;
-        if (Actor->GetActorHiddenInGame()) continue;
-
-        AStaticMeshActor* SMA = Cast<AStaticMeshActor>(Actor);
+        AStaticMeshActor* SMA = Cast<AStaticMeshActor>(Primitive->GetOwner());
         if (!SMA) continue;
+        if (SMA->GetActorHiddenInGame()) continue;
 
         UStaticMeshComponent* SMC = SMA->GetStaticMeshComponent();
-        if (!SMC || SMC->GetCulled()) continue;
+        if (!SMC || SMC != Primitive) continue;
+        AActor* Actor = SMA;
         FBound Bound = SMC->GetWorldAABB();
 
-        OutOccluders.emplace_back();
-        FCandidateDrawable& occluder = OutOccluders.back();
+        OutOccludees.emplace_back();
+        FCandidateDrawable& occluder = OutOccludees.back();
         occluder.ActorIndex = Actor->UUID;
         occluder.Bound = Bound;
         occluder.WorldViewProj = VP;
@@ -640,6 +751,19 @@ void URenderManager::BuildCpuOcclusionSets(
         occluder.ZNear = ZNear;
         occluder.ZFar = ZFar;
 
-        OutOccludees.emplace_back(occluder);
+        // 삼각형 오클루더: 메시 로컬 → 클립/뷰
+        if (UStaticMesh* Mesh = SMC->GetStaticMesh())
+        {
+            occluder.OccluderMesh = OcclusionCPU->GetOccluderMesh(Mesh->GetStaticMeshAsset());
+            if (occluder.OccluderMesh)
+            {
+                const FMatrix World = SMC->GetWorldMatrix();
+                occluder.MeshWorldViewProj = World * VP;
+                occluder.MeshWorldView = World * View;
+            }
+        }
     }
+
+    // 넓고 가까운 후보만 예산 안에서 오클루더로
+    OcclusionCPU->SelectOccluders(OutOccludees, OutOccluders);
 }
\ No newline at end of file
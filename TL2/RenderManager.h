@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include "Object.h"
+#include "RenderCommand.h"
 
 class UWorld;
 class URenderer;
@@ -7,6 +8,7 @@ class ACameraActor;
 class FViewport;
 class FViewportClient;
 struct FCandidateDrawable;
+class FOcclusionCullingManagerCPU;
 class UPrimitiveComponent;
 class UStaticMeshComponent;
 class UTextRenderComponent;
@@ -35,12 +37,49 @@ public:
     // Low-level: Renders with explicit camera
     void RenderViewports(ACameraActor* Camera, FViewport* Viewport);
 
+    // 멀티 뷰 컬링: 이번에 그릴 뷰포트들을 파티션 한 번 순회로 같이 컬링해 두고,
+    // 이어지는 뷰포트별 Render 가 자기 뷰 비트만 골라 쓴다 (같은 월드를 보는 뷰포트끼리만 공유)
+    void BeginSharedViewCulling(const TArray<FViewport*>& InViewports);
+    void EndSharedViewCulling();
+
     // Optional frame hooks if you want to move frame begin/end here later
     void BeginFrame();
     void EndFrame();
 
     URenderer* GetRenderer() const { return Renderer; }
 
+    // CPU 오클루전 컬링 (선정 기준/통계는 GetOcclusionCPU 로)
+    bool IsCPUOcclusionEnabled() const { return bUseCPUOcclusion; }
+    void SetCPUOcclusionEnabled(bool bEnabled) { bUseCPUOcclusion = bEnabled; }
+    FOcclusionCullingManagerCPU* GetOcclusionCPU() const { return OcclusionCPU.get(); }
+
+    // 뷰 가시성 캐시: 카메라/뷰포트/월드 내용/컬링 설정이 그대로인 뷰포트는 지난 컬링 결과를 재사용
+    bool IsViewVisibilityCacheEnabled() const { return bUseViewVisibilityCache; }
+    void SetViewVisibilityCacheEnabled(bool bEnabled);
+    // 직전 프레임에 캐시로 컬링을 건너뛴 뷰포트 수 / 컬링한 뷰포트 수
+    uint32 GetLastViewCacheHits() const { return LastViewCacheHits; }
+    uint32 GetLastViewCacheMisses() const { return LastViewCacheMisses; }
+
+    // 정렬 키 드로우 커맨드 경로 (끄면 프리미티브마다 Render 로 그린다)
+    bool IsDrawCommandListEnabled() const { return bUseDrawCommandList; }
+    void SetDrawCommandListEnabled(bool bEnabled) { bUseDrawCommandList = bEnabled; }
+    // 자동 인스턴싱: 정렬 후 같은 메시/머티리얼/셰이더 섹션이 MinInstances 개 이상 이어지면 인스턴스 드로우 하나로
+    bool IsAutoInstancingEnabled() const { return bUseAutoInstancing; }
+    void SetAutoInstancingEnabled(bool bEnabled) { bUseAutoInstancing = bEnabled; }
+    // 병렬 드로우 리스트 빌드: 보이는 프리미티브를 청크로 나눠 워커마다 서브 리스트를 채우고 청크 순서대로 합친다
+    bool IsParallelDrawListBuildEnabled() const { return bUseParallelDrawListBuild; }
+    void SetParallelDrawListBuildEnabled(bool bEnabled) { bUseParallelDrawListBuild = bEnabled; }
+    uint32 GetMinInstanceCount() const { return MinInstanceCount; }
+    void SetMinInstanceCount(uint32 Count) { MinInstanceCount = std::max(Count, 2u); }
+    // 프레임 상수 링: 드로우별 상수를 리스트마다 한 번 매핑해 쓰고 오프셋으로 바인딩 (끄면 드로우마다 Map)
+    bool IsConstantRingEnabled() const { return bUseConstantRing; }
+    void SetConstantRingEnabled(bool bEnabled) { bUseConstantRing = bEnabled; }
+    // 직전 프레임(모든 뷰포트 합) 커맨드 제출 통계 / 커맨드를 내지 않아 Render 로 그린 프리미티브 수
+    const FDrawSubmitStats& GetLastDrawSubmitStats() const { return LastDrawStats; }
+    uint32 GetLastLegacyDrawPrimitives() const { return LastLegacyDrawPrimitives; }
+    double GetLastDrawListBuildMs() const { return LastDrawListBuildMs; }
+    double GetLastDrawListSortMs() const { return LastDrawListSortMs; }
+
 private:
     UWorld* World = nullptr;
     URenderer* Renderer = nullptr;
@@ -54,7 +93,10 @@ private:
         FMatrix& OutViewMatrix, FMatrix& OutProjectionMatrix,
         Frustum& OutViewFrustum, EViewModeIndex& OutEffectiveViewMode);
 
-    void PerformFrustumCulling(const Frustum& ViewFrustum);
+    void PerformFrustumCulling(FViewport* Viewport, const Frustum& ViewFrustum, const FScreenSizeCullParams& ScreenSize);
+
+    // 월드 설정(클래스별 임계값)과 뷰포트 배율로 화면 크기 컬링 파라미터 구성
+    FScreenSizeCullParams MakeScreenSizeCullParams(const UWorld* InWorld, ACameraActor* Camera, FViewport* Viewport, const FMatrix& ProjectionMatrix) const;
 
     void PerformOcclusionCulling(FViewport* Viewport, const Frustum& ViewFrustum,
         const FMatrix& ViewMatrix, const FMatrix& ProjectionMatrix,
@@ -70,29 +112,7 @@ private:
 
     void RenderBoundingBoxes();
 
-    // === 머티리얼 소팅 렌더링 ===
-    void RenderWithMaterialSorting(const FMatrix& ViewMatrix, const FMatrix& ProjectionMatrix,
-        EViewModeIndex EffectiveViewMode, int& visibleCount);
-
 private:
-    // ==================== Material Sorting ====================
-    struct FRenderBatch
-    {
-        UMaterial* Material;
-        UStaticMesh* StaticMesh;
-        TArray<UStaticMeshComponent*> Components;
-        int MaterialSortKey; // 머티리얼 기반 정렬 키
-        
-        FRenderBatch(UMaterial* InMaterial = nullptr, UStaticMesh* InMesh = nullptr) 
-            : Material(InMaterial), StaticMesh(InMesh), MaterialSortKey(0) {}
-    };
-
-    void CollectRenderBatches(TArray<FRenderBatch>& OutBatches);
-    void SortRenderBatches(TArray<FRenderBatch>& Batches);
-    void ExecuteRenderBatches(const TArray<FRenderBatch>& Batches, const FMatrix& ViewMatrix,
-        const FMatrix& ProjectionMatrix, int& visibleCount);
-    int GenerateMaterialSortKey(UMaterial* Material) const;
-
     // ==================== CPU HZB Occlusion ====================
     void UpdateOcclusionGridSizeForViewport(FViewport* Viewport);
     void BuildCpuOcclusionSets(
@@ -102,8 +122,95 @@ private:
         TArray<FCandidateDrawable>& OutOccluders,
         TArray<FCandidateDrawable>& OutOccludees);
 
+    // 프러스텀 컬링 결과 (뷰포트마다 다시 채움). 이후 단계는 월드 전체가 아닌 이 목록만 순회한다
+    TArray<UPrimitiveComponent*> VisiblePrimitives;
+
+    // ==================== Draw Command List ====================
+    FDrawCommandList DrawCommandList;                   // 뷰포트마다 다시 채움 (용량 재사용)
+    TArray<UPrimitiveComponent*> LegacyDrawPrimitives;  // 커맨드를 내지 않는 프리미티브 (Render 로 그림)
+    bool bUseDrawCommandList = true;
+    bool bUseParallelDrawListBuild = true;
+    bool bUseAutoInstancing = true;
+    bool bUseConstantRing = true;
+    uint32 MinInstanceCount = 2;
+    FDrawSubmitStats DrawStats;
+    FDrawSubmitStats LastDrawStats;
+    uint32 LegacyDrawCount = 0;
+    uint32 LastLegacyDrawPrimitives = 0;
+    double DrawListBuildMs = 0.0;
+    double DrawListSortMs = 0.0;
+    double LastDrawListBuildMs = 0.0;
+    double LastDrawListSortMs = 0.0;
+
+    // 청크(워커)별 빌드 결과. 청크 순서대로 합치므로 결과는 스레드 수와 무관하다 (용량 재사용)
+    struct FDrawListBuildChunk
+    {
+        FDrawCommandList Commands;
+        TArray<UPrimitiveComponent*> LegacyPrimitives;
+        int32 VisibleCount = 0;
+    };
+    TArray<FDrawListBuildChunk> DrawListBuildChunks;
+    static constexpr int32 DrawListBuildMinBatch = 256;
+
+    // 보이는 프리미티브 하나를 커맨드 또는 Legacy 목록으로 보낸다. 그리기 대상(가려지지 않음)이면 true
+    bool BuildDrawCommands(UPrimitiveComponent* Primitive, const FMatrix& ViewMatrix,
+        FDrawCommandList& OutList, TArray<UPrimitiveComponent*>& OutLegacy) const;
+
+    // ==================== View Visibility Cache ====================
+    // 컬링 결과를 결정하는 입력 전부. 하나라도 다르면 다시 컬링한다
+    struct FViewVisibilityKey
+    {
+        const UWorld* World = nullptr;
+        FMatrix View;
+        FMatrix Proj;
+        int32 SizeX = 0;
+        int32 SizeY = 0;
+        uint32 SceneGeneration = 0;         // 파티션 등록/해제/이동/숨김
+        uint32 ScreenSizeCullRevision = 0;  // 월드의 화면 크기 컬링 설정
+        float ScreenSizeCullScale = 1.0f;   // 뷰포트별 배율
+        bool bOcclusion = false;
+        uint32 OcclusionRevision = 0;       // 오클루더 선정/재투영 설정
+
+        bool operator==(const FViewVisibilityKey& Other) const;
+    };
+
+    struct FViewVisibilityCache
+    {
+        FViewVisibilityKey Key;
+        int32 StableCount = 0;                      // Key 그대로 연속 컬링한 횟수
+        bool bValid = false;                        // 아래 결과가 Key 로 만든 안정된 결과인지
+        TArray<UPrimitiveComponent*> Primitives;
+        TArray<uint8> OcclusionFlags;               // Primitives[i] 소유 액터의 VisibleFlags 값 (오클루전 켜진 경우만)
+    };
+
+    FViewVisibilityKey MakeViewVisibilityKey(UWorld* InWorld, ACameraActor* Camera, FViewport* Viewport,
+        const FMatrix& ViewMatrix, const FMatrix& ProjectionMatrix) const;
+    bool IsViewVisibilityCached(FViewport* Viewport, const FViewVisibilityKey& Key) const;
+    // 캐시가 맞으면 VisiblePrimitives/VisibleFlags 를 복원하고 true
+    bool RestoreViewVisibility(FViewport* Viewport, const FViewVisibilityKey& Key);
+    // 방금 컬링한 결과를 저장 (결과가 안정됐을 때만 재사용 가능으로 표시)
+    void StoreViewVisibility(FViewport* Viewport, const FViewVisibilityKey& Key);
+
+    TMap<FViewport*, FViewVisibilityCache> ViewVisibilityCaches;
+    bool bUseViewVisibilityCache = true;
+    uint32 ViewCacheHits = 0;
+    uint32 ViewCacheMisses = 0;
+    uint32 LastViewCacheHits = 0;
+    uint32 LastViewCacheMisses = 0;
+
+    // 멀티 뷰 컬링 결과 (Begin/EndSharedViewCulling 사이에서만 유효)
+    UWorld* SharedCullWorld = nullptr;
+    TArray<FViewport*> SharedCullViewports;
+    TArray<Frustum> SharedCullFrustums;          // 공유 컬링에 쓴 프러스텀 (렌더 시 다르면 단일 쿼리로 폴백)
+    TArray<FScreenSizeCullParams> SharedCullScreenSizes;
+    TArray<UPrimitiveComponent*> SharedCullPrimitives;
+    TArray<uint8> SharedCullViewMasks;          // SharedCullPrimitives[i] 가 보이는 뷰 비트
+
     std::unique_ptr<FOcclusionCullingManagerCPU> OcclusionCPU = nullptr;
     TArray<uint8_t>        VisibleFlags;   // ActorIndex(UUID)로 인덱싱 (0=가려짐, 1=보임)
+    TArray<FCandidateDrawable> OcclusionOccluders;  // 오클루전 패스마다 다시 채움 (용량 재사용)
+    TArray<FCandidateDrawable> OcclusionOccludees;
+    TMap<FViewport*, uint32> ViewRenderPasses;    // 뷰포트별 렌더 횟수 (오클루전 히스토리가 직전 패스 것인지 확인용)
     bool                        bUseCPUOcclusion = false; // False 하면 오클루전 컬링 안씁니다.
     int                         OcclGridDiv = 2; // 화면 크기/이 값 = 오클루전 그리드 해상도(1/6 권장)
 
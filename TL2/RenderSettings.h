@@ -19,7 +19,32 @@ public:
     void ToggleShowFlag(EEngineShowFlags Flag) { ShowFlags = HasShowFlag(ShowFlags, Flag) ? (ShowFlags & ~Flag) : (ShowFlags | Flag); }
     bool IsShowFlagEnabled(EEngineShowFlags Flag) const { return HasShowFlag(ShowFlags, Flag); }
 
+    // Screen-size culling: 화면에서 임계 픽셀(세로)보다 작게 보이는 프리미티브는 제외
+    // 클래스 임계값은 하위 클래스에도 적용된다 (가장 가까운 상위 클래스 설정 우선)
+    void SetScreenSizeCullingEnabled(bool bEnabled) { bScreenSizeCulling = bEnabled; ++ScreenSizeCullRevision; }
+    bool IsScreenSizeCullingEnabled() const { return bScreenSizeCulling; }
+    void SetScreenSizeCullDefault(float Pixels) { ScreenSizeCullDefault = std::max(0.0f, Pixels); ++ScreenSizeCullRevision; }
+    float GetScreenSizeCullDefault() const { return ScreenSizeCullDefault; }
+    void SetScreenSizeCullThreshold(const UClass* Class, float Pixels) { ScreenSizeCullThresholds[Class] = std::max(0.0f, Pixels); ++ScreenSizeCullRevision; }
+    void ClearScreenSizeCullThreshold(const UClass* Class) { ScreenSizeCullThresholds.Remove(Class); ++ScreenSizeCullRevision; }
+    float GetScreenSizeCullThreshold(const UClass* Class) const
+    {
+        for (const UClass* C = Class; C; C = C->Super)
+        {
+            if (const float* Found = ScreenSizeCullThresholds.Find(C)) return *Found;
+        }
+        return ScreenSizeCullDefault;
+    }
+    const TMap<const UClass*, float>& GetScreenSizeCullThresholds() const { return ScreenSizeCullThresholds; }
+    // 위 설정이 바뀔 때마다 증가 (컬링 결과 캐시 무효화용)
+    uint32 GetScreenSizeCullRevision() const { return ScreenSizeCullRevision; }
+
 private:
+    bool bScreenSizeCulling = false;   // 기본 꺼짐 (켜면 작게 보이는 물체가 빠져 기존 씬의 결과가 달라진다)
+    float ScreenSizeCullDefault = 1.0f;
+    TMap<const UClass*, float> ScreenSizeCullThresholds;
+    uint32 ScreenSizeCullRevision = 0;
+
     EEngineShowFlags ShowFlags = EEngineShowFlags::SF_DefaultEnabled;
     EViewModeIndex ViewModeIndex = EViewModeIndex::VMI_Lit;
 };
@@ -0,0 +1,49 @@
+﻿#include "RenderStateCache.h"
+
+const char* GetRenderStateSlotName(ERenderStateSlot Slot)
+{
+    switch (Slot)
+    {
+    case ERenderStateSlot::VertexShader: return "VertexShader";
+    case ERenderStateSlot::PixelShader: return "PixelShader";
+    case ERenderStateSlot::InputLayout: return "InputLayout";
+    case ERenderStateSlot::VertexBuffer: return "VertexBuffer";
+    case ERenderStateSlot::IndexBuffer: return "IndexBuffer";
+    case ERenderStateSlot::PrimitiveTopology: return "Topology";
+    case ERenderStateSlot::RasterizerState: return "Rasterizer";
+    case ERenderStateSlot::DepthStencilState: return "DepthStencil";
+    case ERenderStateSlot::BlendState: return "Blend";
+    case ERenderStateSlot::PixelSampler: return "Sampler";
+    case ERenderStateSlot::PixelTexture: return "Texture";
+    default: return "Unknown";
+    }
+}
+
+uint32 FRenderStateCounters::GetTotalIssued() const
+{
+    uint32 Total = 0;
+    for (uint32 Count : Issued) Total += Count;
+    return Total;
+}
+
+uint32 FRenderStateCounters::GetTotalFiltered() const
+{
+    uint32 Total = 0;
+    for (uint32 Count : Filtered) Total += Count;
+    return Total;
+}
+
+void FRenderStateCache::Invalidate()
+{
+    for (FSlotState& State : Slots)
+    {
+        State.bValid = false;
+    }
+}
+
+void FRenderStateCache::BeginFrame()
+{
+    LastCounters = Counters;
+    Counters = FRenderStateCounters();
+    Invalidate();
+}
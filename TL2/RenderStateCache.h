@@ -0,0 +1,87 @@
+﻿#pragma once
+#include "UEContainer.h"
+
+// ------------------------------------------------------------
+// 렌더 상태 캐시 (RHI 앞단의 중복 바인딩 필터)
+//  - 슬롯마다 마지막으로 넘긴 값을 기억하고, 같은 값이면 Apply 가 false 를 돌려 RHI 호출을 건너뛰게 한다
+//  - 값은 D3D 객체 포인터나 상태 키를 그대로 쓴다. 바인딩된 객체는 컨텍스트가 참조를 쥐고 있어 주소가 재사용되지 않는다
+//  - 캐시 밖에서 컨텍스트 상태가 바뀌면(D2D 오버레이 등) Invalidate 해야 한다
+//  - D3D 를 모르므로 헤드리스로 검증할 수 있다
+// ------------------------------------------------------------
+enum class ERenderStateSlot : uint8
+{
+    VertexShader,
+    PixelShader,
+    InputLayout,
+    VertexBuffer,
+    IndexBuffer,
+    PrimitiveTopology,
+    RasterizerState,
+    DepthStencilState,
+    BlendState,
+    PixelSampler,
+    PixelTexture,
+    Count,
+};
+
+const char* GetRenderStateSlotName(ERenderStateSlot Slot);
+
+struct FRenderStateCounters
+{
+    uint32 Issued[static_cast<int>(ERenderStateSlot::Count)] = {};     // RHI 로 넘긴 변경
+    uint32 Filtered[static_cast<int>(ERenderStateSlot::Count)] = {};   // 같은 값이라 건너뛴 변경
+
+    uint32 GetTotalIssued() const;
+    uint32 GetTotalFiltered() const;
+};
+
+class FRenderStateCache
+{
+public:
+    static uint64 ToKey(const void* Object) { return static_cast<uint64>(reinterpret_cast<uintptr_t>(Object)); }
+
+    // 마지막 값과 같으면 false (호출자는 RHI 호출 생략). SubValue 는 스트라이드/스텐실 참조값처럼 같이 바뀌는 값
+    bool Apply(ERenderStateSlot Slot, uint64 Value, uint64 SubValue = 0)
+    {
+        const int Index = static_cast<int>(Slot);
+        FSlotState& State = Slots[Index];
+        if (bEnabled && State.bValid && State.Value == Value && State.SubValue == SubValue)
+        {
+            ++Counters.Filtered[Index];
+            return false;
+        }
+        State.Value = Value;
+        State.SubValue = SubValue;
+        State.bValid = true;
+        ++Counters.Issued[Index];
+        return true;
+    }
+
+    // 모든 슬롯을 모르는 상태로 (다음 Apply 는 반드시 RHI 로 간다)
+    void Invalidate();
+    void Invalidate(ERenderStateSlot Slot) { Slots[static_cast<int>(Slot)].bValid = false; }
+
+    // 프레임 경계: 카운터를 넘기고 전부 무효화 (Present 의 D2D 오버레이가 컨텍스트 상태를 바꾼다)
+    void BeginFrame();
+
+    // 끄면 모든 변경을 그대로 넘긴다 (비교용)
+    bool IsEnabled() const { return bEnabled; }
+    void SetEnabled(bool bInEnabled) { bEnabled = bInEnabled; }
+
+    const FRenderStateCounters& GetCounters() const { return Counters; }
+    const FRenderStateCounters& GetLastCounters() const { return LastCounters; }
+
+private:
+    struct FSlotState
+    {
+        uint64 Value = 0;
+        uint64 SubValue = 0;
+        bool bValid = false;
+    };
+
+    FSlotState Slots[static_cast<int>(ERenderStateSlot::Count)];
+    bool bEnabled = true;
+
+    FRenderStateCounters Counters;
+    FRenderStateCounters LastCounters;
+};
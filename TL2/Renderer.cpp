@@ -7,6 +7,14 @@
 #include "BillboardComponent.h"
 #include <Windows.h>
 
+namespace
+{
+	// 같은 슬롯에 들어가는 RHI 헬퍼별 상태 키 (EViewModeIndex / EComparisonFunc 값과 겹치지 않게)
+	constexpr uint64 NoCullRasterizerKey = 0x100;
+	constexpr uint64 OverlayWriteStencilKey = 0x100;
+	constexpr uint64 StencilRejectOverlayKey = 0x101;
+}
+
 
 URenderer::URenderer(URHIDevice* InDevice) : RHIDevice(InDevice)
 {
@@ -27,6 +35,11 @@ URenderer::~URenderer()
 	{
 		delete LineBatchData;
 	}
+	if (InstanceBuffer)
+	{
+		InstanceBuffer->Release();
+		InstanceBuffer = nullptr;
+	}
 }
 
 void URenderer::BeginFrame()
@@ -34,8 +47,11 @@ void URenderer::BeginFrame()
 	// 백버퍼/깊이버퍼를 클리어
 	RHIDevice->ClearBackBuffer();  // 배경색
 	RHIDevice->ClearDepthBuffer(1.0f, 0);                 // 깊이값 초기화
+	// 지난 프레임 끝(Present 의 D2D 오버레이)에서 컨텍스트 상태가 바뀌었을 수 있으므로 캐시를 비운다
+	StateCache.BeginFrame();
+
 	//RHIDevice->CreateBlendState();
-	RHIDevice->IASetPrimitiveTopology();
+	BindPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	// RS
 	RHIDevice->RSSetViewport();
 
@@ -43,6 +59,9 @@ void URenderer::BeginFrame()
 	//RHIDevice->OMSetBlendState();
 	RHIDevice->OMSetRenderTargets();
 
+	// 상수 링은 프레임마다 처음부터 (첫 매핑이 DISCARD)
+	RHIDevice->BeginConstantRingFrame();
+
 	// TODO - 한 종류 메쉬만 스폰했을 때 깨지는 현상 방지 임시이므로 고쳐야합니다
 	// ★ 캐시 무효화
 	//PreShader = nullptr;
@@ -53,22 +72,14 @@ void URenderer::BeginFrame()
 
 void URenderer::PrepareShader(FShader& InShader)
 {
-	RHIDevice->GetDeviceContext()->VSSetShader(InShader.SimpleVertexShader, nullptr, 0);
-	RHIDevice->GetDeviceContext()->PSSetShader(InShader.SimplePixelShader, nullptr, 0);
-	RHIDevice->GetDeviceContext()->IASetInputLayout(InShader.SimpleInputLayout);
+	BindShaderStages(InShader.SimpleVertexShader, InShader.SimplePixelShader, InShader.SimpleInputLayout);
 }
 
 void URenderer::PrepareShader(UShader* InShader)
 {
-	if (PreShader != InShader)
-	{
-		/*const FString& ShaderFilePath = InShader->GetFilePath();
-		UE_LOG("change to new Shader: \'%s\'", ShaderFilePath);*/
-		RHIDevice->GetDeviceContext()->VSSetShader(InShader->GetVertexShader(), nullptr, 0);
-		RHIDevice->GetDeviceContext()->PSSetShader(InShader->GetPixelShader(), nullptr, 0);
-		RHIDevice->GetDeviceContext()->IASetInputLayout(InShader->GetInputLayout());
-		PreShader = InShader;
-	}
+	/*const FString& ShaderFilePath = InShader->GetFilePath();
+	UE_LOG("change to new Shader: \'%s\'", ShaderFilePath);*/
+	BindShaderStages(InShader->GetVertexShader(), InShader->GetPixelShader(), InShader->GetInputLayout());
 	/*RHIDevice->GetDeviceContext()->VSSetShader(InShader->GetVertexShader(), nullptr, 0);
 	RHIDevice->GetDeviceContext()->PSSetShader(InShader->GetPixelShader(), nullptr, 0);
 	RHIDevice->GetDeviceContext()->IASetInputLayout(InShader->GetInputLayout());*/
@@ -76,6 +87,10 @@ void URenderer::PrepareShader(UShader* InShader)
 
 void URenderer::OMSetBlendState(bool bIsChecked)
 {
+	if (!StateCache.Apply(ERenderStateSlot::BlendState, bIsChecked ? 1u : 0u))
+	{
+		return;
+	}
 	if (bIsChecked == true)
 	{
 		RHIDevice->OMSetBlendState(true);
@@ -88,12 +103,18 @@ void URenderer::OMSetBlendState(bool bIsChecked)
 
 void URenderer::RSSetState(EViewModeIndex ViewModeIndex)
 {
-	RHIDevice->RSSetState(ViewModeIndex);
+	if (StateCache.Apply(ERenderStateSlot::RasterizerState, static_cast<uint64>(ViewModeIndex)))
+	{
+		RHIDevice->RSSetState(ViewModeIndex);
+	}
 }
 
 void URenderer::RSSetNoCullState()
 {
-	RHIDevice->RSSetNoCullState();
+	if (StateCache.Apply(ERenderStateSlot::RasterizerState, NoCullRasterizerKey))
+	{
+		RHIDevice->RSSetNoCullState();
+	}
 }
 
 void URenderer::UpdateConstantBuffer(const FMatrix& ModelMatrix, const FMatrix& ViewMatrix, const FMatrix& ProjMatrix)
@@ -127,6 +148,30 @@ void URenderer::UpdateUVScroll(const FVector2D& Speed, float TimeSec)
 }
 
 void URenderer::DrawIndexedPrimitiveComponent(UStaticMesh* InMesh, D3D11_PRIMITIVE_TOPOLOGY InTopology, const TArray<FMaterialSlot>& InComponentMaterialSlots)
+{
+	if (!BindStaticMeshBuffers(InMesh, InTopology))
+	{
+		return;
+	}
+
+	if (InMesh->HasMaterial())
+	{
+		const TArray<FGroupInfo>& MeshGroupInfos = InMesh->GetMeshGroupInfo();
+		const uint32 NumMeshGroupInfos = static_cast<uint32>(MeshGroupInfos.size());
+		for (uint32 i = 0; i < NumMeshGroupInfos; ++i)
+		{
+			BindMaterial(UResourceManager::GetInstance().Get<UMaterial>(InComponentMaterialSlots[i].MaterialName.ToString()));
+			RHIDevice->GetDeviceContext()->DrawIndexed(MeshGroupInfos[i].IndexCount, MeshGroupInfos[i].StartIndex, 0);
+		}
+	}
+	else
+	{
+		BindMaterial(nullptr);
+		RHIDevice->GetDeviceContext()->DrawIndexed(InMesh->GetIndexCount(), 0, 0);
+	}
+}
+
+bool URenderer::BindStaticMeshBuffers(UStaticMesh* InMesh, D3D11_PRIMITIVE_TOPOLOGY InTopology)
 {
 	UINT stride = 0;
 	switch (InMesh->GetVertexType())
@@ -146,67 +191,107 @@ void URenderer::DrawIndexedPrimitiveComponent(UStaticMesh* InMesh, D3D11_PRIMITI
 	default:
 		// Handle unknown or unsupported vertex types
 		assert(false && "Unknown vertex type!");
-		return; // or log an error
+		return false; // or log an error
 	}
-	UINT offset = 0;
-
-	ID3D11Buffer* VertexBuffer = InMesh->GetVertexBuffer();
-	ID3D11Buffer* IndexBuffer = InMesh->GetIndexBuffer();
-	uint32 VertexCount = InMesh->GetVertexCount();
-	uint32 IndexCount = InMesh->GetIndexCount();
-
-	RHIDevice->GetDeviceContext()->IASetVertexBuffers(
-		0, 1, &VertexBuffer, &stride, &offset
-	);
 
-	RHIDevice->GetDeviceContext()->IASetIndexBuffer(
-		IndexBuffer, DXGI_FORMAT_R32_UINT, 0
-	);
+	BindVertexBuffer(InMesh->GetVertexBuffer(), stride);
+	BindIndexBuffer(InMesh->GetIndexBuffer());
+	BindPrimitiveTopology(InTopology);
+	BindDefaultSampler();
+	return true;
+}
 
-	RHIDevice->GetDeviceContext()->IASetPrimitiveTopology(InTopology);
-	RHIDevice->PSSetDefaultSampler(0);
+void URenderer::BindMaterial(UMaterial* InMaterial)
+{
+	if (!InMaterial)
+	{
+		FObjMaterialInfo ObjMaterialInfo;
+		RHIDevice->UpdatePixelConstantBuffers(ObjMaterialInfo, false, false); // PSSet도 해줌
+		return;
+	}
 
-	if (InMesh->HasMaterial())
+	const FObjMaterialInfo& MaterialInfo = InMaterial->GetMaterialInfo();
+	ID3D11ShaderResourceView* srv = nullptr;
+	bool bHasTexture = false;
+	if (!MaterialInfo.DiffuseTextureFileName.empty())
 	{
-		const TArray<FGroupInfo>& MeshGroupInfos = InMesh->GetMeshGroupInfo();
-		const uint32 NumMeshGroupInfos = static_cast<uint32>(MeshGroupInfos.size());
-		for (uint32 i = 0; i < NumMeshGroupInfos; ++i)
+		// UTF-8 -> UTF-16 변환 (Windows)
+		int needW = ::MultiByteToWideChar(CP_UTF8, 0, MaterialInfo.DiffuseTextureFileName.c_str(), -1, nullptr, 0);
+		std::wstring WTextureFileName;
+		if (needW > 0)
 		{
-			UMaterial* const Material = UResourceManager::GetInstance().Get<UMaterial>(InComponentMaterialSlots[i].MaterialName.ToString());
-			const FObjMaterialInfo& MaterialInfo = Material->GetMaterialInfo();
-			ID3D11ShaderResourceView* srv = nullptr;
-			bool bHasTexture = false;
-			if (!MaterialInfo.DiffuseTextureFileName.empty())
+			WTextureFileName.resize(needW - 1);
+			::MultiByteToWideChar(CP_UTF8, 0, MaterialInfo.DiffuseTextureFileName.c_str(), -1, WTextureFileName.data(), needW);
+		}
+		// 반환 여기서 로드 
+		if (FTextureData* TextureData = UResourceManager::GetInstance().CreateOrGetTextureData(WTextureFileName))
+		{
+			if (TextureData->TextureSRV)
 			{
-				// UTF-8 -> UTF-16 변환 (Windows)
-				int needW = ::MultiByteToWideChar(CP_UTF8, 0, MaterialInfo.DiffuseTextureFileName.c_str(), -1, nullptr, 0);
-				std::wstring WTextureFileName;
-				if (needW > 0)
-				{
-					WTextureFileName.resize(needW - 1);
-					::MultiByteToWideChar(CP_UTF8, 0, MaterialInfo.DiffuseTextureFileName.c_str(), -1, WTextureFileName.data(), needW);
-				}
-				// 반환 여기서 로드 
-				if (FTextureData* TextureData = UResourceManager::GetInstance().CreateOrGetTextureData(WTextureFileName))
-				{
-					if (TextureData->TextureSRV)
-					{
-						srv = TextureData->TextureSRV;
-						bHasTexture = true;
-					}
-				}
+				srv = TextureData->TextureSRV;
+				bHasTexture = true;
 			}
-			RHIDevice->GetDeviceContext()->PSSetShaderResources(0, 1, &srv);
-			RHIDevice->UpdatePixelConstantBuffers(MaterialInfo, true, bHasTexture); // 성공 여부 기반
-			RHIDevice->GetDeviceContext()->DrawIndexed(MeshGroupInfos[i].IndexCount, MeshGroupInfos[i].StartIndex, 0);
 		}
 	}
-	else
+	BindPixelTexture(srv);
+	RHIDevice->UpdatePixelConstantBuffers(MaterialInfo, true, bHasTexture); // 성공 여부 기반
+}
+
+void URenderer::DrawIndexed(uint32 IndexCount, uint32 StartIndex)
+{
+	RHIDevice->GetDeviceContext()->DrawIndexed(IndexCount, StartIndex, 0);
+}
+
+void URenderer::UploadInstanceTransforms(const FMatrix* Transforms, uint32 Count)
+{
+	if (Count == 0) return;
+
+	if (Count > InstanceBufferCapacity)
 	{
-		FObjMaterialInfo ObjMaterialInfo;
-		RHIDevice->UpdatePixelConstantBuffers(ObjMaterialInfo, false, false); // PSSet도 해줌
-		RHIDevice->GetDeviceContext()->DrawIndexed(IndexCount, 0, 0);
+		if (InstanceBuffer)
+		{
+			InstanceBuffer->Release();
+			InstanceBuffer = nullptr;
+		}
+		// 2의 거듭제곱으로 키워 재생성 횟수를 줄인다
+		uint32 NewCapacity = std::max(InstanceBufferCapacity, MIN_INSTANCE_CAPACITY);
+		while (NewCapacity < Count) NewCapacity *= 2;
+
+		D3D11_BUFFER_DESC Desc = {};
+		Desc.Usage = D3D11_USAGE_DYNAMIC;
+		Desc.ByteWidth = NewCapacity * sizeof(FMatrix);
+		Desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+		Desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		if (FAILED(RHIDevice->GetDevice()->CreateBuffer(&Desc, nullptr, &InstanceBuffer)))
+		{
+			InstanceBufferCapacity = 0;
+			return;
+		}
+		InstanceBufferCapacity = NewCapacity;
+	}
+
+	ID3D11DeviceContext* Context = RHIDevice->GetDeviceContext();
+	D3D11_MAPPED_SUBRESOURCE Mapped;
+	if (FAILED(Context->Map(InstanceBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &Mapped)))
+	{
+		return;
 	}
+	memcpy(Mapped.pData, Transforms, sizeof(FMatrix) * Count);
+	Context->Unmap(InstanceBuffer, 0);
+
+	UINT Stride = sizeof(FMatrix);
+	UINT Offset = 0;
+	Context->IASetVertexBuffers(FInstanceWorldMatrix::Slot, 1, &InstanceBuffer, &Stride, &Offset);
+}
+
+void URenderer::PrepareInstancedShader(UShader* InShader)
+{
+	BindShaderStages(InShader->GetInstancedVertexShader(), InShader->GetPixelShader(), InShader->GetInstancedInputLayout());
+}
+
+void URenderer::DrawIndexedInstanced(uint32 IndexCount, uint32 StartIndex, uint32 InstanceCount, uint32 FirstInstance)
+{
+	RHIDevice->GetDeviceContext()->DrawIndexedInstanced(IndexCount, InstanceCount, StartIndex, 0, FirstInstance);
 }
 
 // TEXT BillBoard 용 
@@ -216,19 +301,14 @@ void URenderer::DrawIndexedPrimitiveComponent(UTextRenderComponent* Comp, D3D11_
 	ID3D11Buffer* VertexBuff = Comp->GetStaticMesh()->GetVertexBuffer();
 	ID3D11Buffer* IndexBuff = Comp->GetStaticMesh()->GetIndexBuffer();
 
-	RHIDevice->GetDeviceContext()->IASetInputLayout(Comp->GetMaterial()->GetShader()->GetInputLayout());
+	BindInputLayout(Comp->GetMaterial()->GetShader()->GetInputLayout());
 
-	UINT offset = 0;
-	RHIDevice->GetDeviceContext()->IASetVertexBuffers(
-		0, 1, &VertexBuff, &Stride, &offset
-	);
-	RHIDevice->GetDeviceContext()->IASetIndexBuffer(
-		IndexBuff, DXGI_FORMAT_R32_UINT, 0
-	);
+	BindVertexBuffer(VertexBuff, Stride);
+	BindIndexBuffer(IndexBuff);
 	ID3D11ShaderResourceView* TextureSRV = Comp->GetMaterial()->GetTexture()->GetShaderResourceView();
-	RHIDevice->PSSetDefaultSampler(0);
-	RHIDevice->GetDeviceContext()->PSSetShaderResources(0, 1, &TextureSRV);
-	RHIDevice->GetDeviceContext()->IASetPrimitiveTopology(InTopology);
+	BindDefaultSampler();
+	BindPixelTexture(TextureSRV);
+	BindPrimitiveTopology(InTopology);
 	const uint32 indexCnt = Comp->GetStaticMesh()->GetIndexCount();
 	RHIDevice->GetDeviceContext()->DrawIndexed(indexCnt, 0, 0);
 }
@@ -241,11 +321,10 @@ void URenderer::DrawIndexedPrimitiveComponent(UBillboardComponent* Comp, D3D11_P
 	ID3D11Buffer* IndexBuff = Comp->GetStaticMesh()->GetIndexBuffer();
 
 	// Input layout comes from the shader bound to the material
-	RHIDevice->GetDeviceContext()->IASetInputLayout(Comp->GetMaterial()->GetShader()->GetInputLayout());
+	BindInputLayout(Comp->GetMaterial()->GetShader()->GetInputLayout());
 
-	UINT offset = 0;
-	RHIDevice->GetDeviceContext()->IASetVertexBuffers(0, 1, &VertexBuff, &Stride, &offset);
-	RHIDevice->GetDeviceContext()->IASetIndexBuffer(IndexBuff, DXGI_FORMAT_R32_UINT, 0);
+	BindVertexBuffer(VertexBuff, Stride);
+	BindIndexBuffer(IndexBuff);
 
     // Bind texture via ResourceManager to support DDS/PNG
     ID3D11ShaderResourceView* srv = nullptr;
@@ -270,13 +349,13 @@ void URenderer::DrawIndexedPrimitiveComponent(UBillboardComponent* Comp, D3D11_P
             }
         }
     }
-    RHIDevice->PSSetDefaultSampler(0);
-    RHIDevice->GetDeviceContext()->PSSetShaderResources(0, 1, &srv);
+    BindDefaultSampler();
+    BindPixelTexture(srv);
 
     // Ensure correct alpha blending just for this draw
     OMSetBlendState(true);
 
-	RHIDevice->GetDeviceContext()->IASetPrimitiveTopology(InTopology);
+	BindPrimitiveTopology(InTopology);
 	const uint32 indexCnt = Comp->GetStaticMesh()->GetIndexCount();
 	RHIDevice->GetDeviceContext()->DrawIndexed(indexCnt, 0, 0);
 
@@ -285,10 +364,11 @@ void URenderer::DrawIndexedPrimitiveComponent(UBillboardComponent* Comp, D3D11_P
 }
 void URenderer::SetViewModeType(EViewModeIndex ViewModeIndex)
 {
+	// 래스터라이저는 다른 경로(바운딩 박스/빌보드)도 바꾸므로 캐시에 맡기고, 색 상수만 뷰 모드가 바뀔 때 갱신
+	RSSetState(ViewModeIndex);
 	if (PreViewModeIndex != ViewModeIndex)
 	{
 		//UE_LOG("Change ViewMode");
-		RHIDevice->RSSetState(ViewModeIndex);
 		if (ViewModeIndex == EViewModeIndex::VMI_Wireframe)
 			RHIDevice->UpdateColorConstantBuffers(FVector4{ 1.f, 0.f, 0.f, 1.f });
 		else
@@ -305,17 +385,88 @@ void URenderer::EndFrame()
 
 void URenderer::OMSetDepthStencilState(EComparisonFunc Func)
 {
-	RHIDevice->OmSetDepthStencilState(Func);
+	if (StateCache.Apply(ERenderStateSlot::DepthStencilState, static_cast<uint64>(Func)))
+	{
+		RHIDevice->OmSetDepthStencilState(Func);
+	}
 }
 
 void URenderer::OMSetDepthStencilStateOverlayWriteStencil()
 {
-    RHIDevice->OMSetDepthStencilState_OverlayWriteStencil();
+    if (StateCache.Apply(ERenderStateSlot::DepthStencilState, OverlayWriteStencilKey, 1))
+    {
+        RHIDevice->OMSetDepthStencilState_OverlayWriteStencil();
+    }
 }
 
 void URenderer::OMSetDepthStencilStateStencilRejectOverlay()
 {
-    RHIDevice->OMSetDepthStencilState_StencilRejectOverlay();
+    if (StateCache.Apply(ERenderStateSlot::DepthStencilState, StencilRejectOverlayKey, 0))
+    {
+        RHIDevice->OMSetDepthStencilState_StencilRejectOverlay();
+    }
+}
+
+void URenderer::BindShaderStages(ID3D11VertexShader* VertexShader, ID3D11PixelShader* PixelShader, ID3D11InputLayout* InputLayout)
+{
+	if (StateCache.Apply(ERenderStateSlot::VertexShader, FRenderStateCache::ToKey(VertexShader)))
+	{
+		RHIDevice->GetDeviceContext()->VSSetShader(VertexShader, nullptr, 0);
+	}
+	if (StateCache.Apply(ERenderStateSlot::PixelShader, FRenderStateCache::ToKey(PixelShader)))
+	{
+		RHIDevice->GetDeviceContext()->PSSetShader(PixelShader, nullptr, 0);
+	}
+	BindInputLayout(InputLayout);
+}
+
+void URenderer::BindInputLayout(ID3D11InputLayout* InputLayout)
+{
+	if (StateCache.Apply(ERenderStateSlot::InputLayout, FRenderStateCache::ToKey(InputLayout)))
+	{
+		RHIDevice->GetDeviceContext()->IASetInputLayout(InputLayout);
+	}
+}
+
+void URenderer::BindVertexBuffer(ID3D11Buffer* VertexBuffer, UINT Stride)
+{
+	if (StateCache.Apply(ERenderStateSlot::VertexBuffer, FRenderStateCache::ToKey(VertexBuffer), Stride))
+	{
+		UINT Offset = 0;
+		RHIDevice->GetDeviceContext()->IASetVertexBuffers(0, 1, &VertexBuffer, &Stride, &Offset);
+	}
+}
+
+void URenderer::BindIndexBuffer(ID3D11Buffer* IndexBuffer)
+{
+	if (StateCache.Apply(ERenderStateSlot::IndexBuffer, FRenderStateCache::ToKey(IndexBuffer)))
+	{
+		RHIDevice->GetDeviceContext()->IASetIndexBuffer(IndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+	}
+}
+
+void URenderer::BindPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology)
+{
+	if (StateCache.Apply(ERenderStateSlot::PrimitiveTopology, static_cast<uint64>(Topology)))
+	{
+		RHIDevice->GetDeviceContext()->IASetPrimitiveTopology(Topology);
+	}
+}
+
+void URenderer::BindDefaultSampler()
+{
+	if (StateCache.Apply(ERenderStateSlot::PixelSampler, 1))
+	{
+		RHIDevice->PSSetDefaultSampler(0);
+	}
+}
+
+void URenderer::BindPixelTexture(ID3D11ShaderResourceView* SRV)
+{
+	if (StateCache.Apply(ERenderStateSlot::PixelTexture, FRenderStateCache::ToKey(SRV)))
+	{
+		RHIDevice->GetDeviceContext()->PSSetShaderResources(0, 1, &SRV);
+	}
 }
 
 void URenderer::InitializeLineBatch()
@@ -437,15 +588,9 @@ void URenderer::EndLineBatch(const FMatrix& ModelMatrix, const FMatrix& ViewMatr
     // Render using dynamic mesh
     if (DynamicLineMesh->GetCurrentVertexCount() > 0 && DynamicLineMesh->GetCurrentIndexCount() > 0)
     {
-        UINT stride = sizeof(FVertexSimple);
-        UINT offset = 0;
-        
-        ID3D11Buffer* vertexBuffer = DynamicLineMesh->GetVertexBuffer();
-        ID3D11Buffer* indexBuffer = DynamicLineMesh->GetIndexBuffer();
-        
-        RHIDevice->GetDeviceContext()->IASetVertexBuffers(0, 1, &vertexBuffer, &stride, &offset);
-        RHIDevice->GetDeviceContext()->IASetIndexBuffer(indexBuffer, DXGI_FORMAT_R32_UINT, 0);
-        RHIDevice->GetDeviceContext()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
+        BindVertexBuffer(DynamicLineMesh->GetVertexBuffer(), sizeof(FVertexSimple));
+        BindIndexBuffer(DynamicLineMesh->GetIndexBuffer());
+        BindPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_LINELIST);
         // Overlay 스텐실(=1) 영역은 그리지 않도록 스텐실 테스트 설정
         OMSetDepthStencilStateStencilRejectOverlay();
         RHIDevice->GetDeviceContext()->DrawIndexed(DynamicLineMesh->GetCurrentIndexCount(), 0, 0);
@@ -466,3 +611,96 @@ void URenderer::ClearLineBatch()
 
 	bLineBatchActive = false;
 }
+
+// ==================== FRendererDrawBackend ====================
+void FRendererDrawBackend::BeginDrawList(const FMatrix& InView, const FMatrix& InProj)
+{
+	View = InView;
+	Proj = InProj;
+	CurShader = nullptr;
+	bMeshBound = false;
+	bViewBound = false; // 링의 뷰 블록이나 첫 SetTransform 이 올린다
+}
+
+void FRendererDrawBackend::SetShader(UShader* Shader)
+{
+	CurShader = Shader;
+	if (Shader)
+	{
+		Renderer->PrepareShader(Shader);
+	}
+}
+
+void FRendererDrawBackend::SetMesh(UStaticMesh* Mesh)
+{
+	bMeshBound = Renderer->BindStaticMeshBuffers(Mesh, D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+}
+
+void FRendererDrawBackend::SetMaterial(UMaterial* Material)
+{
+	Renderer->BindMaterial(Material);
+}
+
+void FRendererDrawBackend::SetTransform(const FMatrix& World)
+{
+	Renderer->UpdateConstantBuffer(World, View, Proj);
+	bViewBound = true;
+}
+
+void FRendererDrawBackend::DrawIndexed(uint32 IndexCount, uint32 StartIndex)
+{
+	if (bMeshBound)
+	{
+		if (CurShader)
+		{
+			Renderer->PrepareShader(CurShader); // 직전이 인스턴스 드로우였으면 일반 변형으로
+		}
+		Renderer->DrawIndexed(IndexCount, StartIndex);
+	}
+}
+
+bool FRendererDrawBackend::SupportsInstancing(const UShader* Shader) const
+{
+	return Shader && Shader->SupportsInstancing();
+}
+
+void FRendererDrawBackend::SetInstanceTransforms(const FMatrix* Transforms, uint32 Count)
+{
+	Renderer->UploadInstanceTransforms(Transforms, Count);
+}
+
+void FRendererDrawBackend::DrawIndexedInstanced(uint32 IndexCount, uint32 StartIndex, uint32 InstanceCount, uint32 FirstInstance)
+{
+	if (bMeshBound && CurShader)
+	{
+		if (!bViewBound)
+		{
+			// 단일 드로우 없이 인스턴스 드로우만 있는 리스트: 뷰/프로젝션만 올린다
+			Renderer->UpdateConstantBuffer(FMatrix::Identity(), View, Proj);
+			bViewBound = true;
+		}
+		Renderer->PrepareInstancedShader(CurShader);
+		Renderer->DrawIndexedInstanced(IndexCount, StartIndex, InstanceCount, FirstInstance);
+	}
+}
+
+uint8* FRendererDrawBackend::MapConstants(uint32 Bytes, uint32& OutOffset)
+{
+	return bUseConstantRing ? Renderer->GetRHIDevice()->MapConstantRing(Bytes, OutOffset) : nullptr;
+}
+
+void FRendererDrawBackend::UnmapConstants()
+{
+	Renderer->GetRHIDevice()->UnmapConstantRing();
+}
+
+void FRendererDrawBackend::SetViewConstants(uint32 Offset)
+{
+	Renderer->GetRHIDevice()->VSSetConstantRing(1, Offset, sizeof(FViewConstants)); // b1 ViewProjBuffer
+	bViewBound = true;
+}
+
+void FRendererDrawBackend::SetTransformConstants(uint32 Offset)
+{
+	Renderer->GetRHIDevice()->VSSetConstantRing(0, Offset, sizeof(FMatrix)); // b0 ModelBuffer
+}
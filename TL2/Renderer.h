@@ -1,6 +1,8 @@
 ﻿#pragma once
 #include "RHIDevice.h"
 #include "LineDynamicMesh.h"
+#include "RenderCommand.h"
+#include "RenderStateCache.h"
 
 class UStaticMeshComponent;
 class UTextRenderComponent;
@@ -8,6 +10,7 @@ class UMeshComponent;
 class URHIDevice;
 class UShader;
 class UStaticMesh;
+class UMaterial;
 class UBillboardComponent;
 struct FMaterialSlot;
 
@@ -47,6 +50,18 @@ public:
 
     void DrawIndexedPrimitiveComponent(UStaticMesh* InMesh, D3D11_PRIMITIVE_TOPOLOGY InTopology, const TArray<FMaterialSlot>& InComponentMaterialSlots);
 
+    // 스태틱 메시 VB/IB/토폴로지 바인딩. 지원하지 않는 정점 형식이면 false
+    bool BindStaticMeshBuffers(UStaticMesh* InMesh, D3D11_PRIMITIVE_TOPOLOGY InTopology);
+    // 섹션 머티리얼의 디퓨즈 SRV + 픽셀 상수 버퍼. nullptr 이면 머티리얼 없는 기본값
+    void BindMaterial(UMaterial* InMaterial);
+    void DrawIndexed(uint32 IndexCount, uint32 StartIndex);
+
+    // 인스턴스 드로우: 트랜스폼을 인스턴스 버퍼(필요하면 키움)에 올리고 IA 슬롯 1에 바인딩
+    void UploadInstanceTransforms(const FMatrix* Transforms, uint32 Count);
+    // 셰이더의 인스턴스 변형(SupportsInstancing) 바인딩. 이후 PrepareShader 는 일반 변형으로 되돌린다
+    void PrepareInstancedShader(UShader* InShader);
+    void DrawIndexedInstanced(uint32 IndexCount, uint32 StartIndex, uint32 InstanceCount, uint32 FirstInstance);
+
     void UpdateUVScroll(const FVector2D& Speed, float TimeSec);
 
     void DrawIndexedPrimitiveComponent(UTextRenderComponent* Comp, D3D11_PRIMITIVE_TOPOLOGY InTopology);
@@ -70,6 +85,8 @@ public:
     void OMSetDepthStencilStateStencilRejectOverlay();
 
     URHIDevice* GetRHIDevice() { return RHIDevice; }
+    // 셰이더/IA/RS/OM 바인딩은 이 캐시를 거쳐 바뀐 것만 RHI 로 간다 (프레임별 발행/생략 카운터 포함)
+    FRenderStateCache& GetRenderStateCache() { return StateCache; }
 private:
     URHIDevice* RHIDevice;
 
@@ -87,9 +104,23 @@ private:
 
     void InitializeLineBatch();
 
+    // 인스턴스 월드 행렬 버퍼 (동적 VB, 드로우 리스트마다 WRITE_DISCARD)
+    ID3D11Buffer* InstanceBuffer = nullptr;
+    uint32 InstanceBufferCapacity = 0;
+    static constexpr uint32 MIN_INSTANCE_CAPACITY = 1024;
+
     // 이전 drawCall에서 이미 썼던 RnderState면, 다시 Set 하지 않기 위해 만든 변수들
-    UShader* PreShader = nullptr; // Shaders, Inputlayout
-    EViewModeIndex PreViewModeIndex = EViewModeIndex::VMI_Wireframe; // RSSetState, UpdateColorConstantBuffers
+    FRenderStateCache StateCache; // Shaders, Inputlayout, VB/IB, Topology, RS, DS, Blend, Sampler, SRV
+    EViewModeIndex PreViewModeIndex = EViewModeIndex::VMI_Wireframe; // UpdateColorConstantBuffers
+
+    // StateCache 를 거치는 바인딩
+    void BindShaderStages(ID3D11VertexShader* VertexShader, ID3D11PixelShader* PixelShader, ID3D11InputLayout* InputLayout);
+    void BindInputLayout(ID3D11InputLayout* InputLayout);
+    void BindVertexBuffer(ID3D11Buffer* VertexBuffer, UINT Stride);
+    void BindIndexBuffer(ID3D11Buffer* IndexBuffer);
+    void BindPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology);
+    void BindDefaultSampler();
+    void BindPixelTexture(ID3D11ShaderResourceView* SRV);
     //UMaterial* PreUMaterial = nullptr; // SRV, UpdatePixelConstantBuffers
     //UStaticMesh* PreStaticMesh = nullptr; // VertexBuffer, IndexBuffer
     /*ID3D11Buffer* PreVertexBuffer = nullptr;
@@ -97,3 +128,35 @@ private:
 
 };
 
+// 드로우 커맨드 리스트를 D3D11 로 제출하는 백엔드 (URenderer 의 바인딩 경로를 그대로 쓴다)
+class FRendererDrawBackend : public FRHIDrawBackend
+{
+public:
+    // bInUseConstantRing 이 false 면 드로우마다 상수 버퍼를 Map 하는 기존 경로로 그린다
+    explicit FRendererDrawBackend(URenderer* InRenderer, bool bInUseConstantRing = true)
+        : Renderer(InRenderer), bUseConstantRing(bInUseConstantRing) {}
+
+    void BeginDrawList(const FMatrix& InView, const FMatrix& InProj) override;
+    void SetShader(UShader* Shader) override;
+    void SetMesh(UStaticMesh* Mesh) override;
+    void SetMaterial(UMaterial* Material) override;
+    void SetTransform(const FMatrix& World) override;
+    void DrawIndexed(uint32 IndexCount, uint32 StartIndex) override;
+    void EndDrawList() override {}
+    bool SupportsInstancing(const UShader* Shader) const override;
+    void SetInstanceTransforms(const FMatrix* Transforms, uint32 Count) override;
+    void DrawIndexedInstanced(uint32 IndexCount, uint32 StartIndex, uint32 InstanceCount, uint32 FirstInstance) override;
+    uint8* MapConstants(uint32 Bytes, uint32& OutOffset) override;
+    void UnmapConstants() override;
+    void SetViewConstants(uint32 Offset) override;
+    void SetTransformConstants(uint32 Offset) override;
+
+private:
+    URenderer* Renderer = nullptr;
+    bool bUseConstantRing = true;
+    FMatrix View;
+    FMatrix Proj;
+    UShader* CurShader = nullptr;   // 드로우 종류(일반/인스턴스)에 따라 정점 셰이더 변형을 고른다
+    bool bMeshBound = false;    // 지원하지 않는 정점 형식이면 그리지 않는다
+    bool bViewBound = false;    // 이 리스트의 뷰/프로젝션이 b1 에 올라갔는지
+};
@@ -179,6 +179,18 @@ FMeshBVH* UResourceManager::GetOrBuildMeshBVH(const FString& ObjPath, const FSta
     return NewBVH;
 }
 
+void UResourceManager::AddMeshBVH(const FString& ObjPath, FMeshBVH* InBVH)
+{
+    if (auto* Found = MeshBVHCache.Find(ObjPath))
+    {
+        if (*Found == InBVH)
+            return;
+        delete *Found;
+        MeshBVHCache.Remove(ObjPath);
+    }
+    MeshBVHCache.Add(ObjPath, InBVH);
+}
+
 void UResourceManager::SetStaticMeshs()
 {
     StaticMeshs = GetAll<UStaticMesh>();
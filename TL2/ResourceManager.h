@@ -81,6 +81,8 @@ public:
     // Mesh BVH cache (OBJ path -> built BVH)
     FMeshBVH* GetMeshBVH(const FString& ObjPath);
     FMeshBVH* GetOrBuildMeshBVH(const FString& ObjPath, const struct FStaticMesh* StaticMeshAsset);
+    // 쿠킹된 BVH 등록 (소유권 이전, 같은 경로의 기존 BVH 는 교체)
+    void AddMeshBVH(const FString& ObjPath, FMeshBVH* InBVH);
 
     // MeshCache (for material sorting)
     void SetStaticMeshs();
@@ -220,6 +220,22 @@ void SViewportWindow::RenderToolbar()
 			case 2: ViewportClient->SetViewModeIndex(EViewModeIndex::VMI_Wireframe); break;
 			}
 		}
+		// 화면 크기 컬링 배율 (0 = 이 뷰포트에서 끔)
+		if (ViewportClient)
+		{
+			float CullScale = ViewportClient->GetScreenSizeCullScale();
+			ImGui::SameLine();
+			ImGui::SetNextItemWidth(50.0f);
+			if (ImGui::DragFloat("##ScreenSizeCullScale", &CullScale, 0.05f, 0.0f, 8.0f, "x%.2f"))
+			{
+				ViewportClient->SetScreenSizeCullScale(CullScale);
+			}
+			if (ImGui::IsItemHovered())
+			{
+				ImGui::SetTooltip("Screen size culling scale (0 = off)");
+			}
+		}
+
 		// 🔘 여기 ‘한 번 클릭’ 버튼 추가
 		const float btnW = 60.0f;
 		const ImVec2 btnSize(btnW, 0.0f);
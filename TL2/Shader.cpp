@@ -32,6 +32,7 @@ void UShader::Load(const FString& InShaderPath, ID3D11Device* InDevice)
     hr = InDevice->CreatePixelShader(PSBlob->GetBufferPointer(), PSBlob->GetBufferSize(), nullptr, &PixelShader);
 
     CreateInputLayout(InDevice, InShaderPath);
+    CreateInstancedVariant(InDevice, InShaderPath, WFilePath);
 }
 
 void UShader::CreateInputLayout(ID3D11Device* Device, const FString& InShaderPath)
@@ -49,6 +50,44 @@ void UShader::CreateInputLayout(ID3D11Device* Device, const FString& InShaderPat
     assert(SUCCEEDED(hr));
 }
 
+void UShader::CreateInstancedVariant(ID3D11Device* Device, const FString& InShaderPath, const std::wstring& InFilePath)
+{
+    // 진입점이 없는 셰이더는 컴파일이 실패하고 인스턴싱 없이 쓴다
+    ID3DBlob* InstancedVSBlob = nullptr;
+    ID3DBlob* errorBlob = nullptr;
+    HRESULT hr = D3DCompileFromFile(InFilePath.c_str(), nullptr, nullptr, "mainVSInstanced", "vs_5_0", 0, 0, &InstancedVSBlob, &errorBlob);
+    if (errorBlob) errorBlob->Release();
+    if (FAILED(hr) || !InstancedVSBlob)
+    {
+        return;
+    }
+
+    hr = Device->CreateVertexShader(InstancedVSBlob->GetBufferPointer(), InstancedVSBlob->GetBufferSize(), nullptr, &InstancedVertexShader);
+    if (SUCCEEDED(hr))
+    {
+        TArray<D3D11_INPUT_ELEMENT_DESC> descArray = UResourceManager::GetInstance().GetProperInputLayout(InShaderPath);
+        const D3D11_INPUT_ELEMENT_DESC* instanceLayout = FInstanceWorldMatrix::GetLayout();
+        descArray.insert(descArray.end(), instanceLayout, instanceLayout + FInstanceWorldMatrix::GetLayoutCount());
+
+        hr = Device->CreateInputLayout(
+            descArray.data(),
+            static_cast<uint32>(descArray.size()),
+            InstancedVSBlob->GetBufferPointer(),
+            InstancedVSBlob->GetBufferSize(),
+            &InstancedInputLayout);
+    }
+    if (FAILED(hr))
+    {
+        UE_LOG("shader \'%s\' instanced variant disabled", InShaderPath.c_str());
+        if (InstancedVertexShader)
+        {
+            InstancedVertexShader->Release();
+            InstancedVertexShader = nullptr;
+        }
+    }
+    InstancedVSBlob->Release();
+}
+
 void UShader::ReleaseResources()
 {
     if (VSBlob)
@@ -76,6 +115,16 @@ void UShader::ReleaseResources()
         PixelShader->Release();
         PixelShader = nullptr;
     }
+    if (InstancedInputLayout)
+    {
+        InstancedInputLayout->Release();
+        InstancedInputLayout = nullptr;
+    }
+    if (InstancedVertexShader)
+    {
+        InstancedVertexShader->Release();
+        InstancedVertexShader = nullptr;
+    }
 }
 // ========================== 오클루전 관련 메소드들 ==========================
 /*
@@ -12,6 +12,11 @@ public:
 	ID3D11VertexShader* GetVertexShader() const { return VertexShader; }
 	ID3D11PixelShader* GetPixelShader() const { return PixelShader; }
 
+	// 셰이더 파일에 mainVSInstanced 가 있으면 인스턴스 드로우 변형 (인스턴스 월드 행렬을 IA 슬롯 1에서 읽는다)
+	bool SupportsInstancing() const { return InstancedVertexShader != nullptr && InstancedInputLayout != nullptr; }
+	ID3D11VertexShader* GetInstancedVertexShader() const { return InstancedVertexShader; }
+	ID3D11InputLayout* GetInstancedInputLayout() const { return InstancedInputLayout; }
+
 
 
 
@@ -26,7 +31,11 @@ private:
 	ID3D11VertexShader* VertexShader = nullptr;
 	ID3D11PixelShader* PixelShader = nullptr;
 
+	ID3D11VertexShader* InstancedVertexShader = nullptr;
+	ID3D11InputLayout* InstancedInputLayout = nullptr;
+
 	void CreateInputLayout(ID3D11Device* Device, const FString& InShaderPath);
+	void CreateInstancedVariant(ID3D11Device* Device, const FString& InShaderPath, const std::wstring& InFilePath);
 	void ReleaseResources();
 };
 
@@ -87,6 +96,25 @@ struct FVertexPositionBillBoard
 
 };
 
+// 인스턴스 스트림 (IA 슬롯 1): FMatrix 한 개 = 행 4개
+struct FInstanceWorldMatrix
+{
+	static constexpr UINT Slot = 1;
+
+	static const D3D11_INPUT_ELEMENT_DESC* GetLayout()
+	{
+		static const D3D11_INPUT_ELEMENT_DESC layout[] = {
+			{ "INSTANCE_WORLD", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, Slot, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+			{ "INSTANCE_WORLD", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, Slot, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+			{ "INSTANCE_WORLD", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, Slot, 32, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+			{ "INSTANCE_WORLD", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, Slot, 48, D3D11_INPUT_PER_INSTANCE_DATA, 1 }
+		};
+		return layout;
+	}
+
+	static uint32 GetLayoutCount() { return 4; }
+};
+
 // ======================== 오클루전 관련 메소드들 ============================
 /*
 // 실패 시 false 반환, *OutVS/*OutPS는 성공 시 유효
@@ -0,0 +1,134 @@
+﻿#include "SimdDispatch.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+
+static inline void CpuId(int Regs[4], int Leaf, int SubLeaf) { __cpuidex(Regs, Leaf, SubLeaf); }
+static inline uint64 ReadXCR0() { return _xgetbv(0); }
+#else
+#include <cpuid.h>
+
+// GCC/Clang 빌드 (헤드리스 테스트)용
+static inline void CpuId(int Regs[4], int Leaf, int SubLeaf)
+{
+    __cpuid_count(Leaf, SubLeaf, Regs[0], Regs[1], Regs[2], Regs[3]);
+}
+
+// _xgetbv 는 -mxsave 없이 쓸 수 없어 명령을 직접 쓴다 (OSXSAVE 가 켜졌을 때만 호출됨)
+static inline uint64 ReadXCR0()
+{
+    uint32 Eax, Edx;
+    __asm__ volatile("xgetbv" : "=a"(Eax), "=d"(Edx) : "c"(0));
+    return (uint64(Edx) << 32) | Eax;
+}
+#endif
+
+ESimdLevel FSimd::ForcedLevel = ESimdLevel::Count;
+std::atomic<uint8> FSimd::ActiveLevel{ static_cast<uint8>(ESimdLevel::Scalar) };
+std::atomic<uint32> FSimd::Revision{ 0 };
+
+namespace
+{
+    FCpuFeatures DetectCpuFeatures()
+    {
+        FCpuFeatures Features;
+
+        int Regs[4];
+        CpuId(Regs, 0, 0);
+        const int MaxLeaf = Regs[0];
+        if (MaxLeaf < 1) return Features;
+
+        CpuId(Regs, 1, 0);
+        const int Ecx1 = Regs[2], Edx1 = Regs[3];
+        Features.bSSE2 = (Edx1 & (1 << 26)) != 0;
+        Features.bSSE41 = (Ecx1 & (1 << 19)) != 0;
+        const bool bFMA = (Ecx1 & (1 << 12)) != 0;
+        const bool bOSXSAVE = (Ecx1 & (1 << 27)) != 0;
+        const bool bAVXBit = (Ecx1 & (1 << 28)) != 0;
+
+        // CPU 가 지원해도 OS 가 해당 레지스터 상태를 저장해 주지 않으면 쓸 수 없다
+        const uint64 XCR0 = bOSXSAVE ? ReadXCR0() : 0;
+        const bool bOSYmm = (XCR0 & 0x6) == 0x6;            // XMM | YMM
+        const bool bOSZmm = (XCR0 & 0xE6) == 0xE6;          // XMM | YMM | opmask | ZMM_Hi256 | Hi16_ZMM
+
+        Features.bAVX = bAVXBit && bOSYmm;
+        Features.bFMA = bFMA && Features.bAVX;
+
+        if (MaxLeaf >= 7)
+        {
+            CpuId(Regs, 7, 0);
+            const int Ebx7 = Regs[1];
+            Features.bAVX2 = Features.bAVX && (Ebx7 & (1 << 5)) != 0;
+            if (bOSZmm)
+            {
+                Features.bAVX512F = (Ebx7 & (1 << 16)) != 0;
+                Features.bAVX512DQ = (Ebx7 & (1 << 17)) != 0;
+                Features.bAVX512BW = (Ebx7 & (1 << 30)) != 0;
+                Features.bAVX512VL = (Ebx7 & (1 << 31)) != 0;
+            }
+        }
+        return Features;
+    }
+
+    ESimdLevel ToLevel(const FCpuFeatures& F)
+    {
+        if (F.bAVX2 && F.bFMA && F.bAVX512F && F.bAVX512VL && F.bAVX512DQ && F.bAVX512BW) return ESimdLevel::AVX512;
+        if (F.bAVX2 && F.bFMA) return ESimdLevel::AVX2;
+        if (F.bSSE41) return ESimdLevel::SSE41;
+        if (F.bSSE2) return ESimdLevel::SSE2;
+        return ESimdLevel::Scalar;
+    }
+
+    // 정적 초기화 때 한 번 감지해 활성 레벨을 정해 둔다
+    struct FSimdStartup
+    {
+        FSimdStartup() { FSimd::SetForcedLevel(ESimdLevel::Count); }
+    } GSimdStartup;
+}
+
+const FCpuFeatures& FSimd::GetCpuFeatures()
+{
+    static const FCpuFeatures Features = DetectCpuFeatures();
+    return Features;
+}
+
+ESimdLevel FSimd::GetDetectedLevel()
+{
+    static const ESimdLevel Detected = ToLevel(GetCpuFeatures());
+    return Detected;
+}
+
+void FSimd::SetForcedLevel(ESimdLevel Level)
+{
+    ForcedLevel = Level;
+    const ESimdLevel Detected = GetDetectedLevel();
+    const ESimdLevel Active = (Level == ESimdLevel::Count || Level > Detected) ? Detected : Level;
+    ActiveLevel.store(static_cast<uint8>(Active), std::memory_order_relaxed);
+    Revision.fetch_add(1, std::memory_order_acq_rel);
+}
+
+const char* FSimd::GetLevelName(ESimdLevel Level)
+{
+    switch (Level)
+    {
+    case ESimdLevel::Scalar: return "Scalar";
+    case ESimdLevel::SSE2:   return "SSE2";
+    case ESimdLevel::SSE41:  return "SSE4.1";
+    case ESimdLevel::AVX2:   return "AVX2";
+    case ESimdLevel::AVX512: return "AVX512";
+    default:                 return "Auto";
+    }
+}
+
+ESimdLevel FSimd::ParseLevelName(const FString& Name)
+{
+    FString Lower = Name;
+    std::transform(Lower.begin(), Lower.end(), Lower.begin(), [](unsigned char C) { return static_cast<char>(std::tolower(C)); });
+    for (int L = 0; L < static_cast<int>(ESimdLevel::Count); ++L)
+    {
+        FString Candidate = GetLevelName(static_cast<ESimdLevel>(L));
+        std::transform(Candidate.begin(), Candidate.end(), Candidate.begin(), [](unsigned char C) { return static_cast<char>(std::tolower(C)); });
+        if (Lower == Candidate) return static_cast<ESimdLevel>(L);
+    }
+    return ESimdLevel::Count;
+}
@@ -0,0 +1,120 @@
+﻿#pragma once
+
+#include <atomic>
+#include <initializer_list>
+#include "UEContainer.h"
+
+// 실행 시점 CPU 기능 감지 + SIMD 커널 선택
+// - 시작 시 CPUID/XGETBV 로 지원 ISA 를 확인하고, 커널마다 가장 높은 지원 변형을 고른다
+// - ForcedLevel 로 상한을 낮출 수 있다 (변형별 벤치마크/스칼라 기준 검증용, editor.ini 의 SimdLevel)
+// - 커널은 자기 변형 중 활성 레벨 이하의 가장 높은 것을 쓴다 (없는 레벨은 아래 변형으로 내려감)
+enum class ESimdLevel : uint8
+{
+    Scalar,
+    SSE2,
+    SSE41,
+    AVX2,       // AVX2 + FMA
+    AVX512,     // AVX-512 F/VL/DQ/BW
+    Count,
+};
+
+// 변형 함수 하나에만 ISA 를 켜는 표시 (GCC/Clang). 파일 전체를 -mavx2 등으로 빌드하면
+// 스칼라/SSE 변형과 디스패치 코드까지 상위 ISA 로 자동 벡터화되므로 커널 단위로만 연다.
+// MSVC 는 /arch 없이도 모든 intrinsic 을 쓸 수 있어 비워둔다
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMD_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define SIMD_TARGET_AVX512 __attribute__((target("avx2,fma,avx512f,avx512vl,avx512dq,avx512bw")))
+#else
+#define SIMD_TARGET_SSE41
+#define SIMD_TARGET_AVX2
+#define SIMD_TARGET_AVX512
+#endif
+
+struct FCpuFeatures
+{
+    bool bSSE2 = false;
+    bool bSSE41 = false;
+    bool bAVX = false;          // OS 가 YMM 상태를 저장할 때만
+    bool bAVX2 = false;
+    bool bFMA = false;
+    bool bAVX512F = false;      // OS 가 ZMM/opmask 상태를 저장할 때만
+    bool bAVX512VL = false;
+    bool bAVX512DQ = false;
+    bool bAVX512BW = false;
+};
+
+class FSimd
+{
+public:
+    static const FCpuFeatures& GetCpuFeatures();
+
+    // CPU 가 지원하는 최고 레벨
+    static ESimdLevel GetDetectedLevel();
+
+    // 커널 선택에 쓰는 레벨 = min(감지 레벨, 강제 레벨)
+    static ESimdLevel GetLevel() { return static_cast<ESimdLevel>(ActiveLevel.load(std::memory_order_relaxed)); }
+    static bool IsAtLeast(ESimdLevel Level) { return GetLevel() >= Level; }
+
+    // 상한 강제 (감지 레벨보다 높이면 감지 레벨로 잘린다). Count 를 넘기면 자동 선택으로 복귀
+    static void SetForcedLevel(ESimdLevel Level);
+    static ESimdLevel GetForcedLevel() { return ForcedLevel; }
+    static bool IsLevelForced() { return ForcedLevel != ESimdLevel::Count; }
+
+    // 레벨이 바뀔 때마다 증가 (커널 포인터 캐시 무효화용)
+    static uint32 GetRevision() { return Revision.load(std::memory_order_acquire); }
+
+    static const char* GetLevelName(ESimdLevel Level);
+    // 이름 → 레벨 (대소문자 무시, "Auto" 나 모르는 이름이면 Count)
+    static ESimdLevel ParseLevelName(const FString& Name);
+
+private:
+    static ESimdLevel ForcedLevel;
+    static std::atomic<uint8> ActiveLevel;
+    static std::atomic<uint32> Revision;
+};
+
+// 레벨별 변형을 들고 있다가 활성 레벨에 맞는 함수 포인터를 돌려주는 커널 테이블
+//  - 선택 결과는 FSimd 리비전이 바뀔 때만 다시 계산한다 (워커 스레드에서 동시에 불려도 모두 유효한 변형을 얻는다)
+template<typename FnType>
+class TSimdKernel
+{
+public:
+    TSimdKernel(std::initializer_list<std::pair<ESimdLevel, FnType>> InVariants)
+    {
+        for (const auto& Variant : InVariants)
+            Variants[static_cast<int>(Variant.first)] = Variant.second;
+    }
+
+    FnType Get() const
+    {
+        const uint32 CurrentRevision = FSimd::GetRevision();
+        if (ResolvedRevision.load(std::memory_order_acquire) == CurrentRevision)
+            return Resolved.load(std::memory_order_relaxed);
+
+        const FnType Fn = GetVariant(FSimd::GetLevel());
+        Resolved.store(Fn, std::memory_order_relaxed);
+        ResolvedRevision.store(CurrentRevision, std::memory_order_release);
+        return Fn;
+    }
+
+    // Level 이하에서 가장 높은 변형 (검증 도구가 레벨별로 직접 호출할 때)
+    FnType GetVariant(ESimdLevel Level) const
+    {
+        for (int L = static_cast<int>(Level); L >= 0; --L)
+            if (Variants[L]) return Variants[L];
+        return nullptr;
+    }
+
+    // 정확히 그 레벨의 변형이 있는지
+    bool HasVariant(ESimdLevel Level) const { return Variants[static_cast<int>(Level)] != nullptr; }
+
+private:
+    FnType Variants[static_cast<int>(ESimdLevel::Count)] = {};
+    mutable std::atomic<FnType> Resolved{ nullptr };
+    mutable std::atomic<uint32> ResolvedRevision{ ~0u };
+};
+
+// 각 SIMD 변형을 스칼라 기준 구현과 무작위 입력으로 비교하고 결과를 로그로 남긴다.
+// 검사한 변형 중 불일치가 있으면 false
+bool ValidateSimdKernels();
@@ -0,0 +1,34 @@
+﻿#include "pch.h"
+#include "SimdDispatch.h"
+#include "FrustumCulling.h"
+#include "Occlusion.h"
+
+// 검증 결과를 콘솔로 남겨야 해서 엔진 헤더(pch)를 쓰는 쪽에 둔다
+bool ValidateSimdKernels()
+{
+    const FCpuFeatures& F = FSimd::GetCpuFeatures();
+    UE_LOG("SIMD detected %s (SSE4.1 %d, AVX %d, AVX2 %d, FMA %d, AVX512F %d), active %s",
+        FSimd::GetLevelName(FSimd::GetDetectedLevel()), F.bSSE41, F.bAVX, F.bAVX2, F.bFMA, F.bAVX512F,
+        FSimd::GetLevelName(FSimd::GetLevel()));
+
+    constexpr uint32 Seed = 0x51D0u;
+    TArray<FCullingKernelReport> CullingReports;
+    const bool bCulling = ValidateCullingKernels(Seed, 20000, CullingReports);
+    for (const FCullingKernelReport& Report : CullingReports)
+    {
+        const bool bPassed = Report.CullMismatches == 0 && Report.StreamMismatches == 0 && Report.TransformMismatches == 0;
+        UE_LOG("SIMD %s culling kernels: %s (Cull mismatches %d, Stream mismatches %d, boundary skipped %d, Transform mismatches %d)",
+            FSimd::GetLevelName(Report.Level), bPassed ? "OK" : "FAILED", Report.CullMismatches, Report.StreamMismatches,
+            Report.BoundarySkipped, Report.TransformMismatches);
+    }
+
+    TArray<FOcclusionGrid::FKernelReport> OcclusionReports;
+    const bool bOcclusion = FOcclusionGrid::ValidateKernels(Seed, 200, OcclusionReports);
+    for (const FOcclusionGrid::FKernelReport& Report : OcclusionReports)
+    {
+        const bool bPassed = Report.RasterMismatches == 0 && Report.HZBMismatches == 0;
+        UE_LOG("SIMD %s occlusion kernels: %s (Raster mismatches %d, HZB mismatches %d)",
+            FSimd::GetLevelName(Report.Level), bPassed ? "OK" : "FAILED", Report.RasterMismatches, Report.HZBMismatches);
+    }
+    return bCulling && bOcclusion;
+}
@@ -20,12 +20,11 @@ void UStaticMesh::Load(const FString& InFilePath, ID3D11Device* InDevice, EVerte
     VertexCount = static_cast<uint32>(StaticMeshAsset->Vertices.size());
     IndexCount = static_cast<uint32>(StaticMeshAsset->Indices.size());
 
-    // Cache or build BVH once per OBJ asset and keep reference
-    //if (StaticMeshAsset)
-    //{
-    //    const FString& Key = StaticMeshAsset->PathFileName;
-    //    MeshBVH = UResourceManager::GetInstance().GetOrBuildMeshBVH(Key, StaticMeshAsset);
-    //}
+    // 메시 에셋 로드 시 함께 준비된(쿠킹된) BVH 참조
+    if (StaticMeshAsset)
+    {
+        MeshBVH = UResourceManager::GetInstance().GetMeshBVH(StaticMeshAsset->PathFileName);
+    }
 }
 
 void UStaticMesh::Load(FMeshData* InData, ID3D11Device* InDevice, EVertexLayoutType InVertexType)
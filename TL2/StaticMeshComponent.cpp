@@ -32,6 +32,53 @@ void UStaticMeshComponent::Render(URenderer* Renderer, const FMatrix& ViewMatrix
     Renderer->PrepareShader(GetMaterial()->GetShader());
     Renderer->DrawIndexedPrimitiveComponent(GetStaticMesh(), D3D10_PRIMITIVE_TOPOLOGY_TRIANGLELIST, MaterailSlots);
 }
+
+bool UStaticMeshComponent::EmitDrawCommands(FDrawCommandList& OutList, const FMatrix& View)
+{
+    UStaticMesh* Mesh = GetStaticMesh();
+    if (!Mesh)
+    {
+        return true; // Render 와 같이 그릴 것이 없다
+    }
+    UMaterial* ComponentMaterial = GetMaterial();
+    UShader* Shader = ComponentMaterial ? ComponentMaterial->GetShader() : nullptr;
+    if (!Shader)
+    {
+        return false;
+    }
+
+    const uint32 ShaderId = DrawSortKey::GetShaderId(Shader);
+    const uint32 MeshId = DrawSortKey::GetMeshId(Mesh);
+    const float ViewDepth = ComputeViewDepth(View, GetWorldLocation());
+
+    FDrawCommand Command;
+    Command.Shader = Shader;
+    Command.Mesh = Mesh;
+    Command.TransformIndex = OutList.AddTransform(GetWorldMatrix());
+
+    if (Mesh->HasMaterial())
+    {
+        const TArray<FGroupInfo>& GroupInfos = Mesh->GetMeshGroupInfo();
+        for (int32 i = 0; i < static_cast<int32>(GroupInfos.size()); ++i)
+        {
+            UMaterial* SectionMaterial = UResourceManager::GetInstance().Get<UMaterial>(MaterailSlots[i].MaterialName.ToString());
+            Command.Material = SectionMaterial;
+            Command.StartIndex = GroupInfos[i].StartIndex;
+            Command.IndexCount = GroupInfos[i].IndexCount;
+            Command.SortKey = DrawSortKey::Make(ERenderPass::Opaque, ShaderId, DrawSortKey::GetMaterialId(SectionMaterial), MeshId, ViewDepth);
+            OutList.AddCommand(Command);
+        }
+    }
+    else
+    {
+        Command.Material = nullptr;
+        Command.StartIndex = 0;
+        Command.IndexCount = Mesh->GetIndexCount();
+        Command.SortKey = DrawSortKey::Make(ERenderPass::Opaque, ShaderId, 0, MeshId, ViewDepth);
+        OutList.AddCommand(Command);
+    }
+    return true;
+}
 void UStaticMeshComponent::SetStaticMesh(const FString& PathFileName)
 {
     if (StaticMesh != nullptr)
@@ -24,6 +24,8 @@ protected:
 
 public:
     void Render(URenderer* Renderer, const FMatrix& View, const FMatrix& Proj) override;
+    // 메시 섹션마다 커맨드 하나 (불투명 패스)
+    bool EmitDrawCommands(FDrawCommandList& OutList, const FMatrix& View) override;
 
     void SetStaticMesh(const FString& PathFileName);
     UStaticMesh* GetStaticMesh() const { return StaticMesh; }
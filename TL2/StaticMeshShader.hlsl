@@ -27,6 +27,19 @@ struct VS_INPUT
     float2 texCoord : TEXCOORD0;
 };
 
+// 인스턴스 드로우 입력: 정점 스트림(슬롯 0) + 인스턴스별 월드 행렬 행 4개(슬롯 1)
+struct VS_INSTANCE_INPUT
+{
+    float3 position : POSITION;
+    float3 normal : NORMAL0;
+    float4 color : COLOR;
+    float2 texCoord : TEXCOORD0;
+    float4 world0 : INSTANCE_WORLD0;
+    float4 world1 : INSTANCE_WORLD1;
+    float4 world2 : INSTANCE_WORLD2;
+    float4 world3 : INSTANCE_WORLD3;
+};
+
 
 Texture2D g_DiffuseTexColor : register(t0);
 SamplerState g_Sample : register(s0);
@@ -75,7 +88,7 @@ struct PS_INPUT
     float2 texCoord : TEXCOORD0;
 };
 
-PS_INPUT mainVS(VS_INPUT input)
+PS_INPUT TransformVertex(VS_INPUT input, float4x4 World)
 {
     PS_INPUT output;
     
@@ -83,7 +96,7 @@ PS_INPUT mainVS(VS_INPUT input)
     // float3 scaledPosition = input.position.xyz * Scale;
     // output.position = float4(Offset + scaledPosition, 1.0);
     
-    float4x4 MVP = mul(mul(WorldMatrix, ViewMatrix), ProjectionMatrix);
+    float4x4 MVP = mul(mul(World, ViewMatrix), ProjectionMatrix);
     
     output.position = mul(float4(input.position, 1.0f), MVP);
     
@@ -135,6 +148,24 @@ PS_INPUT mainVS(VS_INPUT input)
     return output;
 }
 
+PS_INPUT mainVS(VS_INPUT input)
+{
+    return TransformVertex(input, WorldMatrix);
+}
+
+PS_INPUT mainVSInstanced(VS_INSTANCE_INPUT input)
+{
+    VS_INPUT vertex;
+    vertex.position = input.position;
+    vertex.normal = input.normal;
+    vertex.color = input.color;
+    vertex.texCoord = input.texCoord;
+    
+    // CPU FMatrix 행 그대로 (row_major WorldMatrix 와 같은 배치)
+    float4x4 World = float4x4(input.world0, input.world1, input.world2, input.world3);
+    return TransformVertex(vertex, World);
+}
+
 float4 mainPS(PS_INPUT input) : SV_TARGET
 {
     // Lerp the incoming color with the global LerpColor
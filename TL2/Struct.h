@@ -3,6 +3,9 @@
 #include <algorithm>
 #include <string>
 #include <limits>
+#include <cassert>
+#include <cfloat>
+#include <immintrin.h>
 
 #include "UEContainer.h"
 
@@ -1291,3 +1294,94 @@ struct FBound
         return true;
     }
 };
+
+// 8개 AABB 를 축별로 모아 둔 SoA 묶음 (BVH8 노드의 자식 바운드 등)
+struct alignas(32) FBound8
+{
+    float MinX[8];
+    float MinY[8];
+    float MinZ[8];
+    float MaxX[8];
+    float MaxY[8];
+    float MaxZ[8];
+
+    void Set(int32 Lane, const FBound& B)
+    {
+        MinX[Lane] = B.Min.X; MinY[Lane] = B.Min.Y; MinZ[Lane] = B.Min.Z;
+        MaxX[Lane] = B.Max.X; MaxY[Lane] = B.Max.Y; MaxZ[Lane] = B.Max.Z;
+    }
+    FBound Get(int32 Lane) const
+    {
+        return FBound(FVector(MinX[Lane], MinY[Lane], MinZ[Lane]), FVector(MaxX[Lane], MaxY[Lane], MaxZ[Lane]));
+    }
+    // 빈 레인: min > max 라서 어떤 테스트도 통과하지 못한다
+    void SetEmpty(int32 Lane)
+    {
+        MinX[Lane] = MinY[Lane] = MinZ[Lane] = FLT_MAX;
+        MaxX[Lane] = MaxY[Lane] = MaxZ[Lane] = -FLT_MAX;
+    }
+};
+
+// 축별 배열을 가리키는 읽기 전용 AABB 스트림 (배치 프러스텀 컬링 입력, 메모리는 소유하지 않음)
+struct FBoundStream
+{
+    const float* MinX = nullptr;
+    const float* MinY = nullptr;
+    const float* MinZ = nullptr;
+    const float* MaxX = nullptr;
+    const float* MaxY = nullptr;
+    const float* MaxZ = nullptr;
+    int32 Count = 0;
+};
+
+// 개수 제한 없는 AABB SoA 묶음 (파티클, 빌보드, 디버그 도형, BVH 리프 프리미티브 등)
+struct FBoundSoA
+{
+    TArray<float> MinX, MinY, MinZ;
+    TArray<float> MaxX, MaxY, MaxZ;
+
+    int32 Num() const { return static_cast<int32>(MinX.size()); }
+
+    void Reset(int32 ReserveCount = 0)
+    {
+        for (TArray<float>* Axis : { &MinX, &MinY, &MinZ, &MaxX, &MaxY, &MaxZ })
+        {
+            Axis->clear();
+            Axis->reserve(ReserveCount);
+        }
+    }
+    void Resize(int32 Count)
+    {
+        for (TArray<float>* Axis : { &MinX, &MinY, &MinZ, &MaxX, &MaxY, &MaxZ })
+            Axis->resize(Count);
+    }
+    void Add(const FBound& B)
+    {
+        MinX.push_back(B.Min.X); MinY.push_back(B.Min.Y); MinZ.push_back(B.Min.Z);
+        MaxX.push_back(B.Max.X); MaxY.push_back(B.Max.Y); MaxZ.push_back(B.Max.Z);
+    }
+    void Set(int32 Index, const FBound& B)
+    {
+        MinX[Index] = B.Min.X; MinY[Index] = B.Min.Y; MinZ[Index] = B.Min.Z;
+        MaxX[Index] = B.Max.X; MaxY[Index] = B.Max.Y; MaxZ[Index] = B.Max.Z;
+    }
+    FBound Get(int32 Index) const
+    {
+        return FBound(FVector(MinX[Index], MinY[Index], MinZ[Index]), FVector(MaxX[Index], MaxY[Index], MaxZ[Index]));
+    }
+
+    // [First, First + Count) 구간 스트림 (Count < 0 이면 끝까지)
+    FBoundStream MakeStream(int32 First = 0, int32 Count = -1) const
+    {
+        FBoundStream Stream;
+        Stream.Count = Count < 0 ? Num() - First : Count;
+        if (Stream.Count <= 0)
+        {
+            Stream.Count = 0;
+            return Stream;
+        }
+        Stream.MinX = MinX.data() + First; Stream.MinY = MinY.data() + First; Stream.MinZ = MinZ.data() + First;
+        Stream.MaxX = MaxX.data() + First; Stream.MaxY = MaxY.data() + First; Stream.MaxZ = MaxZ.data() + First;
+        return Stream;
+    }
+};
@@ -0,0 +1,102 @@
+﻿#include "TestHarness.h"
+#include "ConstantRingAllocator.h"
+
+TEST_CASE(ConstantRing_CapacityIsAligned)
+{
+    FConstantRingAllocator Ring;
+    Ring.Initialize(1000);
+    CHECK(Ring.GetCapacity() == 1024);
+    CHECK(FConstantRingAllocator::AlignSize(1) == 256);
+    CHECK(FConstantRingAllocator::AlignSize(256) == 256);
+    CHECK(FConstantRingAllocator::AlignSize(257) == 512);
+}
+
+TEST_CASE(ConstantRing_FirstMapOfFrameDiscards)
+{
+    FConstantRingAllocator Ring;
+    Ring.Initialize(4096);
+    Ring.BeginFrame();
+
+    uint32 Offset = ~0u;
+    bool bDiscard = false;
+    CHECK(Ring.Allocate(100, Offset, bDiscard));
+    CHECK(Offset == 0 && bDiscard);
+    CHECK(Ring.Allocate(300, Offset, bDiscard));
+    CHECK(Offset == 256 && !bDiscard);     // 이어 쓰기는 NO_OVERWRITE
+    CHECK(Ring.GetUsedBytes() == 768);
+
+    // 다음 프레임의 첫 매핑은 커서가 처음이라도 다시 DISCARD
+    Ring.BeginFrame();
+    CHECK(Ring.Allocate(16, Offset, bDiscard));
+    CHECK(Offset == 0 && bDiscard);
+    CHECK(Ring.GetLastStats().Allocations == 2 && Ring.GetLastStats().Discards == 1);
+    CHECK(Ring.GetStats().Allocations == 1);
+}
+
+TEST_CASE(ConstantRing_WrapDiscardsAndAsksToGrow)
+{
+    FConstantRingAllocator Ring;
+    Ring.Initialize(1024);
+    Ring.BeginFrame();
+
+    uint32 Offset = 0;
+    bool bDiscard = false;
+    CHECK(Ring.Allocate(512, Offset, bDiscard) && Offset == 0 && bDiscard);
+    CHECK(Ring.Allocate(256, Offset, bDiscard) && Offset == 512 && !bDiscard);
+    CHECK(!Ring.NeedsGrow());
+
+    // 남은 256 바이트로는 모자라 처음으로 되감는다
+    CHECK(Ring.Allocate(512, Offset, bDiscard));
+    CHECK(Offset == 0 && bDiscard);
+    CHECK(Ring.GetStats().Wraps == 1 && Ring.GetStats().Discards == 2);
+
+    // 한 프레임에 1280 바이트를 썼으므로 2의 거듭제곱으로 올린 2048 을 원한다
+    CHECK(Ring.NeedsGrow());
+    CHECK(Ring.GetDesiredCapacity() == 2048);
+}
+
+TEST_CASE(ConstantRing_OversizeRequestFails)
+{
+    FConstantRingAllocator Ring;
+    Ring.Initialize(1024);
+    Ring.BeginFrame();
+
+    uint32 Offset = 123;
+    bool bDiscard = false;
+    CHECK(Ring.Allocate(256, Offset, bDiscard));
+    CHECK(!Ring.Allocate(5000, Offset, bDiscard));
+    CHECK(Ring.GetStats().Failures == 1);
+    CHECK(Ring.GetStats().Allocations == 1);
+    CHECK(Ring.GetUsedBytes() == 256);     // 실패는 커서를 움직이지 않는다
+
+    // 이번 프레임 사용량 + 실패한 요청(정렬 5120)을 담을 크기
+    CHECK(Ring.GetDesiredCapacity() == 8192);
+}
+
+TEST_CASE(ConstantRing_GrowKeepsStatsAndDesiredCapacityOnlyIncreases)
+{
+    FConstantRingAllocator Ring;
+    Ring.Initialize(1024);
+    Ring.BeginFrame();
+
+    uint32 Offset = 0;
+    bool bDiscard = false;
+    CHECK(!Ring.Allocate(3000, Offset, bDiscard));
+    CHECK(Ring.GetDesiredCapacity() == 4096);
+    CHECK(!Ring.Allocate(1500, Offset, bDiscard));
+    CHECK(Ring.GetDesiredCapacity() == 4096);  // 더 작은 요청으로 줄어들지 않는다
+
+    Ring.BeginFrame();
+    CHECK(Ring.NeedsGrow());
+    Ring.Initialize(Ring.GetDesiredCapacity());
+    CHECK(Ring.GetCapacity() == 4096 && !Ring.NeedsGrow());
+    CHECK(Ring.GetLastStats().Failures == 2);  // 키워도 지난 프레임 통계는 남는다
+
+    // 키운 뒤 첫 매핑은 DISCARD 이고 이번에는 들어간다
+    CHECK(Ring.Allocate(3000, Offset, bDiscard));
+    CHECK(Offset == 0 && bDiscard);
+
+    // 더 작은 크기로 다시 초기화해도 원하는 용량은 유지된다
+    Ring.Initialize(1024);
+    CHECK(Ring.GetDesiredCapacity() == 4096 && Ring.NeedsGrow());
+}
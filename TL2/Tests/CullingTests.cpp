@@ -0,0 +1,349 @@
+﻿#include "TestHarness.h"
+#include "FrustumCulling.h"
+#include "SimdDispatch.h"
+#include <bit>
+#include <cfloat>
+#include <limits>
+#include <random>
+
+namespace
+{
+    // 감지된 레벨까지 SIMD 레벨을 하나씩 강제하며 Body 를 실행하고, 끝나면 자동 선택으로 되돌린다
+    template<typename FnType>
+    void ForEachSimdLevel(FnType&& Body)
+    {
+        for (int L = 0; L <= static_cast<int>(FSimd::GetDetectedLevel()); ++L)
+        {
+            FSimd::SetForcedLevel(static_cast<ESimdLevel>(L));
+            Body(static_cast<ESimdLevel>(L));
+        }
+        FSimd::SetForcedLevel(ESimdLevel::Count);
+    }
+
+    Plane MakeTestPlane(const FVector4& Normal, float Distance)
+    {
+        return Plane{ Normalize3(Normal), Distance };
+    }
+
+    // +X 를 보는 원근 프러스텀 (near 1, far 100, 옆면 기울기 0.7). 법선은 모두 안쪽
+    Frustum MakeTestFrustum()
+    {
+        Frustum F;
+        F.TopFace = MakeTestPlane(FVector4(0.7f, 0.0f, -1.0f, 0.0f), 0.0f);
+        F.BottomFace = MakeTestPlane(FVector4(0.7f, 0.0f, 1.0f, 0.0f), 0.0f);
+        F.RightFace = MakeTestPlane(FVector4(0.7f, -1.0f, 0.0f, 0.0f), 0.0f);
+        F.LeftFace = MakeTestPlane(FVector4(0.7f, 1.0f, 0.0f, 0.0f), 0.0f);
+        F.NearFace = MakeTestPlane(FVector4(1.0f, 0.0f, 0.0f, 0.0f), 1.0f);
+        F.FarFace = MakeTestPlane(FVector4(-1.0f, 0.0f, 0.0f, 0.0f), -100.0f);
+        return F;
+    }
+
+    // 평면 기준 판정 (Intersects 와 같은 식). IsAABBVisible 은 여섯 평면 전부를 이것으로 본다
+    bool IsVisibleAgainstPlanes(const Frustum& F, const FBound& B, uint32 PlaneMask)
+    {
+        if (PlaneMask == FrustumAllPlanes) return IsAABBVisible(F, B);
+
+        const FVector4 Center = MakePoint4((B.Min + B.Max) * 0.5f);
+        const FVector4 Extents = MakeDir4((B.Max - B.Min) * 0.5f);
+        const Plane* Planes = &F.TopFace;
+        for (int p = 0; p < 6; ++p)
+            if ((PlaneMask & (1u << p)) && !Intersects(Planes[p], Center, Extents)) return false;
+        return true;
+    }
+
+    // FMA 변형은 반올림이 한 번 적으므로 평면 경계에 닿을락 말락 한 박스는 판정이 갈릴 수 있다
+    bool IsNearBoundary(const Frustum& F, const FBound& B)
+    {
+        const FVector C = (B.Min + B.Max) * 0.5f;
+        const FVector E = (B.Max - B.Min) * 0.5f;
+        const Plane* Planes = &F.TopFace;
+        for (int p = 0; p < 6; ++p)
+        {
+            const Plane& P = Planes[p];
+            const float Dist = C.X * P.Normal.X + C.Y * P.Normal.Y + C.Z * P.Normal.Z - P.Distance;
+            const float Radius = E.X * std::abs(P.Normal.X) + E.Y * std::abs(P.Normal.Y) + E.Z * std::abs(P.Normal.Z);
+            if (std::abs(Dist + Radius) < 1e-3f || std::abs(Dist - Radius) < 1e-3f) return true;
+        }
+        return false;
+    }
+
+    // 프러스텀 안팎에 흩어진 박스. 일부는 중심을 평면 위에 두어 평면을 가로지르게 하고, 빈 박스와 NaN 박스도 섞는다
+    FBoundSoA MakeTestBoxes(std::mt19937& Rng, const Frustum& F, int32 Count)
+    {
+        auto Range = [&](float Lo, float Hi) { return std::uniform_real_distribution<float>(Lo, Hi)(Rng); };
+
+        FBoundSoA Boxes;
+        Boxes.Reset(Count);
+        for (int32 i = 0; i < Count; ++i)
+        {
+            const uint32 Kind = Rng() % 16;
+            if (Kind == 0)
+            {
+                Boxes.Add(FBound(FVector(FLT_MAX, FLT_MAX, FLT_MAX), FVector(-FLT_MAX, -FLT_MAX, -FLT_MAX)));
+                continue;
+            }
+
+            FVector C(Range(-20.0f, 120.0f), Range(-90.0f, 90.0f), Range(-90.0f, 90.0f));
+            const FVector E(Range(0.5f, 15.0f), Range(0.5f, 15.0f), Range(0.5f, 15.0f));
+            if (Kind < 6)
+            {
+                // 평면 하나에 중심을 투영해 걸치게 한다
+                const Plane& P = (&F.TopFace)[Kind];
+                const float Dist = C.X * P.Normal.X + C.Y * P.Normal.Y + C.Z * P.Normal.Z - P.Distance;
+                C = C - FVector(P.Normal.X, P.Normal.Y, P.Normal.Z) * Dist;
+            }
+            Boxes.Add(FBound(C - E, C + E));
+            if (Kind == 6) Boxes.MaxZ[i] = std::numeric_limits<float>::quiet_NaN();
+        }
+        return Boxes;
+    }
+
+    bool SameCullResult(const FCullResult8& A, const FCullResult8& B)
+    {
+        return A.Visible == B.Visible && A.RejectPlane == B.RejectPlane && A.PlaneTests == B.PlaneTests &&
+            std::equal(A.Inside, A.Inside + 6, B.Inside);
+    }
+
+    // 평면 비트 (Frustum 멤버 순서)
+    constexpr int32 TopPlane = 0, NearPlane = 4, FarPlane = 5;
+
+    // SIMD 폭(4/8/16)과 인덱스 버전의 블록(1024)으로 나누어떨어지지 않는 길이 위주
+    constexpr int32 StreamCounts[] = { 0, 1, 3, 5, 7, 9, 13, 15, 17, 31, 33, 63, 65, 127, 129, 1023, 1025, 2501 };
+}
+
+TEST_CASE(Culling_StreamMaskMatchesIsAABBVisible)
+{
+    std::mt19937 Rng(0xC011u);
+    const Frustum F = MakeTestFrustum();
+    const uint32 PlaneMasks[] = { FrustumAllPlanes, 0x00u, 0x01u, 0x30u, 0x2Du, 0x1Eu };
+
+    for (const int32 Count : StreamCounts)
+    {
+        // 한 칸 밀린 시작점으로 정렬되지 않은 스트림도 본다
+        const FBoundSoA Boxes = MakeTestBoxes(Rng, F, Count + 1);
+        const FBoundStream Stream = Boxes.MakeStream(1, Count);
+
+        for (const uint32 PlaneMask : PlaneMasks)
+        {
+            ForEachSimdLevel([&](ESimdLevel)
+            {
+                const int32 Words = (Count + 63) / 64;
+                TArray<uint64> Mask(Words + 1, ~0ull);     // 함수가 덮어쓰는지 보려고 쓰레기 값으로 채움
+                const int32 NumVisible = CullAABBStreamMask(F, Stream, Mask.data(), PlaneMask);
+
+                int32 Mismatches = 0, SetBits = 0;
+                for (int32 i = 0; i < Count; ++i)
+                {
+                    const bool bGot = (Mask[i >> 6] >> (i & 63)) & 1;
+                    SetBits += bGot ? 1 : 0;
+                    const FBound B = Boxes.Get(i + 1);
+                    if (bGot != IsVisibleAgainstPlanes(F, B, PlaneMask) && !IsNearBoundary(F, B)) ++Mismatches;
+                }
+                CHECK(Mismatches == 0);
+                CHECK(NumVisible == SetBits);
+                if (Count & 63) CHECK((Mask[Words - 1] >> (Count & 63)) == 0);    // 남는 비트는 0
+                CHECK(Mask[Words] == ~0ull);                                    // 필요한 워드 밖은 건드리지 않음
+            });
+        }
+    }
+}
+
+TEST_CASE(Culling_StreamIndicesMatchIsAABBVisible)
+{
+    std::mt19937 Rng(0x1D5u);
+    const Frustum F = MakeTestFrustum();
+
+    for (const int32 Count : StreamCounts)
+    {
+        const FBoundSoA Boxes = MakeTestBoxes(Rng, F, Count);
+        const FBoundStream Stream = Boxes.MakeStream();
+
+        ForEachSimdLevel([&](ESimdLevel)
+        {
+            TArray<uint32> Indices(Count + 1, ~0u);
+            const int32 NumVisible = CullAABBStream(F, Stream, Indices.data());
+            CHECK(NumVisible >= 0 && NumVisible <= Count);
+            CHECK(Indices[Count] == ~0u);
+
+            // 오름차순이고, 빠진 박스는 모두 보이지 않아야 한다
+            int32 Mismatches = 0;
+            int32 Next = 0;
+            for (int32 i = 0; i < Count; ++i)
+            {
+                const bool bListed = Next < NumVisible && Indices[Next] == static_cast<uint32>(i);
+                if (bListed) ++Next;
+                const FBound B = Boxes.Get(i);
+                if (bListed != IsAABBVisible(F, B) && !IsNearBoundary(F, B)) ++Mismatches;
+            }
+            CHECK(Next == NumVisible);
+            CHECK(Mismatches == 0);
+
+            // 마스크 버전과 같은 집합
+            TArray<uint64> Mask((Count + 63) / 64 + 1);
+            CHECK(CullAABBStreamMask(F, Stream, Mask.data()) == NumVisible);
+            bool bSameSet = true;
+            for (int32 n = 0; n < NumVisible; ++n)
+                bSameSet &= ((Mask[Indices[n] >> 6] >> (Indices[n] & 63)) & 1) != 0;
+            CHECK(bSameSet);
+        });
+    }
+}
+
+TEST_CASE(Culling_Masked8MatchesScalarAtEveryLevel)
+{
+    std::mt19937 Rng(0x8B0Du);
+    const Frustum F = MakeTestFrustum();
+
+    int32 Compared = 0;
+    for (int32 Iter = 0; Iter < 3000; ++Iter)
+    {
+        const FBoundSoA Boxes = MakeTestBoxes(Rng, F, 8);
+        FBound8 Bounds;
+        bool bNearBoundary = false;
+        for (int32 Lane = 0; Lane < 8; ++Lane)
+        {
+            Bounds.Set(Lane, Boxes.Get(Lane));
+            bNearBoundary |= IsNearBoundary(F, Boxes.Get(Lane));
+        }
+        if (bNearBoundary) continue;
+
+        // 부모 마스크 0 / 레인 마스크 0 (조기 종료 경로)도 일정 비율로 섞는다
+        const uint8_t LaneMask = (Iter % 17 == 0) ? 0 : static_cast<uint8_t>(Rng());
+        const uint32 PlaneMask = (Iter % 13 == 0) ? 0u : (Rng() & FrustumAllPlanes);
+        const int32 FirstPlane = static_cast<int32>(Rng() % 6);
+
+        FSimd::SetForcedLevel(ESimdLevel::Scalar);
+        const FCullResult8 Ref = CullAABBs8Masked(F, Bounds, LaneMask, PlaneMask, FirstPlane);
+        ForEachSimdLevel([&](ESimdLevel)
+        {
+            CHECK(SameCullResult(Ref, CullAABBs8Masked(F, Bounds, LaneMask, PlaneMask, FirstPlane)));
+        });
+        ++Compared;
+    }
+    CHECK(Compared > 1000);
+}
+
+TEST_CASE(Culling_Masked8ReportsPartiallyInsidePlanes)
+{
+    const Frustum F = MakeTestFrustum();
+    FBound8 Bounds;
+    for (int32 Lane = 0; Lane < 8; ++Lane) Bounds.SetEmpty(Lane);
+    Bounds.Set(0, FBound(FVector(49.0f, -1.0f, -1.0f), FVector(51.0f, 1.0f, 1.0f)));           // 완전 내부
+    Bounds.Set(1, FBound(FVector(0.75f, -0.25f, -0.25f), FVector(1.25f, 0.25f, 0.25f)));       // near 평면에 걸침
+    Bounds.Set(2, FBound(FVector(99.0f, -0.5f, -0.5f), FVector(101.0f, 0.5f, 0.5f)));          // far 평면에 걸침
+    Bounds.Set(3, FBound(FVector(-6.0f, -1.0f, -1.0f), FVector(-4.0f, 1.0f, 1.0f)));           // 뒤쪽 (밖)
+
+    ForEachSimdLevel([&](ESimdLevel)
+    {
+        const FCullResult8 Result = CullAABBs8Masked(F, Bounds, 0xFF, FrustumAllPlanes, TopPlane);
+        CHECK(Result.Visible == 0b0111);
+        CHECK(Result.RejectPlane == -1);
+        for (int32 p = 0; p < 6; ++p)
+        {
+            // 걸친 평면에서만 그 레인의 완전 내부 비트가 빠진다
+            uint8_t Expected = 0b0111;
+            if (p == NearPlane) Expected &= ~0b0010;
+            if (p == FarPlane) Expected &= ~0b0100;
+            CHECK(Result.Inside[p] == Expected);
+        }
+
+        // 자식 단계: 부모에서 완전 내부였던 평면은 빼고 넘기면 그 평면은 테스트하지 않는다
+        const uint32 ChildMask = 1u << NearPlane;
+        const FCullResult8 Child = CullAABBs8Masked(F, Bounds, 0b0111, ChildMask, NearPlane);
+        CHECK(Child.Visible == 0b0111);
+        CHECK(Child.PlaneTests == 3);
+        CHECK(Child.Inside[NearPlane] == 0b0101);
+        CHECK(Child.Inside[TopPlane] == 0);
+    });
+}
+
+TEST_CASE(Culling_Masked8EarlyOuts)
+{
+    const Frustum F = MakeTestFrustum();
+    FBound8 Bounds;
+    for (int32 Lane = 0; Lane < 8; ++Lane)
+        Bounds.Set(Lane, FBound(FVector(200.0f + Lane, -1.0f, -1.0f), FVector(201.0f + Lane, 1.0f, 1.0f)));     // 모두 far 밖
+
+    ForEachSimdLevel([&](ESimdLevel)
+    {
+        // 레인 마스크 0: 아무 것도 테스트하지 않는다
+        const FCullResult8 NoLanes = CullAABBs8Masked(F, Bounds, 0, FrustumAllPlanes, FarPlane);
+        CHECK(NoLanes.Visible == 0 && NoLanes.PlaneTests == 0 && NoLanes.RejectPlane == -1);
+
+        // 부모 평면 마스크 0 (부모가 완전 내부): 레인은 그대로 보이고 평면 테스트도 내부 비트도 없다
+        const FCullResult8 NoPlanes = CullAABBs8Masked(F, Bounds, 0xA5, 0, FarPlane);
+        CHECK(NoPlanes.Visible == 0xA5 && NoPlanes.PlaneTests == 0 && NoPlanes.RejectPlane == -1);
+        CHECK(std::all_of(NoPlanes.Inside, NoPlanes.Inside + 6, [](uint8_t Bits) { return Bits == 0; }));
+
+        // 첫 평면에서 전부 탈락하면 거기서 멈추고 그 평면을 돌려준다
+        const FCullResult8 Rejected = CullAABBs8Masked(F, Bounds, 0x3C, FrustumAllPlanes, FarPlane);
+        CHECK(Rejected.Visible == 0 && Rejected.RejectPlane == FarPlane && Rejected.PlaneTests == 4);
+    });
+}
+
+TEST_CASE(Culling_TransformAABBMatchesScalarAtEveryLevel)
+{
+    std::mt19937 Rng(0x7A5Bu);
+    auto Range = [&](float Lo, float Hi) { return std::uniform_real_distribution<float>(Lo, Hi)(Rng); };
+
+    for (int32 Iter = 0; Iter < 2000; ++Iter)
+    {
+        // 회전/스케일/전단이 섞인 임의 아핀 행렬 (행벡터 규약: 이동은 4행)
+        FMatrix M;
+        for (int r = 0; r < 3; ++r)
+            for (int c = 0; c < 4; ++c)
+                M.M[r][c] = c < 3 ? Range(-2.0f, 2.0f) : 0.0f;
+        M.M[3][0] = Range(-100.0f, 100.0f);
+        M.M[3][1] = Range(-100.0f, 100.0f);
+        M.M[3][2] = Range(-100.0f, 100.0f);
+        M.M[3][3] = 1.0f;
+
+        const FVector C(Range(-10.0f, 10.0f), Range(-10.0f, 10.0f), Range(-10.0f, 10.0f));
+        const FVector E(Range(0.0f, 5.0f), Range(0.0f, 5.0f), Range(0.0f, 5.0f));
+        const FBound Local(C - E, C + E);
+
+        FSimd::SetForcedLevel(ESimdLevel::Scalar);
+        const FBound Ref = TransformAABB(Local, M);
+        ForEachSimdLevel([&](ESimdLevel)
+        {
+            const FBound Got = TransformAABB(Local, M);
+            bool bClose = true;
+            for (int a = 0; a < 3; ++a)
+            {
+                const float Tol = 1e-4f * (1.0f + std::abs(Ref.Min[a]) + std::abs(Ref.Max[a]));
+                bClose &= std::abs(Ref.Min[a] - Got.Min[a]) <= Tol && std::abs(Ref.Max[a] - Got.Max[a]) <= Tol;
+            }
+            CHECK(bClose);
+        });
+    }
+
+    // 축 뒤집기 + 이동: 정확한 결과가 나와야 한다
+    FMatrix Flip;
+    for (int r = 0; r < 4; ++r)
+        for (int c = 0; c < 4; ++c)
+            Flip.M[r][c] = 0.0f;
+    Flip.M[0][1] = 1.0f;    // x → y
+    Flip.M[1][0] = -2.0f;   // y → -2x
+    Flip.M[2][2] = 1.0f;
+    Flip.M[3][0] = 10.0f;
+    Flip.M[3][3] = 1.0f;
+    ForEachSimdLevel([&](ESimdLevel)
+    {
+        const FBound Got = TransformAABB(FBound(FVector(1.0f, 2.0f, 3.0f), FVector(3.0f, 4.0f, 5.0f)), Flip);
+        CHECK(Got.Min.X == 2.0f && Got.Max.X == 6.0f);
+        CHECK(Got.Min.Y == 1.0f && Got.Max.Y == 3.0f);
+        CHECK(Got.Min.Z == 3.0f && Got.Max.Z == 5.0f);
+    });
+}
+
+TEST_CASE(Culling_ValidateKernelsReportsNoMismatch)
+{
+    TArray<FCullingKernelReport> Reports;
+    CHECK(ValidateCullingKernels(0x51D0u, 5000, Reports));
+    CHECK(!Reports.empty());
+    for (const FCullingKernelReport& Report : Reports)
+    {
+        CHECK(Report.Level <= FSimd::GetDetectedLevel());
+        CHECK(Report.CullMismatches == 0 && Report.StreamMismatches == 0 && Report.TransformMismatches == 0);
+    }
+}
@@ -0,0 +1,81 @@
+﻿#include "TestHarness.h"
+#include "JobSystem.h"
+#include <cstdlib>
+#include <new>
+
+// 디스패치 경로의 힙 사용을 세기 위해 전역 new/delete 를 바꿔 끼운다 (이 실행 파일 전체에 적용)
+namespace
+{
+    std::atomic<int64> GAllocationCount{ 0 };
+}
+
+// 정렬 없는 new 계열만 바꾸고, 짝이 되는 delete 계열도 모두 같이 바꾼다 (정렬 버전은 기본 구현끼리 짝)
+void* operator new(std::size_t Size, const std::nothrow_t&) noexcept
+{
+    GAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(Size ? Size : 1);
+}
+
+void* operator new(std::size_t Size)
+{
+    if (void* Ptr = operator new(Size, std::nothrow)) return Ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t Size) { return operator new(Size); }
+void* operator new[](std::size_t Size, const std::nothrow_t&) noexcept { return operator new(Size, std::nothrow); }
+
+void operator delete(void* Ptr) noexcept { std::free(Ptr); }
+void operator delete(void* Ptr, std::size_t) noexcept { std::free(Ptr); }
+void operator delete(void* Ptr, const std::nothrow_t&) noexcept { std::free(Ptr); }
+void operator delete[](void* Ptr) noexcept { std::free(Ptr); }
+void operator delete[](void* Ptr, std::size_t) noexcept { std::free(Ptr); }
+void operator delete[](void* Ptr, const std::nothrow_t&) noexcept { std::free(Ptr); }
+
+TEST_CASE(JobSystem_EveryChunkRunsExactlyOnce)
+{
+    for (int32 ChunkCount = 0; ChunkCount <= 67; ++ChunkCount)
+    {
+        std::atomic<int32> Runs[67] = {};
+        FJobSystem::ParallelForChunks(ChunkCount, [&](int32 Chunk) { Runs[Chunk].fetch_add(1); });
+
+        bool bExactlyOnce = true;
+        for (int32 i = 0; i < 67; ++i)
+            bExactlyOnce &= Runs[i].load() == (i < ChunkCount ? 1 : 0);
+        CHECK(bExactlyOnce);
+    }
+
+    // 청크 안에서 다시 ParallelFor (워커가 중첩 디스패치의 호출 스레드가 되어도 끝나야 한다)
+    std::atomic<int64> Sum{ 0 };
+    FJobSystem::ParallelForChunks(13, [&](int32 Outer)
+    {
+        FJobSystem::ParallelFor(1000, 7, [&](int32 Begin, int32 End)
+        {
+            int64 Local = 0;
+            for (int32 i = Begin; i < End; ++i) Local += i + Outer;
+            Sum.fetch_add(Local);
+        });
+    });
+    CHECK(Sum.load() == 13 * (999 * 1000 / 2) + 1000 * (12 * 13 / 2));
+}
+
+TEST_CASE(JobSystem_SteadyStateDispatchDoesNotAllocate)
+{
+    // 캡처가 std::function 의 소형 버퍼를 넘는 크기여도 할당이 없어야 한다
+    int64 A = 1, B = 2, C = 3, D = 4;
+    std::atomic<int64> Sum{ 0 };
+    auto Chunks = [&](int32 Chunk) { Sum.fetch_add(Chunk + A + B + C + D); };
+    auto Range = [&](int32 Begin, int32 End) { Sum.fetch_add(End - Begin + A + B + C + D); };
+
+    // 첫 호출은 싱글턴과 워커 스레드를 만든다
+    FJobSystem::ParallelForChunks(8, Chunks);
+
+    const int64 Before = GAllocationCount.load();
+    for (int32 Iter = 0; Iter < 200; ++Iter)
+    {
+        FJobSystem::ParallelForChunks(1 + Iter % 16, Chunks);
+        FJobSystem::ParallelFor(1 + Iter * 37, 16, Range);
+    }
+    CHECK(GAllocationCount.load() == Before);
+    CHECK(Sum.load() > 0);
+}
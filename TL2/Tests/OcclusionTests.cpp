@@ -0,0 +1,362 @@
+﻿#include "TestHarness.h"
+#include "Occlusion.h"
+#include "JobSystem.h"
+#include "SimdDispatch.h"
+#include <cstring>
+#include <random>
+
+namespace
+{
+    // 감지된 레벨까지 SIMD 레벨을 하나씩 강제하며 Body 를 실행하고, 끝나면 자동 선택으로 되돌린다
+    template<typename FnType>
+    void ForEachSimdLevel(FnType&& Body)
+    {
+        for (int L = 0; L <= static_cast<int>(FSimd::GetDetectedLevel()); ++L)
+        {
+            FSimd::SetForcedLevel(static_cast<ESimdLevel>(L));
+            Body(static_cast<ESimdLevel>(L));
+        }
+        FSimd::SetForcedLevel(ESimdLevel::Count);
+    }
+
+    // 그리드 밖으로 걸치는 것까지 섞은 무작위 삼각형 (뷰 z = ZOverW / InvW)
+    FOcclusionTriangle MakeRandomTriangle(std::mt19937& Rng, int W, int H)
+    {
+        auto Range = [&](float Lo, float Hi) { return std::uniform_real_distribution<float>(Lo, Hi)(Rng); };
+
+        FOcclusionTriangle Tri;
+        Tri.ZNear = 0.1f;
+        Tri.ZFar = 100.0f;
+        Tri.MaxZView = 0.0f;
+        for (int v = 0; v < 3; ++v)
+        {
+            Tri.X[v] = Range(-0.25f * W, 1.25f * W);
+            Tri.Y[v] = Range(-0.25f * H, 1.25f * H);
+            const float ZView = Range(Tri.ZNear, Tri.ZFar);
+            Tri.InvW[v] = 1.0f / ZView;
+            Tri.ZOverW[v] = 1.0f;
+            Tri.MaxZView = std::max(Tri.MaxZView, ZView);
+        }
+
+        // 픽셀 중심 기준 bbox (SetupOccluderTriangles 와 같은 규칙)
+        Tri.MinPX = std::max(0, int(std::ceil(std::min({ Tri.X[0], Tri.X[1], Tri.X[2] }) - 0.5f)));
+        Tri.MaxPX = std::min(W - 1, int(std::floor(std::max({ Tri.X[0], Tri.X[1], Tri.X[2] }) - 0.5f)));
+        Tri.MinPY = std::max(0, int(std::ceil(std::min({ Tri.Y[0], Tri.Y[1], Tri.Y[2] }) - 0.5f)));
+        Tri.MaxPY = std::min(H - 1, int(std::floor(std::max({ Tri.Y[0], Tri.Y[1], Tri.Y[2] }) - 0.5f)));
+        return Tri;
+    }
+
+    // BuildOccluderDepth 와 같은 타일 배치: 마지막 열/행이 나머지를 흡수
+    TArray<FOcclusionTile> MakeTiles(int W, int H)
+    {
+        constexpr int TW = FOcclusionCullingManagerCPU::TileWidth;
+        constexpr int TH = FOcclusionCullingManagerCPU::TileHeight;
+        const int TilesX = std::max(1, W / TW);
+        const int TilesY = std::max(1, H / TH);
+
+        TArray<FOcclusionTile> Tiles;
+        for (int ty = 0; ty < TilesY; ++ty)
+            for (int tx = 0; tx < TilesX; ++tx)
+                Tiles.push_back({ tx * TW, ty * TH,
+                    tx == TilesX - 1 ? W - 1 : (tx + 1) * TW - 1,
+                    ty == TilesY - 1 ? H - 1 : (ty + 1) * TH - 1 });
+        return Tiles;
+    }
+
+    bool Level0Equal(const FOcclusionGrid& A, const FOcclusionGrid& B)
+    {
+        if (A.GetWidth() != B.GetWidth() || A.GetHeight() != B.GetHeight()) return false;
+        for (int y = 0; y < A.GetHeight(); ++y)
+            if (std::memcmp(A.GetRow(0, y), B.GetRow(0, y), sizeof(float) * A.GetWidth()) != 0)
+                return false;
+        return true;
+    }
+}
+
+TEST_CASE(Occlusion_TiledRasterMatchesSingleTileSerial)
+{
+    const int Sizes[][2] = { { 480, 270 }, { 256, 128 }, { 333, 127 }, { 130, 33 }, { 37, 1 }, { 1, 53 }, { 7, 9 } };
+
+    ForEachSimdLevel([&](ESimdLevel Level)
+    {
+        std::mt19937 Rng(0x7113u + static_cast<uint32>(Level));
+        for (const auto& Size : Sizes)
+        {
+            const int W = Size[0], H = Size[1];
+            TArray<FOcclusionTriangle> Tris;
+            for (int t = 0; t < 200; ++t)
+                Tris.push_back(MakeRandomTriangle(Rng, W, H));
+
+            // 기준: 그리드 전체를 타일 하나로 보고 직렬로
+            FOcclusionGrid Serial;
+            Serial.Initialize(W, H);
+            const FOcclusionTile Whole{ 0, 0, W - 1, H - 1 };
+            for (const FOcclusionTriangle& Tri : Tris)
+                Serial.RasterizeTriangleDepthMin(Tri, Whole);
+
+            // 타일별 병렬 (타일 안에서는 삼각형 순서대로, 타일끼리는 스케줄 순서 무관)
+            FOcclusionGrid Tiled;
+            Tiled.Initialize(W, H);
+            const TArray<FOcclusionTile> Tiles = MakeTiles(W, H);
+            FJobSystem::ParallelForChunks(static_cast<int32>(Tiles.size()), [&](int32 TileIndex)
+            {
+                for (const FOcclusionTriangle& Tri : Tris)
+                    Tiled.RasterizeTriangleDepthMin(Tri, Tiles[TileIndex]);
+            });
+
+            CHECK(Level0Equal(Serial, Tiled));
+        }
+    });
+}
+
+TEST_CASE(Occlusion_SimdRasterAndHZBKernelsMatchScalar)
+{
+    TArray<FOcclusionGrid::FKernelReport> Reports;
+    CHECK(FOcclusionGrid::ValidateKernels(0x51D0u, 100, Reports));
+    for (const FOcclusionGrid::FKernelReport& Report : Reports)
+        CHECK(Report.RasterMismatches == 0 && Report.HZBMismatches == 0);
+}
+
+TEST_CASE(Occlusion_HZBMipsMatchBruteForceMax)
+{
+    // 같은 그리드를 줄였다 키우며 재사용 (저장소 재배치 경로도 함께 검사)
+    const int Sizes[][2] = { { 480, 270 }, { 7, 9 }, { 960, 540 }, { 333, 127 }, { 37, 1 }, { 1, 53 }, { 1, 1 } };
+
+    ForEachSimdLevel([&](ESimdLevel Level)
+    {
+        std::mt19937 Rng(0x4A2Bu + static_cast<uint32>(Level));
+        std::uniform_real_distribution<float> Depth(0.0f, 1.0f);
+
+        FOcclusionGrid Grid;
+        for (const auto& Size : Sizes)
+        {
+            const int W = Size[0], H = Size[1];
+            Grid.Initialize(W, H);
+            for (int y = 0; y < H; ++y)
+                for (int x = 0; x < W; ++x)
+                    Grid.GetRow(0, y)[x] = Depth(Rng);
+            Grid.BuildHZB();
+
+            // mip 크기는 올림 절반, 1x1 에서 끝난다
+            int MipW = W, MipH = H;
+            bool bMatch = true;
+            for (int Mip = 1; (MipW > 1 || MipH > 1) && Mip < FOcclusionGrid::MaxLevels; ++Mip)
+            {
+                MipW = (MipW + 1) / 2;
+                MipH = (MipH + 1) / 2;
+                for (int y = 0; y < MipH; ++y)
+                {
+                    for (int x = 0; x < MipW; ++x)
+                    {
+                        // 레벨0 에서 이 텍셀이 덮는 범위 (가장자리는 그리드 안으로 잘림)
+                        float Expected = 0.0f;
+                        for (int Y0 = y << Mip; Y0 < std::min(H, (y + 1) << Mip); ++Y0)
+                            for (int X0 = x << Mip; X0 < std::min(W, (x + 1) << Mip); ++X0)
+                                Expected = std::max(Expected, Grid.GetRow(0, Y0)[X0]);
+                        bMatch &= Grid.GetRow(Mip, y)[x] == Expected;
+                    }
+                }
+            }
+            CHECK(bMatch);
+            CHECK(MipW == 1 && MipH == 1);
+        }
+    });
+}
+
+namespace
+{
+    // 재투영 테스트 장면 (LH, +Z 앞, 그리드 256x128)
+    //  - 0: 카메라 앞 z=0 의 벽 (메시 오클루더)
+    //  - 1~4: 벽 뒤에 완전히 숨은 상자
+    //  - 5~8: 벽 옆/앞에 있거나 일부만 벽에 걸쳐 항상 보이는 상자
+    //  카메라는 벽 정면 z=-10 에서 x 로만 움직이며, 경로 전체에서 위 분류가 바뀌지 않는다
+    struct FReprojectionScene
+    {
+        static constexpr int GridW = 256;
+        static constexpr int GridH = 128;
+        static constexpr float ZNear = 0.1f;
+        static constexpr float ZFar = 100.0f;
+        static constexpr uint32 WallId = 0;
+
+        FOccluderMesh WallMesh;
+        TArray<FBound> Bounds;
+        TArray<bool> AlwaysVisible;
+
+        FReprojectionScene()
+        {
+            WallMesh.Positions = { FVector(-4, -3, 0), FVector(4, -3, 0), FVector(4, 3, 0), FVector(-4, 3, 0) };
+            WallMesh.Indices = { 0, 1, 2, 0, 2, 3 };
+
+            Add(FBound(FVector(-4, -3, 0), FVector(4, 3, 0.05f)), true);
+            for (float Y : { -1.0f, 1.0f })
+                for (float X : { -1.5f, 1.5f })
+                    Add(FBound(FVector(X - 0.5f, Y - 0.5f, 5.5f), FVector(X + 0.5f, Y + 0.5f, 6.5f)), false);
+            Add(FBound(FVector(7, -1, 4), FVector(9, 1, 6)), true);
+            Add(FBound(FVector(-9, -1, 4), FVector(-7, 1, 6)), true);
+            Add(FBound(FVector(3, -1, 4), FVector(8, 1, 6)), true);          // 벽 가장자리에 일부만 가려짐
+            Add(FBound(FVector(-0.5f, -0.5f, -3), FVector(0.5f, 0.5f, -2)), true);
+        }
+
+        void Add(const FBound& Bound, bool bAlwaysVisible)
+        {
+            Bounds.push_back(Bound);
+            AlwaysVisible.push_back(bAlwaysVisible);
+        }
+
+        // 회전 없이 +Z 를 보는 카메라 (행벡터 기준 View = 눈 위치의 역이동)
+        static FMatrix MakeView(float EyeX)
+        {
+            return FMatrix::MakeTranslation(FVector(-EyeX, 0, 10));
+        }
+
+        static FMatrix MakeProj()
+        {
+            return FMatrix::PerspectiveFovLH(3.14159265f / 3.0f, float(GridW) / float(GridH), ZNear, ZFar);
+        }
+
+        TArray<FCandidateDrawable> MakeCandidates(const FMatrix& View, const FMatrix& Proj) const
+        {
+            const FMatrix VP = View * Proj;
+            TArray<FCandidateDrawable> Candidates;
+            for (uint32 Id = 0; Id < uint32(Bounds.size()); ++Id)
+            {
+                FCandidateDrawable D;
+                D.ActorIndex = Id;
+                D.Bound = Bounds[Id];
+                D.WorldViewProj = VP;
+                D.WorldView = View;
+                D.ZNear = ZNear;
+                D.ZFar = ZFar;
+                if (Id == WallId)
+                {
+                    D.OccluderMesh = &WallMesh;
+                    D.MeshWorldViewProj = VP;   // 벽은 월드 좌표 그대로
+                    D.MeshWorldView = View;
+                }
+                Candidates.push_back(D);
+            }
+            return Candidates;
+        }
+    };
+
+    // RenderManager::PerformOcclusionCulling 과 같은 순서로 오클루전 패스 하나
+    void RunOcclusionPass(FOcclusionCullingManagerCPU& Manager, const void* ViewKey, uint32 ViewPass, uint32 SceneGeneration,
+        const FReprojectionScene& Scene, float EyeX, TArray<uint8_t>& OutVisibleFlags)
+    {
+        const FMatrix View = FReprojectionScene::MakeView(EyeX);
+        const FMatrix Proj = FReprojectionScene::MakeProj();
+        const TArray<FCandidateDrawable> Candidates = Scene.MakeCandidates(View, Proj);
+
+        Manager.BeginView(ViewKey, ViewPass, SceneGeneration, View, Proj, FReprojectionScene::ZNear, FReprojectionScene::ZFar);
+        TArray<FCandidateDrawable> Occluders;
+        Manager.SelectOccluders(Candidates, Occluders);
+        Manager.BuildOccluderDepth(Occluders, FReprojectionScene::GridW, FReprojectionScene::GridH);
+        Manager.BuildHZB();
+        Manager.TestOcclusion(Candidates, FReprojectionScene::GridW, FReprojectionScene::GridH, OutVisibleFlags);
+        Manager.EndView(OutVisibleFlags);
+    }
+}
+
+TEST_CASE(Occlusion_ReprojectionNeverCullsVisibleObjects)
+{
+    const FReprojectionScene Scene;
+    static const int ViewKey = 0;
+
+    FOcclusionCullingManagerCPU Temporal, Reference;
+    Temporal.Initialize(FReprojectionScene::GridW, FReprojectionScene::GridH);
+    Reference.Initialize(FReprojectionScene::GridW, FReprojectionScene::GridH);
+    Temporal.SetTemporalReprojectionEnabled(true);
+
+    // 정지 4 프레임 → 매 프레임 0.25 씩 옆으로 이동하는 6 프레임
+    TArray<uint8_t> TemporalFlags, ReferenceFlags;
+    for (uint32 Pass = 1; Pass <= 10; ++Pass)
+    {
+        const float EyeX = Pass <= 4 ? 0.0f : 0.25f * float(Pass - 4);
+        RunOcclusionPass(Temporal, &ViewKey, Pass, 0, Scene, EyeX, TemporalFlags);
+        RunOcclusionPass(Reference, &ViewKey, Pass, 0, Scene, EyeX, ReferenceFlags);
+
+        const FOcclusionStats& Stats = Temporal.GetLastStats();
+        if (Pass > 1)
+            CHECK(Stats.ReprojectedTexels > 0);
+
+        for (uint32 Id = 0; Id < uint32(Scene.Bounds.size()); ++Id)
+        {
+            // 재투영이 켜져 있어도 보이는 것은 절대 컬링하지 않는다 (기준 매니저보다 더 가리지 않음)
+            if (Scene.AlwaysVisible[Id] || ReferenceFlags[Id])
+                CHECK(TemporalFlags[Id] == 1);
+
+            // 히스테리시스(2 프레임)를 지나면 숨은 상자는 계속 가려짐, 그 뒤로는 오클루더 후보에서도 빠진다
+            if (!Scene.AlwaysVisible[Id] && Pass >= 2)
+                CHECK(TemporalFlags[Id] == 0);
+        }
+        if (Pass >= 3)
+            CHECK(Stats.SkippedHidden == 4);
+    }
+}
+
+TEST_CASE(Occlusion_ReprojectionHistoryNeedsSameGenerationAndPreviousPass)
+{
+    const FReprojectionScene Scene;
+    static const int ViewA = 0, ViewB = 0;
+
+    FOcclusionCullingManagerCPU Manager;
+    Manager.Initialize(FReprojectionScene::GridW, FReprojectionScene::GridH);
+    Manager.SetTemporalReprojectionEnabled(true);
+
+    TArray<uint8_t> Flags;
+    auto Reprojected = [&](const void* ViewKey, uint32 ViewPass, uint32 SceneGeneration)
+    {
+        RunOcclusionPass(Manager, ViewKey, ViewPass, SceneGeneration, Scene, 0.0f, Flags);
+        return Manager.GetLastStats().ReprojectedTexels > 0;
+    };
+
+    CHECK(!Reprojected(&ViewA, 1, 0));     // 히스토리 없음
+    CHECK(Reprojected(&ViewA, 2, 0));
+    CHECK(!Reprojected(&ViewB, 1, 0));     // 뷰포트마다 따로
+    CHECK(Reprojected(&ViewA, 3, 0));      // 다른 뷰포트의 패스는 영향 없음
+
+    // 장면 세대가 바뀌면 버림 (지난 오클루더가 움직였거나 사라졌을 수 있음)
+    CHECK(!Reprojected(&ViewA, 4, 1));
+    CHECK(Manager.GetLastStats().SkippedHidden == 0);
+    CHECK(Reprojected(&ViewA, 5, 1));
+
+    // 건너뛴 패스(6)가 있으면 버림
+    CHECK(!Reprojected(&ViewA, 7, 1));
+    CHECK(Reprojected(&ViewA, 8, 1));
+
+    // 껐다 켜면 버림
+    Manager.SetTemporalReprojectionEnabled(false);
+    Manager.SetTemporalReprojectionEnabled(true);
+    CHECK(!Reprojected(&ViewA, 9, 1));
+}
+
+TEST_CASE(Occlusion_ReprojectionStoresOnlyFreshRaster)
+{
+    const FReprojectionScene Scene;
+    static const int ViewKey = 0;
+
+    FOcclusionCullingManagerCPU Manager;
+    Manager.Initialize(FReprojectionScene::GridW, FReprojectionScene::GridH);
+    Manager.SetTemporalReprojectionEnabled(true);
+
+    TArray<uint8_t> Flags;
+    auto CenterDepth = [&]() { return Manager.GetGrid().GetRow(0, FReprojectionScene::GridH / 2)[FReprojectionScene::GridW / 2]; };
+
+    RunOcclusionPass(Manager, &ViewKey, 1, 0, Scene, 0.0f, Flags);
+    const float WallDepth = CenterDepth();
+    CHECK(WallDepth < 1.0f);
+
+    // 오클루더 예산 0: 이번 래스터는 비어 있고 벽 깊이는 지난 프레임에서 옮겨 온 것뿐
+    FOccluderSelectionSettings NoOccluders;
+    NoOccluders.MaxTriangles = 0;
+    NoOccluders.MaxRects = 0;
+    Manager.SetSelectionSettings(NoOccluders);
+    RunOcclusionPass(Manager, &ViewKey, 2, 0, Scene, 0.0f, Flags);
+    CHECK(Manager.GetLastStats().SelectedOccluders == 0);
+    CHECK(CenterDepth() >= WallDepth && CenterDepth() < 1.0f);
+
+    // 그 다음 프레임의 히스토리는 빈 래스터라 옮겨 온 깊이가 다시 이어지지 않는다
+    RunOcclusionPass(Manager, &ViewKey, 3, 0, Scene, 0.0f, Flags);
+    CHECK(Manager.GetLastStats().ReprojectedTexels == 0);
+    CHECK(CenterDepth() == 1.0f);
+}
@@ -0,0 +1,447 @@
+﻿#include "TestHarness.h"
+#include "RenderCommand.h"
+#include <cmath>
+#include <random>
+
+// RenderCommand 는 리소스를 불투명 포인터와 UUID 로만 다루므로 테스트용 최소 정의로 대신한다
+class UShader { public: uint32 UUID = 0; };
+class UMaterial { public: uint32 UUID = 0; };
+class UStaticMesh { public: uint32 UUID = 0; };
+
+namespace
+{
+    // 트랜스폼에 커맨드 번호를 심어 두고 기록된 스트림에서 다시 꺼낸다
+    FMatrix MakeTaggedTransform(uint32 Tag)
+    {
+        FMatrix M = FMatrix::Identity();
+        M.M[3][0] = static_cast<float>(Tag);
+        return M;
+    }
+
+    uint32 GetTag(const FMatrix& M) { return static_cast<uint32>(M.M[3][0]); }
+
+    struct FTestScene
+    {
+        UShader Shaders[3];
+        UMaterial Materials[5];
+        UStaticMesh Meshes[4];
+
+        FTestScene()
+        {
+            uint32 NextId = 1;
+            for (UShader& S : Shaders) S.UUID = NextId++;
+            for (UMaterial& M : Materials) M.UUID = NextId++;
+            for (UStaticMesh& M : Meshes) M.UUID = NextId++;
+        }
+    };
+
+    FDrawCommand MakeCommand(FDrawCommandList& List, ERenderPass Pass, UShader* Shader, UMaterial* Material, UStaticMesh* Mesh,
+        float Depth, uint32 StartIndex = 0, uint32 IndexCount = 36)
+    {
+        FDrawCommand Command;
+        Command.Shader = Shader;
+        Command.Material = Material;
+        Command.Mesh = Mesh;
+        Command.StartIndex = StartIndex;
+        Command.IndexCount = IndexCount;
+        Command.TransformIndex = List.AddTransform(MakeTaggedTransform(static_cast<uint32>(List.Num())));
+        Command.SortKey = DrawSortKey::Make(Pass, DrawSortKey::GetShaderId(Shader), DrawSortKey::GetMaterialId(Material),
+            DrawSortKey::GetMeshId(Mesh), Depth);
+        List.AddCommand(Command);
+        return Command;
+    }
+
+    TArray<ERecordedDrawOp> GetOps(const FRecordingDrawBackend& Backend)
+    {
+        TArray<ERecordedDrawOp> Ops;
+        for (const FRecordedDrawCall& Call : Backend.GetCalls()) Ops.push_back(Call.Op);
+        return Ops;
+    }
+}
+
+// ------------------------------------------------------------
+// 정렬 키
+// ------------------------------------------------------------
+TEST_CASE(SortKey_DepthQuantizationIsMonotonic)
+{
+    uint32 Prev = 0;
+    for (float Depth = 0.01f; Depth < 1e5f; Depth *= 1.1f)
+    {
+        const uint32 Q = DrawSortKey::QuantizeDepth(Depth);
+        CHECK(Q >= Prev);
+        Prev = Q;
+    }
+    CHECK(DrawSortKey::QuantizeDepth(-1.0f) == 0);
+    CHECK(DrawSortKey::QuantizeDepth(NAN) == 0);
+}
+
+TEST_CASE(SortKey_PassAndDepthOrder)
+{
+    const uint64 OpaqueNear = DrawSortKey::Make(ERenderPass::Opaque, 1, 1, 1, 1.0f);
+    const uint64 OpaqueFar = DrawSortKey::Make(ERenderPass::Opaque, 1, 1, 1, 100.0f);
+    const uint64 TranslucentNear = DrawSortKey::Make(ERenderPass::Translucent, 1, 1, 1, 1.0f);
+    const uint64 TranslucentFar = DrawSortKey::Make(ERenderPass::Translucent, 1, 1, 1, 100.0f);
+    const uint64 Overlay = DrawSortKey::Make(ERenderPass::Overlay, 0, 0, 0, 0.0f);
+
+    CHECK(OpaqueNear < OpaqueFar);              // 불투명: 앞→뒤
+    CHECK(TranslucentFar < TranslucentNear);    // 반투명: 뒤→앞
+    CHECK(OpaqueFar < TranslucentFar);          // 패스 순서가 깊이보다 우선
+    CHECK(TranslucentNear < Overlay);
+    CHECK(DrawSortKey::GetPass(TranslucentNear) == ERenderPass::Translucent);
+
+    // 불투명은 상태가 깊이보다 우선
+    const uint64 ShaderA = DrawSortKey::Make(ERenderPass::Opaque, 1, 9, 9, 1000.0f);
+    const uint64 ShaderB = DrawSortKey::Make(ERenderPass::Opaque, 2, 0, 0, 0.1f);
+    CHECK(ShaderA < ShaderB);
+}
+
+TEST_CASE(SortKey_ObjectIdReservesZeroForNull)
+{
+    UShader Shader;
+    Shader.UUID = 0;
+    CHECK(DrawSortKey::GetShaderId(static_cast<const UShader*>(nullptr)) == 0);
+    CHECK(DrawSortKey::GetShaderId(&Shader) != 0);
+}
+
+// ------------------------------------------------------------
+// 정렬 / 배치
+// ------------------------------------------------------------
+TEST_CASE(Sort_OrdersByKeyAndKeepsInsertionOrderForEqualKeys)
+{
+    FTestScene Scene;
+    FDrawCommandList List;
+    MakeCommand(List, ERenderPass::Translucent, &Scene.Shaders[0], &Scene.Materials[0], &Scene.Meshes[0], 5.0f);    // 0
+    MakeCommand(List, ERenderPass::Opaque, &Scene.Shaders[1], &Scene.Materials[0], &Scene.Meshes[0], 5.0f);         // 1
+    MakeCommand(List, ERenderPass::Opaque, &Scene.Shaders[0], &Scene.Materials[1], &Scene.Meshes[2], 3.0f);         // 2
+    MakeCommand(List, ERenderPass::Opaque, &Scene.Shaders[0], &Scene.Materials[1], &Scene.Meshes[2], 3.0f);         // 3 (2 와 같은 키)
+    MakeCommand(List, ERenderPass::Opaque, &Scene.Shaders[0], &Scene.Materials[1], &Scene.Meshes[2], 1.0f);         // 4
+    MakeCommand(List, ERenderPass::Translucent, &Scene.Shaders[0], &Scene.Materials[0], &Scene.Meshes[0], 50.0f);   // 5
+    List.Sort(0);
+
+    const TArray<uint32>& Order = List.GetSortedOrder();
+    const TArray<uint32> Expected = { 4, 2, 3, 1, 5, 0 };
+    CHECK(Order == Expected);
+}
+
+TEST_CASE(Sort_LargeListIsSortedAndStable)
+{
+    // 기수 정렬이 병렬 경로로 들어가는 크기
+    FTestScene Scene;
+    FDrawCommandList List;
+    std::mt19937 Rng(11);
+    for (int i = 0; i < 40000; ++i)
+    {
+        MakeCommand(List, (Rng() % 10 == 0) ? ERenderPass::Translucent : ERenderPass::Opaque,
+            &Scene.Shaders[Rng() % 3], &Scene.Materials[Rng() % 5], &Scene.Meshes[Rng() % 4], static_cast<float>(Rng() % 64));
+    }
+    List.Sort(0);
+
+    const TArray<FDrawCommand>& Commands = List.GetCommands();
+    const TArray<uint32>& Order = List.GetSortedOrder();
+    CHECK(Order.size() == Commands.size());
+    for (size_t i = 1; i < Order.size(); ++i)
+    {
+        const uint64 PrevKey = Commands[Order[i - 1]].SortKey;
+        const uint64 Key = Commands[Order[i]].SortKey;
+        CHECK(PrevKey < Key || (PrevKey == Key && Order[i - 1] < Order[i]));
+    }
+}
+
+TEST_CASE(Batch_SameStateAndSectionBecomesOneInstancedBatch)
+{
+    FTestScene Scene;
+    FDrawCommandList List;
+    for (int i = 0; i < 5; ++i)
+    {
+        MakeCommand(List, ERenderPass::Opaque, &Scene.Shaders[0], &Scene.Materials[0], &Scene.Meshes[0], 1.0f + i);
+    }
+    MakeCommand(List, ERenderPass::Opaque, &Scene.Shaders[0], &Scene.Materials[0], &Scene.Meshes[0], 9.0f, 36);  // 다른 섹션
+    List.Sort(2);
+
+    const TArray<FDrawBatch>& Batches = List.GetBatches();
+    CHECK(Batches.size() == 2);
+    CHECK(Batches[0].bInstanced && Batches[0].InstanceCount == 5 && Batches[0].FirstInstance == 0);
+    CHECK(!Batches[1].bInstanced);
+    CHECK(List.GetInstanceTransforms().size() == 5);
+    CHECK(List.GetDrawTransforms().size() == 1);
+    // 인스턴스 트랜스폼은 정렬 순서(앞→뒤) 그대로
+    for (uint32 i = 0; i < 5; ++i) CHECK(GetTag(List.GetInstanceTransforms()[i]) == i);
+}
+
+TEST_CASE(Batch_RespectsMinInstancesAndTranslucency)
+{
+    FTestScene Scene;
+    FDrawCommandList List;
+    for (int i = 0; i < 3; ++i) MakeCommand(List, ERenderPass::Opaque, &Scene.Shaders[0], &Scene.Materials[0], &Scene.Meshes[0], 1.0f + i);
+    for (int i = 0; i < 4; ++i) MakeCommand(List, ERenderPass::Translucent, &Scene.Shaders[1], &Scene.Materials[1], &Scene.Meshes[1], 1.0f + i);
+
+    List.Sort(4);   // 불투명 3개는 기준 미달, 반투명은 항상 개별
+    for (const FDrawBatch& Batch : List.GetBatches()) CHECK(!Batch.bInstanced);
+    CHECK(List.GetBatches().size() == 7);
+
+    List.Sort(0);   // 0 이면 합치지 않는다
+    CHECK(List.GetBatches().size() == 7);
+    CHECK(List.GetInstanceTransforms().empty());
+
+    List.Sort(3);
+    CHECK(List.GetBatches().size() == 5);
+    CHECK(List.GetBatches()[0].bInstanced && List.GetBatches()[0].InstanceCount == 3);
+}
+
+TEST_CASE(Batch_SectionsOfOneComponentShareTransformBlock)
+{
+    FTestScene Scene;
+    FDrawCommandList List;
+    const uint32 TransformIndex = List.AddTransform(MakeTaggedTransform(7));
+    for (uint32 Section = 0; Section < 3; ++Section)
+    {
+        FDrawCommand Command;
+        Command.Shader = &Scene.Shaders[0];
+        Command.Material = &Scene.Materials[Section];
+        Command.Mesh = &Scene.Meshes[0];
+        Command.StartIndex = Section * 36;
+        Command.IndexCount = 36;
+        Command.TransformIndex = TransformIndex;
+        Command.SortKey = DrawSortKey::Make(ERenderPass::Opaque, 1, Section + 1, 1, 1.0f);
+        List.AddCommand(Command);
+    }
+    List.Sort(2);
+
+    CHECK(List.GetBatches().size() == 3);
+    CHECK(List.GetDrawTransforms().size() == 1);
+    for (const FDrawBatch& Batch : List.GetBatches()) CHECK(Batch.FirstInstance == 0);
+}
+
+TEST_CASE(Append_RebasesTransformIndices)
+{
+    FTestScene Scene;
+    FDrawCommandList A, B;
+    MakeCommand(A, ERenderPass::Opaque, &Scene.Shaders[0], nullptr, &Scene.Meshes[0], 1.0f);
+    MakeCommand(A, ERenderPass::Opaque, &Scene.Shaders[0], nullptr, &Scene.Meshes[0], 2.0f);
+    MakeCommand(B, ERenderPass::Opaque, &Scene.Shaders[1], nullptr, &Scene.Meshes[1], 3.0f);
+    B.AddTransform(MakeTaggedTransform(99));    // 커맨드가 참조하지 않는 트랜스폼도 그대로 옮긴다
+
+    A.Append(B);
+    CHECK(A.Num() == 3);
+    CHECK(A.GetTransforms().size() == 4);
+    CHECK(A.GetCommands()[2].TransformIndex == 2);
+    CHECK(A.GetCommands()[2].Shader == &Scene.Shaders[1]);
+}
+
+// ------------------------------------------------------------
+// 제출 (기록 백엔드의 호출 스트림)
+// ------------------------------------------------------------
+TEST_CASE(Submit_RecordsMinimalStateChanges)
+{
+    FTestScene Scene;
+    FDrawCommandList List;
+    MakeCommand(List, ERenderPass::Opaque, &Scene.Shaders[0], &Scene.Materials[0], &Scene.Meshes[0], 1.0f);
+    MakeCommand(List, ERenderPass::Opaque, &Scene.Shaders[0], &Scene.Materials[0], &Scene.Meshes[1], 1.0f);
+    MakeCommand(List, ERenderPass::Opaque, &Scene.Shaders[0], nullptr, &Scene.Meshes[1], 1.0f);
+    List.Sort(0);
+
+    FRecordingDrawBackend Backend;
+    const FDrawSubmitStats Stats = SubmitDrawCommands(List, FMatrix::Identity(), FMatrix::Identity(), Backend);
+
+    // 키 순서: 머티리얼 없는 커맨드(ID 0) → 머티리얼 0 의 메시 0 → 메시 1. 셰이더는 한 번, 머티리얼은 바뀔 때만
+    using Op = ERecordedDrawOp;
+    const TArray<Op> Expected = {
+        Op::BeginDrawList,
+        Op::SetShader, Op::SetMesh, Op::SetMaterial, Op::SetTransform, Op::DrawIndexed,
+        Op::SetMesh, Op::SetMaterial, Op::SetTransform, Op::DrawIndexed,
+        Op::SetMesh, Op::SetTransform, Op::DrawIndexed,
+        Op::EndDrawList,
+    };
+    CHECK(GetOps(Backend) == Expected);
+    CHECK(Backend.GetCalls()[2].Object == &Scene.Meshes[1]);
+    CHECK(Backend.GetCalls()[3].Object == nullptr);     // nullptr 머티리얼도 바인딩한다
+    CHECK(Backend.GetCalls()[7].Object == &Scene.Materials[0]);
+    CHECK(GetTag(Backend.GetTransforms()[0]) == 2);
+    CHECK(GetTag(Backend.GetTransforms()[1]) == 0);
+    CHECK(GetTag(Backend.GetTransforms()[2]) == 1);
+    CHECK(Stats.DrawCalls == 3 && Stats.ShaderBinds == 1 && Stats.MeshBinds == 3 && Stats.MaterialBinds == 2);
+    CHECK(Stats.ConstantBytes == 0);
+}
+
+TEST_CASE(Submit_InstancedBatchAndFallback)
+{
+    FTestScene Scene;
+    FDrawCommandList List;
+    for (int i = 0; i < 4; ++i) MakeCommand(List, ERenderPass::Opaque, &Scene.Shaders[0], &Scene.Materials[0], &Scene.Meshes[0], 1.0f + i);
+    List.Sort(2);
+
+    using Op = ERecordedDrawOp;
+    {
+        FRecordingDrawBackend Backend(true, true);
+        const FDrawSubmitStats Stats = SubmitDrawCommands(List, FMatrix::Identity(), FMatrix::Identity(), Backend);
+        const TArray<Op> Expected = {
+            Op::BeginDrawList, Op::SetInstanceTransforms,
+            Op::SetShader, Op::SetMesh, Op::SetMaterial, Op::DrawIndexedInstanced,
+            Op::EndDrawList,
+        };
+        CHECK(GetOps(Backend) == Expected);
+        const FRecordedDrawCall& Draw = Backend.GetCalls()[5];
+        CHECK(Draw.A == 36 && Draw.B == 0 && Draw.C == 4 && Draw.D == 0);
+        CHECK(Backend.GetInstanceTransforms().size() == 4);
+        CHECK(Stats.DrawCalls == 1 && Stats.InstancedDraws == 1 && Stats.Instances == 4);
+    }
+    {
+        // 인스턴싱을 못 하는 셰이더는 같은 상태로 하나씩 푼다
+        FRecordingDrawBackend Backend(true, false);
+        const FDrawSubmitStats Stats = SubmitDrawCommands(List, FMatrix::Identity(), FMatrix::Identity(), Backend);
+        CHECK(Backend.GetOpCount(Op::DrawIndexed) == 4);
+        CHECK(Backend.GetOpCount(Op::SetTransform) == 4);
+        CHECK(Backend.GetOpCount(Op::DrawIndexedInstanced) == 0);
+        for (uint32 i = 0; i < 4; ++i) CHECK(GetTag(Backend.GetTransforms()[i]) == i);
+        CHECK(Stats.DrawCalls == 4 && Stats.InstancedDraws == 0);
+    }
+}
+
+TEST_CASE(Submit_ConstantRingStream)
+{
+    FTestScene Scene;
+    FDrawCommandList List;
+    MakeCommand(List, ERenderPass::Opaque, &Scene.Shaders[0], &Scene.Materials[0], &Scene.Meshes[0], 1.0f);
+    MakeCommand(List, ERenderPass::Opaque, &Scene.Shaders[0], &Scene.Materials[1], &Scene.Meshes[0], 2.0f);
+    List.Sort(2);
+
+    FMatrix View = FMatrix::Identity();
+    View.M[3][2] = 5.0f;
+    FMatrix Proj = FMatrix::Identity();
+    Proj.M[2][3] = 1.0f;
+
+    FRecordingDrawBackend Backend;
+    Backend.EnableConstantRing(64 * 1024);
+    Backend.BeginFrame();
+    const FDrawSubmitStats Stats = SubmitDrawCommands(List, View, Proj, Backend);
+
+    using Op = ERecordedDrawOp;
+    const TArray<Op> Expected = {
+        Op::BeginDrawList,
+        Op::MapConstants, Op::UnmapConstants, Op::SetViewConstants,
+        Op::SetShader, Op::SetMesh, Op::SetMaterial, Op::SetTransformConstants, Op::DrawIndexed,
+        Op::SetMaterial, Op::SetTransformConstants, Op::DrawIndexed,
+        Op::EndDrawList,
+    };
+    CHECK(GetOps(Backend) == Expected);
+
+    const uint32 ViewBlock = FConstantRingAllocator::AlignSize(sizeof(FViewConstants));
+    const uint32 TransformBlock = FConstantRingAllocator::AlignSize(sizeof(FMatrix));
+    const FRecordedDrawCall& Map = Backend.GetCalls()[1];
+    CHECK(Map.A == ViewBlock + 2 * TransformBlock && Map.B == 0 && Map.C == 1);    // 프레임 첫 매핑은 DISCARD
+    CHECK(Backend.GetCalls()[7].B == ViewBlock);
+    CHECK(Backend.GetCalls()[10].B == ViewBlock + TransformBlock);
+    CHECK(Backend.GetViewConstants().size() == 1);
+    CHECK(Backend.GetViewConstants()[0].View.M[3][2] == 5.0f && Backend.GetViewConstants()[0].Proj.M[2][3] == 1.0f);
+    CHECK(GetTag(Backend.GetTransforms()[0]) == 0 && GetTag(Backend.GetTransforms()[1]) == 1);
+    CHECK(Stats.ConstantBytes == Map.A && Stats.TransformUpdates == 2);
+
+    // 같은 프레임의 두 번째 리스트는 이어 쓴다 (NO_OVERWRITE)
+    Backend.Reset();
+    SubmitDrawCommands(List, View, Proj, Backend);
+    CHECK(Backend.GetCalls()[1].B == Map.A && Backend.GetCalls()[1].C == 0);
+}
+
+TEST_CASE(Submit_SmallRingFallsBackAndRequestsGrowth)
+{
+    FTestScene Scene;
+    FDrawCommandList List;
+    for (int i = 0; i < 8; ++i) MakeCommand(List, ERenderPass::Opaque, &Scene.Shaders[0], &Scene.Materials[i % 5], &Scene.Meshes[i % 4], 1.0f);
+    List.Sort(0);
+
+    FRecordingDrawBackend Backend;
+    Backend.EnableConstantRing(FConstantRingAllocator::Alignment);
+    Backend.BeginFrame();
+    const FDrawSubmitStats Stats = SubmitDrawCommands(List, FMatrix::Identity(), FMatrix::Identity(), Backend);
+    CHECK(Stats.ConstantBytes == 0);
+    CHECK(Backend.GetOpCount(ERecordedDrawOp::SetTransformConstants) == 0);
+    CHECK(Backend.GetOpCount(ERecordedDrawOp::SetTransform) == 8);
+    CHECK(Backend.GetConstantRing().NeedsGrow());
+
+    // 다음 프레임에 키운 링으로는 들어간다
+    Backend.BeginFrame();
+    Backend.Reset();
+    const FDrawSubmitStats Grown = SubmitDrawCommands(List, FMatrix::Identity(), FMatrix::Identity(), Backend);
+    CHECK(Grown.ConstantBytes > 0);
+    CHECK(Backend.GetOpCount(ERecordedDrawOp::SetTransformConstants) == 8);
+}
+
+TEST_CASE(Submit_RandomListDrawsEveryCommandOnceWithItsState)
+{
+    FTestScene Scene;
+    std::mt19937 Rng(7);
+    for (int Rep = 0; Rep < 6; ++Rep)
+    {
+        FDrawCommandList List;
+        const int N = (Rep & 1) ? 20000 : 300;
+        const uint32 MinInstances = (Rep < 2) ? 0u : (Rep < 4) ? 2u : 3u;
+        for (int i = 0; i < N; ++i)
+        {
+            MakeCommand(List, (Rng() % 10 == 0) ? ERenderPass::Translucent : ERenderPass::Opaque,
+                &Scene.Shaders[Rng() % 3], (Rng() % 6 == 0) ? nullptr : &Scene.Materials[Rng() % 5], &Scene.Meshes[Rng() % 4],
+                static_cast<float>(Rng() % 10000) * 0.1f, (Rng() % 3) * 36);
+        }
+        List.Sort(MinInstances);
+
+        FRecordingDrawBackend Backend(true, Rep != 5);
+        if (Rep % 3 != 0)
+        {
+            Backend.EnableConstantRing(1u << 24);
+            Backend.BeginFrame();
+        }
+        SubmitDrawCommands(List, FMatrix::Identity(), FMatrix::Identity(), Backend);
+
+        // 스트림을 재생해 각 드로우 시점의 상태가 커맨드와 같은지 확인
+        const TArray<FDrawCommand>& Commands = List.GetCommands();
+        TArray<int> DrawCount(N, 0);
+        const void* Shader = nullptr;
+        const void* Mesh = nullptr;
+        const void* Material = nullptr;
+        uint32 Current = UINT32_MAX;
+        uint64 LastTranslucentKey = 0;
+        auto VerifyDraw = [&](uint32 Tag, uint32 IndexCount, uint32 StartIndex)
+        {
+            CHECK(Tag < static_cast<uint32>(N));
+            if (Tag >= static_cast<uint32>(N)) return;
+            const FDrawCommand& C = Commands[Tag];
+            ++DrawCount[Tag];
+            CHECK(Shader == C.Shader && Mesh == C.Mesh && Material == C.Material);
+            CHECK(IndexCount == C.IndexCount && StartIndex == C.StartIndex);
+        };
+        for (const FRecordedDrawCall& Call : Backend.GetCalls())
+        {
+            switch (Call.Op)
+            {
+            case ERecordedDrawOp::SetShader: Shader = Call.Object; break;
+            case ERecordedDrawOp::SetMesh: Mesh = Call.Object; break;
+            case ERecordedDrawOp::SetMaterial: Material = Call.Object; break;
+            case ERecordedDrawOp::SetTransformConstants:
+                CHECK(Call.B % FConstantRingAllocator::Alignment == 0);
+                Current = GetTag(Backend.GetTransforms()[Call.A]);
+                break;
+            case ERecordedDrawOp::SetTransform:
+                Current = GetTag(Backend.GetTransforms()[Call.A]);
+                break;
+            case ERecordedDrawOp::DrawIndexed:
+                VerifyDraw(Current, Call.A, Call.B);
+                if (Current < static_cast<uint32>(N) && DrawSortKey::GetPass(Commands[Current].SortKey) == ERenderPass::Translucent)
+                {
+                    CHECK(Commands[Current].SortKey >= LastTranslucentKey);
+                    LastTranslucentKey = Commands[Current].SortKey;
+                }
+                break;
+            case ERecordedDrawOp::DrawIndexedInstanced:
+                for (uint32 k = 0; k < Call.C; ++k)
+                {
+                    const uint32 Tag = GetTag(Backend.GetInstanceTransforms()[Call.D + k]);
+                    CHECK(DrawSortKey::GetPass(Commands[Tag].SortKey) != ERenderPass::Translucent);
+                    VerifyDraw(Tag, Call.A, Call.B);
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        for (int i = 0; i < N; ++i) CHECK(DrawCount[i] == 1);
+    }
+}
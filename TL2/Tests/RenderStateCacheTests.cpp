@@ -0,0 +1,59 @@
+﻿#include "TestHarness.h"
+#include "RenderStateCache.h"
+#include <cstring>
+
+TEST_CASE(StateCache_FiltersRepeatedValuesPerSlot)
+{
+    FRenderStateCache Cache;
+    int A = 0, B = 0;
+    CHECK(Cache.Apply(ERenderStateSlot::VertexShader, FRenderStateCache::ToKey(&A)));
+    CHECK(!Cache.Apply(ERenderStateSlot::VertexShader, FRenderStateCache::ToKey(&A)));
+    CHECK(Cache.Apply(ERenderStateSlot::PixelShader, FRenderStateCache::ToKey(&A)));    // 슬롯끼리 독립
+    CHECK(Cache.Apply(ERenderStateSlot::VertexShader, FRenderStateCache::ToKey(&B)));
+
+    // SubValue(스트라이드 등)만 바뀌어도 다시 넘긴다
+    CHECK(Cache.Apply(ERenderStateSlot::VertexBuffer, 5, 32));
+    CHECK(Cache.Apply(ERenderStateSlot::VertexBuffer, 5, 44));
+    CHECK(!Cache.Apply(ERenderStateSlot::VertexBuffer, 5, 44));
+
+    CHECK(Cache.GetCounters().GetTotalIssued() == 5);
+    CHECK(Cache.GetCounters().GetTotalFiltered() == 2);
+}
+
+TEST_CASE(StateCache_InvalidateAndDisable)
+{
+    FRenderStateCache Cache;
+    int A = 0;
+    const uint64 Key = FRenderStateCache::ToKey(&A);
+    Cache.Apply(ERenderStateSlot::BlendState, Key);
+    Cache.Apply(ERenderStateSlot::PixelTexture, Key);
+
+    Cache.Invalidate(ERenderStateSlot::BlendState);
+    CHECK(Cache.Apply(ERenderStateSlot::BlendState, Key));
+    CHECK(!Cache.Apply(ERenderStateSlot::PixelTexture, Key));
+
+    Cache.Invalidate();
+    CHECK(Cache.Apply(ERenderStateSlot::PixelTexture, Key));
+
+    Cache.SetEnabled(false);
+    CHECK(Cache.Apply(ERenderStateSlot::PixelTexture, Key));
+}
+
+TEST_CASE(StateCache_BeginFrameRollsCountersAndInvalidates)
+{
+    FRenderStateCache Cache;
+    int A = 0;
+    const uint64 Key = FRenderStateCache::ToKey(&A);
+    Cache.Apply(ERenderStateSlot::InputLayout, Key);
+    Cache.Apply(ERenderStateSlot::InputLayout, Key);
+
+    Cache.BeginFrame();
+    CHECK(Cache.GetLastCounters().GetTotalIssued() == 1 && Cache.GetLastCounters().GetTotalFiltered() == 1);
+    CHECK(Cache.GetCounters().GetTotalIssued() == 0);
+    CHECK(Cache.Apply(ERenderStateSlot::InputLayout, Key));
+
+    for (int i = 0; i < static_cast<int>(ERenderStateSlot::Count); ++i)
+    {
+        CHECK(std::strcmp(GetRenderStateSlotName(static_cast<ERenderStateSlot>(i)), "Unknown") != 0);
+    }
+}
@@ -0,0 +1,65 @@
+﻿#pragma once
+#include <cstdio>
+#include <vector>
+
+// ------------------------------------------------------------
+// 헤드리스 테스트용 최소 하네스 (외부 프레임워크 없이 CMake/ctest 로 돈다)
+//  - TEST_CASE 로 등록한 함수를 등록 순서대로 실행하고, CHECK 실패는 파일/줄과 함께 출력한다
+//  - 실패가 하나라도 있으면 종료 코드 1
+// ------------------------------------------------------------
+namespace TestHarness
+{
+    using FTestFunc = void(*)();
+
+    struct FTestEntry
+    {
+        const char* Name;
+        FTestFunc Func;
+    };
+
+    inline std::vector<FTestEntry>& GetTests()
+    {
+        static std::vector<FTestEntry> Tests;
+        return Tests;
+    }
+
+    inline int& GetFailureCount()
+    {
+        static int Failures = 0;
+        return Failures;
+    }
+
+    struct FTestRegistrar
+    {
+        FTestRegistrar(const char* Name, FTestFunc Func) { GetTests().push_back({ Name, Func }); }
+    };
+
+    inline void ReportFailure(const char* File, int Line, const char* Expr)
+    {
+        std::printf("  FAIL %s:%d: %s\n", File, Line, Expr);
+        ++GetFailureCount();
+    }
+
+    inline int RunAll()
+    {
+        int FailedTests = 0;
+        for (const FTestEntry& Test : GetTests())
+        {
+            const int Before = GetFailureCount();
+            Test.Func();
+            const bool bPassed = GetFailureCount() == Before;
+            std::printf("[%s] %s\n", bPassed ? " OK " : "FAIL", Test.Name);
+            FailedTests += bPassed ? 0 : 1;
+        }
+        std::printf("%d/%d tests passed\n", static_cast<int>(GetTests().size()) - FailedTests, static_cast<int>(GetTests().size()));
+        return FailedTests == 0 ? 0 : 1;
+    }
+}
+
+#define TEST_CASE(Name) \
+    static void Name(); \
+    static TestHarness::FTestRegistrar Name##_Registrar(#Name, &Name); \
+    static void Name()
+
+#define CHECK(Expr) \
+    do { if (!(Expr)) TestHarness::ReportFailure(__FILE__, __LINE__, #Expr); } while (0)
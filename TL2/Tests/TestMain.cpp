@@ -0,0 +1,6 @@
+﻿#include "TestHarness.h"
+
+int main()
+{
+    return TestHarness::RunAll();
+}
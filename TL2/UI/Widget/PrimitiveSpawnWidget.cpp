@@ -14,6 +14,11 @@
 #include "../../Octree.h"
 #include "WorldPartitionManager.h"
 #include "StaticMeshComponent.h"
+#include "TextRenderComponent.h"
+#include "BillboardComponent.h"
+#include "Occlusion.h"
+#include "RenderManager.h"
+#include "SimdDispatch.h"
 
 //// UE_LOG 대체 매크로
 //#define UE_LOG(fmt, ...)
@@ -268,11 +273,193 @@ void UPrimitiveSpawnWidget::RenderWidget()
             ImGui::Text("BVH Nodes: %d", BVH->TotalNodeCount());
             ImGui::Text("BVH Actors: %d", BVH->TotalActorCount());
             ImGui::Text("BVH Max Depth: %d", BVH->MaxOccupiedDepth());
+
+            const char* BuildModes[] = { "LBVH", "Binned SAH" };
+            int BuildModeIndex = static_cast<int>(BVH->GetBuildMode());
+            if (ImGui::Combo("BVH Build Mode", &BuildModeIndex, BuildModes, IM_ARRAYSIZE(BuildModes)))
+            {
+                BVH->SetBuildMode(static_cast<EBVHBuildMode>(BuildModeIndex));
+            }
+            ImGui::Text("BVH Frustum Visits: %u (Plane Tests: %u)", BVH->GetLastFrustumNodeVisits(), BVH->GetLastFrustumPlaneTests());
+            ImGui::Text("BVH Screen-Size Culled: %u", BVH->GetLastScreenSizeCulled());
             if (ImGui::Button("Dump BVH To Log"))
             {
                 BVH->DebugDump();
             }
         }
+
+        // SIMD 커널 레벨 (감지 레벨 이하로만 강제 가능, editor.ini 에 저장)
+        {
+            const int Detected = static_cast<int>(FSimd::GetDetectedLevel());
+            const int Current = FSimd::IsLevelForced() ? static_cast<int>(FSimd::GetForcedLevel()) + 1 : 0;
+            FString Preview = FSimd::IsLevelForced() ? FSimd::GetLevelName(FSimd::GetForcedLevel()) : "Auto";
+            Preview += " (Active: ";
+            Preview += FSimd::GetLevelName(FSimd::GetLevel());
+            Preview += ")";
+            if (ImGui::BeginCombo("SIMD Level", Preview.c_str()))
+            {
+                for (int Option = 0; Option <= Detected + 1; ++Option)
+                {
+                    const ESimdLevel Level = Option == 0 ? ESimdLevel::Count : static_cast<ESimdLevel>(Option - 1);
+                    if (ImGui::Selectable(FSimd::GetLevelName(Level), Option == Current))
+                    {
+                        FSimd::SetForcedLevel(Level);
+                        EditorINI["SimdLevel"] = FSimd::GetLevelName(Level);
+                    }
+                }
+                ImGui::EndCombo();
+            }
+            if (ImGui::Button("Validate SIMD Kernels"))
+            {
+                ValidateSimdKernels();
+            }
+        }
+
+        // 화면 크기 컬링 (클래스별 최소 픽셀, 뷰포트별 배율은 뷰포트 툴바에서)
+        URenderSettings& Settings = World->GetRenderSettings();
+        bool bScreenSizeCulling = Settings.IsScreenSizeCullingEnabled();
+        if (ImGui::Checkbox("Screen Size Culling", &bScreenSizeCulling))
+        {
+            Settings.SetScreenSizeCullingEnabled(bScreenSizeCulling);
+        }
+        if (bScreenSizeCulling)
+        {
+            float DefaultPixels = Settings.GetScreenSizeCullDefault();
+            if (ImGui::DragFloat("Min Pixels##Default", &DefaultPixels, 0.1f, 0.0f, 64.0f))
+            {
+                Settings.SetScreenSizeCullDefault(DefaultPixels);
+            }
+            auto ClassThreshold = [&](const char* Label, const UClass* Class)
+            {
+                float Pixels = Settings.GetScreenSizeCullThreshold(Class);
+                if (ImGui::DragFloat(Label, &Pixels, 0.1f, 0.0f, 64.0f))
+                {
+                    Settings.SetScreenSizeCullThreshold(Class, Pixels);
+                }
+            };
+            ClassThreshold("Min Pixels##StaticMesh", UStaticMeshComponent::StaticClass());
+            ClassThreshold("Min Pixels##Text", UTextRenderComponent::StaticClass());
+            ClassThreshold("Min Pixels##Billboard", UBillboardComponent::StaticClass());
+        }
+
+        // 정지한 뷰포트는 지난 컬링 결과 재사용
+        bool bViewCache = RENDER.IsViewVisibilityCacheEnabled();
+        if (ImGui::Checkbox("View Visibility Cache", &bViewCache))
+        {
+            RENDER.SetViewVisibilityCacheEnabled(bViewCache);
+        }
+        if (bViewCache)
+        {
+            ImGui::Text("Cached Views: %u, Culled Views: %u", RENDER.GetLastViewCacheHits(), RENDER.GetLastViewCacheMisses());
+        }
+
+        // 정렬 키 드로우 커맨드 (바뀐 상태만 바인딩)
+        bool bDrawCommandList = RENDER.IsDrawCommandListEnabled();
+        if (ImGui::Checkbox("Sorted Draw Commands", &bDrawCommandList))
+        {
+            RENDER.SetDrawCommandListEnabled(bDrawCommandList);
+        }
+        if (bDrawCommandList)
+        {
+            bool bParallelBuild = RENDER.IsParallelDrawListBuildEnabled();
+            if (ImGui::Checkbox("Parallel Draw List Build", &bParallelBuild))
+            {
+                RENDER.SetParallelDrawListBuildEnabled(bParallelBuild);
+            }
+            bool bInstancing = RENDER.IsAutoInstancingEnabled();
+            if (ImGui::Checkbox("Auto Instancing", &bInstancing))
+            {
+                RENDER.SetAutoInstancingEnabled(bInstancing);
+            }
+            if (bInstancing)
+            {
+                int MinInstances = static_cast<int>(RENDER.GetMinInstanceCount());
+                if (ImGui::DragInt("Min Instances", &MinInstances, 0.1f, 2, 64))
+                {
+                    RENDER.SetMinInstanceCount(static_cast<uint32>(std::max(MinInstances, 2)));
+                }
+            }
+            bool bConstantRing = RENDER.IsConstantRingEnabled();
+            if (ImGui::Checkbox("Constant Ring", &bConstantRing))
+            {
+                RENDER.SetConstantRingEnabled(bConstantRing);
+            }
+
+            const FDrawSubmitStats& DrawStats = RENDER.GetLastDrawSubmitStats();
+            ImGui::Text("Commands: %u, Draws: %u, Legacy Primitives: %u", DrawStats.Commands, DrawStats.DrawCalls, RENDER.GetLastLegacyDrawPrimitives());
+            ImGui::Text("Instanced Draws: %u (%u Instances)", DrawStats.InstancedDraws, DrawStats.Instances);
+            ImGui::Text("Binds - Shader: %u, Material: %u, Mesh: %u, Transform: %u",
+                DrawStats.ShaderBinds, DrawStats.MaterialBinds, DrawStats.MeshBinds, DrawStats.TransformUpdates);
+            ImGui::Text("Draw List: Build %.3f ms, Sort %.3f ms", RENDER.GetLastDrawListBuildMs(), RENDER.GetLastDrawListSortMs());
+            if (const FConstantRingAllocator* ConstantRing = RENDER.GetRenderer()->GetRHIDevice()->GetConstantRing())
+            {
+                const FConstantRingStats& RingStats = ConstantRing->GetLastStats();
+                ImGui::Text("Constant Ring: %.1f / %.1f KB, Maps: %u, Wraps: %u, Fallbacks: %u",
+                    RingStats.Bytes / 1024.0, ConstantRing->GetCapacity() / 1024.0, RingStats.Allocations, RingStats.Wraps, RingStats.Failures);
+            }
+            else
+            {
+                ImGui::TextDisabled("Constant Ring: unsupported (D3D11.1 offsets)");
+            }
+        }
+
+        // 렌더 상태 캐시 (같은 객체 재바인딩 생략)
+        if (URenderer* Renderer = RENDER.GetRenderer())
+        {
+            FRenderStateCache& StateCache = Renderer->GetRenderStateCache();
+            bool bStateCache = StateCache.IsEnabled();
+            if (ImGui::Checkbox("Render State Cache", &bStateCache))
+            {
+                StateCache.SetEnabled(bStateCache);
+            }
+
+            const FRenderStateCounters& StateCounters = StateCache.GetLastCounters();
+            ImGui::Text("State Changes: Issued %u, Filtered %u", StateCounters.GetTotalIssued(), StateCounters.GetTotalFiltered());
+            if (ImGui::TreeNode("State Changes by Slot"))
+            {
+                for (int i = 0; i < static_cast<int>(ERenderStateSlot::Count); ++i)
+                {
+                    ImGui::Text("%s: %u / %u", GetRenderStateSlotName(static_cast<ERenderStateSlot>(i)),
+                        StateCounters.Issued[i], StateCounters.Filtered[i]);
+                }
+                ImGui::TreePop();
+            }
+        }
+
+        // CPU 오클루전 (오클루더 선정 예산 + 마지막 패스 통계)
+        bool bCPUOcclusion = RENDER.IsCPUOcclusionEnabled();
+        if (ImGui::Checkbox("CPU Occlusion Culling", &bCPUOcclusion))
+        {
+            RENDER.SetCPUOcclusionEnabled(bCPUOcclusion);
+        }
+        FOcclusionCullingManagerCPU* Occlusion = RENDER.GetOcclusionCPU();
+        if (bCPUOcclusion && Occlusion)
+        {
+            bool bTemporal = Occlusion->IsTemporalReprojectionEnabled();
+            if (ImGui::Checkbox("Temporal Reprojection", &bTemporal))
+            {
+                Occlusion->SetTemporalReprojectionEnabled(bTemporal);
+            }
+
+            FOccluderSelectionSettings Selection = Occlusion->GetSelectionSettings();
+            ImGui::DragInt("Occluder Triangle Budget", &Selection.MaxTriangles, 64.0f, 0, 262144);
+            ImGui::DragInt("Occluder Rect Budget", &Selection.MaxRects, 1.0f, 0, 4096);
+            ImGui::DragFloat("Occluder Min Area (px^2)", &Selection.MinScreenArea, 1.0f, 0.0f, 65536.0f);
+            ImGui::DragFloat("Occluder Min Thickness (px)", &Selection.MinScreenThickness, 0.1f, 0.0f, 256.0f);
+            Occlusion->SetSelectionSettings(Selection);
+
+            const FOcclusionStats& Stats = Occlusion->GetLastStats();
+            ImGui::Text("Occluders: %u / %u (Skipped Small: %u, Budget: %u, Hidden: %u)",
+                Stats.SelectedOccluders, Stats.Candidates, Stats.SkippedSmall, Stats.SkippedBudget, Stats.SkippedHidden);
+            ImGui::Text("Occluder Tris: %u, Rects: %u", Stats.OccluderTriangles, Stats.OccluderRects);
+            ImGui::Text("Occluded: %u / %u", Stats.Occluded, Stats.Occludees);
+            if (bTemporal)
+            {
+                ImGui::Text("Reprojected Texels: %u", Stats.ReprojectedTexels);
+            }
+            ImGui::Text("Occlusion: %.3f ms (Select %.3f, Raster %.3f, Reproject %.3f, HZB %.3f, Test %.3f)",
+                Stats.GetTotalMs(), Stats.SelectMs, Stats.RasterMs, Stats.ReprojectMs, Stats.HZBMs, Stats.TestMs);
+        }
     }
     else
     {
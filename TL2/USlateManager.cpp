@@ -8,6 +8,7 @@
 #include "SControlPanel.h"
 #include "SViewportWindow.h"
 #include "FViewportClient.h"
+#include "RenderManager.h"
 #include "UI/UIManager.h"
 
 USlateManager& USlateManager::GetInstance()
@@ -179,7 +180,21 @@ void USlateManager::Render()
     MenuBar->RenderWidget();
     if (RootSplitter)
     {
+        // 4분할로 보이는 뷰포트들은 컬링을 한 번에 해 두고 각 뷰포트 렌더에서 나눠 쓴다
+        TArray<FViewport*> VisibleViewports;
+        if (TopPanel && TopPanel->SideLT == LeftPanel)
+        {
+            for (SViewportWindow* ViewportWindow : Viewports)
+            {
+                if (ViewportWindow && ViewportWindow->GetViewport())
+                    VisibleViewports.Add(ViewportWindow->GetViewport());
+            }
+        }
+        RENDER.BeginSharedViewCulling(VisibleViewports);
+
         RootSplitter->OnRender();
+
+        RENDER.EndSharedViewCulling();
     }
 }
 
@@ -17,6 +17,7 @@ public:
     {
         File.read(reinterpret_cast<char*>(Data), Length);
     }
+    bool IsError() const override { return File.fail(); }
     /*void Seek(size_t Position) override { File.seekg(Position); }
     size_t Tell() const override { return (size_t)File.tellg(); }*/
     bool Close() override
@@ -17,6 +17,7 @@ public:
     {
         File.write(reinterpret_cast<char*>(Data), Length);
     }
+    bool IsError() const override { return File.fail(); }
     /*void Seek(size_t Position) override { File.seekp(Position); }
     size_t Tell() const override { return (size_t)File.tellp(); }*/
     bool Close() override
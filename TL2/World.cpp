@@ -7,6 +7,7 @@
 #include "CameraComponent.h"
 #include "ObjectFactory.h"
 #include "TextRenderComponent.h"
+#include "BillboardComponent.h"
 #include "AABoundingBoxComponent.h"
 #include "FViewport.h"
 #include "SViewportWindow.h"
@@ -32,6 +33,10 @@ UWorld::UWorld()
 	SelectionMgr = std::make_unique<USelectionManager>();
 	Level = std::make_unique<ULevel>();
 	CreateLevel();
+
+	// 멀리서 점처럼 보이는 텍스트/빌보드는 일반 프리미티브보다 일찍 뺀다
+	RenderSettings.SetScreenSizeCullThreshold(UTextRenderComponent::StaticClass(), 6.0f);
+	RenderSettings.SetScreenSizeCullThreshold(UBillboardComponent::StaticClass(), 4.0f);
 }
 
 UWorld::~UWorld()
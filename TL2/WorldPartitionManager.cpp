@@ -18,6 +18,9 @@ namespace
 		// 추후 컴포넌트 별 처리 가능하게 수정 필
 		return Actor && Actor->IsA<AStaticMeshActor>();
 	}
+
+	// 파티션 매니저끼리 값이 겹치지 않도록 전역으로 증가 (월드가 바뀌어도 이전 세대와 혼동 없음)
+	uint32 GSceneGenerationCounter = 0;
 }
 
 UWorldPartitionManager::UWorldPartitionManager()
@@ -25,6 +28,7 @@ UWorldPartitionManager::UWorldPartitionManager()
 	//FBound WorldBounds(FVector(-50, -50, -50), FVector(50, 50, 50));
 	FBound WorldBounds(FVector(-50, -50, -50), FVector(50, 50, 50));
 	SceneOctree = new FOctree(WorldBounds, 0, 8, 10);
+	MarkSceneChanged();
 	// BVH도 동일 월드 바운드로 초기화 (더 깊고 작은 리프 설정)
 	//BVH = new FBVHierachy(FBound(), 0, 5, 1); 
 	BVH = new FBVHierachy(FBound(), 0, 8, 1); 
@@ -52,6 +56,12 @@ void UWorldPartitionManager::Clear()
 
 	DirtyQueue.Empty();
 	DirtySet.Empty();
+	MarkSceneChanged();
+}
+
+void UWorldPartitionManager::MarkSceneChanged()
+{
+	SceneGeneration = ++GSceneGenerationCounter;
 }
 
 void UWorldPartitionManager::Register(AActor* Owner)
@@ -90,6 +100,7 @@ void UWorldPartitionManager::BulkRegister(const TArray<AActor*>& Actors)
 	}
 
 	if (BVH) BVH->BulkInsert(PrimsAndBounds);
+	MarkSceneChanged();
 }
 
 void UWorldPartitionManager::Unregister(AActor* Owner)
@@ -103,6 +114,7 @@ void UWorldPartitionManager::Unregister(AActor* Owner)
 		BVH->Remove(Owner);
 		BVH->FlushRebuild(); // Immediately apply removal
 	}
+	MarkSceneChanged();
 
 	// DirtySet에서 이 액터 소유 프리미티브 제거
 	TArray<UPrimitiveComponent*> ToErase;
@@ -128,6 +140,7 @@ void UWorldPartitionManager::Register(UPrimitiveComponent* Prim)
 	{
 		DirtyQueue.push(Prim);
 	}
+	MarkSceneChanged();
 }
 
 void UWorldPartitionManager::Unregister(UPrimitiveComponent* Prim)
@@ -139,6 +152,7 @@ void UWorldPartitionManager::Unregister(UPrimitiveComponent* Prim)
 		BVH->Remove(Prim, Prim->GetWorldAABB());
 		BVH->FlushRebuild(); // Immediately apply removal
 	}
+	MarkSceneChanged();
 }
 
 void UWorldPartitionManager::MarkDirty(AActor* Owner)
@@ -163,6 +177,8 @@ void UWorldPartitionManager::MarkDirty(UPrimitiveComponent* Prim)
 	{
 		DirtyQueue.push(Prim);
 	}
+	// 트랜스폼/메시/표시 상태 변경도 여기로 들어온다
+	MarkSceneChanged();
 }
 
 void UWorldPartitionManager::Update(float DeltaTime, uint32 InBugetCount)
@@ -189,7 +205,12 @@ void UWorldPartitionManager::Update(float DeltaTime, uint32 InBugetCount)
 
 		++processed;
 	}
-	if (any && BVH) BVH->FlushRebuild();
+	// 이동만 있었다면 리핏, 추가/제거가 있었다면 재빌드 (BVH 내부에서 판단)
+	if (any && BVH)
+	{
+		BVH->FlushRebuild();
+		MarkSceneChanged();
+	}
 }
 
 //void UWorldPartitionManager::RayQueryOrdered(FRay InRay, OUT TArray<std::pair<AActor*, float>>& Candidates)
@@ -213,11 +234,35 @@ void UWorldPartitionManager::RayQueryClosest(FRay InRay, OUT AActor*& OutActor,
 	}
 }
 
-void UWorldPartitionManager::FrustumQuery(Frustum InFrustum)
+void UWorldPartitionManager::RayQueryClosestBatch(const TArray<FRay>& Rays, OUT TArray<FRayHit>& OutHits)
+{
+	if (BVH)
+	{
+		BVH->QueryRaysClosest(Rays, OutHits);
+	}
+	else
+	{
+		OutHits.assign(Rays.size(), FRayHit());
+	}
+}
+
+void UWorldPartitionManager::FrustumQuery(const Frustum& InFrustum, OUT TArray<UPrimitiveComponent*>& OutVisible, const FScreenSizeCullParams* ScreenSize)
 {
+	OutVisible.clear();
 	if(BVH)
 	{
-		BVH->QueryFrustum(InFrustum);
+		BVH->QueryFrustum(InFrustum, OutVisible, ScreenSize);
+	}
+}
+
+void UWorldPartitionManager::FrustumQueryMulti(const TArray<Frustum>& InFrustums, OUT TArray<UPrimitiveComponent*>& OutPrimitives, OUT TArray<uint8>& OutViewMasks,
+	const TArray<FScreenSizeCullParams>* ScreenSizes)
+{
+	OutPrimitives.clear();
+	OutViewMasks.clear();
+	if (BVH)
+	{
+		BVH->QueryFrustumMulti(InFrustums, OutPrimitives, OutViewMasks, ScreenSizes);
 	}
 }
 
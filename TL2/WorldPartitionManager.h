@@ -9,8 +9,10 @@ class FOctree;
 class FBVHierachy;
 
 struct FRay;
+struct FRayHit;
 struct FBound;
 struct Frustum;
+struct FScreenSizeCullParams;
 
 class UWorldPartitionManager : public UObject
 {
@@ -36,7 +38,17 @@ public:
 
     //void RayQueryOrdered(FRay InRay, OUT TArray<std::pair<AActor*, float>>& Candidates);
     void RayQueryClosest(FRay InRay, OUT AActor*& OutActor, OUT float& OutBestT);
-	void FrustumQuery(Frustum InFrustum);
+    // 여러 레이를 한 번에 쿼리 (레이별 가장 가까운 액터/거리)
+    void RayQueryClosestBatch(const TArray<FRay>& Rays, OUT TArray<FRayHit>& OutHits);
+	// 보이는 프리미티브 목록을 OutVisible 에 채운다 (기존 내용은 비움)
+	void FrustumQuery(const Frustum& InFrustum, OUT TArray<UPrimitiveComponent*>& OutVisible, const FScreenSizeCullParams* ScreenSize = nullptr);
+	// 여러 뷰를 한 번에 컬링. OutViewMasks[i] 의 비트 v = OutPrimitives[i] 가 InFrustums[v] 에서 보임
+	void FrustumQueryMulti(const TArray<Frustum>& InFrustums, OUT TArray<UPrimitiveComponent*>& OutPrimitives, OUT TArray<uint8>& OutViewMasks,
+		const TArray<FScreenSizeCullParams>* ScreenSizes = nullptr);
+
+	// 등록/해제/이동 등 파티션 내용이 바뀔 때마다 새 값이 된다 (모든 월드에서 유일, 가시성 캐시 무효화용)
+	uint32 GetSceneGeneration() const { return SceneGeneration; }
+	void MarkSceneChanged();
 
 	/** 옥트리 게터 */
 	FOctree* GetSceneOctree() const { return SceneOctree; }
@@ -57,4 +69,5 @@ private:
 	TSet<UPrimitiveComponent*> DirtySet;
 	FOctree* SceneOctree = nullptr;
 	FBVHierachy* BVH = nullptr;
+	uint32 SceneGeneration = 0;
 };